@@ -0,0 +1,194 @@
+//@HEADER
+/*
+*******************************************************************************
+
+    Copyright (C) 2004, 2005, 2007 EPFL, Politecnico di Milano, INRIA
+    Copyright (C) 2010 EPFL, Politecnico di Milano, Emory University
+
+    This file is part of LifeV.
+
+    LifeV is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    LifeV is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with LifeV.  If not, see <http://www.gnu.org/licenses/>.
+
+*******************************************************************************
+*/
+//@HEADER
+
+/*!
+    @file
+    @brief Initial guess for a sequence of linear systems from the projection on the previous solutions
+
+    @date 10-2026
+ */
+
+#include <cmath>
+
+#include <lifev/core/algorithm/InitialGuessProjection.hpp>
+
+namespace LifeV
+{
+
+// ===================================================
+// Constructors & Destructor
+// ===================================================
+InitialGuessProjection::InitialGuessProjection ( const UInt& size, const ProjectionNorm& norm ) :
+    M_size               ( size ),
+    M_norm               ( norm ),
+    M_solutions          (),
+    M_numStoredSolutions ( 0 ),
+    M_basis              (),
+    M_images             ()
+{
+
+}
+
+// ===================================================
+// Methods
+// ===================================================
+UInt
+InitialGuessProjection::computeInitialGuess ( const operator_Type& oper, const vector_Type& rhs,
+                                              vector_Type& initialGuess, vector_Type& residual )
+{
+    // Solutions whose component orthogonal to the previous ones is below this
+    // fraction of their norm are considered linearly dependent
+    const Real dependencyTolerance ( 1e-8 );
+
+    // The workspace is allocated once for all
+    while ( M_basis.size() < M_numStoredSolutions )
+    {
+        M_basis.push_back ( vectorPtr_Type ( new vector_Type ( M_solutions[0] ) ) );
+        M_images.push_back ( vectorPtr_Type ( new vector_Type ( M_solutions[0] ) ) );
+    }
+
+    // Orthonormalization of the stored solutions with the current operator (modified Gram-Schmidt)
+    UInt dimension ( 0 );
+    for ( UInt i ( 0 ); i < M_numStoredSolutions; ++i )
+    {
+        vector_Type& v  = *M_basis[dimension];
+        vector_Type& Av = *M_images[dimension];
+
+        v = M_solutions[i];
+        oper.Apply ( v.epetraVector(), Av.epetraVector() );
+
+        const Real initialNorm ( innerProduct ( v, Av, v, Av ) );
+        if ( initialNorm <= 0. )
+        {
+            continue;
+        }
+
+        for ( UInt j ( 0 ); j < dimension; ++j )
+        {
+            const Real h ( innerProduct ( v, Av, *M_basis[j], *M_images[j] ) );
+            v.linearCombination ( -h, *M_basis[j], 1. );
+            Av.linearCombination ( -h, *M_images[j], 1. );
+        }
+
+        const Real norm ( innerProduct ( v, Av, v, Av ) );
+        if ( norm <= dependencyTolerance * dependencyTolerance * initialNorm )
+        {
+            continue;
+        }
+
+        v  *= 1. / std::sqrt ( norm );
+        Av *= 1. / std::sqrt ( norm );
+        ++dimension;
+    }
+
+    if ( dimension == 0 )
+    {
+        initialGuess = 0.;
+        residual = rhs;
+        return 0;
+    }
+
+    // Projection: x0 = sum_j c_j v_j and b - A x0 = b - sum_j c_j A v_j
+    std::vector<Real> guessCoefficients ( dimension );
+    std::vector<Real> residualCoefficients ( dimension + 1 );
+    std::vector<const vector_Type*> basis ( dimension );
+    std::vector<const vector_Type*> images ( dimension + 1 );
+    for ( UInt j ( 0 ); j < dimension; ++j )
+    {
+        // In the energy norm, (x, v_j)_A = (A x, v_j) = (b, v_j)
+        const Real c ( M_norm == EnergyNorm ? rhs.dot ( *M_basis[j] ) : rhs.dot ( *M_images[j] ) );
+
+        guessCoefficients[j]    = c;
+        residualCoefficients[j] = -c;
+        basis[j]                = M_basis[j].get();
+        images[j]               = M_images[j].get();
+    }
+    residualCoefficients[dimension] = 1.;
+    images[dimension]               = &rhs;
+
+    initialGuess.linearCombination ( guessCoefficients, basis );
+    residual.linearCombination ( residualCoefficients, images );
+
+    return dimension;
+}
+
+void
+InitialGuessProjection::storeSolution ( const vector_Type& solution )
+{
+    if ( M_size == 0 )
+    {
+        return;
+    }
+
+    if ( M_solutions.size() != M_size )
+    {
+        M_solutions.setup ( M_size, solution );
+        M_numStoredSolutions = 1;
+        return;
+    }
+
+    M_solutions.shift ( solution );
+    if ( M_numStoredSolutions < M_size )
+    {
+        ++M_numStoredSolutions;
+    }
+}
+
+void
+InitialGuessProjection::reset()
+{
+    M_numStoredSolutions = 0;
+}
+
+// ===================================================
+// Set Methods
+// ===================================================
+void
+InitialGuessProjection::setup ( const UInt& size, const ProjectionNorm& norm )
+{
+    M_size               = size;
+    M_norm               = norm;
+    M_solutions          = TimeAdvanceHistory<vector_Type>();
+    M_numStoredSolutions = 0;
+    M_basis.clear();
+    M_images.clear();
+}
+
+// ===================================================
+// Private Methods
+// ===================================================
+Real
+InitialGuessProjection::innerProduct ( const vector_Type& /*u*/, const vector_Type& Au,
+                                       const vector_Type& v, const vector_Type& Av ) const
+{
+    if ( M_norm == EnergyNorm )
+    {
+        return Au.dot ( v );
+    }
+    return Au.dot ( Av );
+}
+
+} // namespace LifeV
@@ -0,0 +1,180 @@
+//@HEADER
+/*
+*******************************************************************************
+
+    Copyright (C) 2004, 2005, 2007 EPFL, Politecnico di Milano, INRIA
+    Copyright (C) 2010 EPFL, Politecnico di Milano, Emory University
+
+    This file is part of LifeV.
+
+    LifeV is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    LifeV is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with LifeV.  If not, see <http://www.gnu.org/licenses/>.
+
+*******************************************************************************
+*/
+//@HEADER
+
+/*!
+    @file
+    @brief Initial guess for a sequence of linear systems from the projection on the previous solutions
+
+    @date 10-2026
+ */
+
+#ifndef _INITIALGUESSPROJECTION_HPP
+#define _INITIALGUESSPROJECTION_HPP 1
+
+#include <vector>
+
+#include <Epetra_Operator.h>
+
+#include <lifev/core/LifeV.hpp>
+#include <lifev/core/array/VectorEpetra.hpp>
+#include <lifev/core/fem/TimeAdvanceHistory.hpp>
+
+namespace LifeV
+{
+
+//! InitialGuessProjection - Initial guess of A x = b from the last solutions of the sequence
+/*!
+  The last k solutions x^{n-1}, ..., x^{n-k} of a sequence of linear systems are stored.
+  Before solving A x^n = b^n, they are orthonormalized with respect to the current
+  operator and x^n is approximated by its projection on their span:
+  <ul>
+  <li> EnergyNorm: the basis is orthonormal in the A-norm and the initial guess minimizes
+       the A-norm of the error (A symmetric positive definite);
+  <li> ResidualNorm: the images A v_i of the basis are orthonormal and the initial guess
+       minimizes the norm of the residual (any nonsingular A).
+  </ul>
+  The orthonormalization is done at each projection with the current operator, so that
+  the projection stays optimal when A varies between the systems; it costs one
+  application of A per stored solution.
+
+  The residual b - A x0 is returned together with the initial guess x0: solving
+  A dx = b - A x0 and setting x = x0 + dx allows to use the initial guess with
+  solvers that always start from zero.
+ */
+class InitialGuessProjection
+{
+public:
+
+    //! @name Public Types
+    //@{
+
+    typedef VectorEpetra                           vector_Type;
+    typedef std::shared_ptr<vector_Type>           vectorPtr_Type;
+    typedef Epetra_Operator                        operator_Type;
+
+    enum ProjectionNorm { EnergyNorm, ResidualNorm };
+
+    //@}
+
+
+    //! @name Constructors & Destructor
+    //@{
+
+    //! Constructor
+    /*!
+      @param size Number of solutions stored (0 disables the projection)
+      @param norm Norm minimized by the projection
+     */
+    explicit InitialGuessProjection ( const UInt& size = 0, const ProjectionNorm& norm = EnergyNorm );
+
+    //! Destructor
+    ~InitialGuessProjection() {}
+
+    //@}
+
+
+    //! @name Methods
+    //@{
+
+    //! Compute the initial guess and the corresponding residual
+    /*!
+      @param oper Operator A of the system
+      @param rhs Right hand side b of the system
+      @param initialGuess Initial guess x0 (zero if no solution is stored)
+      @param residual Residual b - A x0
+      @return Dimension of the space used for the projection
+     */
+    UInt computeInitialGuess ( const operator_Type& oper, const vector_Type& rhs,
+                               vector_Type& initialGuess, vector_Type& residual );
+
+    //! Store a solution of the sequence, the oldest one being discarded if needed
+    /*!
+      @param solution Solution of the last system
+     */
+    void storeSolution ( const vector_Type& solution );
+
+    //! Discard the stored solutions
+    void reset();
+
+    //@}
+
+
+    //! @name Set Methods
+    //@{
+
+    //! Set the number of stored solutions and the norm (the stored solutions are discarded)
+    /*!
+      @param size Number of solutions stored (0 disables the projection)
+      @param norm Norm minimized by the projection
+     */
+    void setup ( const UInt& size, const ProjectionNorm& norm = EnergyNorm );
+
+    //@}
+
+
+    //! @name Get Methods
+    //@{
+
+    //! Return the maximum number of stored solutions
+    const UInt& size() const
+    {
+        return M_size;
+    }
+
+    //! Return the number of solutions currently stored
+    const UInt& numStoredSolutions() const
+    {
+        return M_numStoredSolutions;
+    }
+
+    //! Return the norm minimized by the projection
+    const ProjectionNorm& norm() const
+    {
+        return M_norm;
+    }
+
+    //@}
+
+private:
+
+    //! Inner product defining the orthonormality of the basis
+    Real innerProduct ( const vector_Type& u, const vector_Type& Au,
+                        const vector_Type& v, const vector_Type& Av ) const;
+
+    UInt                                M_size;
+    ProjectionNorm                      M_norm;
+
+    TimeAdvanceHistory<vector_Type>     M_solutions;
+    UInt                                M_numStoredSolutions;
+
+    // Orthonormal basis and its image through the operator
+    std::vector<vectorPtr_Type>         M_basis;
+    std::vector<vectorPtr_Type>         M_images;
+};
+
+} // namespace LifeV
+
+#endif /* _INITIALGUESSPROJECTION_HPP */
@@ -34,6 +34,8 @@
     @date 03-08-2011
  */
 
+#include <algorithm>
+
 #include <lifev/core/LifeV.hpp>
 #include <lifev/core/algorithm/LinearSolver.hpp>
 #include <lifev/core/algorithm/PreconditionerIfpack.hpp>
@@ -56,10 +58,16 @@ LinearSolver::LinearSolver() :
     M_solverOperator       (),
     M_parameterList        (),
     M_displayer            ( new Displayer() ),
+    M_initialGuessProjection( new initialGuessProjection_Type() ),
     M_maxItersForReuse     ( 0 ),
     M_reusePreconditioner  ( false ),
     M_quitOnFailure        ( false ),
     M_silent               ( false ),
+    M_reusePolicy          ( ThresholdReuse ),
+    M_preconditionerSetupTime( 0. ),
+    M_solvesSinceSetup     ( 0 ),
+    M_iterationsSinceSetup ( 0 ),
+    M_solveTimeSinceSetup  ( 0. ),
     M_lossOfPrecision      ( SolverOperator_Type::undefined ),
     M_maxNumItersReached   ( SolverOperator_Type::undefined ),
     M_converged            ( SolverOperator_Type::undefined ),
@@ -78,10 +86,16 @@ LinearSolver::LinearSolver ( const std::shared_ptr<Epetra_Comm> commPtr ) :
     M_solverOperator       (),
     M_parameterList        (),
     M_displayer            ( new Displayer ( commPtr ) ),
+    M_initialGuessProjection( new initialGuessProjection_Type() ),
     M_maxItersForReuse     ( 0 ),
     M_reusePreconditioner  ( false ),
     M_quitOnFailure        ( false ),
     M_silent               ( false ),
+    M_reusePolicy          ( ThresholdReuse ),
+    M_preconditionerSetupTime( 0. ),
+    M_solvesSinceSetup     ( 0 ),
+    M_iterationsSinceSetup ( 0 ),
+    M_solveTimeSinceSetup  ( 0. ),
     M_lossOfPrecision      ( SolverOperator_Type::undefined ),
     M_maxNumItersReached   ( SolverOperator_Type::undefined ),
     M_converged            ( SolverOperator_Type::undefined ),
@@ -124,6 +138,33 @@ LinearSolver::solve ( vectorPtr_Type solutionPtr )
         return -1;
     }
 
+    // Initial guess from the projection on the previous solutions:
+    // the solver computes the correction to this initial guess
+    vectorPtr_Type rhsPtr ( M_rhs );
+    vectorPtr_Type initialGuessPtr;
+    if ( M_initialGuessProjection->size() > 0 )
+    {
+        initialGuessPtr.reset ( new vector_Type ( *M_rhs ) );
+        rhsPtr.reset ( new vector_Type ( *M_rhs ) );
+        UInt dimension = M_initialGuessProjection->computeInitialGuess ( *M_operator, *M_rhs, *initialGuessPtr, *rhsPtr );
+        if ( !M_silent )
+        {
+            M_displayer->leaderPrint ( "SLV-  Initial guess projected on " , dimension, " previous solutions\n" );
+        }
+    }
+
+    // The correction is computed with a tolerance relative to the initial residual:
+    // it is scaled so that the solve stops at the tolerance relative to the rhs
+    const Real tolerance ( M_tolerance );
+    if ( initialGuessPtr )
+    {
+        const Real residualNorm ( rhsPtr->norm2() );
+        if ( residualNorm > 0. )
+        {
+            M_tolerance = solverTolerance() * M_rhs->norm2() / residualNorm;
+        }
+    }
+
     // Setup the Solver Operator
     setupSolverOperator();
 
@@ -136,7 +177,7 @@ LinearSolver::solve ( vectorPtr_Type solutionPtr )
     WallClock chrono;
     chrono.start();
 
-    M_solverOperator->ApplyInverse ( M_rhs->epetraVector(), solutionPtr->epetraVector() );
+    M_solverOperator->ApplyInverse ( rhsPtr->epetraVector(), solutionPtr->epetraVector() );
     M_converged         = M_solverOperator->hasConverged();
     M_lossOfPrecision   = M_solverOperator->isLossOfAccuracyDetected();
     chrono.stop();
@@ -147,6 +188,8 @@ LinearSolver::solve ( vectorPtr_Type solutionPtr )
 
     // Getting informations post-solve
     Int numIters = M_solverOperator->numIterations();
+    Real solveTime ( chrono.diff() );
+    Int numFailedIters ( 0 );
 
     // Second run recomputing the preconditioner
     // This is done only if the preconditioner has not been
@@ -161,8 +204,9 @@ LinearSolver::solve ( vectorPtr_Type solutionPtr )
         buildPreconditioner();
 
         // Solving again, but only once (retry = false)
+        M_solverOperator->resetStatus();
         chrono.start();
-        M_solverOperator->ApplyInverse ( M_rhs->epetraVector(), solutionPtr->epetraVector() );
+        M_solverOperator->ApplyInverse ( rhsPtr->epetraVector(), solutionPtr->epetraVector() );
         M_converged         = M_solverOperator->hasConverged();
         M_lossOfPrecision   = M_solverOperator->isLossOfAccuracyDetected();
         chrono.stop();
@@ -170,6 +214,26 @@ LinearSolver::solve ( vectorPtr_Type solutionPtr )
         {
             M_displayer->leaderPrintMax ( "SLV-  Solution time: " , chrono.diff(), " s." );
         }
+
+        // Both attempts are part of the cost of this solve
+        solveTime     += chrono.diff();
+        numFailedIters = numIters;
+        numIters       = M_solverOperator->numIterations();
+    }
+
+    // The scaled tolerance is only used for this solve
+    M_tolerance = tolerance;
+    M_solverOperator->setTolerance ( tolerance );
+
+    if ( initialGuessPtr )
+    {
+        solutionPtr->linearCombination ( 1., *initialGuessPtr, 1. );
+
+        // Only converged solutions are used for the next projections
+        if ( M_converged == SolverOperator_Type::yes )
+        {
+            M_initialGuessProjection->storeSolution ( *solutionPtr );
+        }
     }
 
     if ( M_lossOfPrecision == SolverOperator_Type::yes )
@@ -203,10 +267,150 @@ LinearSolver::solve ( vectorPtr_Type solutionPtr )
     // Reset the solver to free the internal pointers
     M_solverOperator->resetSolver();
 
+    // With the adaptive policy, the preconditioner is reset when reusing it
+    // further would increase the amortized cost of the solves
+    bool rebuild = updateReuseStatistics ( solveTime, numIters, numFailedIters );
+
     // If the number of iterations reaches the threshold of maxIterForReuse
     // we reset the preconditioners to force to solver to recompute it next
     // time
     if ( numIters > M_maxItersForReuse )
+    {
+        rebuild = true;
+    }
+
+    if ( rebuild )
+    {
+        resetPreconditioner();
+    }
+
+    return numIters;
+}
+
+Int
+LinearSolver::solve ( const multiVector_Type& rightHandSides, multiVector_Type& solutions )
+{
+    ASSERT ( rightHandSides.NumVectors() == solutions.NumVectors(), "LinearSolver: the number of solutions and right hand sides differ" );
+
+    // Build preconditioners if needed
+    if ( !isPreconditionerSet() || !M_reusePreconditioner  )
+    {
+        buildPreconditioner();
+    }
+    else
+    {
+        if ( !M_silent )
+        {
+            M_displayer->leaderPrint ( "SLV-  Reusing precond ...\n" );
+        }
+    }
+
+    if ( M_operator == nullptr )
+    {
+        M_displayer->leaderPrint ( "SLV-  ERROR: LinearSolver failed to set up correctly!\n" );
+        return -1;
+    }
+
+    // Setup the Solver Operator
+    setupSolverOperator();
+
+    // Reset status informations
+    bool failure = false;
+    this->resetStatus();
+
+    const Int numRightHandSides ( rightHandSides.NumVectors() );
+    Int numIters ( 0 );
+
+    WallClock chrono;
+    chrono.start();
+
+    if ( M_solverType == Belos )
+    {
+        // The block solvers work on blocks of the size of the number of right hand sides
+        Teuchos::ParameterList operatorList ( M_parameterList.sublist ( "Solver: Operator List" ) );
+        const std::string solverManagerType ( operatorList.get<std::string> ( "Solver Manager Type" ) );
+        if ( solverManagerType == "BlockGmres" || solverManagerType == "BlockCG" )
+        {
+            operatorList.sublist ( "Trilinos: Belos List" ).set ( "Block Size", numRightHandSides );
+            M_solverOperator->setParameters ( operatorList );
+        }
+
+        M_solverOperator->resetStatus();
+        M_solverOperator->ApplyInverse ( rightHandSides, solutions );
+        M_converged         = M_solverOperator->hasConverged();
+        M_lossOfPrecision   = M_solverOperator->isLossOfAccuracyDetected();
+        numIters            = M_solverOperator->numIterations();
+    }
+    else
+    {
+        // One right hand side at a time
+        M_converged       = SolverOperator_Type::yes;
+        M_lossOfPrecision = SolverOperator_Type::no;
+        for ( Int i ( 0 ); i < numRightHandSides; ++i )
+        {
+            const multiVector_Type rightHandSide ( View, rightHandSides, i, 1 );
+            multiVector_Type solution ( View, solutions, i, 1 );
+
+            M_solverOperator->resetStatus();
+            M_solverOperator->ApplyInverse ( rightHandSide, solution );
+            if ( M_solverOperator->hasConverged() != SolverOperator_Type::yes )
+            {
+                M_converged = SolverOperator_Type::no;
+            }
+            if ( M_solverOperator->isLossOfAccuracyDetected() == SolverOperator_Type::yes )
+            {
+                M_lossOfPrecision = SolverOperator_Type::yes;
+            }
+            numIters = std::max ( numIters, M_solverOperator->numIterations() );
+        }
+    }
+
+    chrono.stop();
+    if ( !M_silent )
+    {
+        M_displayer->leaderPrint ( "SLV-  Number of right hand sides: " , numRightHandSides, "\n" );
+        M_displayer->leaderPrintMax ( "SLV-  Solution time: " , chrono.diff(), " s." );
+    }
+
+    if ( M_lossOfPrecision == SolverOperator_Type::yes )
+    {
+        M_displayer->leaderPrint ( "SLV-  WARNING: Loss of accuracy detected!\n" );
+        failure = true;
+    }
+
+    if ( M_converged == SolverOperator_Type::yes )
+    {
+        if ( !M_silent )
+        {
+            M_displayer->leaderPrint ( "SLV-  Convergence in " , numIters, " iterations\n" );
+        }
+        M_maxNumItersReached = SolverOperator_Type::no;
+    }
+    else
+    {
+        M_displayer->leaderPrint ( "SLV-  WARNING: Solver failed to converged to the desired precision!\n" );
+        M_maxNumItersReached = SolverOperator_Type::yes;
+        failure = true;
+    }
+
+    // If quitOnFailure is enabled and if some problems occur
+    // the simulation is stopped
+    if ( M_quitOnFailure && failure )
+    {
+        exit ( -1 );
+    }
+
+    // Reset the solver to free the internal pointers
+    M_solverOperator->resetSolver();
+
+    // The preconditioner is recomputed as for a single right hand side
+    bool rebuild = updateReuseStatistics ( chrono.diff(), numIters );
+    if ( numIters > M_maxItersForReuse )
+    {
+        rebuild = true;
+    }
+
+    if ( rebuild )
     {
         resetPreconditioner();
     }
@@ -214,6 +418,33 @@ LinearSolver::solve ( vectorPtr_Type solutionPtr )
     return numIters;
 }
 
+Int
+LinearSolver::solve ( const std::vector<vectorPtr_Type>& rightHandSides, const std::vector<vectorPtr_Type>& solutions )
+{
+    ASSERT ( !rightHandSides.empty(), "LinearSolver: no right hand side" );
+    ASSERT ( rightHandSides.size() == solutions.size(), "LinearSolver: the number of solutions and right hand sides differ" );
+
+    const Int numRightHandSides ( rightHandSides.size() );
+    const Epetra_BlockMap& map ( rightHandSides[0]->epetraVector().Map() );
+
+    multiVector_Type rightHandSidesBlock ( map, numRightHandSides, false );
+    multiVector_Type solutionsBlock ( map, numRightHandSides, false );
+    for ( Int i ( 0 ); i < numRightHandSides; ++i )
+    {
+        rightHandSidesBlock ( i )->Update ( 1., * ( rightHandSides[i]->epetraVector() ( 0 ) ), 0. );
+        solutionsBlock ( i )->Update ( 1., * ( solutions[i]->epetraVector() ( 0 ) ), 0. );
+    }
+
+    Int numIters = solve ( rightHandSidesBlock, solutionsBlock );
+
+    for ( Int i ( 0 ); i < numRightHandSides; ++i )
+    {
+        solutions[i]->epetraVector() ( 0 )->Update ( 1., * ( solutionsBlock ( i ) ), 0. );
+    }
+
+    return numIters;
+}
+
 Real
 LinearSolver::computeResidual ( vectorPtr_Type solutionPtr )
 {
@@ -312,6 +543,11 @@ LinearSolver::buildPreconditioner()
             }
             condest = M_preconditioner->condest();
             chrono.stop();
+
+            M_preconditionerSetupTime = ( M_reusePolicy == AdaptiveReuse ) ? maxTime ( chrono.diff() ) : chrono.diff();
+            M_solvesSinceSetup        = 0;
+            M_iterationsSinceSetup    = 0;
+            M_solveTimeSinceSetup     = 0.;
             if ( !M_silent )
             {
                 M_displayer->leaderPrintMax ( "SLV-  Preconditioner computed in " , chrono.diff(), " s." );
@@ -378,6 +614,9 @@ LinearSolver::setupSolverOperator()
             case AztecOO:
                 M_solverOperator.reset ( Operators::SolverOperatorFactory::instance().createObject ( "AztecOO" ) );
                 break;
+            case Pipelined:
+                M_solverOperator.reset ( Operators::SolverOperatorFactory::instance().createObject ( "Pipelined" ) );
+                break;
             default:
                 M_displayer->leaderPrint ( "SLV-  ERROR: The type of solver is not recognized!\n" );
                 exit ( 1 );
@@ -480,12 +719,45 @@ LinearSolver::setParameters ( const Teuchos::ParameterList& list )
     {
         M_solverType = AztecOO;
     }
+    else if ( solverName == "Pipelined" )
+    {
+        M_solverType = Pipelined;
+    }
 
     M_reusePreconditioner  = M_parameterList.get ( "Reuse Preconditioner"     , false );
     Int maxIter            = M_parameterList.get ( "Maximum Iterations"       , 200 );
     M_maxItersForReuse     = M_parameterList.get ( "Max Iterations For Reuse" , static_cast<Int> ( maxIter * 8. / 10. ) );
     M_quitOnFailure        = M_parameterList.get ( "Quit On Failure"          , false );
     M_silent               = M_parameterList.get ( "Silent"                   , false );
+
+    UInt projectionSize = M_parameterList.get ( "Projection History Size", 0 );
+    std::string projectionNorm = M_parameterList.get ( "Projection Norm", std::string ( "Energy" ) );
+    if ( projectionNorm == "Energy" )
+    {
+        setInitialGuessProjection ( projectionSize, initialGuessProjection_Type::EnergyNorm );
+    }
+    else if ( projectionNorm == "Residual" )
+    {
+        setInitialGuessProjection ( projectionSize, initialGuessProjection_Type::ResidualNorm );
+    }
+    else
+    {
+        ERROR_MSG ( "LinearSolver: unknown Projection Norm (Energy, Residual)" );
+    }
+
+    std::string reusePolicy = M_parameterList.get ( "Reuse Policy", std::string ( "Threshold" ) );
+    if ( reusePolicy == "Adaptive" )
+    {
+        M_reusePolicy = AdaptiveReuse;
+    }
+    else if ( reusePolicy == "Threshold" )
+    {
+        M_reusePolicy = ThresholdReuse;
+    }
+    else
+    {
+        ERROR_MSG ( "LinearSolver: unknown Reuse Policy (Threshold, Adaptive)" );
+    }
 }
 
 void
@@ -500,6 +772,22 @@ LinearSolver::setReusePreconditioner ( const bool reusePreconditioner )
     M_reusePreconditioner = reusePreconditioner;
 }
 
+void
+LinearSolver::setReusePolicy ( const ReusePolicy& reusePolicy )
+{
+    M_reusePolicy = reusePolicy;
+}
+
+void
+LinearSolver::setInitialGuessProjection ( const UInt& size, const initialGuessProjection_Type::ProjectionNorm& norm )
+{
+    // The stored solutions are kept if the projection is unchanged
+    if ( size != M_initialGuessProjection->size() || norm != M_initialGuessProjection->norm() )
+    {
+        M_initialGuessProjection->setup ( size, norm );
+    }
+}
+
 void
 LinearSolver::setQuitOnFailure ( const bool enable )
 {
@@ -567,6 +855,12 @@ LinearSolver::displayer()
     return M_displayer;
 }
 
+LinearSolver::initialGuessProjectionPtr_Type
+LinearSolver::initialGuessProjection()
+{
+    return M_initialGuessProjection;
+}
+
 Int
 LinearSolver::maxItersForReuse() const
 {
@@ -579,6 +873,24 @@ LinearSolver::reusePreconditioner() const
     return M_reusePreconditioner;
 }
 
+LinearSolver::ReusePolicy
+LinearSolver::reusePolicy() const
+{
+    return M_reusePolicy;
+}
+
+Real
+LinearSolver::preconditionerSetupTime() const
+{
+    return M_preconditionerSetupTime;
+}
+
+UInt
+LinearSolver::solvesSinceSetup() const
+{
+    return M_solvesSinceSetup;
+}
+
 bool
 LinearSolver::quitOnFailure() const
 {
@@ -612,7 +924,103 @@ LinearSolver::hasConverged() const
 // ===================================================
 // Private Methods
 // ===================================================
+Real
+LinearSolver::solverTolerance() const
+{
+    if ( M_tolerance > 0 )
+    {
+        return M_tolerance;
+    }
+
+    // Tolerance of the parameter list, or the default value of the solver
+    std::string listName ( "Trilinos: Belos List" );
+    std::string toleranceName ( "Convergence Tolerance" );
+    Real tolerance ( 1e-8 );
+    if ( M_solverType == AztecOO )
+    {
+        listName      = "Trilinos: AztecOO List";
+        toleranceName = "tol";
+        tolerance     = 1e-6;
+    }
+    else if ( M_solverType == Pipelined )
+    {
+        listName      = "Pipelined Krylov List";
+        tolerance     = 1e-6;
+    }
+
+    if ( M_parameterList.isSublist ( "Solver: Operator List" )
+            && M_parameterList.sublist ( "Solver: Operator List" ).isSublist ( listName ) )
+    {
+        const Teuchos::ParameterList& list ( M_parameterList.sublist ( "Solver: Operator List" ).sublist ( listName ) );
+        if ( list.isParameter ( toleranceName ) )
+        {
+            tolerance = list.get<Real> ( toleranceName );
+        }
+    }
 
+    return tolerance;
+}
+
+Real
+LinearSolver::maxTime ( const Real& localTime ) const
+{
+    // The decisions are taken on the slowest processor, so that
+    // all the processors agree to recompute the preconditioner
+    Real globalTime ( localTime );
+    if ( M_displayer->comm() )
+    {
+        Real time ( localTime );
+        M_displayer->comm()->MaxAll ( &time, &globalTime, 1 );
+    }
+    return globalTime;
+}
+
+bool
+LinearSolver::updateReuseStatistics ( const Real& localSolveTime, const Int& numIters, const Int& numFailedIters )
+{
+    ++M_solvesSinceSetup;
+    M_iterationsSinceSetup += numIters + numFailedIters;
+
+    // The statistics are only meaningful for a LifeV preconditioner which is reused.
+    // The times are gathered only in this case, to avoid a global reduction after each solve.
+    if ( M_reusePolicy != AdaptiveReuse || !M_reusePreconditioner || !M_preconditioner )
+    {
+        M_solveTimeSinceSetup += localSolveTime;
+        return false;
+    }
+
+    M_solveTimeSinceSetup += maxTime ( localSolveTime );
+
+    // Cost of one iteration with the current preconditioner, averaged over
+    // all the solves to smooth the timing noise
+    const Real iterationTime = M_iterationsSinceSetup > 0 ? M_solveTimeSinceSetup / M_iterationsSinceSetup : 0.;
+
+    // Amortized cost of a solve since the last setup, the setup being included.
+    // Reusing the preconditioner for a solve as expensive as the last one
+    // lowers this average only if the last solve is cheaper than the average.
+    const Real amortizedTime = ( M_preconditionerSetupTime + M_solveTimeSinceSetup ) / M_solvesSinceSetup;
+    const Real projectedTime = numIters * iterationTime;
+    const bool rebuild = projectedTime > amortizedTime;
+
+    if ( !M_silent )
+    {
+        M_displayer->leaderPrint ( "SLV-  Preconditioner setup time:               " , M_preconditionerSetupTime, " s.\n" );
+        M_displayer->leaderPrint ( "SLV-  Solves with this preconditioner:         " , M_solvesSinceSetup, "\n" );
+        M_displayer->leaderPrint ( "SLV-  Mean time per iteration:                 " , iterationTime, " s.\n" );
+        M_displayer->leaderPrint ( "SLV-  Amortized time per solve:                " , amortizedTime, " s.\n" );
+        M_displayer->leaderPrint ( "SLV-  Projected time of the next solve:        " , projectedTime, " s.\n" );
+        if ( rebuild )
+        {
+            M_displayer->leaderPrint ( "SLV-  Reuse no longer pays off: the preconditioner will be recomputed\n" );
+        }
+        else
+        {
+            M_displayer->leaderPrint ( "SLV-  The preconditioner will be reused\n" );
+        }
+    }
+
+    return rebuild;
+}
 
 
 // ===================================================
@@ -627,6 +1035,8 @@ belosParameterList()
     Teuchos::ParameterList defaultList;
     defaultList.set ( "Reuse Preconditioner"    , false );
     defaultList.set ( "Max Iterations For Reuse", 80 );
+    defaultList.set ( "Reuse Policy"            , "Threshold" );
+    defaultList.set ( "Projection History Size" , 0 );
     defaultList.set ( "Quit On Failure"         , false );
     defaultList.set ( "Silent"                  , false );
     defaultList.set ( "Solver Type"             , "Belos" );
@@ -634,6 +1044,7 @@ belosParameterList()
     Teuchos::ParameterList& operatorList = defaultList.sublist ( "Solver: Operator List" );
     operatorList.set ( "Solver Manager Type", "BlockGmres" );
     operatorList.set ( "Preconditioner Side", "Right" );
+    operatorList.set ( "Recycle Krylov Subspace", false );
 
     Teuchos::ParameterList& defaultBelos = operatorList.sublist ( "Trilinos: Belos List" );
     defaultBelos.set ( "Flexible Gmres"       , false );
@@ -655,6 +1066,8 @@ aztecOOParameterList()
     Teuchos::ParameterList defaultList;
     defaultList.set ( "Reuse Preconditioner"    , false );
     defaultList.set ( "Max Iterations For Reuse", 80 );
+    defaultList.set ( "Reuse Policy"            , "Threshold" );
+    defaultList.set ( "Projection History Size" , 0 );
     defaultList.set ( "Quit On Failure"         , false );
     defaultList.set ( "Silent"                  , false );
     defaultList.set ( "Solver Type"             , "AztecOO" );
@@ -674,6 +1087,29 @@ aztecOOParameterList()
 
     return defaultList;
 }
+
+Teuchos::ParameterList
+pipelinedParameterList()
+{
+    Teuchos::ParameterList defaultList;
+    defaultList.set ( "Reuse Preconditioner"    , false );
+    defaultList.set ( "Max Iterations For Reuse", 80 );
+    defaultList.set ( "Reuse Policy"            , "Threshold" );
+    defaultList.set ( "Projection History Size" , 0 );
+    defaultList.set ( "Quit On Failure"         , false );
+    defaultList.set ( "Silent"                  , false );
+    defaultList.set ( "Solver Type"             , "Pipelined" );
+
+    Teuchos::ParameterList& operatorList = defaultList.sublist ( "Solver: Operator List" );
+
+    Teuchos::ParameterList& defaultPipelined = operatorList.sublist ( "Pipelined Krylov List" );
+    defaultPipelined.set ( "Method"               , "SStepGmres" );
+    defaultPipelined.set ( "Convergence Tolerance", 1e-6 );
+    defaultPipelined.set ( "Maximum Iterations"   , 200 );
+    defaultPipelined.set ( "Steps Per Reduction"  , 4 );
+
+    return defaultList;
+}
 }
 
 } // namespace LifeV
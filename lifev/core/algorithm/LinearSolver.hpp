@@ -75,10 +75,12 @@
 #include <lifev/core/array/VectorEpetra.hpp>
 #include <lifev/core/array/MatrixEpetra.hpp>
 #include <lifev/core/algorithm/Preconditioner.hpp>
+#include <lifev/core/algorithm/InitialGuessProjection.hpp>
 #include <lifev/core/filter/GetPot.hpp>
 #include <lifev/core/operator/SolverOperator.hpp>
 #include <lifev/core/operator/BelosOperator.hpp>
 #include <lifev/core/operator/AztecooOperator.hpp>
+#include <lifev/core/operator/PipelinedKrylovOperator.hpp>
 
 namespace LifeV
 {
@@ -113,8 +115,11 @@ public:
     typedef std::shared_ptr<preconditioner_Type>                        preconditionerPtr_Type;
     typedef Teuchos::ParameterList                                      parameterList_Type;
     typedef Teuchos::RCP< parameterList_Type >                          parameterListPtr_Type;
+    typedef InitialGuessProjection                                      initialGuessProjection_Type;
+    typedef std::shared_ptr<initialGuessProjection_Type>                initialGuessProjectionPtr_Type;
 
-    enum SolverType          { UndefinedSolver, Belos, AztecOO };
+    enum SolverType          { UndefinedSolver, Belos, AztecOO, Pipelined };
+    enum ReusePolicy         { ThresholdReuse, AdaptiveReuse };
 
     //@}
 
@@ -150,6 +155,37 @@ public:
      */
     Int solve ( vectorPtr_Type solutionPtr );
 
+    //! Solves the system for several right hand sides and returns the maximum number of iterations
+    /*!
+      With Belos, all the right hand sides are solved together: the operator and the
+      preconditioner are applied to all the columns at once. For the block solver
+      managers (BlockGmres, BlockCG) the "Block Size" is set to the number of right hand
+      sides; the pseudo-block ones iterate on all the columns by construction.
+      AztecOO solves the right hand sides one after the other.
+
+      The preconditioner is built (or reused) as in solve(), but there is no retry
+      and no projection of the initial guess. The right hand side set with
+      setRightHandSide is not used.
+      @param rightHandSides Right hand sides, one per column
+      @param solutions Multivector to store the solutions (same map and number of columns)
+      @return Maximum number of iterations over the right hand sides, -1 if the solver is not set up
+     */
+    Int solve ( const multiVector_Type& rightHandSides, multiVector_Type& solutions );
+
+    //! Solves the system for several right hand sides and returns the maximum number of iterations
+    /*!
+      The vectors are gathered in a multivector.
+      With Belos the Krylov basis has one column per right hand side: for n right hand
+      sides the storage is n times the one of a single solve, with the block managers
+      (n x "Num Blocks" vectors) as with the pseudo-block ones. If the memory is the
+      limit, reduce "Num Blocks" or call solve() for each right hand side.
+      @see solve ( const multiVector_Type&, multiVector_Type& )
+      @param rightHandSides Right hand sides (with the same unique map)
+      @param solutions Vectors to store the solutions
+      @return Maximum number of iterations over the right hand sides
+     */
+    Int solve ( const std::vector<vectorPtr_Type>& rightHandSides, const std::vector<vectorPtr_Type>& solutions );
+
     //! Compute the residual
     /*!
       @param solutionPtr Shared pointer on the solution of the system
@@ -274,6 +310,34 @@ public:
      */
     void setReusePreconditioner ( const bool reusePreconditioner );
 
+    //! Specify how the solver decides to recompute a reused preconditioner
+    /*!
+      With ThresholdReuse (default) the preconditioner is recomputed when the number
+      of iterations exceeds maxItersForReuse.
+      With AdaptiveReuse the setup time and the time of each solve are recorded and the
+      preconditioner is recomputed as soon as the cost of the last solve exceeds the
+      average cost per solve since the last setup (setup included): from that point,
+      reusing the preconditioner further can only increase the amortized cost.
+      The threshold on the number of iterations is still applied as a safeguard.
+      @param reusePolicy Policy used when the preconditioner is reused
+     */
+    void setReusePolicy ( const ReusePolicy& reusePolicy );
+
+    //! Compute the initial guess of each solve from the previous solutions
+    /*!
+      The last solutions are orthonormalized with respect to the current operator and
+      the solution is approximated by its projection on their span (see InitialGuessProjection).
+      The solver then computes the correction to this initial guess, with the tolerance
+      scaled by ||b|| / ||b - A x0||, so that the stopping criterion stays relative to the
+      norm of the right hand side b and not to the (smaller) initial residual.
+      This can be set in the parameter list with "Projection History Size" and
+      "Projection Norm" ("Energy" for symmetric positive definite systems, "Residual" otherwise).
+      @param size Number of solutions stored (0 disables the projection)
+      @param norm Norm minimized by the projection
+     */
+    void setInitialGuessProjection ( const UInt& size,
+                                     const initialGuessProjection_Type::ProjectionNorm& norm = initialGuessProjection_Type::EnergyNorm );
+
     //! Specify if the application should stop when problems occur in the iterations
     /*!
       @param enable If set to true, application will stop if problems occur
@@ -315,12 +379,24 @@ public:
     //! Return a shared pointer on the displayer
     std::shared_ptr<Displayer> displayer();
 
+    //! Return a shared pointer on the generator of the initial guess
+    initialGuessProjectionPtr_Type initialGuessProjection();
+
     //! Returns the maximum of iterations tolerate to avoid recomputing the preconditioner
     Int maxItersForReuse() const;
 
     //! Returns if the preconditioner can be reused
     bool reusePreconditioner() const;
 
+    //! Returns the policy used to decide when a reused preconditioner is recomputed
+    ReusePolicy reusePolicy() const;
+
+    //! Returns the time spent to build the current preconditioner (max over the processors with the AdaptiveReuse policy)
+    Real preconditionerSetupTime() const;
+
+    //! Returns the number of solves performed with the current preconditioner
+    UInt solvesSinceSetup() const;
+
     //! Returns if the application should stop if a problem occurs
     bool quitOnFailure() const;
 
@@ -343,6 +419,21 @@ private:
     //! @name Private Methods
     //@{
 
+    //! Return the tolerance of the solver: the one set by setTolerance or the one of the parameter list
+    Real solverTolerance() const;
+
+    //! Return the maximum over the processors of a local time (collective call)
+    Real maxTime ( const Real& localTime ) const;
+
+    //! Record the statistics of a solve and return true if the preconditioner should be recomputed
+    /*!
+      The times are only gathered over the processors with the AdaptiveReuse policy.
+      @param localSolveTime Time of the solve on this processor (including a failed first attempt)
+      @param numIters Number of iterations of the solve
+      @param numFailedIters Number of iterations of a failed first attempt, if any
+     */
+    bool updateReuseStatistics ( const Real& localSolveTime, const Int& numIters, const Int& numFailedIters = 0 );
+
     //@}
 
     operatorPtr_Type             M_operator;
@@ -359,11 +450,20 @@ private:
     Teuchos::ParameterList       M_parameterList;
     std::shared_ptr<Displayer> M_displayer;
 
+    initialGuessProjectionPtr_Type M_initialGuessProjection;
+
     // LifeV features
     Int                          M_maxItersForReuse;
     bool                         M_reusePreconditioner;
     bool                         M_quitOnFailure;
     bool                         M_silent;
+    ReusePolicy                  M_reusePolicy;
+
+    // Statistics of the current preconditioner
+    Real                         M_preconditionerSetupTime;
+    UInt                         M_solvesSinceSetup;
+    Int                          M_iterationsSinceSetup;
+    Real                         M_solveTimeSinceSetup;
 
     // Status informations
     SolverOperator_Type::SolverOperatorStatusType M_lossOfPrecision;
@@ -388,7 +488,8 @@ namespace defaultParameterLists
   Belos uses the right preconditioned GMRES method with a tolerance of 1e-6.
   The maximum number of iterations and Krylov vectors are set to 200.
   The preconditioner is automatically recomputed if more than 80 iterations are
-  necessary to converge.
+  necessary to converge. Set "Reuse Policy" to "Adaptive" to recompute it from
+  the measured setup and solve times instead.
  */
 Teuchos::ParameterList
 belosParameterList();
@@ -398,10 +499,21 @@ belosParameterList();
   AztecOO uses the right preconditioned GMRES method with a tolerance of 1e-6.
   The maximum number of iterations and Krylov vectors are set to 200.
   The preconditioner is automatically recomputed if more than 80 iterations are
-  necessary to converge.
+  necessary to converge. Set "Reuse Policy" to "Adaptive" to recompute it from
+  the measured setup and solve times instead.
  */
 Teuchos::ParameterList
 aztecOOParameterList();
+
+//! Returns a default parameter list to initialize the LinearSolver class with the pipelined Krylov solvers.
+/*!
+  The s-step GMRES method with 4 steps per reduction is used with a tolerance of 1e-6
+  and at most 200 iterations (see Operators::PipelinedKrylovOperator).
+  The preconditioner is automatically recomputed if more than 80 iterations are
+  necessary to converge.
+ */
+Teuchos::ParameterList
+pipelinedParameterList();
 }
 
 } // namespace LifeV
@@ -307,7 +307,10 @@ NonLinearAitken< VectorType >::computeDeltaLambdaFSI ( const vector_Type& soluti
 #ifdef HAVE_LIFEV_DEBUG
         debugStream (7020) << "NonLinearAitken: omegaFluid = " << M_defaultOmegaFluid << " omegaSolid = " << M_defaultOmegaSolid << "\n";
 #endif
-        return M_defaultOmegaFluid * residualFluid + M_defaultOmegaSolid * residualSolid;
+        vector_Type deltaLambda ( residualFluid );
+        deltaLambda.linearCombination ( M_defaultOmegaFluid, residualFluid, M_defaultOmegaSolid, residualSolid );
+
+        return deltaLambda;
     }
     else
     {
@@ -318,8 +321,11 @@ NonLinearAitken< VectorType >::computeDeltaLambdaFSI ( const vector_Type& soluti
         Real a21 = deltaRFluid * deltaRSolid;
         Real a22 = deltaRSolid * deltaRSolid;
 
-        Real b1  = deltaRFluid * ( solution - *M_oldSolution);
-        Real b2  = deltaRSolid * ( solution - *M_oldSolution);
+        vector_Type deltaX ( solution );
+        deltaX -= *M_oldSolution;
+
+        Real b1  = deltaRFluid * deltaX;
+        Real b2  = deltaRSolid * deltaX;
 
         Real det ( a22 * a11 - a21 * a21 );
 
@@ -371,7 +377,10 @@ NonLinearAitken< VectorType >::computeDeltaLambdaFSI ( const vector_Type& soluti
         *M_oldResidualFluid = residualFluid;
         *M_oldResidualSolid = residualSolid;
 
-        return omegaFluid * residualFluid + omegaSolid * residualSolid;
+        vector_Type deltaLambda ( residualFluid );
+        deltaLambda.linearCombination ( omegaFluid, residualFluid, omegaSolid, residualSolid );
+
+        return deltaLambda;
     }
 }
 
@@ -45,6 +45,9 @@
 #include <Epetra_MpiComm.h>
 #include <Epetra_FECrsMatrix.h>
 #include <Epetra_FECrsGraph.h>
+#include <Epetra_Distributor.h>
+#include <Epetra_Import.h>
+#include <Epetra_Vector.h>
 #include <EpetraExt_MatrixMatrix.h>
 #include <EpetraExt_Transpose_RowMatrix.h>
 #include <EpetraExt_RowMatrixOut.h>
@@ -268,6 +271,11 @@ public:
 
     //! Set entries (rVec(i),rVec(i)) to coefficient and the rest of the row entries to zero
     /*!
+      Each process may give rows owned by other processes. When the row map and the domain map
+      of the matrix are the same, the rows in the column map are sent to their owner with one
+      exchange between neighbours, using the importer of the matrix. The other ones (all of them
+      if the two maps differ) are sent through the directory of the row map.
+      The matrix must be filled.
       @param rVec Vector of the Id that should be set to "coefficient"
       @param coefficient Value to be set on the diagonal
       @param offset Offset used for the indices
@@ -518,6 +526,26 @@ public:
                                DataType* const* const localValues,
                                Int format = Epetra_FECrsMatrix::COLUMN_MAJOR );
 
+    //! Add a set of values to the corresponding set of coefficient in the closed matrix, without critical region on the local rows
+    /*!
+      The rows owned by this process are summed directly in the values of the
+      underlying Epetra_CrsMatrix. This is safe only if the concurrent callers
+      write in different rows, e.g. when the elements are processed by colors
+      (see OpenMPParameters::setElementColors). The contributions to non-local
+      rows are buffered by the Epetra_FECrsMatrix inside a critical region.
+
+      @param numRows Number of rows into the list given in "localValues"
+      @param numColumns Number of columns into the list given in "localValues"
+      @param rowIndices List of row indices
+      @param columnIndices List of column indices
+      @param localValues 2D array containing the coefficient related to "rowIndices" and "columnIndices",
+             stored row by row (Epetra_FECrsMatrix::ROW_MAJOR)
+     */
+    void sumIntoCoefficientsLockFree ( Int const numRows, Int const numColumns,
+                                       std::vector<Int> const& rowIndices,
+                                       std::vector<Int> const& columnIndices,
+                                       DataType* const* const localValues );
+
     //! Add a value at a coefficient of the matrix
     /*!
       @param row Row index of the value to be added
@@ -983,52 +1011,138 @@ std::shared_ptr<MatrixEpetra<DataType> > MatrixEpetra<DataType>::transpose( )
 template <typename DataType>
 void MatrixEpetra<DataType>::diagonalize ( std::vector<UInt> rVec, DataType const coefficient, UInt offset )
 {
+    if ( !M_epetraCrs->Filled() )
+    {
+        // if not filled, I do not know how to diagonalize.
+        ERROR_MSG ( "if not filled, I do not know how to diagonalize\n" );
+    }
 
-    const Epetra_Comm&  Comm ( M_epetraCrs->Comm() );
-    Int numProcs ( Comm.NumProc() );
-    Int MyPID   ( Comm.MyPID() );
-    Int i;
+    const Epetra_Comm& comm ( M_epetraCrs->Comm() );
+    const Epetra_Map& rowMap ( M_epetraCrs->RowMap() );
+    const Epetra_Map& colMap ( M_epetraCrs->ColMap() );
+    const Epetra_Import* importer ( M_epetraCrs->Importer() );
 
+    // The importer sends the column entries to the owners in the domain map, which
+    // are the owners of the rows only if the two maps are the same
+    const bool useImporter ( importer != 0 && rowMap.SameAs ( M_epetraCrs->DomainMap() ) );
 
-    // Note: Epetra_Comm::broadcast does not support passing of uint, hence
-    //       I define an int pointer to make the broadcast but then come back to an
-    //       UInt pointer to insert the data
-    Int*  r;
-    UInt* Ur;
+    // Rows of this process to be diagonalized (local IDs)
+    std::vector<bool> myRows ( rowMap.NumMyElements(), false );
 
+    // Rows of the other processes: flagged in the column map when possible,
+    // the owners being known from the importer of the matrix
+    Epetra_Vector columnFlags ( colMap );
+    std::vector<EpetraInt_Type> otherRows;
 
-    // loop on all proc
-    for ( Int p (0); p < numProcs; p++ )
+    for ( UInt i (0); i < rVec.size(); ++i )
     {
-        Int sizeVec ( rVec.size() );
+        const EpetraInt_Type globalRow ( static_cast<EpetraInt_Type> ( rVec[i] + offset ) );
+        const Int myRow ( rowMap.LID ( globalRow ) );
 
-        Comm.Broadcast ( &sizeVec, 1, p );
+        if ( myRow >= 0 )
+        {
+            myRows[myRow] = true;
+            continue;
+        }
 
-        if ( p == MyPID )
+        const Int myCol ( colMap.LID ( globalRow ) );
+        if ( myCol >= 0 && useImporter )
         {
-            Ur = &rVec.front();
+            columnFlags[myCol] = 1.0;
         }
         else
         {
-            Ur = new UInt[sizeVec];
+            otherRows.push_back ( globalRow );
         }
+    }
 
-        r = (Int*) Ur;
+    // One exchange with the neighbours, using the communication plan of the matrix in reverse
+    if ( useImporter )
+    {
+        const Epetra_Map& domainMap ( M_epetraCrs->DomainMap() );
+        Epetra_Vector domainFlags ( domainMap );
 
-        Comm.Broadcast ( r, sizeVec, p );
+        domainFlags.Export ( columnFlags, *importer, Add );
 
-        for ( i = 0; i < sizeVec; i++ )
+        for ( Int i (0); i < domainMap.NumMyElements(); ++i )
         {
-            diagonalize ( Ur[i], coefficient, offset );
+            if ( domainFlags[i] > 0.0 )
+            {
+                const Int myRow ( rowMap.LID ( domainMap.GID ( i ) ) );
+                if ( myRow >= 0 )
+                {
+                    myRows[myRow] = true;
+                }
+            }
         }
+    }
 
-        if ( p != MyPID )
+    // Rows which are not sent by the importer: sent to their owner through the directory of the row map
+    Int numOtherRows ( otherRows.size() );
+    Int maxNumOtherRows ( 0 );
+    comm.MaxAll ( &numOtherRows, &maxNumOtherRows, 1 );
+
+    if ( maxNumOtherRows > 0 )
+    {
+        std::vector<Int> owners ( numOtherRows + 1 );
+        std::vector<Int> ownerLIDs ( numOtherRows + 1 );
+        rowMap.RemoteIDList ( numOtherRows, otherRows.empty() ? 0 : &otherRows[0], &owners[0], &ownerLIDs[0] );
+
+        // Rows which do not exist in the matrix are ignored
+        std::vector<EpetraInt_Type> sentRows;
+        std::vector<Int> sentOwners;
+        for ( Int i (0); i < numOtherRows; ++i )
         {
-            delete[] Ur;
+            if ( owners[i] >= 0 )
+            {
+                sentRows.push_back ( otherRows[i] );
+                sentOwners.push_back ( owners[i] );
+            }
         }
 
+        std::shared_ptr<Epetra_Distributor> distributor ( comm.CreateDistributor() );
+        Int numReceivedRows ( 0 );
+        distributor->CreateFromSends ( sentRows.size(), sentOwners.empty() ? 0 : &sentOwners[0], true, numReceivedRows );
+
+        Int receivedLength ( 0 );
+        char* receivedBuffer ( 0 );
+        distributor->Do ( sentRows.empty() ? 0 : reinterpret_cast<char*> ( &sentRows[0] ),
+                          sizeof ( EpetraInt_Type ), receivedLength, receivedBuffer );
+
+        const EpetraInt_Type* receivedRows ( reinterpret_cast<const EpetraInt_Type*> ( receivedBuffer ) );
+        for ( Int i (0); i < numReceivedRows; ++i )
+        {
+            const Int myRow ( rowMap.LID ( receivedRows[i] ) );
+            if ( myRow >= 0 )
+            {
+                myRows[myRow] = true;
+            }
+        }
+
+        delete[] receivedBuffer;
     }
 
+    // Local rows: zero out the values and set the diagonal, through local IDs
+    for ( Int myRow (0); myRow < static_cast<Int> ( myRows.size() ); ++myRow )
+    {
+        if ( !myRows[myRow] )
+        {
+            continue;
+        }
+
+        Int numEntries;
+        Real* values;
+        Int* indices;
+
+        M_epetraCrs->ExtractMyRowView ( myRow, numEntries, values, indices );
+
+        const Int myCol ( colMap.LID ( rowMap.GID ( myRow ) ) );
+
+        for ( Int i (0); i < numEntries; ++i )
+        {
+            values[i] = ( indices[i] == myCol ) ? coefficient : 0.0;
+        }
+    }
 }
 
 template <typename DataType>
@@ -1643,6 +1757,44 @@ sumIntoCoefficients ( Int const numRows, Int const numColumns,
 
 }
 
+template <typename DataType>
+void MatrixEpetra<DataType>::
+sumIntoCoefficientsLockFree ( Int const numRows, Int const numColumns,
+                              std::vector<Int> const& rowIndices, std::vector<Int> const& columnIndices,
+                              DataType* const* const localValues )
+{
+    ASSERT ( M_epetraCrs->Filled(), "sumIntoCoefficientsLockFree requires a closed matrix" );
+
+    const Epetra_Map& rowMap ( M_epetraCrs->RowMap() );
+
+    for ( Int i (0); i < numRows; ++i )
+    {
+        Int ierr;
+        if ( rowMap.MyGID ( rowIndices[i] ) )
+        {
+            // Only the values of the row are modified, the graph is left untouched
+            ierr = M_epetraCrs->Epetra_CrsMatrix::SumIntoGlobalValues ( rowIndices[i], numColumns,
+                                                                        localValues[i], &columnIndices[0] );
+        }
+        else
+        {
+            #pragma omp critical
+            {
+                ierr = M_epetraCrs->SumIntoGlobalValues ( 1, &rowIndices[i], numColumns, &columnIndices[0],
+                                                          &localValues[i], Epetra_FECrsMatrix::ROW_MAJOR );
+            }
+        }
+
+        if ( ierr < 0 )
+        {
+            std::stringstream errorMessage;
+            errorMessage << " error in matrix insertion [sumIntoCoefficientsLockFree] " << ierr
+                         << " when inserting in (" << rowIndices[i] << ", " << columnIndices[0] << ")" << std::endl;
+            ERROR_MSG ( errorMessage.str() );
+        }
+    }
+}
+
 // ===================================================
 // Get Methods
 // ===================================================
@@ -0,0 +1,833 @@
+//@HEADER
+/*
+*******************************************************************************
+
+   Copyright (C) 2004, 2005, 2007 EPFL, Politecnico di Milano, INRIA
+   Copyright (C) 2010 EPFL, Politecnico di Milano, Emory UNiversity
+
+   This file is part of the LifeV library
+
+   LifeV is free software; you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+
+   LifeV is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with this library; if not, see <http://www.gnu.org/licenses/>
+
+
+*******************************************************************************
+*/
+//@HEADER
+
+/*!
+    @file
+    @brief MatrixEpetraBlockCRS
+
+    @date 10-2026
+ */
+
+#ifndef _MATRIXEPETRABLOCKCRS_HPP_
+#define _MATRIXEPETRABLOCKCRS_HPP_
+
+#include <map>
+#include <vector>
+#include <string>
+#include <sstream>
+
+#include <Epetra_BlockMap.h>
+#include <Epetra_FEVbrMatrix.h>
+#include <Epetra_Vector.h>
+
+#include <lifev/core/LifeV.hpp>
+
+#include <lifev/core/array/MapEpetra.hpp>
+#include <lifev/core/array/MatrixEpetra.hpp>
+#include <lifev/core/array/VectorEpetra.hpp>
+
+#include <lifev/core/linear_algebra/LinearOperatorAlgebra.hpp>
+
+namespace LifeV
+{
+
+template <typename DataType>
+class MatrixEpetraBlockCRSOperator;
+
+//! MatrixEpetraBlockCRS - Block sparse matrix for vector valued FE fields
+/*!
+  The matrix of a vector field with d components is stored by blocks of size
+  d x d, one block for each pair of coupled nodes, in an Epetra_FEVbrMatrix.
+  Compared with the MatrixEpetra of the same field, the graph is d*d times
+  smaller and the d components of a node are contiguous in memory.
+
+  The matrix is built from the MapEpetra of the vector field, where the global
+  identifier of the component c of the node n is n + c * N (N being the number
+  of nodes). All the components of a node have to be owned by the same process,
+  as for the maps of the vector FE spaces. The rows of the matrix are the
+  nodes, with the same global identifiers as the scalar dofs.
+
+  The coefficients can be added with the same methods as for a MatrixEpetra
+  (addToCoefficients, sumIntoCoefficients), so that the assembly of ETA works
+  without changes, or directly by nodal blocks with addToBlocks (used by the
+  FastAssemblerGeneric and the assembly of the MatrixElemental).
+
+  While the matrix is open, the blocks are accumulated and inserted once in
+  globalAssemble. When the matrix is closed, the blocks are summed at once.
+
+  The Epetra matrix is an Epetra_RowMatrix whose point rows are ordered node
+  by node (interleaved components), so that it can be given to the ML
+  (with "PDE equations" equal to the block size) and Ifpack preconditioners.
+  The vectors in the component-major layout of LifeV are converted to this
+  layout with exportToPointLayout and importFromPointLayout.
+
+  To solve a system with the right hand side and the solution of the field,
+  the matrix is given to LinearSolver::setOperator as the operator returned
+  by fieldOperator, which does the conversions. The preconditioner is then
+  set with LinearSolver::setPreconditioner and has to act on the same
+  component-major layout (e.g. built from a MatrixEpetra of the field).
+ */
+template <typename DataType>
+class MatrixEpetraBlockCRS
+{
+public:
+
+    //! @name Public Types
+    //@{
+
+    typedef Epetra_FEVbrMatrix matrix_type;
+    typedef std::shared_ptr<matrix_type> matrix_ptrtype;
+    typedef VectorEpetra vector_type;
+
+    //@}
+
+
+    //! @name Constructor & Destructor
+    //@{
+
+    //! Constructor
+    /*!
+      @param map Map of the vector field (component-major numbering)
+      @param blockSize Number of components of the field
+      @param numBlockEntries Estimated number of blocks per row
+     */
+    MatrixEpetraBlockCRS ( const MapEpetra& map, const UInt& blockSize, Int numBlockEntries = 30 );
+
+    //! Destructor
+    ~MatrixEpetraBlockCRS() {}
+
+    //@}
+
+
+    //! @name Methods
+    //@{
+
+    //! Insert the pending blocks and close the matrix
+    /*!
+      If the matrix is already closed, only the contributions to the rows of the
+      other processes are communicated.
+      @return Epetra error code
+     */
+    Int globalAssemble();
+
+    //! Set all the coefficients to zero
+    /*!
+      The structure of a closed matrix is kept.
+     */
+    void zero();
+
+    //! Add a set of nodal blocks to the matrix
+    /*!
+      @param numBlockRows Number of block rows
+      @param numBlockColumns Number of block columns
+      @param blockRowIndices Global identifiers of the nodes of the rows
+      @param blockColumnIndices Global identifiers of the nodes of the columns
+      @param values Values of the blocks: the block (i,j) is stored column by column
+             at values + ( i * numBlockColumns + j ) * blockSize * blockSize
+     */
+    void addToBlocks ( Int const numBlockRows, Int const numBlockColumns,
+                       Int const* blockRowIndices, Int const* blockColumnIndices,
+                       DataType const* values );
+
+    //! Add a set of values to the corresponding set of coefficients
+    /*!
+      Same interface as MatrixEpetra::addToCoefficients: the values are gathered
+      by nodes and added with addToBlocks.
+      @param numRows Number of rows into the list given in "localValues"
+      @param numColumns Number of columns into the list given in "localValues"
+      @param rowIndices List of row indices (component-major numbering)
+      @param columnIndices List of column indices (component-major numbering)
+      @param localValues 2D array containing the coefficient related to "rowIndices" and "columnIndices"
+      @param format Format of the matrix (Epetra_FECrsMatrix::COLUMN_MAJOR or Epetra_FECrsMatrix::ROW_MAJOR)
+     */
+    void addToCoefficients ( Int const numRows, Int const numColumns,
+                             std::vector<Int> const& rowIndices, std::vector<Int> const& columnIndices,
+                             DataType* const* const localValues,
+                             Int format = Epetra_FECrsMatrix::COLUMN_MAJOR );
+
+    //! Add a set of values to the corresponding set of coefficients in the closed matrix
+    /*!
+      @see addToCoefficients
+     */
+    void sumIntoCoefficients ( Int const numRows, Int const numColumns,
+                               std::vector<Int> const& rowIndices, std::vector<Int> const& columnIndices,
+                               DataType* const* const localValues,
+                               Int format = Epetra_FECrsMatrix::COLUMN_MAJOR );
+
+    //! Add a set of values in the closed matrix from a colored assembly
+    /*!
+      The Epetra_VbrMatrix keeps the current row as a state, so the values are
+      always summed inside a critical region.
+     */
+    void sumIntoCoefficientsLockFree ( Int const numRows, Int const numColumns,
+                                       std::vector<Int> const& rowIndices, std::vector<Int> const& columnIndices,
+                                       DataType* const* const localValues );
+
+    //! Multiply the matrix by a vector
+    /*!
+      @param transposeCurrent If true, the transpose of the matrix is used
+      @param vector1 Vector to be multiplied (unique, component-major numbering)
+      @param vector2 Result (unique, component-major numbering)
+      @return Epetra error code
+     */
+    Int multiply ( bool transposeCurrent, const vector_type& vector1, vector_type& vector2 ) const;
+
+    //! Copy a vector of the field in the point layout of the Epetra matrix
+    /*!
+      @param vector Unique vector in the component-major numbering
+      @param pointVector Vector built on the row map of the Epetra matrix
+     */
+    void exportToPointLayout ( const vector_type& vector, Epetra_MultiVector& pointVector ) const;
+
+    //! Copy a vector in the point layout of the Epetra matrix in a vector of the field
+    /*!
+      @param pointVector Vector built on the row map of the Epetra matrix
+      @param vector Unique vector in the component-major numbering
+     */
+    void importFromPointLayout ( const Epetra_MultiVector& pointVector, vector_type& vector ) const;
+
+    //! Return the matrix as an operator on the vectors of the field
+    /*!
+      The operator keeps a reference on this matrix, which must outlive it.
+      @return Operator whose domain and range maps are the unique map of the field
+     */
+    std::shared_ptr<Epetra_Operator> fieldOperator() const
+    {
+        return std::shared_ptr<Epetra_Operator> ( new MatrixEpetraBlockCRSOperator<DataType> ( *this ) );
+    }
+
+    //@}
+
+
+    //! @name Get Methods
+    //@{
+
+    //! Return the fill-complete status of the Epetra matrix
+    bool filled() const
+    {
+        return M_matrix->Filled();
+    }
+
+    //! Return the shared pointer of the Epetra_FEVbrMatrix
+    matrix_ptrtype& matrixPtr()
+    {
+        return M_matrix;
+    }
+
+    //! Return the shared pointer of the Epetra_FEVbrMatrix
+    const matrix_ptrtype& matrixPtr() const
+    {
+        return M_matrix;
+    }
+
+    //! Return the map of the nodes (one element of size blockSize per node)
+    const Epetra_BlockMap& blockMap() const
+    {
+        return *M_blockMap;
+    }
+
+    //! Return the map of the vector field
+    const MapEpetra& map() const
+    {
+        return *M_map;
+    }
+
+    //! Return the number of components of the blocks
+    UInt blockSize() const
+    {
+        return M_blockSize;
+    }
+
+    //! Return the global number of nodes
+    Int numGlobalNodes() const
+    {
+        return M_numGlobalNodes;
+    }
+
+    //@}
+
+private:
+
+    friend class MatrixEpetraBlockCRSOperator<DataType>;
+
+    typedef std::map<Int, std::vector<DataType> > blockRow_Type;
+
+    //! Compute the node of each index, its position in the list of the nodes and its component
+    void splitIndices ( Int const numIndices, std::vector<Int> const& indices, std::vector<Int>& nodes,
+                        std::vector<Int>& positions, std::vector<Int>& components ) const;
+
+    //! Scatter scalar coefficients in nodal blocks and add them
+    void addScalarCoefficients ( Int const numRows, Int const numColumns,
+                                 std::vector<Int> const& rowIndices, std::vector<Int> const& columnIndices,
+                                 DataType* const* const localValues, Int format );
+
+    //! Insert or sum the blocks of one row in the Epetra matrix
+    void submitBlockRow ( Int blockRow, Int const numBlocks, Int* blockColumnIndices, DataType const* values );
+
+    //! Insert the blocks accumulated while the matrix is open
+    void submitPendingBlocks();
+
+    std::shared_ptr<MapEpetra> M_map;
+    std::shared_ptr<Epetra_BlockMap> M_blockMap;
+    matrix_ptrtype M_matrix;
+
+    UInt M_blockSize;
+    Int M_numGlobalNodes;
+    Int M_numBlockEntries;
+
+    // Position in the point layout of the local entries of the unique map
+    std::vector<Int> M_pointIndices;
+
+    // Blocks added while the matrix is open, by block row and block column
+    std::map<Int, blockRow_Type> M_pendingBlocks;
+};
+
+
+// ===================================================
+// Constructor
+// ===================================================
+
+template <typename DataType>
+MatrixEpetraBlockCRS<DataType>::MatrixEpetraBlockCRS ( const MapEpetra& map, const UInt& blockSize, Int numBlockEntries ) :
+    M_map ( new MapEpetra ( map ) ),
+    M_blockSize ( blockSize ),
+    M_numGlobalNodes ( 0 ),
+    M_numBlockEntries ( numBlockEntries )
+{
+    const Epetra_Map& uniqueMap ( *M_map->map ( Unique ) );
+    const Int size ( static_cast<Int> ( M_blockSize ) );
+
+    ASSERT ( M_blockSize > 0, "The block size must be positive" );
+    ASSERT ( uniqueMap.NumGlobalElements() % size == 0, "The size of the map is not a multiple of the block size" );
+
+    M_numGlobalNodes = uniqueMap.NumGlobalElements() / size;
+
+    // The nodes owned are the ones of the first component
+    std::vector<Int> nodes;
+    nodes.reserve ( uniqueMap.NumMyElements() / size );
+
+    for ( Int i ( 0 ); i < uniqueMap.NumMyElements(); ++i )
+    {
+        if ( uniqueMap.GID ( i ) < M_numGlobalNodes )
+        {
+            nodes.push_back ( uniqueMap.GID ( i ) );
+        }
+    }
+
+    ASSERT ( static_cast<Int> ( nodes.size() ) * size == uniqueMap.NumMyElements(),
+             "All the components of a node must be owned by the same process" );
+
+    M_blockMap.reset ( new Epetra_BlockMap ( -1, nodes.size(), nodes.empty() ? 0 : &nodes[0], size,
+                                             uniqueMap.IndexBase(), uniqueMap.Comm() ) );
+
+    M_matrix.reset ( new matrix_type ( Copy, *M_blockMap, M_numBlockEntries ) );
+
+    M_pointIndices.resize ( uniqueMap.NumMyElements() );
+
+    for ( Int i ( 0 ); i < uniqueMap.NumMyElements(); ++i )
+    {
+        const Int globalId ( uniqueMap.GID ( i ) );
+        const Int node ( globalId % M_numGlobalNodes );
+        const Int component ( globalId / M_numGlobalNodes );
+
+        M_pointIndices[i] = M_blockMap->FirstPointInElement ( M_blockMap->LID ( node ) ) + component;
+    }
+}
+
+// ===================================================
+// Methods
+// ===================================================
+
+template <typename DataType>
+Int MatrixEpetraBlockCRS<DataType>::globalAssemble()
+{
+    submitPendingBlocks();
+
+    return M_matrix->GlobalAssemble ( !M_matrix->Filled() );
+}
+
+template <typename DataType>
+void MatrixEpetraBlockCRS<DataType>::zero()
+{
+    M_pendingBlocks.clear();
+
+    if ( M_matrix->Filled() )
+    {
+        M_matrix->PutScalar ( 0. );
+    }
+    else
+    {
+        M_matrix.reset ( new matrix_type ( Copy, *M_blockMap, M_numBlockEntries ) );
+    }
+}
+
+template <typename DataType>
+void MatrixEpetraBlockCRS<DataType>::
+addToBlocks ( Int const numBlockRows, Int const numBlockColumns,
+              Int const* blockRowIndices, Int const* blockColumnIndices,
+              DataType const* values )
+{
+    const UInt blockArea ( M_blockSize * M_blockSize );
+
+    if ( M_matrix->Filled() )
+    {
+        std::vector<Int> columns ( blockColumnIndices, blockColumnIndices + numBlockColumns );
+
+        for ( Int i ( 0 ); i < numBlockRows; ++i )
+        {
+            submitBlockRow ( blockRowIndices[i], numBlockColumns, &columns[0],
+                             values + i * numBlockColumns * blockArea );
+        }
+        return;
+    }
+
+    for ( Int i ( 0 ); i < numBlockRows; ++i )
+    {
+        blockRow_Type& blockRow ( M_pendingBlocks[blockRowIndices[i]] );
+
+        for ( Int j ( 0 ); j < numBlockColumns; ++j )
+        {
+            std::vector<DataType>& block ( blockRow[blockColumnIndices[j]] );
+            DataType const* blockValues ( values + ( i * numBlockColumns + j ) * blockArea );
+
+            if ( block.empty() )
+            {
+                block.assign ( blockValues, blockValues + blockArea );
+            }
+            else
+            {
+                for ( UInt k ( 0 ); k < blockArea; ++k )
+                {
+                    block[k] += blockValues[k];
+                }
+            }
+        }
+    }
+}
+
+template <typename DataType>
+void MatrixEpetraBlockCRS<DataType>::
+addToCoefficients ( Int const numRows, Int const numColumns,
+                    std::vector<Int> const& rowIndices, std::vector<Int> const& columnIndices,
+                    DataType* const* const localValues,
+                    Int format )
+{
+    addScalarCoefficients ( numRows, numColumns, rowIndices, columnIndices, localValues, format );
+}
+
+template <typename DataType>
+void MatrixEpetraBlockCRS<DataType>::
+sumIntoCoefficients ( Int const numRows, Int const numColumns,
+                      std::vector<Int> const& rowIndices, std::vector<Int> const& columnIndices,
+                      DataType* const* const localValues,
+                      Int format )
+{
+    ASSERT ( M_matrix->Filled(), "The matrix must be closed to sum into its coefficients" );
+
+#ifdef LIFEV_MT_CRITICAL_UPDATES
+    #pragma omp critical
+#endif
+    {
+        addScalarCoefficients ( numRows, numColumns, rowIndices, columnIndices, localValues, format );
+    }
+}
+
+template <typename DataType>
+void MatrixEpetraBlockCRS<DataType>::
+sumIntoCoefficientsLockFree ( Int const numRows, Int const numColumns,
+                              std::vector<Int> const& rowIndices, std::vector<Int> const& columnIndices,
+                              DataType* const* const localValues )
+{
+    ASSERT ( M_matrix->Filled(), "The matrix must be closed to sum into its coefficients" );
+
+    #pragma omp critical
+    {
+        addScalarCoefficients ( numRows, numColumns, rowIndices, columnIndices, localValues,
+                                Epetra_FECrsMatrix::ROW_MAJOR );
+    }
+}
+
+template <typename DataType>
+Int MatrixEpetraBlockCRS<DataType>::
+multiply ( bool transposeCurrent, const vector_type& vector1, vector_type& vector2 ) const
+{
+    ASSERT_PRE ( M_matrix->Filled(), "MatrixEpetraBlockCRS::multiply: globalAssemble(...) should be called first" );
+    ASSERT_PRE ( vector1.mapType() == Unique && vector2.mapType() == Unique,
+                 "MatrixEpetraBlockCRS::multiply: the vectors must be unique" );
+
+    Epetra_Vector pointVector1 ( M_matrix->DomainMap() );
+    Epetra_Vector pointVector2 ( M_matrix->RangeMap() );
+
+    exportToPointLayout ( vector1, pointVector1 );
+
+    const Int ierr ( M_matrix->Multiply ( transposeCurrent, pointVector1, pointVector2 ) );
+
+    importFromPointLayout ( pointVector2, vector2 );
+
+    return ierr;
+}
+
+template <typename DataType>
+void MatrixEpetraBlockCRS<DataType>::
+exportToPointLayout ( const vector_type& vector, Epetra_MultiVector& pointVector ) const
+{
+    ASSERT ( vector.blockMap().SameAs ( *M_map->map ( Unique ) ), "The vector is not defined on the unique map of the matrix" );
+    ASSERT ( pointVector.Map().SameAs ( *M_blockMap ), "The point vector is not defined on the map of the matrix" );
+
+    const Real* values ( vector.epetraVector() [0] );
+    Real* pointValues ( pointVector[0] );
+
+    for ( UInt i ( 0 ); i < M_pointIndices.size(); ++i )
+    {
+        pointValues[M_pointIndices[i]] = values[i];
+    }
+}
+
+template <typename DataType>
+void MatrixEpetraBlockCRS<DataType>::
+importFromPointLayout ( const Epetra_MultiVector& pointVector, vector_type& vector ) const
+{
+    ASSERT ( vector.blockMap().SameAs ( *M_map->map ( Unique ) ), "The vector is not defined on the unique map of the matrix" );
+    ASSERT ( pointVector.Map().SameAs ( *M_blockMap ), "The point vector is not defined on the map of the matrix" );
+
+    const Real* pointValues ( pointVector[0] );
+    Real* values ( vector.epetraVector() [0] );
+
+    for ( UInt i ( 0 ); i < M_pointIndices.size(); ++i )
+    {
+        values[i] = pointValues[M_pointIndices[i]];
+    }
+}
+
+// ===================================================
+// Private Methods
+// ===================================================
+
+template <typename DataType>
+void MatrixEpetraBlockCRS<DataType>::
+splitIndices ( Int const numIndices, std::vector<Int> const& indices, std::vector<Int>& nodes,
+               std::vector<Int>& positions, std::vector<Int>& components ) const
+{
+    const Int size ( M_blockSize );
+    const Int numNodes ( numIndices / size );
+
+    positions.resize ( numIndices );
+    components.resize ( numIndices );
+
+    // The indices of the elements of a vector field are component-major:
+    // the index i + c * numNodes is the component c of the node of the index i
+    bool componentMajor ( numNodes * size == numIndices );
+
+    for ( Int i ( numNodes ); i < numIndices && componentMajor; ++i )
+    {
+        componentMajor = ( indices[i] == indices[i % numNodes] + ( i / numNodes ) * M_numGlobalNodes );
+    }
+
+    if ( componentMajor )
+    {
+        nodes.resize ( numNodes );
+
+        for ( Int k ( 0 ); k < numNodes; ++k )
+        {
+            nodes[k] = indices[k] % M_numGlobalNodes;
+        }
+
+        for ( Int i ( 0 ); i < numIndices; ++i )
+        {
+            positions[i] = i % numNodes;
+            components[i] = indices[i] / M_numGlobalNodes;
+        }
+        return;
+    }
+
+    // Other orderings: the nodes are listed in order of appearance
+    nodes.clear();
+
+    for ( Int i ( 0 ); i < numIndices; ++i )
+    {
+        const Int node ( indices[i] % M_numGlobalNodes );
+
+        Int position ( 0 );
+        while ( position < static_cast<Int> ( nodes.size() ) && nodes[position] != node )
+        {
+            ++position;
+        }
+
+        if ( position == static_cast<Int> ( nodes.size() ) )
+        {
+            nodes.push_back ( node );
+        }
+        positions[i] = position;
+        components[i] = indices[i] / M_numGlobalNodes;
+    }
+}
+
+template <typename DataType>
+void MatrixEpetraBlockCRS<DataType>::
+addScalarCoefficients ( Int const numRows, Int const numColumns,
+                        std::vector<Int> const& rowIndices, std::vector<Int> const& columnIndices,
+                        DataType* const* const localValues, Int format )
+{
+    std::vector<Int> rowNodes, rowPositions, rowComponents;
+    std::vector<Int> columnNodes, columnPositions, columnComponents;
+
+    splitIndices ( numRows, rowIndices, rowNodes, rowPositions, rowComponents );
+    splitIndices ( numColumns, columnIndices, columnNodes, columnPositions, columnComponents );
+
+    // Each value goes directly at its place in the blocks, the missing components are zero
+    const UInt blockArea ( M_blockSize * M_blockSize );
+    const Int numBlockColumns ( columnNodes.size() );
+    std::vector<DataType> blocks ( rowNodes.size() * numBlockColumns * blockArea, 0. );
+
+    for ( Int i ( 0 ); i < numRows; ++i )
+    {
+        DataType* blockRow ( &blocks[0] + rowPositions[i] * numBlockColumns * blockArea + rowComponents[i] );
+
+        for ( Int j ( 0 ); j < numColumns; ++j )
+        {
+            blockRow[columnPositions[j] * blockArea + columnComponents[j] * M_blockSize] +=
+                ( format == Epetra_FECrsMatrix::ROW_MAJOR ) ? localValues[i][j] : localValues[j][i];
+        }
+    }
+
+    // A closed matrix receives the blocks directly, without the pending blocks
+    addToBlocks ( rowNodes.size(), numBlockColumns, &rowNodes[0], &columnNodes[0], &blocks[0] );
+}
+
+template <typename DataType>
+void MatrixEpetraBlockCRS<DataType>::
+submitBlockRow ( Int blockRow, Int const numBlocks, Int* blockColumnIndices, DataType const* values )
+{
+    const Int size ( M_blockSize );
+    const UInt blockArea ( M_blockSize * M_blockSize );
+
+    Int ierr = ( M_matrix->Filled() ) ?
+               M_matrix->BeginSumIntoGlobalValues ( blockRow, numBlocks, blockColumnIndices )
+               :
+               M_matrix->BeginInsertGlobalValues ( blockRow, numBlocks, blockColumnIndices );
+
+    for ( Int j ( 0 ); j < numBlocks && ierr >= 0; ++j )
+    {
+        ierr = M_matrix->SubmitBlockEntry ( const_cast<DataType*> ( values + j * blockArea ), size, size, size );
+    }
+
+    if ( ierr >= 0 )
+    {
+        ierr = M_matrix->EndSubmitEntries();
+    }
+
+    std::stringstream errorMessage;
+    errorMessage << " error in matrix insertion [submitBlockRow] " << ierr
+                 << " when inserting in the block row " << blockRow << std::endl;
+    ASSERT ( ierr >= 0, errorMessage.str() );
+}
+
+template <typename DataType>
+void MatrixEpetraBlockCRS<DataType>::submitPendingBlocks()
+{
+    const UInt blockArea ( M_blockSize * M_blockSize );
+
+    std::vector<Int> columns;
+    std::vector<DataType> values;
+
+    for ( typename std::map<Int, blockRow_Type>::const_iterator row ( M_pendingBlocks.begin() );
+            row != M_pendingBlocks.end(); ++row )
+    {
+        columns.clear();
+        values.clear();
+
+        for ( typename blockRow_Type::const_iterator block ( row->second.begin() ); block != row->second.end(); ++block )
+        {
+            columns.push_back ( block->first );
+            values.insert ( values.end(), block->second.begin(), block->second.begin() + blockArea );
+        }
+
+        submitBlockRow ( row->first, columns.size(), &columns[0], &values[0] );
+    }
+
+    M_pendingBlocks.clear();
+}
+
+
+//! MatrixEpetraBlockCRSOperator - Operator applying a MatrixEpetraBlockCRS to the vectors of the field
+/*!
+  The columns of the input multivector are copied in the point layout of the
+  Epetra matrix, multiplied, and copied back in the component-major layout.
+  The operator can be given to LinearSolver::setOperator; the inverse is not
+  available.
+ */
+template <typename DataType>
+class MatrixEpetraBlockCRSOperator : public Operators::LinearOperatorAlgebra
+{
+public:
+
+    //! @name Public Types
+    //@{
+
+    typedef Operators::LinearOperatorAlgebra super;
+    typedef super::comm_Type comm_Type;
+    typedef super::map_Type map_Type;
+    typedef super::vector_Type vector_Type;
+    typedef MatrixEpetraBlockCRS<DataType> matrix_Type;
+
+    //@}
+
+
+    //! @name Constructor & Destructor
+    //@{
+
+    //! Constructor
+    /*!
+      @param matrix The block matrix (a reference is stored)
+     */
+    explicit MatrixEpetraBlockCRSOperator ( const matrix_Type& matrix ) :
+        M_matrix ( matrix ),
+        M_name ( "MatrixEpetraBlockCRSOperator" ),
+        M_useTranspose ( false )
+    {}
+
+    //! Destructor
+    virtual ~MatrixEpetraBlockCRSOperator() {}
+
+    //@}
+
+
+    //! @name Methods
+    //@{
+
+    //! Set the use of the transpose of the matrix
+    int SetUseTranspose ( bool useTranspose )
+    {
+        M_useTranspose = useTranspose;
+        return 0;
+    }
+
+    //! Apply the operator: Y = A X
+    int Apply ( const vector_Type& X, vector_Type& Y ) const;
+
+    //! The inverse is not available (returns -1)
+    int ApplyInverse ( const vector_Type& /*X*/, vector_Type& /*Y*/ ) const
+    {
+        return -1;
+    }
+
+    //! Infinity norm of the matrix
+    double NormInf() const
+    {
+        return M_matrix.matrixPtr()->NormInf();
+    }
+
+    //@}
+
+
+    //! @name Get Methods
+    //@{
+
+    //! Name of the operator
+    const char* Label() const
+    {
+        return M_name.c_str();
+    }
+
+    //! Return true if the transpose of the matrix is used
+    bool UseTranspose() const
+    {
+        return M_useTranspose;
+    }
+
+    //! Always true
+    bool HasNormInf() const
+    {
+        return true;
+    }
+
+    //! Communicator of the maps
+    const comm_Type& Comm() const
+    {
+        return OperatorRangeMap().Comm();
+    }
+
+    //! Domain map: unique map of the field
+    const map_Type& OperatorDomainMap() const
+    {
+        return *M_matrix.map().map ( Unique );
+    }
+
+    //! Range map: unique map of the field
+    const map_Type& OperatorRangeMap() const
+    {
+        return *M_matrix.map().map ( Unique );
+    }
+
+    //@}
+
+private:
+
+    const matrix_Type& M_matrix;
+    std::string M_name;
+    bool M_useTranspose;
+};
+
+template <typename DataType>
+int MatrixEpetraBlockCRSOperator<DataType>::
+Apply ( const vector_Type& X, vector_Type& Y ) const
+{
+    ASSERT ( M_matrix.filled(), "MatrixEpetraBlockCRSOperator::Apply: the matrix must be closed" );
+    ASSERT ( X.NumVectors() == Y.NumVectors(), "Different number of vectors in X and Y" );
+    ASSERT ( X.Map().SameAs ( OperatorDomainMap() ), "X is not defined on the domain map" );
+    ASSERT ( Y.Map().SameAs ( OperatorRangeMap() ), "Y is not defined on the range map" );
+
+    const std::vector<Int>& pointIndices ( M_matrix.M_pointIndices );
+    const Int numVectors ( X.NumVectors() );
+
+    Epetra_MultiVector pointX ( M_matrix.matrixPtr()->DomainMap(), numVectors, false );
+    Epetra_MultiVector pointY ( M_matrix.matrixPtr()->RangeMap(), numVectors, false );
+
+    for ( Int k ( 0 ); k < numVectors; ++k )
+    {
+        for ( UInt i ( 0 ); i < pointIndices.size(); ++i )
+        {
+            pointX[k][pointIndices[i]] = X[k][i];
+        }
+    }
+
+    const Int ierr ( M_matrix.matrixPtr()->Multiply ( M_useTranspose, pointX, pointY ) );
+
+    for ( Int k ( 0 ); k < numVectors; ++k )
+    {
+        for ( UInt i ( 0 ); i < pointIndices.size(); ++i )
+        {
+            Y[k][i] = pointY[k][pointIndices[i]];
+        }
+    }
+
+    return ierr;
+}
+
+} // Namespace LifeV
+
+#endif // _MATRIXEPETRABLOCKCRS_HPP_
@@ -0,0 +1,319 @@
+//@HEADER
+/*
+*******************************************************************************
+
+   Copyright (C) 2004, 2005, 2007 EPFL, Politecnico di Milano, INRIA
+   Copyright (C) 2010 EPFL, Politecnico di Milano, Emory UNiversity
+
+   This file is part of the LifeV library
+
+   LifeV is free software; you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+
+   LifeV is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with this library; if not, see <http://www.gnu.org/licenses/>
+
+
+*******************************************************************************
+*/
+//@HEADER
+
+/*!
+    @file
+    @brief MatrixEpetraOffsets
+
+    @date 10-2026
+ */
+
+#ifndef _MATRIXEPETRAOFFSETS_HPP_
+#define _MATRIXEPETRAOFFSETS_HPP_
+
+#include <vector>
+
+#include <lifev/core/LifeV.hpp>
+
+#include <lifev/core/array/MatrixEpetra.hpp>
+
+namespace LifeV
+{
+
+//! MatrixEpetraOffsets - Cached positions of elemental blocks in the values of a closed MatrixEpetra
+/*!
+  When a closed matrix (i.e. with a fixed graph) is assembled several times,
+  e.g. a Jacobian rebuilt at each time step, each call to SumIntoGlobalValues
+  translates the global indices and searches the columns in the rows of the
+  Epetra_CrsMatrix.
+
+  This class stores, for each elemental block (a "slot", typically the local
+  identifier of the element), the offsets of its entries in the contiguous
+  value array of the Epetra_CrsMatrix. The offsets are computed the first time
+  the slot is summed into the matrix; later sums write directly in the values.
+
+  The contributions to rows which are not owned by this process are passed to
+  the Epetra_FECrsMatrix as usual (inside a critical region), so that
+  MatrixEpetra::globalAssemble has to be called as after any other assembly.
+
+  The offsets are valid as long as the structure of the matrix does not change;
+  this is checked with isValidFor, and reset has to be called otherwise.
+
+  Concurrent calls to sumIntoCoefficients are allowed for different slots,
+  provided that the number of slots has been given in reset.
+ */
+template <typename DataType>
+class MatrixEpetraOffsets
+{
+public:
+
+    //! @name Public Types
+    //@{
+
+    typedef MatrixEpetra<DataType> matrix_Type;
+
+    //@}
+
+
+    //! @name Constructors & Destructor
+    //@{
+
+    //! Empty constructor: no matrix and no slot
+    MatrixEpetraOffsets();
+
+    //! Destructor
+    ~MatrixEpetraOffsets() {}
+
+    //@}
+
+
+    //! @name Methods
+    //@{
+
+    //! Forget all the offsets and bind the cache to the given closed matrix
+    /*!
+      @param matrix Closed matrix whose values are to be summed
+      @param numSlots Number of slots to be allocated (more slots are allocated
+             on demand, but not in a thread-safe way)
+     */
+    void reset ( matrix_Type& matrix, const UInt numSlots = 0 );
+
+    //! True if the offsets have been computed for the current structure of the matrix
+    bool isValidFor ( const matrix_Type& matrix ) const;
+
+    //! Add a set of values to the matrix, using (and recording the first time) the offsets of the slot
+    /*!
+      @param slot Identifier of the elemental block (e.g. local identifier of the element)
+      @param matrix Closed matrix given in reset
+      @param numRows Number of rows into the list given in "localValues"
+      @param numColumns Number of columns into the list given in "localValues"
+      @param rowIndices List of row indices
+      @param columnIndices List of column indices
+      @param localValues 2D array containing the coefficient related to "rowIndices" and "columnIndices",
+             stored row by row (Epetra_FECrsMatrix::ROW_MAJOR)
+     */
+    void sumIntoCoefficients ( const UInt slot, matrix_Type& matrix,
+                               Int const numRows, Int const numColumns,
+                               Int const* rowIndices, Int const* columnIndices,
+                               DataType const* const* localValues );
+
+    //! Same as above, with the indices given in vectors
+    void sumIntoCoefficients ( const UInt slot, matrix_Type& matrix,
+                               Int const numRows, Int const numColumns,
+                               std::vector<Int> const& rowIndices,
+                               std::vector<Int> const& columnIndices,
+                               DataType const* const* localValues )
+    {
+        sumIntoCoefficients ( slot, matrix, numRows, numColumns, &rowIndices[0], &columnIndices[0], localValues );
+    }
+
+    //@}
+
+
+    //! @name Get Methods
+    //@{
+
+    //! Number of slots allocated
+    UInt numSlots() const
+    {
+        return M_offsets.size();
+    }
+
+    //! True if the offsets of the slot have already been recorded
+    bool isRecorded ( const UInt slot ) const
+    {
+        return slot < M_offsets.size() && !M_offsets[slot].empty();
+    }
+
+    //@}
+
+private:
+
+    //! Compute the offsets of the entries of a slot
+    void record ( const UInt slot, const matrix_Type& matrix,
+                  Int const numRows, Int const numColumns,
+                  Int const* rowIndices, Int const* columnIndices );
+
+    // Offsets of the entries of each slot (row by row), -1 for the non-local rows
+    std::vector<std::vector<Int> > M_offsets;
+
+    // Value array of the matrix when the offsets were computed
+    DataType* M_values;
+
+    // Number of local entries of the matrix when the offsets were computed
+    Int M_numMyNonzeros;
+};
+
+// ===================================================
+// Constructors & Destructor
+// ===================================================
+
+template <typename DataType>
+MatrixEpetraOffsets<DataType>::MatrixEpetraOffsets()
+    :
+    M_offsets(),
+    M_values ( 0 ),
+    M_numMyNonzeros ( 0 )
+{
+}
+
+// ===================================================
+// Methods
+// ===================================================
+
+template <typename DataType>
+void MatrixEpetraOffsets<DataType>::reset ( matrix_Type& matrix, const UInt numSlots )
+{
+    ASSERT ( matrix.filled(), "The offsets can only be computed for a closed matrix" );
+
+    // The offsets refer to a single value array
+    if ( !matrix.matrixPtr()->StorageOptimized() )
+    {
+        matrix.matrixPtr()->OptimizeStorage();
+    }
+
+    Int* indexOffset;
+    Int* indices;
+    matrix.matrixPtr()->ExtractCrsDataPointers ( indexOffset, indices, M_values );
+    M_numMyNonzeros = matrix.matrixPtr()->NumMyNonzeros();
+
+    M_offsets.clear();
+    M_offsets.resize ( numSlots );
+}
+
+template <typename DataType>
+bool MatrixEpetraOffsets<DataType>::isValidFor ( const matrix_Type& matrix ) const
+{
+    if ( M_values == 0 || !matrix.filled() || !matrix.matrixPtr()->StorageOptimized() )
+    {
+        return false;
+    }
+
+    Int* indexOffset;
+    Int* indices;
+    DataType* values;
+    matrix.matrixPtr()->ExtractCrsDataPointers ( indexOffset, indices, values );
+
+    return values == M_values && matrix.matrixPtr()->NumMyNonzeros() == M_numMyNonzeros;
+}
+
+template <typename DataType>
+void MatrixEpetraOffsets<DataType>::
+sumIntoCoefficients ( const UInt slot, matrix_Type& matrix,
+                      Int const numRows, Int const numColumns,
+                      Int const* rowIndices, Int const* columnIndices,
+                      DataType const* const* localValues )
+{
+    ASSERT ( M_values != 0, "The offsets have to be reset with a closed matrix before use" );
+
+    if ( slot >= M_offsets.size() )
+    {
+        M_offsets.resize ( slot + 1 );
+    }
+
+    if ( M_offsets[slot].empty() )
+    {
+        record ( slot, matrix, numRows, numColumns, rowIndices, columnIndices );
+    }
+
+    ASSERT ( M_offsets[slot].size() == static_cast<UInt> ( numRows * numColumns ),
+             "The size of the block does not match the recorded offsets" );
+
+    const Int* offsets ( &M_offsets[slot][0] );
+
+    for ( Int i (0); i < numRows; ++i )
+    {
+        if ( offsets[i * numColumns] < 0 )
+        {
+            Int ierr;
+            #pragma omp critical
+            {
+                ierr = matrix.matrixPtr()->SumIntoGlobalValues ( 1, &rowIndices[i], numColumns, columnIndices,
+                                                                 &localValues[i], Epetra_FECrsMatrix::ROW_MAJOR );
+            }
+            ASSERT ( ierr >= 0, "Error in the insertion of a non-local row" );
+            continue;
+        }
+
+        for ( Int j (0); j < numColumns; ++j )
+        {
+            #pragma omp atomic
+            M_values[offsets[i * numColumns + j]] += localValues[i][j];
+        }
+    }
+}
+
+template <typename DataType>
+void MatrixEpetraOffsets<DataType>::
+record ( const UInt slot, const matrix_Type& matrix,
+         Int const numRows, Int const numColumns,
+         Int const* rowIndices, Int const* columnIndices )
+{
+    const Epetra_FECrsMatrix& epetraMatrix ( *matrix.matrixPtr() );
+
+    Int* indexOffset;
+    Int* indices;
+    DataType* values;
+    epetraMatrix.ExtractCrsDataPointers ( indexOffset, indices, values );
+
+    std::vector<Int>& offsets ( M_offsets[slot] );
+    offsets.assign ( numRows * numColumns, -1 );
+
+    for ( Int i (0); i < numRows; ++i )
+    {
+        const Int localRow ( epetraMatrix.LRID ( rowIndices[i] ) );
+        if ( localRow < 0 )
+        {
+            continue;
+        }
+
+        for ( Int j (0); j < numColumns; ++j )
+        {
+            const Int localColumn ( epetraMatrix.LCID ( columnIndices[j] ) );
+
+            Int position ( indexOffset[localRow] );
+            while ( position < indexOffset[localRow + 1] && indices[position] != localColumn )
+            {
+                ++position;
+            }
+
+            if ( localColumn < 0 || position == indexOffset[localRow + 1] )
+            {
+                std::stringstream errorMessage;
+                errorMessage << " entry (" << rowIndices[i] << ", " << columnIndices[j]
+                             << ") is not in the graph of the matrix [MatrixEpetraOffsets]" << std::endl;
+                ERROR_MSG ( errorMessage.str() );
+            }
+
+            offsets[i * numColumns + j] = position;
+        }
+    }
+}
+
+} // Namespace LifeV
+
+#endif /* _MATRIXEPETRAOFFSETS_HPP_ */
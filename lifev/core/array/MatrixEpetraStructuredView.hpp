@@ -109,6 +109,11 @@ public:
                                std::vector<Int> const& blockRowIndices, std::vector<Int> const& blockColumnIndices,
                                DataType* const* const localValues,
                                Int format = Epetra_FECrsMatrix::COLUMN_MAJOR ) const;
+
+    //! Function to sum a row-major elemental matrix in a closed block, without critical region on the local rows
+    void sumIntoCoefficientsLockFree ( UInt const numRows, UInt const numColumns,
+                                       std::vector<Int> const& blockRowIndices, std::vector<Int> const& blockColumnIndices,
+                                       DataType* const* const localValues ) const;
     //@}
 
     //! @name  Set Methods
@@ -303,6 +308,30 @@ sumIntoCoefficients ( UInt const numRows, UInt const numColumns,
                                    localValues, format);
 }
 
+template<typename DataType>
+void
+MatrixEpetraStructuredView<DataType>::
+sumIntoCoefficientsLockFree ( UInt const numRows, UInt const numColumns,
+                              std::vector<Int> const& blockRowIndices, std::vector<Int> const& blockColumnIndices,
+                              DataType* const* const localValues ) const
+{
+    std::vector<Int> rowIndices (blockRowIndices);
+    std::vector<Int> columnIndices (blockColumnIndices);
+
+    for (UInt i (0); i < numRows; ++i)
+    {
+        rowIndices[i] += M_firstRowIndex;
+    }
+    for (UInt i (0); i < numColumns; ++i)
+    {
+        columnIndices[i] += M_firstColumnIndex;
+    }
+
+    M_matrix->sumIntoCoefficientsLockFree (numRows, numColumns,
+                                           rowIndices, columnIndices,
+                                           localValues);
+}
+
 // ===================================================
 // Set Methods
 // ===================================================
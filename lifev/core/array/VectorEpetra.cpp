@@ -715,6 +715,90 @@ VectorEpetra::sumIntoGlobalValues ( const Int GID, const Real value )
     return M_epetraVector->SumIntoGlobalValues ( 1, &GID, &value );
 }
 
+VectorEpetra&
+VectorEpetra::linearCombination ( const data_type& coefficient, const VectorEpetra& vector,
+                                  const data_type& scalarThis )
+{
+    if ( this->blockMap().SameAs ( vector.blockMap() ) )
+    {
+        M_epetraVector->Update ( coefficient, vector.epetraVector(), scalarThis );
+    }
+    else
+    {
+        VectorEpetra vCopy ( vector, M_mapType, M_combineMode );
+        M_epetraVector->Update ( coefficient, vCopy.epetraVector(), scalarThis );
+    }
+
+    return *this;
+}
+
+VectorEpetra&
+VectorEpetra::linearCombination ( const data_type& coefficient1, const VectorEpetra& vector1,
+                                  const data_type& coefficient2, const VectorEpetra& vector2,
+                                  const data_type& scalarThis )
+{
+    if ( this->blockMap().SameAs ( vector1.blockMap() ) && this->blockMap().SameAs ( vector2.blockMap() ) )
+    {
+        M_epetraVector->Update ( coefficient1, vector1.epetraVector(),
+                                 coefficient2, vector2.epetraVector(), scalarThis );
+        return *this;
+    }
+
+    std::vector<data_type> coefficients ( 2 );
+    std::vector<const VectorEpetra*> vectors ( 2 );
+
+    coefficients[0] = coefficient1;
+    coefficients[1] = coefficient2;
+    vectors[0] = &vector1;
+    vectors[1] = &vector2;
+
+    return linearCombination ( coefficients, vectors, scalarThis );
+}
+
+VectorEpetra&
+VectorEpetra::linearCombination ( const std::vector<data_type>& coefficients,
+                                  const std::vector<const VectorEpetra*>& vectors,
+                                  const data_type& scalarThis )
+{
+    ASSERT ( coefficients.size() == vectors.size(), "The number of coefficients and of vectors must be the same" );
+
+    const UInt numVectors ( vectors.size() );
+
+    // Values of the vectors in the map of this: the vectors on other maps are copied
+    std::vector<std::shared_ptr<VectorEpetra> > copies;
+    std::vector<const data_type*> values ( numVectors );
+
+    for ( UInt k ( 0 ); k < numVectors; ++k )
+    {
+        if ( this->blockMap().SameAs ( vectors[k]->blockMap() ) )
+        {
+            values[k] = vectors[k]->epetraVector() [0];
+        }
+        else
+        {
+            copies.push_back ( std::shared_ptr<VectorEpetra> ( new VectorEpetra ( *vectors[k], M_mapType, M_combineMode ) ) );
+            values[k] = copies.back()->epetraVector() [0];
+        }
+    }
+
+    data_type* result ( (*M_epetraVector) [0] );
+    const Int length ( M_epetraVector->MyLength() );
+
+    for ( Int i ( 0 ); i < length; ++i )
+    {
+        data_type sum ( scalarThis == 0. ? 0. : scalarThis * result[i] );
+
+        for ( UInt k ( 0 ); k < numVectors; ++k )
+        {
+            sum += coefficients[k] * values[k][i];
+        }
+
+        result[i] = sum;
+    }
+
+    return *this;
+}
+
 VectorEpetra&
 VectorEpetra::add ( const VectorEpetra& vector, const Int offset )
 {
@@ -470,6 +470,38 @@ public:
      */
     Int sumIntoGlobalValues ( const Int GID, const Real value );
 
+    //! Linear combination with one vector: this = coefficient * vector + scalarThis * this
+    /*!
+      The combination is computed in one pass, without temporary vectors when
+      the vector has the same map as this (otherwise it is copied in the map of this,
+      as for operator+=).
+      @param coefficient Coefficient of the vector
+      @param vector Vector of the combination
+      @param scalarThis Coefficient of the current vector (the current values are not used if zero)
+     */
+    VectorEpetra& linearCombination ( const data_type& coefficient, const VectorEpetra& vector,
+                                      const data_type& scalarThis = 0. );
+
+    //! Linear combination with two vectors: this = coefficient1 * vector1 + coefficient2 * vector2 + scalarThis * this
+    /*!
+      @see linearCombination ( const data_type&, const VectorEpetra&, const data_type& )
+     */
+    VectorEpetra& linearCombination ( const data_type& coefficient1, const VectorEpetra& vector1,
+                                      const data_type& coefficient2, const VectorEpetra& vector2,
+                                      const data_type& scalarThis = 0. );
+
+    //! Linear combination with any number of vectors: this = sum_k coefficients[k] * vectors[k] + scalarThis * this
+    /*!
+      All the vectors are read in the same loop, e.g. a = b*x + c*y - z is computed
+      as a.linearCombination ( {b, c, -1}, {&x, &y, &z} ) with one pass on the data.
+      @param coefficients Coefficients of the vectors
+      @param vectors Vectors of the combination (they may include this)
+      @param scalarThis Coefficient of the current vector (the current values are not used if zero)
+     */
+    VectorEpetra& linearCombination ( const std::vector<data_type>& coefficients,
+                                      const std::vector<const VectorEpetra*>& vectors,
+                                      const data_type& scalarThis = 0. );
+
     //! Add a vector to the current vector with an offset
     /*!
       typically to do: (u,p) += p or (u,p) += u.
@@ -56,6 +56,7 @@
 #include <lifev/core/array/MatrixElemental.hpp>
 #include <lifev/core/array/VectorElemental.hpp>
 #include <lifev/core/array/MatrixEpetra.hpp>
+#include <lifev/core/array/MatrixEpetraBlockCRS.hpp>
 #include <lifev/core/array/VectorEpetra.hpp>
 
 #include <lifev/core/fem/CurrentFE.hpp>
@@ -263,6 +264,55 @@ assembleMatrix ( MatrixEpetra<Real>& globalMatrix,
 
 }
 
+//! Assembly procedure for the block matrix of a vector field
+/*!
+  This method transfers all the blocks of the local matrix of a vector field
+  (one block per pair of components) to a global block matrix, by nodal blocks.
+  The number of blocks of the local matrix is the block size of the matrix.
+ */
+template <typename DofType>
+void
+assembleMatrix ( MatrixEpetraBlockCRS<Real>& globalMatrix,
+                 MatrixElemental&            localMatrix,
+                 const CurrentFE&            currentFE,
+                 const DofType&              dof )
+
+{
+    const UInt nbDof ( currentFE.nbFEDof() );
+    const UInt blockSize ( globalMatrix.blockSize() );
+    const UInt blockArea ( blockSize * blockSize );
+    const UInt elementID ( currentFE.currentLocalId() );
+
+    // Global ID of the nodes
+    std::vector<Int> nodeList ( nbDof );
+
+    for ( UInt k (0) ; k < nbDof ; k++ )
+    {
+        nodeList[k] = dof.localToGlobalMap ( elementID, k );
+    }
+
+    // Nodal blocks, stored column by column
+    std::vector<Real> blocks ( nbDof * nbDof * blockArea );
+
+    for ( UInt iComponent (0) ; iComponent < blockSize ; iComponent++ )
+    {
+        for ( UInt jComponent (0) ; jComponent < blockSize ; jComponent++ )
+        {
+            MatrixElemental::matrix_view localView = localMatrix.block ( iComponent, jComponent );
+
+            for ( UInt k1 (0) ; k1 < nbDof ; k1++ )
+            {
+                for ( UInt k2 (0) ; k2 < nbDof ; k2++ )
+                {
+                    blocks[ ( k1 * nbDof + k2 ) * blockArea + jComponent * blockSize + iComponent ] = localView ( k1, k2 );
+                }
+            }
+        }
+    }
+
+    globalMatrix.addToBlocks ( nbDof, nbDof, &nodeList[0], &nodeList[0], &blocks[0] );
+}
+
 //! Assembly procedure for the transposed matrix
 /*!
   This method allows to transfer local contributions
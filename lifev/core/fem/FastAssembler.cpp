@@ -1,4 +1,5 @@
 #include <lifev/core/fem/FastAssembler.hpp>
+#include <algorithm>
 #include <chrono>
 
 #ifdef EPETRA_HAVE_OMP
@@ -18,10 +19,149 @@ FastAssembler::FastAssembler( const meshPtr_Type& mesh, const commPtr_Type& comm
 		M_comm ( comm ),
 		M_referenceFE ( refFE ),
 		M_qr ( qr ),
-		M_useSUPG ( false )
+		M_vals ( 0 ),
+		M_vals_supg ( 0 ),
+		M_rows ( 0 ),
+		M_cols ( 0 ),
+		M_rows_tmp ( 0 ),
+		M_cols_tmp ( 0 ),
+		M_useSUPG ( false ),
+		M_useInsertionOffsets ( false ),
+		M_chunkSize ( 0 ),
+		M_bufferSize ( 0 ),
+		M_valsBuffer ( 0 ),
+		M_valsRows ( 0 ),
+		M_rowsBuffer ( 0 ),
+		M_colsBuffer ( 0 ),
+		M_valsBuffer_supg ( 0 ),
+		M_valsRows_supg ( 0 ),
+		M_valsBlocks_supg ( 0 ),
+		M_valsComponents_supg ( 0 ),
+		M_tmpBuffer ( 0 ),
+		M_tauBuffer ( 0 )
 {
 }
 //=========================================================================
+void
+FastAssembler::setUseInsertionOffsets( const bool& useOffsets )
+{
+	M_useInsertionOffsets = useOffsets;
+	M_insertionOffsets.clear();
+}
+//=========================================================================
+void
+FastAssembler::setChunkSize( const int& chunkSize )
+{
+	ASSERT ( M_vals == 0, "The chunk size must be set before allocateSpace" );
+	ASSERT ( chunkSize >= 0, "The chunk size cannot be negative" );
+	M_chunkSize = chunkSize;
+}
+//=========================================================================
+void
+FastAssembler::allocateBuffers()
+{
+	int ndof = M_referenceFE->nbDof();
+
+	M_bufferSize = ( M_chunkSize > 0 && M_chunkSize < M_numElements ) ? M_chunkSize : M_numElements;
+
+	// One contiguous block per buffer, M_vals, M_rows and M_cols giving the views of each element of the chunk
+	M_valsBuffer = new double [ M_bufferSize * ndof * ndof ];
+	M_valsRows = new double* [ M_bufferSize * ndof ];
+	M_vals = new double** [ M_bufferSize ];
+
+	M_rowsBuffer = new int [ M_bufferSize * ndof ];
+	M_colsBuffer = new int [ M_bufferSize * ndof ];
+	M_rows = new int* [ M_bufferSize ];
+	M_cols = new int* [ M_bufferSize ];
+
+	for ( int i_slot = 0; i_slot < M_bufferSize; i_slot++ )
+	{
+		for ( int i = 0; i < ndof; i++ )
+		{
+			M_valsRows[i_slot * ndof + i] = M_valsBuffer + ( i_slot * ndof + i ) * ndof;
+		}
+		M_vals[i_slot] = M_valsRows + i_slot * ndof;
+
+		M_rows[i_slot] = M_rowsBuffer + i_slot * ndof;
+		M_cols[i_slot] = M_colsBuffer + i_slot * ndof;
+	}
+}
+//=========================================================================
+void
+FastAssembler::insertChunk( matrix_Type& matrix, const int& chunkBegin, const int& chunkEnd, const int& numBlocks )
+{
+	int ndof = M_referenceFE->nbDof();
+
+	for ( int k = chunkBegin; k < chunkEnd; ++k )
+	{
+		insertValues ( matrix, 0, k, ndof, M_rows[k - chunkBegin], M_cols[k - chunkBegin], M_vals[k - chunkBegin] );
+	}
+
+	// Same values in the diagonal blocks of the other components
+	for ( int d1 = 1; d1 < numBlocks ; d1++ )
+	{
+		for ( int k = chunkBegin; k < chunkEnd; ++k )
+		{
+			int i_slot = k - chunkBegin;
+			for ( int i = 0; i <  ndof; i++ )
+			{
+				M_rows[i_slot][i] += M_numScalarDofs;
+				M_cols[i_slot][i] += M_numScalarDofs;
+			}
+			insertValues ( matrix, 4 * d1, k, ndof, M_rows[i_slot], M_cols[i_slot], M_vals[i_slot] );
+		}
+	}
+}
+//=========================================================================
+void
+FastAssembler::insertChunk_SUPG( matrix_Type& matrix, const int& chunkBegin, const int& chunkEnd )
+{
+	int ndof = M_referenceFE->nbDof();
+
+	for ( int d1 = 0; d1 < 3 ; d1++ ) // row index
+	{
+		for ( int d2 = 0; d2 < 3 ; d2++ ) // column
+		{
+			for ( int k = chunkBegin; k < chunkEnd; ++k )
+			{
+				int i_slot = k - chunkBegin;
+				for ( int i = 0; i <  ndof; i++ )
+				{
+					M_rows_tmp[i_slot][i] = M_rows[i_slot][i] + d1 * M_numScalarDofs;
+					M_cols_tmp[i_slot][i] = M_cols[i_slot][i] + d2 * M_numScalarDofs;
+				}
+				insertValues ( matrix, 3 * d1 + d2, k, ndof, M_rows_tmp[i_slot], M_cols_tmp[i_slot], M_vals_supg[i_slot][d1][d2] );
+			}
+		}
+	}
+}
+//=========================================================================
+void
+FastAssembler::insertValues( matrix_Type& matrix, const int& block, const int& k, const int& ndof, int* rows, int* cols, double** vals )
+{
+	if ( M_useInsertionOffsets && matrix.filled() )
+	{
+		offsetsPtr_Type& offsets = M_insertionOffsets[ matrix.matrixPtr().get() ];
+
+		if ( !offsets )
+		{
+			offsets.reset ( new offsets_Type );
+		}
+
+		// The structure of the matrix changed (or first use): the offsets are recomputed
+		if ( !offsets->isValidFor ( matrix ) )
+		{
+			offsets->reset ( matrix, 9 * M_numElements );
+		}
+
+		offsets->sumIntoCoefficients ( block * M_numElements + k, matrix, ndof, ndof, rows, cols, vals );
+	}
+	else
+	{
+		matrix.matrixPtr()->InsertGlobalValues ( ndof, rows, ndof, cols, vals, Epetra_FECrsMatrix::ROW_MAJOR);
+	}
+}
+//=========================================================================
 // Destructor //
 FastAssembler::~FastAssembler()
 {
@@ -88,52 +228,27 @@ FastAssembler::~FastAssembler()
 
 	//---------------------
 
-	for( int i = 0 ; i < M_numElements ; i++ )
-	{
-		for ( int j = 0; j < M_referenceFE->nbDof(); j++ )
-		{
-			delete [] M_vals[i][j];
-		}
-		delete [] M_vals[i];
-	}
+	delete [] M_valsBuffer;
+	delete [] M_valsRows;
 	delete [] M_vals;
 
 	//---------------------
 
-	for( int i = 0 ; i < M_numElements ; i++ )
-	{
-		delete [] M_rows[i];
-		delete [] M_cols[i];
-	}
+	delete [] M_rowsBuffer;
+	delete [] M_colsBuffer;
 	delete [] M_rows;
 	delete [] M_cols;
 
 	//---------------------
 	if ( M_useSUPG )
 	{
-		for ( int i_elem = 0; i_elem <  M_numElements; i_elem++ )
-		{
-			for ( int k = 0; k <  3; k++ )
-			{
-				for ( int z = 0; z <  3; z++ )
-				{
-					for ( int i = 0; i <  M_referenceFE->nbDof(); i++ )
-					{
-						delete [] M_vals_supg[i_elem][k][z][i];
-					}
-					delete [] M_vals_supg[i_elem][k][z];
-				}
-				delete [] M_vals_supg[i_elem][k];
-			}
-			delete [] M_vals_supg[i_elem];
-		}
+		delete [] M_valsBuffer_supg;
+		delete [] M_valsRows_supg;
+		delete [] M_valsBlocks_supg;
+		delete [] M_valsComponents_supg;
 		delete [] M_vals_supg;
-        
-        for( int i = 0 ; i < M_numElements ; i++ )
-        {
-            delete [] M_rows_tmp[i];
-            delete [] M_cols_tmp[i];
-        }
+
+        delete [] M_tmpBuffer;
         delete [] M_rows_tmp;
         delete [] M_cols_tmp;
 
@@ -146,11 +261,10 @@ FastAssembler::~FastAssembler()
         	}
         	delete [] M_G[i];
         	delete [] M_g[i];
-        	delete [] M_Tau_M[i];
-        	delete [] M_Tau_C[i];
         }
         delete [] M_G;
         delete [] M_g;
+        delete [] M_tauBuffer;
         delete [] M_Tau_M;
         delete [] M_Tau_C;
     }
@@ -288,32 +402,9 @@ FastAssembler::allocateSpace ( const int& numElements, CurrentFE* fe, const fesp
 
     //-------------------------------------------------------------------------------------------------
 
-    // Allocate space for M_rows, M_cols and M_vals
-
-    M_vals = new double** [M_numElements];
-
-    for ( int i_elem = 0; i_elem <  M_numElements; i_elem++ )
-    {
-    	M_vals[i_elem] = new double* [ M_referenceFE->nbDof() ];
-    	for ( int i = 0; i <  M_referenceFE->nbDof(); i++ )
-    	{
-    		M_vals[i_elem][i] = new double [ M_referenceFE->nbDof() ];
-    	}
-    }
-
-    M_rows = new int* [M_numElements];
-
-    for ( int i_elem = 0; i_elem <  M_numElements; i_elem++ )
-    {
-    	M_rows[i_elem] = new int [ M_referenceFE->nbDof() ];
-    }
+    // Allocate space for M_rows, M_cols and M_vals (one chunk of elements)
 
-    M_cols = new int* [M_numElements];
-
-    for ( int i_elem = 0; i_elem <  M_numElements; i_elem++ )
-    {
-    	M_cols[i_elem] = new int [ M_referenceFE->nbDof() ];
-    }
+    allocateBuffers();
 }
 //=========================================================================
 void
@@ -321,41 +412,48 @@ FastAssembler::allocateSpace_SUPG( CurrentFE* fe )
 {
 	M_useSUPG = true;
 
-	M_vals_supg = new double**** [M_numElements];
+	int ndof = M_referenceFE->nbDof();
+
+	// The buffers of the SUPG terms are allocated for one chunk of elements, as M_vals
+	M_valsBuffer_supg = new double [ M_bufferSize * 9 * ndof * ndof ];
+	M_valsRows_supg = new double* [ M_bufferSize * 9 * ndof ];
+	M_valsBlocks_supg = new double** [ M_bufferSize * 9 ];
+	M_valsComponents_supg = new double*** [ M_bufferSize * 3 ];
+	M_vals_supg = new double**** [ M_bufferSize ];
 
-	for ( int i_elem = 0; i_elem <  M_numElements; i_elem++ )
+	for ( int i = 0; i < M_bufferSize * 9 * ndof * ndof; i++ )
 	{
-		M_vals_supg[i_elem] = new double*** [ 3 ];
-		for ( int k = 0; k <  3; k++ )
-		{
-			M_vals_supg[i_elem][k] = new double** [ 3 ];
-			for ( int z = 0; z < 3; z++ )
-			{
-				M_vals_supg[i_elem][k][z] = new double* [ M_referenceFE->nbDof() ];
-				for ( int i = 0; i <  M_referenceFE->nbDof(); i++ )
-				{
-					M_vals_supg[i_elem][k][z][i] = new double [ M_referenceFE->nbDof() ];
-                    for ( int j = 0; j <  M_referenceFE->nbDof(); j++ )
-                    {
-                        M_vals_supg[i_elem][k][z][i][j] = 0.0;
-                    }
-                }
-			}
-		}
+		M_valsBuffer_supg[i] = 0.0;
 	}
-    
-    M_rows_tmp = new int* [M_numElements];
-    
-    for ( int i_elem = 0; i_elem <  M_numElements; i_elem++ )
-    {
-        M_rows_tmp[i_elem] = new int [ M_referenceFE->nbDof() ];
-    }
-    
-    M_cols_tmp = new int* [M_numElements];
-    
-    for ( int i_elem = 0; i_elem <  M_numElements; i_elem++ )
+
+	for ( int i = 0; i < M_bufferSize * 9 * ndof; i++ )
+	{
+		M_valsRows_supg[i] = M_valsBuffer_supg + i * ndof;
+	}
+
+	for ( int i = 0; i < M_bufferSize * 9; i++ )
+	{
+		M_valsBlocks_supg[i] = M_valsRows_supg + i * ndof;
+	}
+
+	for ( int i = 0; i < M_bufferSize * 3; i++ )
+	{
+		M_valsComponents_supg[i] = M_valsBlocks_supg + i * 3;
+	}
+
+	for ( int i_slot = 0; i_slot < M_bufferSize; i_slot++ )
+	{
+		M_vals_supg[i_slot] = M_valsComponents_supg + i_slot * 3;
+	}
+
+    M_tmpBuffer = new int [ 2 * M_bufferSize * ndof ];
+    M_rows_tmp = new int* [ M_bufferSize ];
+    M_cols_tmp = new int* [ M_bufferSize ];
+
+    for ( int i_slot = 0; i_slot < M_bufferSize; i_slot++ )
     {
-        M_cols_tmp[i_elem] = new int [ M_referenceFE->nbDof() ];
+        M_rows_tmp[i_slot] = M_tmpBuffer + i_slot * ndof;
+        M_cols_tmp[i_slot] = M_tmpBuffer + ( M_bufferSize + i_slot ) * ndof;
     }
 
     //-------------------------------------------------------------------------------------------------
@@ -375,12 +473,13 @@ FastAssembler::allocateSpace_SUPG( CurrentFE* fe )
 
     //-------------------------------------------------------------------------------------------------
 
-    M_Tau_M = new double* [ M_numElements];
-    M_Tau_C = new double* [ M_numElements];
-    for ( int i = 0; i <  M_numElements; i++ )
+    M_tauBuffer = new double [ 2 * M_bufferSize * M_qr->nbQuadPt() ];
+    M_Tau_M = new double* [ M_bufferSize ];
+    M_Tau_C = new double* [ M_bufferSize ];
+    for ( int i_slot = 0; i_slot < M_bufferSize; i_slot++ )
     {
-    	M_Tau_M[i] = new double [ M_qr->nbQuadPt() ];
-    	M_Tau_C[i] = new double [ M_qr->nbQuadPt() ];
+    	M_Tau_M[i_slot] = M_tauBuffer + i_slot * M_qr->nbQuadPt();
+    	M_Tau_C[i_slot] = M_tauBuffer + ( M_bufferSize + i_slot ) * M_qr->nbQuadPt();
     }
 
     //-------------------------------------------------------------------------------------------------
@@ -502,8 +601,12 @@ FastAssembler::allocateSpace( const int& numElements, CurrentFE* fe, const fespa
         }
     }
 
-}
+    //-------------------------------------------------------------------------------------------------
 
+    // Allocate space for M_rows, M_cols and M_vals (one chunk of elements)
+
+    allocateBuffers();
+}
 //=========================================================================
 void
 FastAssembler::assembleGradGrad_scalar( matrixPtr_Type& matrix )
@@ -519,68 +622,72 @@ FastAssembler::assembleGradGrad_scalar( matrixPtr_Type& matrix )
 
     #pragma omp parallel firstprivate( w_quad, ndof, NumQuadPoints)
     {
-        int i_el, i_elem, i_dof, q, d1, d2, i_test, i_trial;
+        int i_el, i_elem, i_slot, i_chunk, i_chunkEnd, i_dof, q, d1, d2, i_test, i_trial;
         double integral;
 
         double dphi_phys[ndof][NumQuadPoints][3];
 
-        // ELEMENTI
-        #pragma omp for
-        for ( i_el = 0; i_el <  M_numElements ; i_el++ )
+        // CHUNKS of elements (a single chunk if no chunk size is set)
+        for ( i_chunk = 0; i_chunk < M_numElements; i_chunk += M_bufferSize )
         {
-        	i_elem = i_el;
+            i_chunkEnd = std::min ( i_chunk + M_bufferSize, M_numElements );
 
-            // DOF
-            for ( i_dof = 0; i_dof <  ndof; i_dof++ )
+            // ELEMENTI
+            #pragma omp for
+            for ( i_el = i_chunk; i_el < i_chunkEnd; i_el++ )
             {
-                // QUAD
-                for (  q = 0; q < NumQuadPoints ; q++ )
+            	i_elem = i_el;
+            	i_slot = i_el - i_chunk;
+
+                // DOF
+                for ( i_dof = 0; i_dof <  ndof; i_dof++ )
                 {
-                    // DIM 1
-                    for ( d1 = 0; d1 < 3 ; d1++ )
+                    // QUAD
+                    for (  q = 0; q < NumQuadPoints ; q++ )
                     {
-                        dphi_phys[i_dof][q][d1] = 0.0;
-
-                        // DIM 2
-                        for ( d2 = 0; d2 < 3 ; d2++ )
+                        // DIM 1
+                        for ( d1 = 0; d1 < 3 ; d1++ )
                         {
-                            dphi_phys[i_dof][q][d1] += M_invJacobian[i_elem][d1][d2] * M_dphi[i_dof][q][d2];
+                            dphi_phys[i_dof][q][d1] = 0.0;
+
+                            // DIM 2
+                            for ( d2 = 0; d2 < 3 ; d2++ )
+                            {
+                                dphi_phys[i_dof][q][d1] += M_invJacobian[i_elem][d1][d2] * M_dphi[i_dof][q][d2];
+                            }
                         }
                     }
                 }
-            }
 
-            // DOF - test
-            for ( i_test = 0; i_test <  ndof; i_test++ )
-            {
-                M_rows[i_elem][i_test] = M_elements[i_elem][i_test];
-
-                // DOF - trial
-                for ( i_trial = 0; i_trial <  ndof; i_trial++ )
+                // DOF - test
+                for ( i_test = 0; i_test <  ndof; i_test++ )
                 {
-                    M_cols[i_elem][i_trial] = M_elements[i_elem][i_trial];
+                    M_rows[i_slot][i_test] = M_elements[i_elem][i_test];
 
-                    integral = 0.0;
-                    // QUAD
-                    for ( q = 0; q < NumQuadPoints ; q++ )
+                    // DOF - trial
+                    for ( i_trial = 0; i_trial <  ndof; i_trial++ )
                     {
-                        // DIM 1
-                        for ( d1 = 0; d1 < 3 ; d1++ )
+                        M_cols[i_slot][i_trial] = M_elements[i_elem][i_trial];
+
+                        integral = 0.0;
+                        // QUAD
+                        for ( q = 0; q < NumQuadPoints ; q++ )
                         {
-                            integral += dphi_phys[i_test][q][d1] * dphi_phys[i_trial][q][d1]*w_quad[q];
+                            // DIM 1
+                            for ( d1 = 0; d1 < 3 ; d1++ )
+                            {
+                                integral += dphi_phys[i_test][q][d1] * dphi_phys[i_trial][q][d1]*w_quad[q];
+                            }
                         }
+                        M_vals[i_slot][i_test][i_trial] = integral * M_detJacobian[i_elem];
                     }
-                    M_vals[i_elem][i_test][i_trial] = integral * M_detJacobian[i_elem];
                 }
             }
-        }
-    }
 
-    for ( int k = 0; k < M_numElements; ++k )
-    {
-    	matrix->matrixPtr()->InsertGlobalValues ( ndof, M_rows[k], ndof, M_cols[k], M_vals[k], Epetra_FECrsMatrix::ROW_MAJOR);
+            #pragma omp single
+            insertChunk ( *matrix, i_chunk, i_chunkEnd, 1 );
+        }
     }
-
 }
 //=========================================================================
 void
@@ -597,81 +704,72 @@ FastAssembler::assembleGradGrad_vectorial( matrixPtr_Type& matrix )
 
     #pragma omp parallel firstprivate( w_quad, ndof, NumQuadPoints)
     {
-        int i_el, i_elem, i_dof, q, d1, d2, i_test, i_trial;
+        int i_el, i_elem, i_slot, i_chunk, i_chunkEnd, i_dof, q, d1, d2, i_test, i_trial;
         double integral;
 
         double dphi_phys[ndof][NumQuadPoints][3];
 
-        // ELEMENTI
-        #pragma omp for
-        for ( i_el = 0; i_el <  M_numElements ; i_el++ )
+        // CHUNKS of elements (a single chunk if no chunk size is set)
+        for ( i_chunk = 0; i_chunk < M_numElements; i_chunk += M_bufferSize )
         {
-        	i_elem = i_el;
+            i_chunkEnd = std::min ( i_chunk + M_bufferSize, M_numElements );
 
-            // DOF
-            for ( i_dof = 0; i_dof <  ndof; i_dof++ )
+            // ELEMENTI
+            #pragma omp for
+            for ( i_el = i_chunk; i_el < i_chunkEnd; i_el++ )
             {
-                // QUAD
-                for (  q = 0; q < NumQuadPoints ; q++ )
+            	i_elem = i_el;
+            	i_slot = i_el - i_chunk;
+
+                // DOF
+                for ( i_dof = 0; i_dof <  ndof; i_dof++ )
                 {
-                    // DIM 1
-                    for ( d1 = 0; d1 < 3 ; d1++ )
+                    // QUAD
+                    for (  q = 0; q < NumQuadPoints ; q++ )
                     {
-                        dphi_phys[i_dof][q][d1] = 0.0;
-
-                        // DIM 2
-                        for ( d2 = 0; d2 < 3 ; d2++ )
+                        // DIM 1
+                        for ( d1 = 0; d1 < 3 ; d1++ )
                         {
-                            dphi_phys[i_dof][q][d1] += M_invJacobian[i_elem][d1][d2] * M_dphi[i_dof][q][d2];
+                            dphi_phys[i_dof][q][d1] = 0.0;
+
+                            // DIM 2
+                            for ( d2 = 0; d2 < 3 ; d2++ )
+                            {
+                                dphi_phys[i_dof][q][d1] += M_invJacobian[i_elem][d1][d2] * M_dphi[i_dof][q][d2];
+                            }
                         }
                     }
                 }
-            }
-
-            // DOF - test
-            for ( i_test = 0; i_test <  ndof; i_test++ )
-            {
-                M_rows[i_elem][i_test] = M_elements[i_elem][i_test];
 
-                // DOF - trial
-                for ( i_trial = 0; i_trial <  ndof; i_trial++ )
+                // DOF - test
+                for ( i_test = 0; i_test <  ndof; i_test++ )
                 {
-                    M_cols[i_elem][i_trial] = M_elements[i_elem][i_trial];
+                    M_rows[i_slot][i_test] = M_elements[i_elem][i_test];
 
-                    integral = 0.0;
-                    // QUAD
-                    for ( q = 0; q < NumQuadPoints ; q++ )
+                    // DOF - trial
+                    for ( i_trial = 0; i_trial <  ndof; i_trial++ )
                     {
-                        // DIM 1
-                        for ( d1 = 0; d1 < 3 ; d1++ )
+                        M_cols[i_slot][i_trial] = M_elements[i_elem][i_trial];
+
+                        integral = 0.0;
+                        // QUAD
+                        for ( q = 0; q < NumQuadPoints ; q++ )
                         {
-                            integral += dphi_phys[i_test][q][d1] * dphi_phys[i_trial][q][d1]*w_quad[q];
+                            // DIM 1
+                            for ( d1 = 0; d1 < 3 ; d1++ )
+                            {
+                                integral += dphi_phys[i_test][q][d1] * dphi_phys[i_trial][q][d1]*w_quad[q];
+                            }
                         }
+                        M_vals[i_slot][i_test][i_trial] = integral * M_detJacobian[i_elem];
                     }
-                    M_vals[i_elem][i_test][i_trial] = integral * M_detJacobian[i_elem];
                 }
             }
-        }
-    }
-
-    for ( int k = 0; k < M_numElements; ++k )
-    {
-    	matrix->matrixPtr()->InsertGlobalValues ( ndof, M_rows[k], ndof, M_cols[k], M_vals[k], Epetra_FECrsMatrix::ROW_MAJOR);
-    }
 
-    for ( UInt d1 = 1; d1 < 3 ; d1++ )
-    {
-    	for ( int k = 0; k < M_numElements; ++k )
-    	{
-    		for ( UInt i = 0; i <  ndof; i++ )
-    		{
-    			M_rows[k][i] += M_numScalarDofs;
-    			M_cols[k][i] += M_numScalarDofs;
-    		}
-    		matrix->matrixPtr()->InsertGlobalValues ( ndof, M_rows[k], ndof, M_cols[k], M_vals[k], Epetra_FECrsMatrix::ROW_MAJOR);
-    	}
+            #pragma omp single
+            insertChunk ( *matrix, i_chunk, i_chunkEnd, 3 );
+        }
     }
-
 }
 //=========================================================================
 void
@@ -688,55 +786,47 @@ FastAssembler::assembleMass_vectorial( matrixPtr_Type& matrix )
 
     #pragma omp parallel firstprivate( w_quad, ndof, NumQuadPoints)
     {
-        int i_el, i_elem, i_dof, q, d1, d2, i_test, i_trial;
+        int i_el, i_elem, i_slot, i_chunk, i_chunkEnd, i_dof, q, d1, d2, i_test, i_trial;
         double integral;
 
         double dphi_phys[ndof][NumQuadPoints][3];
 
-        // ELEMENTI
-        #pragma omp for
-        for ( i_el = 0; i_el <  M_numElements ; i_el++ )
+        // CHUNKS of elements (a single chunk if no chunk size is set)
+        for ( i_chunk = 0; i_chunk < M_numElements; i_chunk += M_bufferSize )
         {
-        	i_elem = i_el;
+            i_chunkEnd = std::min ( i_chunk + M_bufferSize, M_numElements );
 
-            // DOF - test
-            for ( i_test = 0; i_test <  ndof; i_test++ )
+            // ELEMENTI
+            #pragma omp for
+            for ( i_el = i_chunk; i_el < i_chunkEnd; i_el++ )
             {
-                M_rows[i_elem][i_test] = M_elements[i_elem][i_test];
+            	i_elem = i_el;
+            	i_slot = i_el - i_chunk;
 
-                // DOF - trial
-                for ( i_trial = 0; i_trial <  ndof; i_trial++ )
+                // DOF - test
+                for ( i_test = 0; i_test <  ndof; i_test++ )
                 {
-                    M_cols[i_elem][i_trial] = M_elements[i_elem][i_trial];
+                    M_rows[i_slot][i_test] = M_elements[i_elem][i_test];
 
-                    integral = 0.0;
-                    // QUAD
-                    for ( q = 0; q < NumQuadPoints ; q++ )
+                    // DOF - trial
+                    for ( i_trial = 0; i_trial <  ndof; i_trial++ )
                     {
-                    	integral += M_phi[i_test][q] * M_phi[i_trial][q]*w_quad[q];
+                        M_cols[i_slot][i_trial] = M_elements[i_elem][i_trial];
+
+                        integral = 0.0;
+                        // QUAD
+                        for ( q = 0; q < NumQuadPoints ; q++ )
+                        {
+                        	integral += M_phi[i_test][q] * M_phi[i_trial][q]*w_quad[q];
+                        }
+                        M_vals[i_slot][i_test][i_trial] = integral * M_detJacobian[i_elem];
                     }
-                    M_vals[i_elem][i_test][i_trial] = integral * M_detJacobian[i_elem];
                 }
             }
-        }
-    }
 
-    for ( int k = 0; k < M_numElements; ++k )
-    {
-    	matrix->matrixPtr()->InsertGlobalValues ( ndof, M_rows[k], ndof, M_cols[k], M_vals[k], Epetra_FECrsMatrix::ROW_MAJOR);
-    }
-
-    for ( UInt d1 = 1; d1 < 3 ; d1++ )
-    {
-    	for ( int k = 0; k < M_numElements; ++k )
-    	{
-    		for ( UInt i = 0; i <  ndof; i++ )
-    		{
-    			M_rows[k][i] += M_numScalarDofs;
-    			M_cols[k][i] += M_numScalarDofs;
-    		}
-    		matrix->matrixPtr()->InsertGlobalValues ( ndof, M_rows[k], ndof, M_cols[k], M_vals[k], Epetra_FECrsMatrix::ROW_MAJOR);
-    	}
+            #pragma omp single
+            insertChunk ( *matrix, i_chunk, i_chunkEnd, 3 );
+        }
     }
 }
 //=========================================================================
@@ -754,44 +844,48 @@ FastAssembler::assembleMass_scalar( matrixPtr_Type& matrix )
 
     #pragma omp parallel firstprivate( w_quad, ndof, NumQuadPoints)
     {
-        int i_el, i_elem, i_dof, q, d1, d2, i_test, i_trial;
+        int i_el, i_elem, i_slot, i_chunk, i_chunkEnd, i_dof, q, d1, d2, i_test, i_trial;
         double integral;
 
         double dphi_phys[ndof][NumQuadPoints][3];
 
-        // ELEMENTI
-        #pragma omp for
-        for ( i_el = 0; i_el <  M_numElements ; i_el++ )
+        // CHUNKS of elements (a single chunk if no chunk size is set)
+        for ( i_chunk = 0; i_chunk < M_numElements; i_chunk += M_bufferSize )
         {
-        	i_elem = i_el;
+            i_chunkEnd = std::min ( i_chunk + M_bufferSize, M_numElements );
 
-            // DOF - test
-            for ( i_test = 0; i_test <  ndof; i_test++ )
+            // ELEMENTI
+            #pragma omp for
+            for ( i_el = i_chunk; i_el < i_chunkEnd; i_el++ )
             {
-                M_rows[i_elem][i_test] = M_elements[i_elem][i_test];
+            	i_elem = i_el;
+            	i_slot = i_el - i_chunk;
 
-                // DOF - trial
-                for ( i_trial = 0; i_trial <  ndof; i_trial++ )
+                // DOF - test
+                for ( i_test = 0; i_test <  ndof; i_test++ )
                 {
-                    M_cols[i_elem][i_trial] = M_elements[i_elem][i_trial];
+                    M_rows[i_slot][i_test] = M_elements[i_elem][i_test];
 
-                    integral = 0.0;
-                    // QUAD
-                    for ( q = 0; q < NumQuadPoints ; q++ )
+                    // DOF - trial
+                    for ( i_trial = 0; i_trial <  ndof; i_trial++ )
                     {
-                    	integral += M_phi[i_test][q] * M_phi[i_trial][q]*w_quad[q];
+                        M_cols[i_slot][i_trial] = M_elements[i_elem][i_trial];
+
+                        integral = 0.0;
+                        // QUAD
+                        for ( q = 0; q < NumQuadPoints ; q++ )
+                        {
+                        	integral += M_phi[i_test][q] * M_phi[i_trial][q]*w_quad[q];
+                        }
+                        M_vals[i_slot][i_test][i_trial] = integral * M_detJacobian[i_elem];
                     }
-                    M_vals[i_elem][i_test][i_trial] = integral * M_detJacobian[i_elem];
                 }
             }
-        }
-    }
 
-    for ( int k = 0; k < M_numElements; ++k )
-    {
-    	matrix->matrixPtr()->InsertGlobalValues ( ndof, M_rows[k], ndof, M_cols[k], M_vals[k], Epetra_FECrsMatrix::ROW_MAJOR);
+            #pragma omp single
+            insertChunk ( *matrix, i_chunk, i_chunkEnd, 1 );
+        }
     }
-
 }
 //=========================================================================
 void
@@ -815,94 +909,88 @@ FastAssembler::assembleConvective( matrix_Type& matrix, const vector_Type& u_h )
 
     #pragma omp parallel firstprivate( w_quad, ndof, NumQuadPoints)
     {
-        int i_elem, i_dof, q, d1, d2, i_test, i_trial, e_idof;
+        int i_el, i_elem, i_slot, i_chunk, i_chunkEnd, i_dof, q, d1, d2, i_test, i_trial, e_idof;
         double integral;
 
         double dphi_phys[ndof][NumQuadPoints][3];
 
         double uhq[3][NumQuadPoints];
 
-        // ELEMENTI,
-        #pragma omp for
-        for ( i_elem = 0; i_elem <  M_numElements; i_elem++ )
+        // CHUNKS of elements (a single chunk if no chunk size is set)
+        for ( i_chunk = 0; i_chunk < M_numElements; i_chunk += M_bufferSize )
         {
-            // DOF
-            for ( i_dof = 0; i_dof <  ndof; i_dof++ )
+            i_chunkEnd = std::min ( i_chunk + M_bufferSize, M_numElements );
+
+            // ELEMENTI,
+            #pragma omp for
+            for ( i_el = i_chunk; i_el < i_chunkEnd; i_el++ )
             {
-                // QUAD
-                for (  q = 0; q < NumQuadPoints ; q++ )
+                i_elem = i_el;
+                i_slot = i_el - i_chunk;
+
+                // DOF
+                for ( i_dof = 0; i_dof <  ndof; i_dof++ )
                 {
-                    // DIM 1
-                    for ( d1 = 0; d1 < 3 ; d1++ )
+                    // QUAD
+                    for (  q = 0; q < NumQuadPoints ; q++ )
                     {
-                        dphi_phys[i_dof][q][d1] = 0.0;
-
-                        // DIM 2
-                        for ( d2 = 0; d2 < 3 ; d2++ )
+                        // DIM 1
+                        for ( d1 = 0; d1 < 3 ; d1++ )
                         {
-                            dphi_phys[i_dof][q][d1] += M_invJacobian[i_elem][d1][d2] * M_dphi[i_dof][q][d2];
+                            dphi_phys[i_dof][q][d1] = 0.0;
+
+                            // DIM 2
+                            for ( d2 = 0; d2 < 3 ; d2++ )
+                            {
+                                dphi_phys[i_dof][q][d1] += M_invJacobian[i_elem][d1][d2] * M_dphi[i_dof][q][d2];
+                            }
                         }
                     }
                 }
-            }
 
-            // QUAD
-            for (  q = 0; q < NumQuadPoints ; q++ )
-            {
-            	for ( d1 = 0; d1 < 3 ; d1++ )
-            	{
-            		uhq[d1][q] = 0.0;
-            		for ( i_dof = 0; i_dof <  ndof; i_dof++ )
-            		{
-            			e_idof =  M_elements[i_elem][i_dof] + d1*M_numScalarDofs  ;
-            			uhq[d1][q] += u_h[e_idof] * M_phi[i_dof][q];
-            			//printf("\n u_h[%d] = %f",  e_idof, u_h[e_idof]);
-            		}
-            	}
-            }
-
-            // DOF - test
-            for ( i_test = 0; i_test <  ndof; i_test++ )
-            {
-                M_rows[i_elem][i_test] = M_elements[i_elem][i_test];
+                // QUAD
+                for (  q = 0; q < NumQuadPoints ; q++ )
+                {
+                	for ( d1 = 0; d1 < 3 ; d1++ )
+                	{
+                		uhq[d1][q] = 0.0;
+                		for ( i_dof = 0; i_dof <  ndof; i_dof++ )
+                		{
+                			e_idof =  M_elements[i_elem][i_dof] + d1*M_numScalarDofs  ;
+                			uhq[d1][q] += u_h[e_idof] * M_phi[i_dof][q];
+                			//printf("\n u_h[%d] = %f",  e_idof, u_h[e_idof]);
+                		}
+                	}
+                }
 
-                // DOF - trial
-                for ( i_trial = 0; i_trial <  ndof; i_trial++ )
+                // DOF - test
+                for ( i_test = 0; i_test <  ndof; i_test++ )
                 {
-                    M_cols[i_elem][i_trial] = M_elements[i_elem][i_trial];
+                    M_rows[i_slot][i_test] = M_elements[i_elem][i_test];
 
-                    integral = 0.0;
-                    // QUAD
-                    for ( q = 0; q < NumQuadPoints ; q++ )
+                    // DOF - trial
+                    for ( i_trial = 0; i_trial <  ndof; i_trial++ )
                     {
-                        // DIM 1
-                        for ( d1 = 0; d1 < 3 ; d1++ )
+                        M_cols[i_slot][i_trial] = M_elements[i_elem][i_trial];
+
+                        integral = 0.0;
+                        // QUAD
+                        for ( q = 0; q < NumQuadPoints ; q++ )
                         {
-                            integral += uhq[d1][q] * dphi_phys[i_trial][q][d1] * M_phi[i_test][q] * w_quad[q];
+                            // DIM 1
+                            for ( d1 = 0; d1 < 3 ; d1++ )
+                            {
+                                integral += uhq[d1][q] * dphi_phys[i_trial][q][d1] * M_phi[i_test][q] * w_quad[q];
+                            }
                         }
+                        M_vals[i_slot][i_test][i_trial] = integral *  M_detJacobian[i_elem];
                     }
-                    M_vals[i_elem][i_test][i_trial] = integral *  M_detJacobian[i_elem];
                 }
             }
-        }
-    }
-
-    for ( int k = 0; k < M_numElements; ++k )
-    {
-    	matrix.matrixPtr()->InsertGlobalValues ( ndof, M_rows[k], ndof, M_cols[k], M_vals[k], Epetra_FECrsMatrix::ROW_MAJOR);
-    }
 
-    for ( UInt d1 = 1; d1 < 3 ; d1++ )
-    {
-    	for ( int k = 0; k < M_numElements; ++k )
-    	{
-    		for ( UInt i = 0; i <  ndof; i++ )
-    		{
-    			M_rows[k][i] += M_numScalarDofs;
-    			M_cols[k][i] += M_numScalarDofs;
-    		}
-    		matrix.matrixPtr()->InsertGlobalValues ( ndof, M_rows[k], ndof, M_cols[k], M_vals[k], Epetra_FECrsMatrix::ROW_MAJOR);
-    	}
+            #pragma omp single
+            insertChunk ( matrix, i_chunk, i_chunkEnd, 3 );
+        }
     }
 }
 //=========================================================================
@@ -922,79 +1010,71 @@ FastAssembler::NS_constant_terms_00( matrixPtr_Type& matrix )
 
 	#pragma omp parallel firstprivate( w_quad, ndof, NumQuadPoints)
 	{
-		int i_el, i_elem, i_dof, q, d1, d2, i_test, i_trial;
+		int i_el, i_elem, i_slot, i_chunk, i_chunkEnd, i_dof, q, d1, d2, i_test, i_trial;
 		double integral;
 
 		double dphi_phys[ndof][NumQuadPoints][3];
 
-		// ELEMENTI
-		#pragma omp for
-		for ( i_el = 0; i_el <  M_numElements ; i_el++ )
+		// CHUNKS of elements (a single chunk if no chunk size is set)
+		for ( i_chunk = 0; i_chunk < M_numElements; i_chunk += M_bufferSize )
 		{
-			i_elem = i_el;
+			i_chunkEnd = std::min ( i_chunk + M_bufferSize, M_numElements );
 
-			// DOF
-			for ( i_dof = 0; i_dof <  ndof; i_dof++ )
+			// ELEMENTI
+			#pragma omp for
+			for ( i_el = i_chunk; i_el < i_chunkEnd; i_el++ )
 			{
-				// QUAD
-				for (  q = 0; q < NumQuadPoints ; q++ )
+				i_elem = i_el;
+				i_slot = i_el - i_chunk;
+
+				// DOF
+				for ( i_dof = 0; i_dof <  ndof; i_dof++ )
 				{
-					// DIM 1
-					for ( d1 = 0; d1 < 3 ; d1++ )
+					// QUAD
+					for (  q = 0; q < NumQuadPoints ; q++ )
 					{
-						dphi_phys[i_dof][q][d1] = 0.0;
-
-						// DIM 2
-						for ( d2 = 0; d2 < 3 ; d2++ )
+						// DIM 1
+						for ( d1 = 0; d1 < 3 ; d1++ )
 						{
-							dphi_phys[i_dof][q][d1] += M_invJacobian[i_elem][d1][d2] * M_dphi[i_dof][q][d2];
+							dphi_phys[i_dof][q][d1] = 0.0;
+
+							// DIM 2
+							for ( d2 = 0; d2 < 3 ; d2++ )
+							{
+								dphi_phys[i_dof][q][d1] += M_invJacobian[i_elem][d1][d2] * M_dphi[i_dof][q][d2];
+							}
 						}
 					}
 				}
-			}
-
-			// DOF - test
-			for ( i_test = 0; i_test <  ndof; i_test++ )
-			{
-				M_rows[i_elem][i_test] = M_elements[i_elem][i_test];
 
-				// DOF - trial
-				for ( i_trial = 0; i_trial <  ndof; i_trial++ )
+				// DOF - test
+				for ( i_test = 0; i_test <  ndof; i_test++ )
 				{
-					M_cols[i_elem][i_trial] = M_elements[i_elem][i_trial];
+					M_rows[i_slot][i_test] = M_elements[i_elem][i_test];
 
-					integral = 0.0;
-					// QUAD
-					for ( q = 0; q < NumQuadPoints ; q++ )
+					// DOF - trial
+					for ( i_trial = 0; i_trial <  ndof; i_trial++ )
 					{
-						integral += M_phi[i_test][q] * M_phi[i_trial][q]*w_quad[q]; // MASS
-						// DIM 1
-						for ( d1 = 0; d1 < 3 ; d1++ )
+						M_cols[i_slot][i_trial] = M_elements[i_elem][i_trial];
+
+						integral = 0.0;
+						// QUAD
+						for ( q = 0; q < NumQuadPoints ; q++ )
 						{
-							integral += dphi_phys[i_test][q][d1] * dphi_phys[i_trial][q][d1]*w_quad[q]; // STIFFNESS
+							integral += M_phi[i_test][q] * M_phi[i_trial][q]*w_quad[q]; // MASS
+							// DIM 1
+							for ( d1 = 0; d1 < 3 ; d1++ )
+							{
+								integral += dphi_phys[i_test][q][d1] * dphi_phys[i_trial][q][d1]*w_quad[q]; // STIFFNESS
+							}
 						}
+						M_vals[i_slot][i_test][i_trial] = integral * M_detJacobian[i_elem];
 					}
-					M_vals[i_elem][i_test][i_trial] = integral * M_detJacobian[i_elem];
 				}
 			}
-		}
-	}
-
-	for ( int k = 0; k < M_numElements; ++k )
-	{
-		matrix->matrixPtr()->InsertGlobalValues ( ndof, M_rows[k], ndof, M_cols[k], M_vals[k], Epetra_FECrsMatrix::ROW_MAJOR);
-	}
 
-	for ( UInt d1 = 1; d1 < 3 ; d1++ )
-	{
-		for ( int k = 0; k < M_numElements; ++k )
-		{
-			for ( UInt i = 0; i <  ndof; i++ )
-			{
-				M_rows[k][i] += M_numScalarDofs;
-				M_cols[k][i] += M_numScalarDofs;
-			}
-			matrix->matrixPtr()->InsertGlobalValues ( ndof, M_rows[k], ndof, M_cols[k], M_vals[k], Epetra_FECrsMatrix::ROW_MAJOR);
+			#pragma omp single
+			insertChunk ( *matrix, i_chunk, i_chunkEnd, 3 );
 		}
 	}
 }
@@ -1014,138 +1094,142 @@ FastAssembler::assemble_SUPG_block00( matrixPtr_Type& matrix, const vector_Type&
 
 	#pragma omp parallel firstprivate( w_quad, ndof, NumQuadPoints)
 	{
-		int i_elem, i_dof, q, d1, d2, i_test, i_trial, e_idof;
+		int i_el, i_elem, i_slot, i_chunk, i_chunkEnd, i_dof, q, d1, d2, i_test, i_trial, e_idof;
 		double integral, integral_test, integral_trial;
 
 		double dphi_phys[ndof][NumQuadPoints][3];
 
 		double uhq[3][NumQuadPoints];
 
-		// ELEMENTI,
-		#pragma omp for
-		for ( i_elem = 0; i_elem <  M_numElements; i_elem++ )
+		// CHUNKS of elements (a single chunk if no chunk size is set)
+		for ( i_chunk = 0; i_chunk < M_numElements; i_chunk += M_bufferSize )
 		{
-			// DOF
-			for ( i_dof = 0; i_dof <  ndof; i_dof++ )
+			i_chunkEnd = std::min ( i_chunk + M_bufferSize, M_numElements );
+
+			// ELEMENTI,
+			#pragma omp for
+			for ( i_el = i_chunk; i_el < i_chunkEnd; i_el++ )
 			{
-				// QUAD
-				for (  q = 0; q < NumQuadPoints ; q++ )
+				i_elem = i_el;
+				i_slot = i_el - i_chunk;
+
+				// DOF
+				for ( i_dof = 0; i_dof <  ndof; i_dof++ )
 				{
-					// DIM 1
-					for ( d1 = 0; d1 < 3 ; d1++ )
+					// QUAD
+					for (  q = 0; q < NumQuadPoints ; q++ )
 					{
-						dphi_phys[i_dof][q][d1] = 0.0;
-
-						// DIM 2
-						for ( d2 = 0; d2 < 3 ; d2++ )
+						// DIM 1
+						for ( d1 = 0; d1 < 3 ; d1++ )
 						{
-							dphi_phys[i_dof][q][d1] += M_invJacobian[i_elem][d1][d2] * M_dphi[i_dof][q][d2];
+							dphi_phys[i_dof][q][d1] = 0.0;
+
+							// DIM 2
+							for ( d2 = 0; d2 < 3 ; d2++ )
+							{
+								dphi_phys[i_dof][q][d1] += M_invJacobian[i_elem][d1][d2] * M_dphi[i_dof][q][d2];
+							}
 						}
 					}
 				}
-			}
             
-			// QUAD
-			for (  q = 0; q < NumQuadPoints ; q++ )
-			{
-				for ( d1 = 0; d1 < 3 ; d1++ )
+				// QUAD
+				for (  q = 0; q < NumQuadPoints ; q++ )
 				{
-					uhq[d1][q] = 0.0;
-					for ( i_dof = 0; i_dof <  ndof; i_dof++ )
+					for ( d1 = 0; d1 < 3 ; d1++ )
 					{
-						e_idof =  M_elements[i_elem][i_dof] + d1*M_numScalarDofs  ;
-						uhq[d1][q] += u_h[e_idof] * M_phi[i_dof][q];
+						uhq[d1][q] = 0.0;
+						for ( i_dof = 0; i_dof <  ndof; i_dof++ )
+						{
+							e_idof =  M_elements[i_elem][i_dof] + d1*M_numScalarDofs  ;
+							uhq[d1][q] += u_h[e_idof] * M_phi[i_dof][q];
+						}
 					}
 				}
-			}
 
-			// STABILIZZAZIONE - coefficienti Tau_M e Tau_C
-			for (  q = 0; q < NumQuadPoints ; q++ )
-			{
-				M_Tau_M[i_elem][q] = 1.0/std::sqrt(
-				 M_density*M_density*M_orderBDF*M_orderBDF/(M_timestep*M_timestep) // TAU_M_DEN_DT
-				+M_density*M_density*( uhq[0][q]*( M_G[i_elem][0][0]* uhq[0][q] +  M_G[i_elem][0][1] * uhq[1][q] + M_G[i_elem][0][2] * uhq[2][q] ) +
-									   uhq[1][q]*( M_G[i_elem][1][0]* uhq[0][q] +  M_G[i_elem][1][1] * uhq[1][q] + M_G[i_elem][1][2] * uhq[2][q] ) +
-									   uhq[2][q]*( M_G[i_elem][2][0]* uhq[0][q] +  M_G[i_elem][2][1] * uhq[1][q] + M_G[i_elem][2][2] * uhq[2][q]   )
-									 ) 					// TAU_M_DEN_VEL
-				+M_C_I*M_viscosity*M_viscosity*(
-						M_G[i_elem][0][0]*M_G[i_elem][0][0] + M_G[i_elem][0][1]*M_G[i_elem][0][1] + M_G[i_elem][0][2]*M_G[i_elem][0][2] +
-						M_G[i_elem][1][0]*M_G[i_elem][1][0] + M_G[i_elem][1][1]*M_G[i_elem][1][1] + M_G[i_elem][1][2]*M_G[i_elem][1][2] +
-						M_G[i_elem][2][0]*M_G[i_elem][2][0] + M_G[i_elem][2][1]*M_G[i_elem][2][1] + M_G[i_elem][2][2]*M_G[i_elem][2][2]
-						                       ) 		// TAU_M_DEN_VISC*/
-						                       	  );
-
-				M_Tau_C[i_elem][q] = 1.0/( M_g[i_elem][0]*M_Tau_M[i_elem][q]*M_g[i_elem][0] +
-										   M_g[i_elem][1]*M_Tau_M[i_elem][q]*M_g[i_elem][1] +
-										   M_g[i_elem][2]*M_Tau_M[i_elem][q]*M_g[i_elem][2]
-						                 );
+				// STABILIZZAZIONE - coefficienti Tau_M e Tau_C
+				for (  q = 0; q < NumQuadPoints ; q++ )
+				{
+					M_Tau_M[i_slot][q] = 1.0/std::sqrt(
+					 M_density*M_density*M_orderBDF*M_orderBDF/(M_timestep*M_timestep) // TAU_M_DEN_DT
+					+M_density*M_density*( uhq[0][q]*( M_G[i_elem][0][0]* uhq[0][q] +  M_G[i_elem][0][1] * uhq[1][q] + M_G[i_elem][0][2] * uhq[2][q] ) +
+										   uhq[1][q]*( M_G[i_elem][1][0]* uhq[0][q] +  M_G[i_elem][1][1] * uhq[1][q] + M_G[i_elem][1][2] * uhq[2][q] ) +
+										   uhq[2][q]*( M_G[i_elem][2][0]* uhq[0][q] +  M_G[i_elem][2][1] * uhq[1][q] + M_G[i_elem][2][2] * uhq[2][q]   )
+										 ) 					// TAU_M_DEN_VEL
+					+M_C_I*M_viscosity*M_viscosity*(
+							M_G[i_elem][0][0]*M_G[i_elem][0][0] + M_G[i_elem][0][1]*M_G[i_elem][0][1] + M_G[i_elem][0][2]*M_G[i_elem][0][2] +
+							M_G[i_elem][1][0]*M_G[i_elem][1][0] + M_G[i_elem][1][1]*M_G[i_elem][1][1] + M_G[i_elem][1][2]*M_G[i_elem][1][2] +
+							M_G[i_elem][2][0]*M_G[i_elem][2][0] + M_G[i_elem][2][1]*M_G[i_elem][2][1] + M_G[i_elem][2][2]*M_G[i_elem][2][2]
+							                       ) 		// TAU_M_DEN_VISC*/
+							                       	  );
+
+					M_Tau_C[i_slot][q] = 1.0/( M_g[i_elem][0]*M_Tau_M[i_slot][q]*M_g[i_elem][0] +
+											   M_g[i_elem][1]*M_Tau_M[i_slot][q]*M_g[i_elem][1] +
+											   M_g[i_elem][2]*M_Tau_M[i_slot][q]*M_g[i_elem][2]
+							                 );
 
-			}
+				}
 
 
-			// DOF - test
-			for ( i_test = 0; i_test <  ndof; i_test++ )
-			{
-				M_rows[i_elem][i_test] = M_elements[i_elem][i_test];
-                
-				// DOF - trial
-				for ( i_trial = 0; i_trial <  ndof; i_trial++ )
+				// DOF - test
+				for ( i_test = 0; i_test <  ndof; i_test++ )
 				{
-					M_cols[i_elem][i_trial] = M_elements[i_elem][i_trial];
-
-					integral = 0.0;
-					// QUAD
-					for ( q = 0; q < NumQuadPoints ; q++ )
+					M_rows[i_slot][i_test] = M_elements[i_elem][i_test];
+                
+					// DOF - trial
+					for ( i_trial = 0; i_trial <  ndof; i_trial++ )
 					{
-						integral_test = 0;
-						integral_trial = 0;
+						M_cols[i_slot][i_trial] = M_elements[i_elem][i_trial];
 
-						// DIM 1
-						for ( d1 = 0; d1 < 3 ; d1++ )
+						integral = 0.0;
+						// QUAD
+						for ( q = 0; q < NumQuadPoints ; q++ )
 						{
-							integral_test += uhq[d1][q] * dphi_phys[i_test][q][d1];   // w grad(phi_i)
-							integral_trial += uhq[d1][q] * dphi_phys[i_trial][q][d1]; // w grad(phi_j) terzo indice dphi_phys e' derivata in x,y,z
+							integral_test = 0;
+							integral_trial = 0;
+
+							// DIM 1
+							for ( d1 = 0; d1 < 3 ; d1++ )
+							{
+								integral_test += uhq[d1][q] * dphi_phys[i_test][q][d1];   // w grad(phi_i)
+								integral_trial += uhq[d1][q] * dphi_phys[i_trial][q][d1]; // w grad(phi_j) terzo indice dphi_phys e' derivata in x,y,z
+							}
+							integral += M_Tau_M[i_slot][q] * (integral_test * integral_trial + integral_test * M_phi[i_trial][q] ) * w_quad[q];
+	                        // above, the term "integral_test * M_phi[i_trial][q]" is the one which comes from (w grad(phi_i), phi_j)
 						}
-						integral += M_Tau_M[i_elem][q] * (integral_test * integral_trial + integral_test * M_phi[i_trial][q] ) * w_quad[q];
-                        // above, the term "integral_test * M_phi[i_trial][q]" is the one which comes from (w grad(phi_i), phi_j)
-					}
-                    M_vals_supg[i_elem][0][0][i_test][i_trial] = integral *  M_detJacobian[i_elem]; // (w grad(phi_i), w grad(phi_j) )
-                    M_vals_supg[i_elem][1][1][i_test][i_trial] = integral *  M_detJacobian[i_elem];
-                    M_vals_supg[i_elem][2][2][i_test][i_trial] = integral *  M_detJacobian[i_elem];
+	                    M_vals_supg[i_slot][0][0][i_test][i_trial] = integral *  M_detJacobian[i_elem]; // (w grad(phi_i), w grad(phi_j) )
+	                    M_vals_supg[i_slot][1][1][i_test][i_trial] = integral *  M_detJacobian[i_elem];
+	                    M_vals_supg[i_slot][2][2][i_test][i_trial] = integral *  M_detJacobian[i_elem];
 
-					for ( d1 = 0; d1 < 3; d1++ )
-					{
-						for ( d2 = 0; d2 < 3; d2++ )
+						for ( d1 = 0; d1 < 3; d1++ )
 						{
-							integral = 0.0;
-							// QUAD
-							for ( q = 0; q < NumQuadPoints ; q++ )
+							for ( d2 = 0; d2 < 3; d2++ )
 							{
-								integral += M_Tau_C[i_elem][q] * dphi_phys[i_test][q][d1] * dphi_phys[i_trial][q][d2] * w_quad[q]; // div(phi_i) * div(phi_j)
+								integral = 0.0;
+								// QUAD
+								for ( q = 0; q < NumQuadPoints ; q++ )
+								{
+									integral += M_Tau_C[i_slot][q] * dphi_phys[i_test][q][d1] * dphi_phys[i_trial][q][d2] * w_quad[q]; // div(phi_i) * div(phi_j)
+								}
+	                            // The diagonal blocks already contain the terms above, the other ones are reset (the buffers are reused)
+	                            if ( d1 == d2 )
+	                            {
+	                                M_vals_supg[i_slot][d1][d2][i_test][i_trial] += integral *  M_detJacobian[i_elem];
+	                            }
+	                            else
+	                            {
+	                                M_vals_supg[i_slot][d1][d2][i_test][i_trial] = integral *  M_detJacobian[i_elem];
+	                            }
 							}
-                            M_vals_supg[i_elem][d1][d2][i_test][i_trial] += integral *  M_detJacobian[i_elem];
 						}
-					}
 
+					}
 				}
 			}
-		}
-	}
 
-    for ( UInt d1 = 0; d1 < 3 ; d1++ ) // row index
-	{
-		for ( UInt d2 = 0; d2 < 3 ; d2++ ) // column
-		{
-			for ( int k = 0; k < M_numElements; ++k )
-			{
-				for ( UInt i = 0; i <  ndof; i++ )
-				{
-					M_rows_tmp[k][i] = M_rows[k][i] + d1 * M_numScalarDofs;
-					M_cols_tmp[k][i] = M_cols[k][i] + d2 * M_numScalarDofs;
-				}
-				matrix->matrixPtr()->InsertGlobalValues ( ndof, M_rows_tmp[k], ndof, M_cols_tmp[k], M_vals_supg[k][d1][d2], Epetra_FECrsMatrix::ROW_MAJOR);
-			}
-        }
+			#pragma omp single
+			insertChunk_SUPG ( *matrix, i_chunk, i_chunkEnd );
+		}
 	}
 }
 //=========================================================================
@@ -1163,99 +1247,104 @@ FastAssembler::assemble_SUPG_block11( matrixPtr_Type& matrix, const vector_Type&
 
 	#pragma omp parallel firstprivate( w_quad, ndof, NumQuadPoints)
 	{
-		int i_el, i_elem, i_dof, q, d1, d2, i_test, i_trial, e_idof;
+		int i_el, i_elem, i_slot, i_chunk, i_chunkEnd, i_dof, q, d1, d2, i_test, i_trial, e_idof;
 		double integral;
 
 		double dphi_phys[ndof][NumQuadPoints][3];
 
 		double uhq[3][NumQuadPoints];
 
-		// ELEMENTI
-		#pragma omp for
-		for ( i_el = 0; i_el <  M_numElements ; i_el++ )
+		// CHUNKS of elements (a single chunk if no chunk size is set)
+		for ( i_chunk = 0; i_chunk < M_numElements; i_chunk += M_bufferSize )
 		{
-			i_elem = i_el;
+			i_chunkEnd = std::min ( i_chunk + M_bufferSize, M_numElements );
 
-			// DOF
-			for ( i_dof = 0; i_dof <  ndof; i_dof++ )
+			// ELEMENTI
+			#pragma omp for
+			for ( i_el = i_chunk; i_el < i_chunkEnd; i_el++ )
 			{
-				// QUAD
-				for (  q = 0; q < NumQuadPoints ; q++ )
+				i_elem = i_el;
+				i_slot = i_el - i_chunk;
+
+				// DOF
+				for ( i_dof = 0; i_dof <  ndof; i_dof++ )
 				{
-					// DIM 1
-					for ( d1 = 0; d1 < 3 ; d1++ )
+					// QUAD
+					for (  q = 0; q < NumQuadPoints ; q++ )
 					{
-						dphi_phys[i_dof][q][d1] = 0.0;
-
-						// DIM 2
-						for ( d2 = 0; d2 < 3 ; d2++ )
+						// DIM 1
+						for ( d1 = 0; d1 < 3 ; d1++ )
 						{
-							dphi_phys[i_dof][q][d1] += M_invJacobian[i_elem][d1][d2] * M_dphi[i_dof][q][d2];
+							dphi_phys[i_dof][q][d1] = 0.0;
+
+							// DIM 2
+							for ( d2 = 0; d2 < 3 ; d2++ )
+							{
+								dphi_phys[i_dof][q][d1] += M_invJacobian[i_elem][d1][d2] * M_dphi[i_dof][q][d2];
+							}
 						}
 					}
 				}
-			}
 
-			// QUAD
-			for (  q = 0; q < NumQuadPoints ; q++ )
-			{
-				for ( d1 = 0; d1 < 3 ; d1++ )
+				// QUAD
+				for (  q = 0; q < NumQuadPoints ; q++ )
 				{
-					uhq[d1][q] = 0.0;
-					for ( i_dof = 0; i_dof <  ndof; i_dof++ )
+					for ( d1 = 0; d1 < 3 ; d1++ )
 					{
-						e_idof =  M_elements[i_elem][i_dof] + d1*M_numScalarDofs  ;
-						uhq[d1][q] += u_h[e_idof] * M_phi[i_dof][q];
+						uhq[d1][q] = 0.0;
+						for ( i_dof = 0; i_dof <  ndof; i_dof++ )
+						{
+							e_idof =  M_elements[i_elem][i_dof] + d1*M_numScalarDofs  ;
+							uhq[d1][q] += u_h[e_idof] * M_phi[i_dof][q];
+						}
 					}
 				}
-			}
 
-			// STABILIZZAZIONE - coefficienti Tau_M e Tau_C
-			for (  q = 0; q < NumQuadPoints ; q++ )
-			{
-				M_Tau_M[i_elem][q] = 1.0/std::sqrt(
-						M_density*M_density*M_orderBDF*M_orderBDF/(M_timestep*M_timestep) // TAU_M_DEN_DT
-						+M_density*M_density*( uhq[0][q]*( M_G[i_elem][0][0]* uhq[0][q] +  M_G[i_elem][0][1] * uhq[1][q] + M_G[i_elem][0][2] * uhq[2][q] ) +
-								uhq[1][q]*( M_G[i_elem][1][0]* uhq[0][q] +  M_G[i_elem][1][1] * uhq[1][q] + M_G[i_elem][1][2] * uhq[2][q] ) +
-								uhq[2][q]*( M_G[i_elem][2][0]* uhq[0][q] +  M_G[i_elem][2][1] * uhq[1][q] + M_G[i_elem][2][2] * uhq[2][q]   )
-						) 					// TAU_M_DEN_VEL
-						+M_C_I*M_viscosity*M_viscosity*(
-								M_G[i_elem][0][0]*M_G[i_elem][0][0] + M_G[i_elem][0][1]*M_G[i_elem][0][1] + M_G[i_elem][0][2]*M_G[i_elem][0][2] +
-								M_G[i_elem][1][0]*M_G[i_elem][1][0] + M_G[i_elem][1][1]*M_G[i_elem][1][1] + M_G[i_elem][1][2]*M_G[i_elem][1][2] +
-								M_G[i_elem][2][0]*M_G[i_elem][2][0] + M_G[i_elem][2][1]*M_G[i_elem][2][1] + M_G[i_elem][2][2]*M_G[i_elem][2][2]
-						) 		// TAU_M_DEN_VISC*/
-				);
-			}
-
-			// DOF - test
-			for ( i_test = 0; i_test <  ndof; i_test++ )
-			{
-				M_rows[i_elem][i_test] = M_elements[i_elem][i_test];
+				// STABILIZZAZIONE - coefficienti Tau_M e Tau_C
+				for (  q = 0; q < NumQuadPoints ; q++ )
+				{
+					M_Tau_M[i_slot][q] = 1.0/std::sqrt(
+							M_density*M_density*M_orderBDF*M_orderBDF/(M_timestep*M_timestep) // TAU_M_DEN_DT
+							+M_density*M_density*( uhq[0][q]*( M_G[i_elem][0][0]* uhq[0][q] +  M_G[i_elem][0][1] * uhq[1][q] + M_G[i_elem][0][2] * uhq[2][q] ) +
+									uhq[1][q]*( M_G[i_elem][1][0]* uhq[0][q] +  M_G[i_elem][1][1] * uhq[1][q] + M_G[i_elem][1][2] * uhq[2][q] ) +
+									uhq[2][q]*( M_G[i_elem][2][0]* uhq[0][q] +  M_G[i_elem][2][1] * uhq[1][q] + M_G[i_elem][2][2] * uhq[2][q]   )
+							) 					// TAU_M_DEN_VEL
+							+M_C_I*M_viscosity*M_viscosity*(
+									M_G[i_elem][0][0]*M_G[i_elem][0][0] + M_G[i_elem][0][1]*M_G[i_elem][0][1] + M_G[i_elem][0][2]*M_G[i_elem][0][2] +
+									M_G[i_elem][1][0]*M_G[i_elem][1][0] + M_G[i_elem][1][1]*M_G[i_elem][1][1] + M_G[i_elem][1][2]*M_G[i_elem][1][2] +
+									M_G[i_elem][2][0]*M_G[i_elem][2][0] + M_G[i_elem][2][1]*M_G[i_elem][2][1] + M_G[i_elem][2][2]*M_G[i_elem][2][2]
+							) 		// TAU_M_DEN_VISC*/
+					);
+				}
 
-				// DOF - trial
-				for ( i_trial = 0; i_trial <  ndof; i_trial++ )
+				// DOF - test
+				for ( i_test = 0; i_test <  ndof; i_test++ )
 				{
-					M_cols[i_elem][i_trial] = M_elements[i_elem][i_trial];
+					M_rows[i_slot][i_test] = M_elements[i_elem][i_test];
 
-					integral = 0.0;
-					// QUAD
-					for ( q = 0; q < NumQuadPoints ; q++ )
+					// DOF - trial
+					for ( i_trial = 0; i_trial <  ndof; i_trial++ )
 					{
-						// DIM 1
-						for ( d1 = 0; d1 < 3 ; d1++ )
+						M_cols[i_slot][i_trial] = M_elements[i_elem][i_trial];
+
+						integral = 0.0;
+						// QUAD
+						for ( q = 0; q < NumQuadPoints ; q++ )
 						{
-							integral += M_Tau_M[i_elem][q] * dphi_phys[i_test][q][d1] * dphi_phys[i_trial][q][d1]*w_quad[q];
+							// DIM 1
+							for ( d1 = 0; d1 < 3 ; d1++ )
+							{
+								integral += M_Tau_M[i_slot][q] * dphi_phys[i_test][q][d1] * dphi_phys[i_trial][q][d1]*w_quad[q];
+							}
 						}
+						M_vals[i_slot][i_test][i_trial] = integral * M_detJacobian[i_elem];
 					}
-					M_vals[i_elem][i_test][i_trial] = integral * M_detJacobian[i_elem];
 				}
 			}
-		}
-	}
 
-	for ( int k = 0; k < M_numElements; ++k )
-	{
-		matrix->matrixPtr()->InsertGlobalValues ( ndof, M_rows[k], ndof, M_cols[k], M_vals[k], Epetra_FECrsMatrix::ROW_MAJOR);
+			#pragma omp single
+			insertChunk ( *matrix, i_chunk, i_chunkEnd, 1 );
+		}
 	}
 }
 //=========================================================================
@@ -1283,93 +1372,86 @@ FastAssembler::assembleLaplacianPhiILaplacianPhiJ_vectorial( matrixPtr_Type& mat
 
     #pragma omp parallel firstprivate( w_quad, ndof, NumQuadPoints)
     {
-        int i_el, i_elem, i_dof, q, d1, d2, i_test, i_trial, iCoor, jCoor, k1, k2;
+        int i_el, i_elem, i_slot, i_chunk, i_chunkEnd, i_dof, q, d1, d2, i_test, i_trial, iCoor, jCoor, k1, k2;
         double integral, partialSum, integral_test, integral_trial;
 
         double d2phi_phys[ndof][NumQuadPoints][3][3];
 
-        // ELEMENTI
-        #pragma omp for
-        for ( i_elem = 0; i_elem <  M_numElements ; i_elem++ )
+        // CHUNKS of elements (a single chunk if no chunk size is set)
+        for ( i_chunk = 0; i_chunk < M_numElements; i_chunk += M_bufferSize )
         {
-        	// QUAD
-        	for (  q = 0; q < NumQuadPoints ; q++ )
-        	{
-        		// DOF
-        		for ( i_dof = 0; i_dof <  ndof; i_dof++ )
-        		{
-        			// DIM 1
-        			for ( iCoor = 0; iCoor < 3 ; iCoor++ )
-        			{
-        				// DIM 2
-        				for ( jCoor = 0; jCoor < 3 ; jCoor++ )
-        				{
-        					partialSum = 0.0;
-        					// DIM 1
-        					for ( k1 = 0; k1 < 3 ; k1++ )
-        					{
-        						// DIM 2
-        						for ( k2 = 0; k2 < 3 ; k2++ )
-        						{
-        							partialSum += M_invJacobian[i_elem][iCoor][k1]
-        							        	  * M_d2phi[i_dof][q][k1][k2]
-        							        	  * M_invJacobian[i_elem][jCoor][k2];
-        						}
-        					}
-        					d2phi_phys[i_dof][q][iCoor][jCoor] = partialSum;
-        				}
-        			}
-        		}
-        	}
+            i_chunkEnd = std::min ( i_chunk + M_bufferSize, M_numElements );
 
-            // DOF - test
-            for ( i_test = 0; i_test <  ndof; i_test++ )
+            // ELEMENTI
+            #pragma omp for
+            for ( i_el = i_chunk; i_el < i_chunkEnd; i_el++ )
             {
-                M_rows[i_elem][i_test] = M_elements[i_elem][i_test];
+                i_elem = i_el;
+                i_slot = i_el - i_chunk;
+
+            	// QUAD
+            	for (  q = 0; q < NumQuadPoints ; q++ )
+            	{
+            		// DOF
+            		for ( i_dof = 0; i_dof <  ndof; i_dof++ )
+            		{
+            			// DIM 1
+            			for ( iCoor = 0; iCoor < 3 ; iCoor++ )
+            			{
+            				// DIM 2
+            				for ( jCoor = 0; jCoor < 3 ; jCoor++ )
+            				{
+            					partialSum = 0.0;
+            					// DIM 1
+            					for ( k1 = 0; k1 < 3 ; k1++ )
+            					{
+            						// DIM 2
+            						for ( k2 = 0; k2 < 3 ; k2++ )
+            						{
+            							partialSum += M_invJacobian[i_elem][iCoor][k1]
+            							        	  * M_d2phi[i_dof][q][k1][k2]
+            							        	  * M_invJacobian[i_elem][jCoor][k2];
+            						}
+            					}
+            					d2phi_phys[i_dof][q][iCoor][jCoor] = partialSum;
+            				}
+            			}
+            		}
+            	}
 
-                // DOF - trial
-                for ( i_trial = 0; i_trial <  ndof; i_trial++ )
+                // DOF - test
+                for ( i_test = 0; i_test <  ndof; i_test++ )
                 {
-                    M_cols[i_elem][i_trial] = M_elements[i_elem][i_trial];
+                    M_rows[i_slot][i_test] = M_elements[i_elem][i_test];
 
-                    integral = 0.0;
-                    // QUAD
-                    for ( q = 0; q < NumQuadPoints ; q++ )
+                    // DOF - trial
+                    for ( i_trial = 0; i_trial <  ndof; i_trial++ )
                     {
-                    	integral_test = 0.0;
-                    	integral_trial = 0.0;
-                        // DIM 1
-                        for ( d1 = 0; d1 < 3 ; d1++ )
+                        M_cols[i_slot][i_trial] = M_elements[i_elem][i_trial];
+
+                        integral = 0.0;
+                        // QUAD
+                        for ( q = 0; q < NumQuadPoints ; q++ )
                         {
-                        	integral_test += d2phi_phys[i_test][q][d1][d1];
-                        	integral_trial += d2phi_phys[i_trial][q][d1][d1];
+                        	integral_test = 0.0;
+                        	integral_trial = 0.0;
+                            // DIM 1
+                            for ( d1 = 0; d1 < 3 ; d1++ )
+                            {
+                            	integral_test += d2phi_phys[i_test][q][d1][d1];
+                            	integral_trial += d2phi_phys[i_trial][q][d1][d1];
+                            }
+                            integral += integral_test * integral_trial * w_quad[q];
                         }
-                        integral += integral_test * integral_trial * w_quad[q];
+                        M_vals[i_slot][i_test][i_trial] = integral * M_detJacobian[i_elem];
                     }
-                    M_vals[i_elem][i_test][i_trial] = integral * M_detJacobian[i_elem];
                 }
             }
-        }
-    }
-
-    for ( int k = 0; k < M_numElements; ++k )
-    {
-    	matrix->matrixPtr()->InsertGlobalValues ( ndof, M_rows[k], ndof, M_cols[k], M_vals[k], Epetra_FECrsMatrix::ROW_MAJOR);
-    }
 
-    for ( UInt d1 = 1; d1 < 3 ; d1++ )
-    {
-    	for ( int k = 0; k < M_numElements; ++k )
-    	{
-    		for ( UInt i = 0; i <  ndof; i++ )
-    		{
-    			M_rows[k][i] += M_numScalarDofs;
-    			M_cols[k][i] += M_numScalarDofs;
-    		}
-    		matrix->matrixPtr()->InsertGlobalValues ( ndof, M_rows[k], ndof, M_cols[k], M_vals[k], Epetra_FECrsMatrix::ROW_MAJOR);
-    	}
+            #pragma omp single
+            insertChunk ( *matrix, i_chunk, i_chunkEnd, 3 );
+        }
     }
-
 }
 
 
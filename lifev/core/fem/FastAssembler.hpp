@@ -32,6 +32,9 @@
      This function is used to perform an efficient assembly of FE matrices
      where the test and trial functions are the same.
 
+     It is restricted to linear tetrahedra: see FastAssemblerGeneric for other
+     meshes, vectors and user defined kernels.
+
      @date 06/2016
      @author Davide Forti <davide.forti@epfl.ch>
  */
@@ -39,10 +42,13 @@
 #ifndef FASTASSEMBLER_HPP
 #define FASTASSEMBLER_HPP
 
+#include <map>
+
 #include <lifev/core/LifeV.hpp>
 #include <lifev/core/mesh/RegionMesh.hpp>
 #include <lifev/core/array/VectorEpetra.hpp>
 #include <lifev/core/array/MatrixEpetra.hpp>
+#include <lifev/core/array/MatrixEpetraOffsets.hpp>
 #include <lifev/core/fem/QuadratureRule.hpp>
 #include <lifev/core/fem/ReferenceFE.hpp>
 #include <lifev/core/fem/CurrentFE.hpp>
@@ -56,22 +62,25 @@ class FastAssembler
 public:
 
 	typedef RegionMesh< LinearTetra > mesh_Type;
-    typedef boost::shared_ptr<mesh_Type>  meshPtr_Type;
+    typedef std::shared_ptr<mesh_Type>  meshPtr_Type;
 
     typedef VectorEpetra vector_Type;
-    typedef boost::shared_ptr<vector_Type> vectorPtr_Type;
+    typedef std::shared_ptr<vector_Type> vectorPtr_Type;
 
     typedef MatrixEpetra<Real> matrix_Type;
-    typedef boost::shared_ptr<matrix_Type> matrixPtr_Type;
+    typedef std::shared_ptr<matrix_Type> matrixPtr_Type;
 
     typedef Epetra_Comm comm_Type;
-    typedef boost::shared_ptr< comm_Type > commPtr_Type;
+    typedef std::shared_ptr< comm_Type > commPtr_Type;
 
     typedef QuadratureRule qr_Type;
-    typedef boost::shared_ptr< qr_Type > qrPtr_Type;
+    typedef std::shared_ptr< qr_Type > qrPtr_Type;
 
     typedef FESpace<mesh_Type, MapEpetra> fespace_Type;
-    typedef boost::shared_ptr<fespace_Type> fespacePtr_Type;
+    typedef std::shared_ptr<fespace_Type> fespacePtr_Type;
+
+    typedef MatrixEpetraOffsets<Real> offsets_Type;
+    typedef std::shared_ptr<offsets_Type> offsetsPtr_Type;
 
 
     //! Constructor
@@ -164,6 +173,10 @@ public:
 
 	//! FE Assembly of SUPG terms - block (0,0)
 	/*!
+	 * The local values of all the 3x3 blocks are recomputed at each call, then summed in
+	 * the matrix. Before the chunked buffers, the off-diagonal local blocks were accumulated
+	 * from one call to the next, so that a second assembly added the terms of the first one
+	 * twice: each call now gives the same local values, whatever the chunk size.
 	 * @param matrix - global matrix
 	 * @param u_h - vector extrapolapolated velocity
 	 */
@@ -186,10 +199,58 @@ public:
      */
     void setConstants_NavierStokes( const Real& density, const Real& viscosity, const Real& timestep, const Real& orderBDF, const Real& C_I );
 
+    //! Use cached insertion offsets when assembling in closed matrices
+    /*!
+     * When enabled, the first assembly in a closed matrix records the positions
+     * of the entries of each element in the values of the matrix (see MatrixEpetraOffsets),
+     * and the following assemblies in the same matrix write directly in these values.
+     * Assemblies in open matrices are not affected.
+     * @param useOffsets - true to enable the cached offsets
+     */
+    void setUseInsertionOffsets( const bool& useOffsets );
+
+    //! Process the elements in chunks of fixed size
+    /*!
+     * The local values, rows and columns are stored for one chunk of elements only,
+     * in contiguous buffers reused by all the chunks: each chunk is computed in parallel
+     * and then inserted in the matrix before the next one. This bounds the memory used
+     * by the assembly, at the price of more synchronizations between the threads.
+     * Must be called before allocateSpace.
+     * @param chunkSize - number of elements per chunk (0, the default, for all the elements at once)
+     */
+    void setChunkSize( const int& chunkSize );
+
 	//@}
 
 private:
 
+    //! Allocate the buffers of the local values, rows and columns for one chunk of elements
+    void allocateBuffers();
+
+    //! Insert the values of a chunk of elements in the diagonal blocks of the matrix
+    /*!
+     * @param matrix - global matrix
+     * @param chunkBegin - index of the first element of the chunk
+     * @param chunkEnd - index after the last element of the chunk
+     * @param numBlocks - number of components (the same values are inserted in each diagonal block)
+     */
+    void insertChunk( matrix_Type& matrix, const int& chunkBegin, const int& chunkEnd, const int& numBlocks );
+
+    //! Insert the SUPG values of a chunk of elements (all the 3x3 blocks) in the matrix
+    void insertChunk_SUPG( matrix_Type& matrix, const int& chunkBegin, const int& chunkEnd );
+
+    //! Sum the values of a block of an element in the matrix
+    /*!
+     * @param matrix - global matrix
+     * @param block - index of the block (3*row component + column component)
+     * @param k - index of the element
+     * @param ndof - number of rows and of columns of the block
+     * @param rows - global row indices
+     * @param cols - global column indices
+     * @param vals - values of the block, row by row
+     */
+    void insertValues( matrix_Type& matrix, const int& block, const int& k, const int& ndof, int* rows, int* cols, double** vals );
+
 	meshPtr_Type M_mesh;
 	commPtr_Type M_comm;
 
@@ -226,6 +287,24 @@ private:
     double M_timestep;
     double M_orderBDF;
     double M_C_I;
+
+    bool M_useInsertionOffsets;
+    std::map<const Epetra_FECrsMatrix*, offsetsPtr_Type> M_insertionOffsets;
+
+    // Chunks of elements: M_vals, M_rows, M_cols, M_vals_supg, M_rows_tmp, M_cols_tmp,
+    // M_Tau_M and M_Tau_C are views in the following contiguous buffers, of M_bufferSize elements
+    int M_chunkSize;
+    int M_bufferSize;
+    double* M_valsBuffer;
+    double** M_valsRows;
+    int* M_rowsBuffer;
+    int* M_colsBuffer;
+    double* M_valsBuffer_supg;
+    double** M_valsRows_supg;
+    double*** M_valsBlocks_supg;
+    double**** M_valsComponents_supg;
+    int* M_tmpBuffer;
+    double* M_tauBuffer;
 };
 
 } // Namespace LifeV
@@ -0,0 +1,773 @@
+//@HEADER
+/*
+*******************************************************************************
+
+   Copyright (C) 2004, 2005, 2007 EPFL, Politecnico di Milano, INRIA
+   Copyright (C) 2010 EPFL, Politecnico di Milano, Emory UNiversity
+
+   This file is part of the LifeV library
+
+   LifeV is free software; you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+
+   LifeV is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with this library; if not, see <http://www.gnu.org/licenses/>
+
+
+*******************************************************************************
+*/
+//@HEADER
+
+/*!
+ *   @file
+     @brief This file contains the definition of the FastAssemblerGeneric class.
+
+     Generalization of the FastAssembler to any mesh type and finite element,
+     with user defined kernels for matrices and vectors.
+
+     @date 10/2026
+ */
+
+#ifndef FASTASSEMBLERGENERIC_HPP
+#define FASTASSEMBLERGENERIC_HPP
+
+#include <cmath>
+#include <map>
+#include <utility>
+#include <vector>
+
+#include <lifev/core/LifeV.hpp>
+#include <lifev/core/array/VectorEpetra.hpp>
+#include <lifev/core/array/MatrixEpetra.hpp>
+#include <lifev/core/array/MatrixEpetraOffsets.hpp>
+#include <lifev/core/array/MatrixEpetraBlockCRS.hpp>
+#include <lifev/core/fem/QuadratureRule.hpp>
+#include <lifev/core/fem/ReferenceFE.hpp>
+#include <lifev/core/fem/GeometricMap.hpp>
+#include <lifev/core/fem/CurrentFE.hpp>
+#include <lifev/core/fem/DOF.hpp>
+
+namespace LifeV
+{
+
+//! FastAssemblerElement - Data of an element given to the kernels of the FastAssemblerGeneric
+/*!
+  This class gives to the kernels the values of the basis functions, of their
+  (physical) derivatives and of the weights (quadrature weight times the
+  determinant of the jacobian) in the quadrature nodes of the current element,
+  all computed from the data precomputed by the FastAssemblerGeneric.
+
+  It also provides the interpolation of FE functions in the quadrature nodes,
+  the vectors being indexed with the global identifiers of the scalar dofs
+  (vector fields are stored component by component, as in the FESpace).
+
+  Each thread uses its own FastAssemblerElement.
+ */
+class FastAssemblerElement
+{
+public:
+
+    //! @name Constructor
+    //@{
+
+    //! Constructor
+    /*!
+      @param nbDof Number of dofs (scalar) of the element
+      @param nbQuadPt Number of quadrature nodes
+      @param nbDimensions Dimension of the elements
+      @param numScalarDofs Total number of scalar dofs
+      @param phi Basis functions in the quadrature nodes, index q * nbDof + i
+      @param dphiRef Derivatives of the basis functions on the reference element, index (q * nbDof + i) * nbDimensions + d
+      @param weights Weights of the quadrature rule
+     */
+    FastAssemblerElement ( const UInt& nbDof, const UInt& nbQuadPt, const UInt& nbDimensions, const UInt& numScalarDofs,
+                           const Real* phi, const Real* dphiRef, const Real* weights )
+        :
+        M_id ( 0 ),
+        M_nbDof ( nbDof ),
+        M_nbQuadPt ( nbQuadPt ),
+        M_nbDimensions ( nbDimensions ),
+        M_numScalarDofs ( numScalarDofs ),
+        M_dofs ( 0 ),
+        M_phi ( phi ),
+        M_dphiRef ( dphiRef ),
+        M_weights ( weights ),
+        M_dphi ( nbQuadPt * nbDof * nbDimensions ),
+        M_wDetJacobian ( nbQuadPt ),
+        M_values(),
+        M_gradients()
+    {}
+
+    //@}
+
+
+    //! @name Methods
+    //@{
+
+    //! Update the element data
+    /*!
+      @param id Local identifier of the element
+      @param dofs Global identifiers of the scalar dofs of the element
+      @param detJacobian Determinants of the jacobian (one value if the map is affine, one per quadrature node otherwise)
+      @param invJacobian Transposed inverse of the jacobian (nbDimensions x nbDimensions, row by row),
+             one matrix if the map is affine, one per quadrature node otherwise
+      @param isAffine True if the geometric map is affine
+     */
+    void update ( const UInt& id, const Int* dofs, const Real* detJacobian, const Real* invJacobian, const bool& isAffine )
+    {
+        M_id = id;
+        M_dofs = dofs;
+
+        const UInt nbDim2 ( M_nbDimensions * M_nbDimensions );
+
+        for ( UInt q ( 0 ); q < M_nbQuadPt; ++q )
+        {
+            const UInt g ( isAffine ? 0 : q );
+            const Real* invJ ( invJacobian + g * nbDim2 );
+
+            M_wDetJacobian[q] = M_weights[q] * std::fabs ( detJacobian[g] );
+
+            for ( UInt i ( 0 ); i < M_nbDof; ++i )
+            {
+                const Real* dphiRef ( M_dphiRef + ( q * M_nbDof + i ) * M_nbDimensions );
+                Real* dphi ( &M_dphi[ ( q * M_nbDof + i ) * M_nbDimensions ] );
+
+                for ( UInt d1 ( 0 ); d1 < M_nbDimensions; ++d1 )
+                {
+                    dphi[d1] = 0.0;
+                    for ( UInt d2 ( 0 ); d2 < M_nbDimensions; ++d2 )
+                    {
+                        dphi[d1] += invJ[d1 * M_nbDimensions + d2] * dphiRef[d2];
+                    }
+                }
+            }
+        }
+    }
+
+    //! Interpolate a FE function in the quadrature nodes
+    /*!
+      @param vector Vector of the FE function, which has to contain the dofs of the element (e.g. repeated)
+      @param fieldDim Number of components of the FE function
+      @param offset Offset of the FE function in the vector
+      @return The values, index c * nbQuadPt + q (valid until the next call)
+     */
+    const Real* interpolateValues ( const VectorEpetra& vector, const UInt& fieldDim, const UInt& offset = 0 )
+    {
+        M_values.assign ( fieldDim * M_nbQuadPt, 0.0 );
+
+        for ( UInt c ( 0 ); c < fieldDim; ++c )
+        {
+            for ( UInt i ( 0 ); i < M_nbDof; ++i )
+            {
+                const Real nodalValue ( vector[ M_dofs[i] + c * M_numScalarDofs + offset ] );
+
+                for ( UInt q ( 0 ); q < M_nbQuadPt; ++q )
+                {
+                    M_values[c * M_nbQuadPt + q] += nodalValue * phi ( i, q );
+                }
+            }
+        }
+        return &M_values[0];
+    }
+
+    //! Interpolate the gradient of a FE function in the quadrature nodes
+    /*!
+      @param vector Vector of the FE function, which has to contain the dofs of the element (e.g. repeated)
+      @param fieldDim Number of components of the FE function
+      @param offset Offset of the FE function in the vector
+      @return The derivatives, index (c * nbDimensions + d) * nbQuadPt + q (valid until the next call)
+     */
+    const Real* interpolateGradients ( const VectorEpetra& vector, const UInt& fieldDim, const UInt& offset = 0 )
+    {
+        M_gradients.assign ( fieldDim * M_nbDimensions * M_nbQuadPt, 0.0 );
+
+        for ( UInt c ( 0 ); c < fieldDim; ++c )
+        {
+            for ( UInt i ( 0 ); i < M_nbDof; ++i )
+            {
+                const Real nodalValue ( vector[ M_dofs[i] + c * M_numScalarDofs + offset ] );
+
+                for ( UInt d ( 0 ); d < M_nbDimensions; ++d )
+                {
+                    for ( UInt q ( 0 ); q < M_nbQuadPt; ++q )
+                    {
+                        M_gradients[ ( c * M_nbDimensions + d ) * M_nbQuadPt + q] += nodalValue * dphi ( i, d, q );
+                    }
+                }
+            }
+        }
+        return &M_gradients[0];
+    }
+
+    //@}
+
+
+    //! @name Get Methods
+    //@{
+
+    //! Local identifier of the element
+    const UInt& id() const
+    {
+        return M_id;
+    }
+
+    //! Number of (scalar) dofs of the element
+    const UInt& nbDof() const
+    {
+        return M_nbDof;
+    }
+
+    //! Number of quadrature nodes
+    const UInt& nbQuadPt() const
+    {
+        return M_nbQuadPt;
+    }
+
+    //! Dimension of the element
+    const UInt& nbDimensions() const
+    {
+        return M_nbDimensions;
+    }
+
+    //! Global identifier of the scalar dof i
+    const Int& dof ( const UInt& i ) const
+    {
+        return M_dofs[i];
+    }
+
+    //! Value of the basis function i in the quadrature node q
+    const Real& phi ( const UInt& i, const UInt& q ) const
+    {
+        return M_phi[q * M_nbDof + i];
+    }
+
+    //! Derivative d of the basis function i in the quadrature node q
+    const Real& dphi ( const UInt& i, const UInt& d, const UInt& q ) const
+    {
+        return M_dphi[ ( q * M_nbDof + i ) * M_nbDimensions + d];
+    }
+
+    //! Quadrature weight times the determinant of the jacobian in the quadrature node q
+    const Real& wDetJacobian ( const UInt& q ) const
+    {
+        return M_wDetJacobian[q];
+    }
+
+    //@}
+
+private:
+
+    UInt M_id;
+    UInt M_nbDof;
+    UInt M_nbQuadPt;
+    UInt M_nbDimensions;
+    UInt M_numScalarDofs;
+
+    const Int* M_dofs;
+
+    // Shared precomputed data
+    const Real* M_phi;
+    const Real* M_dphiRef;
+    const Real* M_weights;
+
+    // Data of the current element
+    std::vector<Real> M_dphi;
+    std::vector<Real> M_wDetJacobian;
+
+    // Interpolated FE functions
+    std::vector<Real> M_values;
+    std::vector<Real> M_gradients;
+};
+
+
+//! FastAssemblerGeneric - Fast assembly of FE matrices and vectors with precomputed data
+/*!
+  As the FastAssembler, this class precomputes once the geometric data of all
+  the elements (determinant and inverse of the jacobian), the basis functions
+  and their derivatives on the reference element, and the global identifiers
+  of the dofs, and then streams over these arrays in the OpenMP loops of the
+  assembly. The test and trial functions are the same.
+
+  The geometric data is stored once per element for affine maps (simplices
+  with linear geometry) and once per quadrature node otherwise (e.g. hexahedra),
+  so any mesh type and any (Lagrangian) reference FE can be used.
+
+  The integrand is given by a kernel, i.e. a class with the following members:
+
+  \code
+  struct MyKernel
+  {
+      // Number of components of the test and trial functions
+      static const UInt S_fieldDim = 3;
+
+      // (matrices) True if the local matrix is the same scalar block on each component
+      static const bool S_blockDiagonal = true;
+
+      // (matrices) Local matrix, row by row, of size (n x n) with n = nbDof if
+      // S_blockDiagonal, n = S_fieldDim * nbDof otherwise, the index of the dof i
+      // of the component c being c * nbDof + i
+      void computeMatrix ( FastAssemblerElement& element, Real* values ) const;
+
+      // (vectors) Local vector of size S_fieldDim * nbDof, same indices
+      void computeVector ( FastAssemblerElement& element, Real* values ) const;
+  };
+  \endcode
+
+  Standard kernels are defined in FastAssemblerKernels.hpp.
+
+  The local values are computed in parallel and then summed serially in the
+  global matrix or vector. The matrices of vector fields can also be assembled
+  by nodal blocks in a MatrixEpetraBlockCRS.
+ */
+template <typename MeshType>
+class FastAssemblerGeneric
+{
+public:
+
+    //! @name Public Types
+    //@{
+
+    typedef MeshType mesh_Type;
+    typedef std::shared_ptr<mesh_Type> meshPtr_Type;
+
+    typedef VectorEpetra vector_Type;
+    typedef MatrixEpetra<Real> matrix_Type;
+    typedef MatrixEpetraBlockCRS<Real> blockMatrix_Type;
+
+    typedef QuadratureRule qr_Type;
+
+    typedef MatrixEpetraOffsets<Real> offsets_Type;
+    typedef std::shared_ptr<offsets_Type> offsetsPtr_Type;
+
+    //@}
+
+
+    //! @name Constructor & Destructor
+    //@{
+
+    //! Constructor
+    /*!
+      @param fespace FE space of the test and trial functions (FESpace or ETFESpace)
+      @param qr Quadrature rule to be used for the integration
+     */
+    template <typename FESpaceType>
+    FastAssemblerGeneric ( const FESpaceType& fespace, const qr_Type& qr );
+
+    //! Destructor
+    ~FastAssemblerGeneric() {}
+
+    //@}
+
+
+    //! @name Methods
+    //@{
+
+    //! Precompute the data of the elements before the assembly
+    void allocateSpace();
+
+    //! Assemble a matrix
+    /*!
+      @param matrix Global matrix (open or closed)
+      @param kernel Kernel computing the local matrices
+     */
+    template <typename KernelType>
+    void assembleMatrix ( matrix_Type& matrix, const KernelType& kernel );
+
+    //! Assemble a matrix by nodal blocks
+    /*!
+      The block size of the matrix must be the number of components of the kernel.
+      @param matrix Global block matrix (open or closed)
+      @param kernel Kernel computing the local matrices
+     */
+    template <typename KernelType>
+    void assembleMatrix ( blockMatrix_Type& matrix, const KernelType& kernel );
+
+    //! Assemble a vector
+    /*!
+      The values are summed in the vector with their global identifiers: the
+      vector has to be global assembled afterwards.
+      @param vector Global vector
+      @param kernel Kernel computing the local vectors
+     */
+    template <typename KernelType>
+    void assembleVector ( vector_Type& vector, const KernelType& kernel );
+
+    //@}
+
+
+    //! @name Set Methods
+    //@{
+
+    //! Use cached insertion offsets when assembling in closed matrices (see FastAssembler)
+    void setUseInsertionOffsets ( const bool& useOffsets )
+    {
+        M_useInsertionOffsets = useOffsets;
+        M_insertionOffsets.clear();
+    }
+
+    //@}
+
+
+    //! @name Get Methods
+    //@{
+
+    //! Number of elements
+    UInt numElements() const
+    {
+        return M_numElements;
+    }
+
+    //! True if the geometric data is stored once per element
+    bool isAffine() const
+    {
+        return M_isAffine;
+    }
+
+    //@}
+
+private:
+
+    //! Compute the local matrices of all the elements in M_vals
+    template <typename KernelType>
+    void computeMatrices ( const KernelType& kernel, const UInt& localSize );
+
+    //! Sum the values of a block of an element in the matrix
+    void insertValues ( matrix_Type& matrix, const UInt& layout, const UInt& slot, const UInt& numSlots,
+                        const UInt& size, const Int* indices, const Real* values );
+
+    //! Create the (thread) element data
+    FastAssemblerElement element() const
+    {
+        return FastAssemblerElement ( M_nbDof, M_nbQuadPt, M_nbDimensions, M_numScalarDofs,
+                                      &M_phi[0], &M_dphiRef[0], &M_weights[0] );
+    }
+
+    meshPtr_Type M_mesh;
+    const ReferenceFE* M_referenceFE;
+    const DOF* M_dof;
+    const qr_Type* M_qr;
+
+    UInt M_numElements;
+    UInt M_numScalarDofs;
+    UInt M_nbDof;
+    UInt M_nbQuadPt;
+    UInt M_nbDimensions;
+
+    // Geometric data, once per element (affine maps) or per quadrature node
+    bool M_isAffine;
+    UInt M_nbGeometricPoints;
+    std::vector<Real> M_detJacobian;
+    std::vector<Real> M_invJacobian;
+
+    // Reference data
+    std::vector<Real> M_weights;
+    std::vector<Real> M_phi;
+    std::vector<Real> M_dphiRef;
+
+    // Global identifiers of the scalar dofs of the elements
+    std::vector<Int> M_elements;
+
+    // Local values of all the elements
+    std::vector<Real> M_vals;
+
+    bool M_useInsertionOffsets;
+    std::map<std::pair<const Epetra_FECrsMatrix*, UInt>, offsetsPtr_Type> M_insertionOffsets;
+};
+
+
+// ===================================================
+// Constructor
+// ===================================================
+
+template <typename MeshType>
+template <typename FESpaceType>
+FastAssemblerGeneric<MeshType>::
+FastAssemblerGeneric ( const FESpaceType& fespace, const qr_Type& qr )
+    :
+    M_mesh ( fespace.mesh() ),
+    M_referenceFE ( &fespace.refFE() ),
+    M_dof ( &fespace.dof() ),
+    M_qr ( &qr ),
+    M_numElements ( 0 ),
+    M_numScalarDofs ( fespace.dof().numTotalDof() ),
+    M_nbDof ( fespace.refFE().nbDof() ),
+    M_nbQuadPt ( qr.nbQuadPt() ),
+    M_nbDimensions ( MeshType::S_geoDimensions ),
+    M_isAffine ( getGeometricMap ( *fespace.mesh() ).nbDof() == MeshType::S_geoDimensions + 1 ),
+    M_nbGeometricPoints ( M_isAffine ? 1 : qr.nbQuadPt() ),
+    M_detJacobian(),
+    M_invJacobian(),
+    M_weights(),
+    M_phi(),
+    M_dphiRef(),
+    M_elements(),
+    M_vals(),
+    M_useInsertionOffsets ( false ),
+    M_insertionOffsets()
+{}
+
+
+// ===================================================
+// Methods
+// ===================================================
+
+template <typename MeshType>
+void
+FastAssemblerGeneric<MeshType>::allocateSpace()
+{
+    M_numElements = M_mesh->numElements();
+
+    CurrentFE fe ( *M_referenceFE, getGeometricMap ( *M_mesh ), *M_qr );
+
+    // Geometric data
+    const UInt nbDim2 ( M_nbDimensions * M_nbDimensions );
+
+    M_detJacobian.resize ( M_numElements * M_nbGeometricPoints );
+    M_invJacobian.resize ( M_numElements * M_nbGeometricPoints * nbDim2 );
+
+    for ( UInt iElement ( 0 ); iElement < M_numElements; ++iElement )
+    {
+        fe.update ( M_mesh->element ( iElement ), UPDATE_DPHI );
+
+        for ( UInt g ( 0 ); g < M_nbGeometricPoints; ++g )
+        {
+            const UInt point ( iElement * M_nbGeometricPoints + g );
+
+            M_detJacobian[point] = fe.detJacobian ( g );
+
+            for ( UInt d1 ( 0 ); d1 < M_nbDimensions; ++d1 )
+            {
+                for ( UInt d2 ( 0 ); d2 < M_nbDimensions; ++d2 )
+                {
+                    M_invJacobian[point * nbDim2 + d1 * M_nbDimensions + d2] = fe.tInverseJacobian ( d1, d2, g );
+                }
+            }
+        }
+    }
+
+    // Reference data
+    M_weights.resize ( M_nbQuadPt );
+    M_phi.resize ( M_nbQuadPt * M_nbDof );
+    M_dphiRef.resize ( M_nbQuadPt * M_nbDof * M_nbDimensions );
+
+    for ( UInt q ( 0 ); q < M_nbQuadPt; ++q )
+    {
+        M_weights[q] = M_qr->weight ( q );
+
+        for ( UInt i ( 0 ); i < M_nbDof; ++i )
+        {
+            M_phi[q * M_nbDof + i] = M_referenceFE->phi ( i, M_qr->quadPointCoor ( q ) );
+
+            for ( UInt d ( 0 ); d < M_nbDimensions; ++d )
+            {
+                M_dphiRef[ ( q * M_nbDof + i ) * M_nbDimensions + d] = M_referenceFE->dPhi ( i, d, M_qr->quadPointCoor ( q ) );
+            }
+        }
+    }
+
+    // Dofs
+    M_elements.resize ( M_numElements * M_nbDof );
+
+    for ( UInt iElement ( 0 ); iElement < M_numElements; ++iElement )
+    {
+        for ( UInt i ( 0 ); i < M_nbDof; ++i )
+        {
+            M_elements[iElement * M_nbDof + i] = M_dof->localToGlobalMap ( iElement, i );
+        }
+    }
+}
+
+template <typename MeshType>
+template <typename KernelType>
+void
+FastAssemblerGeneric<MeshType>::assembleMatrix ( matrix_Type& matrix, const KernelType& kernel )
+{
+    ASSERT ( !M_elements.empty() || M_numElements == 0, "allocateSpace must be called before the assembly" );
+
+    const UInt fieldDim ( KernelType::S_fieldDim );
+    const UInt blockSize ( KernelType::S_blockDiagonal ? M_nbDof : fieldDim * M_nbDof );
+    const UInt localSize ( blockSize * blockSize );
+
+    computeMatrices ( kernel, localSize );
+
+    // Serial insertion, block by block
+    std::vector<Int> indices ( blockSize );
+    const UInt numBlocks ( KernelType::S_blockDiagonal ? fieldDim : 1 );
+
+    for ( UInt iBlock ( 0 ); iBlock < numBlocks; ++iBlock )
+    {
+        for ( UInt iElement ( 0 ); iElement < M_numElements; ++iElement )
+        {
+            for ( UInt k ( 0 ); k < blockSize; ++k )
+            {
+                indices[k] = M_elements[iElement * M_nbDof + k % M_nbDof]
+                             + ( iBlock + k / M_nbDof ) * M_numScalarDofs;
+            }
+
+            insertValues ( matrix, blockSize, iBlock * M_numElements + iElement, numBlocks * M_numElements,
+                           blockSize, &indices[0], &M_vals[iElement * localSize] );
+        }
+    }
+}
+
+template <typename MeshType>
+template <typename KernelType>
+void
+FastAssemblerGeneric<MeshType>::assembleMatrix ( blockMatrix_Type& matrix, const KernelType& kernel )
+{
+    ASSERT ( !M_elements.empty() || M_numElements == 0, "allocateSpace must be called before the assembly" );
+    ASSERT ( matrix.blockSize() == KernelType::S_fieldDim, "The block size of the matrix must be the number of components" );
+
+    const UInt fieldDim ( KernelType::S_fieldDim );
+    const UInt localDim ( KernelType::S_blockDiagonal ? M_nbDof : fieldDim * M_nbDof );
+    const UInt localSize ( localDim * localDim );
+    const UInt blockArea ( fieldDim * fieldDim );
+
+    computeMatrices ( kernel, localSize );
+
+    // Serial insertion, element by element: the block (i,j) gathers the
+    // coefficients of all the components of the nodes i and j
+    std::vector<Real> blocks ( M_nbDof * M_nbDof * blockArea, 0. );
+
+    for ( UInt iElement ( 0 ); iElement < M_numElements; ++iElement )
+    {
+        const Real* values ( &M_vals[iElement * localSize] );
+
+        for ( UInt i ( 0 ); i < M_nbDof; ++i )
+        {
+            for ( UInt j ( 0 ); j < M_nbDof; ++j )
+            {
+                Real* block ( &blocks[ ( i * M_nbDof + j ) * blockArea] );
+
+                for ( UInt ci ( 0 ); ci < fieldDim; ++ci )
+                {
+                    for ( UInt cj ( 0 ); cj < fieldDim; ++cj )
+                    {
+                        if ( KernelType::S_blockDiagonal )
+                        {
+                            block[cj * fieldDim + ci] = ( ci == cj ) ? values[i * M_nbDof + j] : 0.;
+                        }
+                        else
+                        {
+                            block[cj * fieldDim + ci] = values[ ( ci * M_nbDof + i ) * localDim + cj * M_nbDof + j];
+                        }
+                    }
+                }
+            }
+        }
+
+        matrix.addToBlocks ( M_nbDof, M_nbDof, &M_elements[iElement * M_nbDof], &M_elements[iElement * M_nbDof], &blocks[0] );
+    }
+}
+
+template <typename MeshType>
+template <typename KernelType>
+void
+FastAssemblerGeneric<MeshType>::assembleVector ( vector_Type& vector, const KernelType& kernel )
+{
+    ASSERT ( !M_elements.empty() || M_numElements == 0, "allocateSpace must be called before the assembly" );
+
+    const UInt fieldDim ( KernelType::S_fieldDim );
+    const UInt localSize ( fieldDim * M_nbDof );
+    const Int numElements ( M_numElements );
+
+    M_vals.resize ( M_numElements * localSize );
+
+    #pragma omp parallel
+    {
+        FastAssemblerElement elementData ( element() );
+
+        #pragma omp for
+        for ( Int iElement = 0; iElement < numElements; ++iElement )
+        {
+            const UInt g ( iElement * M_nbGeometricPoints );
+
+            elementData.update ( iElement, &M_elements[iElement * M_nbDof], &M_detJacobian[g],
+                                 &M_invJacobian[g * M_nbDimensions * M_nbDimensions], M_isAffine );
+
+            kernel.computeVector ( elementData, &M_vals[iElement * localSize] );
+        }
+    }
+
+    // Serial insertion
+    for ( UInt iElement ( 0 ); iElement < M_numElements; ++iElement )
+    {
+        for ( UInt k ( 0 ); k < localSize; ++k )
+        {
+            vector.sumIntoGlobalValues ( M_elements[iElement * M_nbDof + k % M_nbDof] + ( k / M_nbDof ) * M_numScalarDofs,
+                                         M_vals[iElement * localSize + k] );
+        }
+    }
+}
+
+template <typename MeshType>
+template <typename KernelType>
+void
+FastAssemblerGeneric<MeshType>::computeMatrices ( const KernelType& kernel, const UInt& localSize )
+{
+    const Int numElements ( M_numElements );
+
+    M_vals.resize ( M_numElements * localSize );
+
+    #pragma omp parallel
+    {
+        FastAssemblerElement elementData ( element() );
+
+        #pragma omp for
+        for ( Int iElement = 0; iElement < numElements; ++iElement )
+        {
+            const UInt g ( iElement * M_nbGeometricPoints );
+
+            elementData.update ( iElement, &M_elements[iElement * M_nbDof], &M_detJacobian[g],
+                                 &M_invJacobian[g * M_nbDimensions * M_nbDimensions], M_isAffine );
+
+            kernel.computeMatrix ( elementData, &M_vals[iElement * localSize] );
+        }
+    }
+}
+
+template <typename MeshType>
+void
+FastAssemblerGeneric<MeshType>::insertValues ( matrix_Type& matrix, const UInt& layout, const UInt& slot, const UInt& numSlots,
+                                               const UInt& size, const Int* indices, const Real* values )
+{
+    if ( M_useInsertionOffsets && matrix.filled() )
+    {
+        // The slots depend on the size of the blocks: one set of offsets per block size
+        offsetsPtr_Type& offsets = M_insertionOffsets[ std::make_pair ( matrix.matrixPtr().get(), layout ) ];
+
+        if ( !offsets )
+        {
+            offsets.reset ( new offsets_Type );
+        }
+
+        // The structure of the matrix changed (or first use): the offsets are recomputed
+        if ( !offsets->isValidFor ( matrix ) )
+        {
+            offsets->reset ( matrix, numSlots );
+        }
+
+        std::vector<const Real*> rows ( size );
+        for ( UInt i ( 0 ); i < size; ++i )
+        {
+            rows[i] = values + i * size;
+        }
+
+        offsets->sumIntoCoefficients ( slot, matrix, size, size, indices, indices, &rows[0] );
+    }
+    else
+    {
+        matrix.matrixPtr()->InsertGlobalValues ( size, indices, size, indices, values, Epetra_FECrsMatrix::ROW_MAJOR );
+    }
+}
+
+} // Namespace LifeV
+
+#endif // FASTASSEMBLERGENERIC_HPP
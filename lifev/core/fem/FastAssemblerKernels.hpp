@@ -0,0 +1,265 @@
+//@HEADER
+/*
+*******************************************************************************
+
+   Copyright (C) 2004, 2005, 2007 EPFL, Politecnico di Milano, INRIA
+   Copyright (C) 2010 EPFL, Politecnico di Milano, Emory UNiversity
+
+   This file is part of the LifeV library
+
+   LifeV is free software; you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+
+   LifeV is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with this library; if not, see <http://www.gnu.org/licenses/>
+
+
+*******************************************************************************
+*/
+//@HEADER
+
+/*!
+ *   @file
+     @brief This file contains standard kernels for the FastAssemblerGeneric.
+
+     The kernels for vector fields use the dimension of the mesh as number of
+     components. New kernels can be defined in the same way, without changing
+     the FastAssemblerGeneric (see its documentation for the interface).
+
+     @date 10/2026
+ */
+
+#ifndef FASTASSEMBLERKERNELS_HPP
+#define FASTASSEMBLERKERNELS_HPP
+
+#include <lifev/core/LifeV.hpp>
+#include <lifev/core/array/VectorEpetra.hpp>
+#include <lifev/core/fem/FastAssemblerGeneric.hpp>
+
+namespace LifeV
+{
+
+//! Kernel of the stiffness matrix: coefficient * grad(phi_j) : grad(phi_i)
+template <UInt FieldDim>
+class FastAssemblerKernelGradGrad
+{
+public:
+
+    static const UInt S_fieldDim = FieldDim;
+    static const bool S_blockDiagonal = true;
+
+    explicit FastAssemblerKernelGradGrad ( const Real& coefficient = 1.0 )
+        :
+        M_coefficient ( coefficient )
+    {}
+
+    void computeMatrix ( FastAssemblerElement& element, Real* values ) const
+    {
+        const UInt nbDof ( element.nbDof() );
+
+        for ( UInt i ( 0 ); i < nbDof; ++i )
+        {
+            for ( UInt j ( 0 ); j < nbDof; ++j )
+            {
+                Real integral ( 0.0 );
+                for ( UInt q ( 0 ); q < element.nbQuadPt(); ++q )
+                {
+                    Real product ( 0.0 );
+                    for ( UInt d ( 0 ); d < element.nbDimensions(); ++d )
+                    {
+                        product += element.dphi ( i, d, q ) * element.dphi ( j, d, q );
+                    }
+                    integral += product * element.wDetJacobian ( q );
+                }
+                values[i * nbDof + j] = M_coefficient * integral;
+            }
+        }
+    }
+
+private:
+
+    Real M_coefficient;
+};
+
+//! Kernel of the mass matrix: coefficient * phi_j . phi_i
+template <UInt FieldDim>
+class FastAssemblerKernelMass
+{
+public:
+
+    static const UInt S_fieldDim = FieldDim;
+    static const bool S_blockDiagonal = true;
+
+    explicit FastAssemblerKernelMass ( const Real& coefficient = 1.0 )
+        :
+        M_coefficient ( coefficient )
+    {}
+
+    void computeMatrix ( FastAssemblerElement& element, Real* values ) const
+    {
+        const UInt nbDof ( element.nbDof() );
+
+        for ( UInt i ( 0 ); i < nbDof; ++i )
+        {
+            for ( UInt j ( 0 ); j < nbDof; ++j )
+            {
+                Real integral ( 0.0 );
+                for ( UInt q ( 0 ); q < element.nbQuadPt(); ++q )
+                {
+                    integral += element.phi ( i, q ) * element.phi ( j, q ) * element.wDetJacobian ( q );
+                }
+                values[i * nbDof + j] = M_coefficient * integral;
+            }
+        }
+    }
+
+private:
+
+    Real M_coefficient;
+};
+
+//! Kernel of the convective matrix: (u_h . grad) phi_j . phi_i
+/*!
+  The velocity u_h (Dim components, repeated) is defined on the FE space of the assembler.
+ */
+template <UInt Dim>
+class FastAssemblerKernelConvective
+{
+public:
+
+    static const UInt S_fieldDim = Dim;
+    static const bool S_blockDiagonal = true;
+
+    explicit FastAssemblerKernelConvective ( const VectorEpetra& velocity )
+        :
+        M_velocity ( velocity )
+    {}
+
+    void computeMatrix ( FastAssemblerElement& element, Real* values ) const
+    {
+        const UInt nbDof ( element.nbDof() );
+        const UInt nbQuadPt ( element.nbQuadPt() );
+        const Real* uhq ( element.interpolateValues ( M_velocity, Dim ) );
+
+        for ( UInt i ( 0 ); i < nbDof; ++i )
+        {
+            for ( UInt j ( 0 ); j < nbDof; ++j )
+            {
+                Real integral ( 0.0 );
+                for ( UInt q ( 0 ); q < nbQuadPt; ++q )
+                {
+                    Real advection ( 0.0 );
+                    for ( UInt d ( 0 ); d < Dim; ++d )
+                    {
+                        advection += uhq[d * nbQuadPt + q] * element.dphi ( j, d, q );
+                    }
+                    integral += advection * element.phi ( i, q ) * element.wDetJacobian ( q );
+                }
+                values[i * nbDof + j] = integral;
+            }
+        }
+    }
+
+private:
+
+    const VectorEpetra& M_velocity;
+};
+
+//! Kernel of the right hand side of a FE source term: f_h . phi_i
+/*!
+  The source f_h (FieldDim components, repeated) is defined on the FE space of the assembler.
+ */
+template <UInt FieldDim>
+class FastAssemblerKernelSource
+{
+public:
+
+    static const UInt S_fieldDim = FieldDim;
+
+    explicit FastAssemblerKernelSource ( const VectorEpetra& source )
+        :
+        M_source ( source )
+    {}
+
+    void computeVector ( FastAssemblerElement& element, Real* values ) const
+    {
+        const UInt nbDof ( element.nbDof() );
+        const UInt nbQuadPt ( element.nbQuadPt() );
+        const Real* fhq ( element.interpolateValues ( M_source, FieldDim ) );
+
+        for ( UInt c ( 0 ); c < FieldDim; ++c )
+        {
+            for ( UInt i ( 0 ); i < nbDof; ++i )
+            {
+                Real integral ( 0.0 );
+                for ( UInt q ( 0 ); q < nbQuadPt; ++q )
+                {
+                    integral += fhq[c * nbQuadPt + q] * element.phi ( i, q ) * element.wDetJacobian ( q );
+                }
+                values[c * nbDof + i] = integral;
+            }
+        }
+    }
+
+private:
+
+    const VectorEpetra& M_source;
+};
+
+//! Kernel of the convective residual: (u_h . grad) u_h . phi_i
+/*!
+  The velocity u_h (Dim components, repeated) is defined on the FE space of the assembler.
+ */
+template <UInt Dim>
+class FastAssemblerKernelConvectiveResidual
+{
+public:
+
+    static const UInt S_fieldDim = Dim;
+
+    explicit FastAssemblerKernelConvectiveResidual ( const VectorEpetra& velocity )
+        :
+        M_velocity ( velocity )
+    {}
+
+    void computeVector ( FastAssemblerElement& element, Real* values ) const
+    {
+        const UInt nbDof ( element.nbDof() );
+        const UInt nbQuadPt ( element.nbQuadPt() );
+        const Real* uhq ( element.interpolateValues ( M_velocity, Dim ) );
+        const Real* graduhq ( element.interpolateGradients ( M_velocity, Dim ) );
+
+        for ( UInt c ( 0 ); c < Dim; ++c )
+        {
+            for ( UInt i ( 0 ); i < nbDof; ++i )
+            {
+                Real integral ( 0.0 );
+                for ( UInt q ( 0 ); q < nbQuadPt; ++q )
+                {
+                    Real advection ( 0.0 );
+                    for ( UInt d ( 0 ); d < Dim; ++d )
+                    {
+                        advection += uhq[d * nbQuadPt + q] * graduhq[ ( c * Dim + d ) * nbQuadPt + q];
+                    }
+                    integral += advection * element.phi ( i, q ) * element.wDetJacobian ( q );
+                }
+                values[c * nbDof + i] = integral;
+            }
+        }
+    }
+
+private:
+
+    const VectorEpetra& M_velocity;
+};
+
+} // Namespace LifeV
+
+#endif // FASTASSEMBLERKERNELS_HPP
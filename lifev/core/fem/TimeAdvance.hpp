@@ -39,6 +39,8 @@
 #define TIMEADVANCE_H 1
 
 
+#include <algorithm>
+#include <vector>
 #include <stdexcept>
 #include <sstream>
 
@@ -687,6 +689,42 @@ TimeAdvance<feVectorType>::acceleration (feVector_Type& u) const
     accelerate  -= (*this->M_rhsContribution[1]);
     return accelerate;
 }
+// ===================================================
+// Helpers
+// ===================================================
+
+//! Linear combination of the states: result = sum_k coefficients[k] * vectors[k] + scalarThis * result
+/*!
+  Generic version for the types providing the arithmetic operators (e.g. Real).
+  @param result Vector of the combination (it may be in vectors)
+  @param coefficients Coefficients of the vectors
+  @param vectors Vectors of the combination
+  @param scalarThis Coefficient of the current result
+ */
+template<typename feVectorType>
+void
+timeAdvanceLinearCombination ( feVectorType& result, const std::vector<Real>& coefficients,
+                               const std::vector<const feVectorType*>& vectors, const Real& scalarThis = 0. )
+{
+    feVectorType combination ( result );
+    combination *= scalarThis;
+
+    for ( UInt k = 0; k < vectors.size(); ++k )
+    {
+        combination += coefficients[ k ] * *vectors[ k ];
+    }
+
+    result = combination;
+}
+
+//! Linear combination of the states, in one pass on the data of the VectorEpetra
+inline void
+timeAdvanceLinearCombination ( VectorEpetra& result, const std::vector<Real>& coefficients,
+                               const std::vector<const VectorEpetra*>& vectors, const Real& scalarThis = 0. )
+{
+    result.linearCombination ( coefficients, vectors, scalarThis );
+}
+
 // ===================================================
 // Macros
 // ===================================================
@@ -316,20 +316,10 @@ TimeAdvanceBDF<feVectorType>::shiftRight (feVector_Type const&  solution )
     ASSERT ( this->M_unknowns.size() == this->M_size,
              "M_unknowns.size() and  M_size must be equal" );
 
-    feVectorContainerPtrIterate_Type it   = this->M_unknowns.end() - 1;
-    feVectorContainerPtrIterate_Type itm1 = this->M_unknowns.end() - 1;
-    feVectorContainerPtrIterate_Type itb  = this->M_unknowns.begin();
-
-    delete *itm1;
-
-    for ( ; it != itb; --it )
-    {
-        itm1--;
-        *it = *itm1;
-    }
-
-    *itb = new feVector_Type (solution);
+    // The vectors are rotated by one position: the oldest one is reused for the new solution
+    std::rotate ( this->M_unknowns.begin(), this->M_unknowns.end() - 1, this->M_unknowns.end() );
 
+    *this->M_unknowns[0] = solution;
 }
 
 template<typename feVectorType>
@@ -337,12 +327,17 @@ void
 TimeAdvanceBDF<feVectorType>::RHSFirstDerivative (const Real& timeStep, feVectorType& rhsContribution ) const
 {
 
-    rhsContribution *= (this->M_alpha[ 1 ] / timeStep);
+    // One pass on the data, without temporary vectors
+    std::vector<Real> coefficients;
+    std::vector<const feVectorType*> vectors;
 
     for ( UInt i = 1; i < this->M_order; ++i )
     {
-        rhsContribution += (this->M_alpha[ i + 1 ] / timeStep) * *this->M_unknowns[ i ];
+        coefficients.push_back ( this->M_alpha[ i + 1 ] / timeStep );
+        vectors.push_back ( this->M_unknowns[ i ] );
     }
+
+    timeAdvanceLinearCombination ( rhsContribution, coefficients, vectors, this->M_alpha[ 1 ] / timeStep );
 }
 
 
@@ -355,14 +350,25 @@ TimeAdvanceBDF<feVectorType>::updateRHSSecondDerivative (const Real& timeStep )
 
     feVectorContainerPtrIterate_Type it  = this->M_rhsContribution.end() - 1;
 
-    *it = new feVector_Type (*this->M_unknowns[ 0 ]);
+    if ( *it == NULL )
+    {
+        *it = new feVector_Type (*this->M_unknowns[ 0 ]);
+    }
+    else
+    {
+        **it = *this->M_unknowns[ 0 ];
+    }
 
-    ** it *= this->M_xi[ 1 ] / (timeStep * timeStep);
+    std::vector<Real> coefficients;
+    std::vector<const feVectorType*> vectors;
 
     for ( UInt i = 1; i < this->M_order + 1; ++i )
     {
-        **it += ( this->M_xi[ i + 1 ] / (timeStep * timeStep) ) * *this->M_unknowns[ i ];
+        coefficients.push_back ( this->M_xi[ i + 1 ] / (timeStep * timeStep) );
+        vectors.push_back ( this->M_unknowns[ i ] );
     }
+
+    timeAdvanceLinearCombination ( **it, coefficients, vectors, this->M_xi[ 1 ] / (timeStep * timeStep) );
 }
 
 template<typename feVectorType>
@@ -625,12 +631,16 @@ template<typename feVectorType>
 void
 TimeAdvanceBDF<feVectorType>::extrapolation (feVector_Type& extrapolation) const
 {
-    extrapolation = this->M_beta[ 0 ] * (*this->M_unknowns[ 0 ]);
+    std::vector<Real> coefficients;
+    std::vector<const feVectorType*> vectors;
 
-    for ( UInt i = 1; i < this->M_order; ++i )
+    for ( UInt i = 0; i < this->M_order; ++i )
     {
-        extrapolation += this->M_beta[ i ] * (*this->M_unknowns[ i ]);
+        coefficients.push_back ( this->M_beta[ i ] );
+        vectors.push_back ( this->M_unknowns[ i ] );
     }
+
+    timeAdvanceLinearCombination ( extrapolation, coefficients, vectors );
 }
 
 template<typename feVectorType>
@@ -640,12 +650,16 @@ TimeAdvanceBDF<feVectorType>::extrapolationFirstDerivative (feVector_Type& extra
     ASSERT ( this->M_orderDerivative == 2,
              "extrapolationFirstDerivative: this method must be used with the second order problem." )
 
-    extrapolation = this->M_betaFirstDerivative[ 0 ] * (*this->M_unknowns[ 0 ]);
+    std::vector<Real> coefficients;
+    std::vector<const feVectorType*> vectors;
 
-    for ( UInt i = 1; i < this->M_order; ++i )
+    for ( UInt i = 0; i < this->M_order; ++i )
     {
-        extrapolation += this->M_betaFirstDerivative[ i ] * (*this->M_unknowns[ i ]);
+        coefficients.push_back ( this->M_betaFirstDerivative[ i ] );
+        vectors.push_back ( this->M_unknowns[ i ] );
     }
+
+    timeAdvanceLinearCombination ( extrapolation, coefficients, vectors );
 }
 
 template<typename feVectorType>
@@ -672,15 +686,22 @@ TimeAdvanceBDF<feVectorType>::firstDerivative() const
     //
     // Before going in this direction the design of the TimeAdvance needs to be discussed.
     // The same consideration is valid for the second derivative.
-    return *this->M_unknowns[0] * this->M_alpha[ 0 ] / this->M_timeStep
-           - ( *this->M_rhsContribution[0] );
+    feVectorType derivative ( *this->M_rhsContribution[0] );
+    timeAdvanceLinearCombination ( derivative, std::vector<Real> ( 1, this->M_alpha[ 0 ] / this->M_timeStep ),
+                                   std::vector<const feVectorType*> ( 1, this->M_unknowns[0] ), -1. );
+
+    return derivative;
 }
 
 template<typename feVectorType>
 feVectorType
 TimeAdvanceBDF<feVectorType>::secondDerivative() const
 {
-    return (*this->M_unknowns[0]) * this->M_xi[ 0 ] / (this->M_timeStep * this->M_timeStep) -  ( *this->M_rhsContribution[1] );
+    feVectorType derivative ( *this->M_rhsContribution[1] );
+    timeAdvanceLinearCombination ( derivative, std::vector<Real> ( 1, this->M_xi[ 0 ] / (this->M_timeStep * this->M_timeStep) ),
+                                   std::vector<const feVectorType*> ( 1, this->M_unknowns[0] ), -1. );
+
+    return derivative;
 }
 
 
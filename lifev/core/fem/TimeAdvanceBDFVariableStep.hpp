@@ -43,6 +43,8 @@
 #ifndef _BDF_VARIABLE_TIMESTEP_H
 #define _BDF_VARIABLE_TIMESTEP_H
 
+#include <algorithm>
+
 #include <lifev/core/LifeV.hpp>
 #include <lifev/core/array/VectorEpetra.hpp>
 
@@ -495,18 +497,9 @@ template<typename FEVectorType>
 void
 TimeAdvanceBDFVariableStep<FEVectorType>::shiftRight ( feVector_Type const& uCurrent )
 {
-    typedef typename feVectorPtrContainer_Type::iterator bdfContainerIterator_Type;
-    bdfContainerIterator_Type it = M_unknowns.end() - 1;
-    bdfContainerIterator_Type itMinusOne = M_unknowns.end() - 1;
-    bdfContainerIterator_Type itBegin = M_unknowns.begin();
-
-    for ( ; it != itBegin; --it )
-    {
-        itMinusOne--;
-        *it = *itMinusOne;
-    }
-    feVectorPtr_Type tmp ( new feVector_Type ( uCurrent ) );
-    *itBegin = tmp;
+    // The vectors are rotated by one position: the oldest one is reused for the new solution
+    std::rotate ( M_unknowns.begin(), M_unknowns.end() - 1, M_unknowns.end() );
+    *M_unknowns[ 0 ] = uCurrent;
 
     for ( UInt i = M_order - 1; i > 0; i-- )
     {
@@ -520,20 +513,9 @@ template<typename FEVectorType>
 void
 TimeAdvanceBDFVariableStep<FEVectorType>::shiftRight ( feVector_Type const& uCurrent, Real timeStepNew )
 {
-
-    typedef typename feVectorPtrContainer_Type::iterator bdfContainerIterator_Type;
-    bdfContainerIterator_Type it = M_unknowns.end() - 1;
-    bdfContainerIterator_Type itMinusOne = M_unknowns.end() - 1;
-    bdfContainerIterator_Type itBegin = M_unknowns.begin();
-
-    for ( ; it != itBegin; --it )
-    {
-        itMinusOne--;
-        *it = *itMinusOne;
-    }
-
-    feVectorPtr_Type tmp ( new feVector_Type ( uCurrent ) );
-    *itBegin = tmp;
+    // The vectors are rotated by one position: the oldest one is reused for the new solution
+    std::rotate ( M_unknowns.begin(), M_unknowns.end() - 1, M_unknowns.end() );
+    *M_unknowns[ 0 ] = uCurrent;
 
     for ( UInt i = M_order - 1; i > 0; i-- )
     {
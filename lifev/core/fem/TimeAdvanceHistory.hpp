@@ -0,0 +1,197 @@
+//@HEADER
+/*
+*******************************************************************************
+
+    Copyright (C) 2004, 2005, 2007 EPFL, Politecnico di Milano, INRIA
+    Copyright (C) 2010 EPFL, Politecnico di Milano, Emory University
+
+    This file is part of LifeV.
+
+    LifeV is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    LifeV is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with LifeV.  If not, see <http://www.gnu.org/licenses/>.
+
+*******************************************************************************
+*/
+//@HEADER
+
+/*!
+    @file
+    @brief File containing a fixed pool of vectors storing the history of a time advancing scheme
+
+    @date 10-2026
+ */
+
+#ifndef TIMEADVANCEHISTORY_H
+#define TIMEADVANCEHISTORY_H 1
+
+#include <vector>
+
+#include <lifev/core/LifeV.hpp>
+
+namespace LifeV
+{
+
+//! TimeAdvanceHistory - Ring buffer of the states u^n, u^{n-1}, ..., u^{n-size+1}
+/*!
+  The states are stored in a fixed pool of vectors allocated once in setup.
+  When a time step is completed, shift rotates the pool by one position: the
+  slot of the oldest state becomes the slot of the newest one and is
+  overwritten by assignment, so that no vector is allocated or freed during
+  the time loop (for a VectorEpetra, the assignment reuses the map and the
+  values of the slot).
+
+  The element i is the state at time n - i (0 is the newest state).
+
+  The VectorType must be copy constructible and assignable.
+ */
+template <typename VectorType>
+class TimeAdvanceHistory
+{
+public:
+
+    //! @name Public Types
+    //@{
+
+    typedef VectorType                       vector_Type;
+    typedef std::shared_ptr<vector_Type>     vectorPtr_Type;
+
+    //@}
+
+
+    //! @name Constructor & Destructor
+    //@{
+
+    //! Empty constructor
+    TimeAdvanceHistory() :
+        M_pool(),
+        M_newest ( 0 )
+    {}
+
+    //! Destructor
+    ~TimeAdvanceHistory() {}
+
+    //@}
+
+
+    //! @name Methods
+    //@{
+
+    //! Allocate the pool, all the states being equal to the given vector
+    /*!
+      @param size Number of states stored
+      @param state Initial value of all the states
+     */
+    void setup ( const UInt& size, const vector_Type& state )
+    {
+        M_pool.resize ( size );
+        for ( UInt i ( 0 ); i < size; ++i )
+        {
+            M_pool[i].reset ( new vector_Type ( state ) );
+        }
+        M_newest = 0;
+    }
+
+    //! Allocate the pool from the given states
+    /*!
+      @param states States ordered from the newest (time n) to the oldest
+     */
+    void setup ( const std::vector<vector_Type>& states )
+    {
+        M_pool.resize ( states.size() );
+        for ( UInt i ( 0 ); i < states.size(); ++i )
+        {
+            M_pool[i].reset ( new vector_Type ( states[i] ) );
+        }
+        M_newest = 0;
+    }
+
+    //! Rotate the pool and return the slot of the new state
+    /*!
+      The returned vector still contains the oldest state: it has to be
+      overwritten with the new state by the caller.
+      @return The vector of the state at the new time n
+     */
+    vector_Type& shift()
+    {
+        ASSERT ( !M_pool.empty(), "TimeAdvanceHistory::shift: setup has not been called" );
+
+        M_newest = ( M_newest + M_pool.size() - 1 ) % M_pool.size();
+
+        return *M_pool[M_newest];
+    }
+
+    //! Rotate the pool and copy the new state in the slot of the oldest one
+    /*!
+      @param state The state at the new time n
+     */
+    void shift ( const vector_Type& state )
+    {
+        shift() = state;
+    }
+
+    //@}
+
+
+    //! @name Operators
+    //@{
+
+    //! Access to the state at time n - i
+    vector_Type& operator[] ( const UInt& i )
+    {
+        return *M_pool[slot ( i )];
+    }
+
+    //! Access to the state at time n - i
+    const vector_Type& operator[] ( const UInt& i ) const
+    {
+        return *M_pool[slot ( i )];
+    }
+
+    //@}
+
+
+    //! @name Get Methods
+    //@{
+
+    //! Number of states stored
+    UInt size() const
+    {
+        return M_pool.size();
+    }
+
+    //! Shared pointer to the state at time n - i
+    const vectorPtr_Type& statePtr ( const UInt& i ) const
+    {
+        return M_pool[slot ( i )];
+    }
+
+    //@}
+
+private:
+
+    //! Position in the pool of the state at time n - i
+    UInt slot ( const UInt& i ) const
+    {
+        ASSERT ( i < M_pool.size(), "TimeAdvanceHistory: state out of range" );
+
+        return ( M_newest + i ) % M_pool.size();
+    }
+
+    std::vector<vectorPtr_Type> M_pool;
+
+    UInt M_newest;
+};
+
+} // Namespace LifeV
+
+#endif // TIMEADVANCEHISTORY_H
@@ -46,6 +46,7 @@
 #include <stdexcept>
 #include <sstream>
 #include <cmath>
+#include <algorithm>
 
 
 #include <lifev/core/fem/TimeAdvance.hpp>
@@ -312,40 +313,28 @@ void TimeAdvanceNewmark <feVectorType>::shiftRight (const feVector_Type& solutio
 {
     ASSERT (  this->M_timeStep != 0 ,  "M_timeStep must be different to 0");
 
-    feVectorContainerPtrIterate_Type it   =  this->M_unknowns.end();
-    feVectorContainerPtrIterate_Type itb1 =  this->M_unknowns.begin() +  this->M_size / 2;
-    feVectorContainerPtrIterate_Type itb  =  this->M_unknowns.begin();
-
-    for ( ; itb1 != it; ++itb1, ++itb)
-    {
-        *itb1 = *itb;
-    }
-
-    itb  =  this->M_unknowns.begin();
+    // The current states become the previous ones: the vectors of the previous
+    // states are reused for the new ones, without allocation
+    std::swap_ranges ( this->M_unknowns.begin(), this->M_unknowns.begin() + this->M_size / 2,
+                       this->M_unknowns.begin() + this->M_size / 2 );
 
     // insert unk in unknowns[0];
-    *itb = new feVector_Type ( solution );
-
-    itb++;
+    *this->M_unknowns[0] = solution;
 
-    //update velocity
-    feVector_Type velocityTemp (solution);
-    velocityTemp *=  this->M_alpha[0] / this->M_timeStep;
-    velocityTemp -= *this->M_rhsContribution[0];
+    std::vector<Real> coefficients ( 2, -1. );
+    std::vector<const feVectorType*> vectors ( 2, &solution );
 
-    // update unknows[1] with velocityTemp is current velocity
-    *itb = new feVector_Type (velocityTemp);
+    // update unknows[1] with the current velocity
+    coefficients[0] = this->M_alpha[0] / this->M_timeStep;
+    vectors[1] = this->M_rhsContribution[0];
+    timeAdvanceLinearCombination ( *this->M_unknowns[1], coefficients, vectors );
 
     if ( this->M_orderDerivative == 2 )
     {
-        itb++;
-
         //update acceleration
-        feVector_Type accelerationTemp ( solution );
-        accelerationTemp *= this->M_xi[ 0 ] / ( this->M_timeStep * this->M_timeStep);
-        accelerationTemp -= * this->M_rhsContribution[ 1 ];
-
-        *itb = new feVector_Type ( accelerationTemp );
+        coefficients[0] = this->M_xi[ 0 ] / ( this->M_timeStep * this->M_timeStep);
+        vectors[1] = this->M_rhsContribution[ 1 ];
+        timeAdvanceLinearCombination ( *this->M_unknowns[2], coefficients, vectors );
     }
     return;
 }
@@ -354,15 +343,20 @@ template<typename feVectorType>
 void
 TimeAdvanceNewmark<feVectorType>::RHSFirstDerivative (const Real& timeStep, feVectorType& rhsContribution ) const
 {
-    rhsContribution *=  (this->M_alpha[ 1 ] / timeStep) ;
+    // One pass on the data, without temporary vectors
+    std::vector<Real> coefficients;
+    std::vector<const feVectorType*> vectors;
 
     Real timeStepPower (1.); // was: std::pow( timeStep, static_cast<Real>(i - 1 ) )
 
     for (UInt i = 1; i  < this->M_firstOrderDerivativeSize; ++i )
     {
-        rhsContribution += ( this->M_alpha[ i + 1 ] * timeStepPower ) *  (* this->M_unknowns[ i ]);
+        coefficients.push_back ( this->M_alpha[ i + 1 ] * timeStepPower );
+        vectors.push_back ( this->M_unknowns[ i ] );
         timeStepPower *= timeStep;
     }
+
+    timeAdvanceLinearCombination ( rhsContribution, coefficients, vectors, this->M_alpha[ 1 ] / timeStep );
 }
 
 template<typename feVectorType>
@@ -371,14 +365,25 @@ TimeAdvanceNewmark<feVectorType>::updateRHSSecondDerivative (const Real& timeSte
 {
     feVectorContainerPtrIterate_Type it =  this->M_rhsContribution.end() - 1;
 
-    *it = new feVector_Type (*this->M_unknowns[0]);
+    if ( *it == NULL )
+    {
+        *it = new feVector_Type (*this->M_unknowns[0]);
+    }
+    else
+    {
+        **it = *this->M_unknowns[0];
+    }
 
-    ** it *=  this->M_xi[ 1 ] / (timeStep * timeStep) ;
+    std::vector<Real> coefficients;
+    std::vector<const feVectorType*> vectors;
 
     for ( UInt i = 1;  i < this->M_secondOrderDerivativeSize; ++i )
     {
-        **it += ( this->M_xi[ i + 1 ] * std::pow (timeStep, static_cast<Real> (i - 2) ) ) * ( *this->M_unknowns[ i ]);
+        coefficients.push_back ( this->M_xi[ i + 1 ] * std::pow (timeStep, static_cast<Real> (i - 2) ) );
+        vectors.push_back ( this->M_unknowns[ i ] );
     }
+
+    timeAdvanceLinearCombination ( **it, coefficients, vectors, this->M_xi[ 1 ] / (timeStep * timeStep) );
 }
 
 template<typename feVectorType>
@@ -671,12 +676,16 @@ template<typename feVectorType>
 void
 TimeAdvanceNewmark<feVectorType>::extrapolation (feVector_Type& extrapolation) const
 {
-    extrapolation += this->M_timeStep * ( *this->M_unknowns[ 1 ]);
+    std::vector<Real> coefficients ( 1, this->M_timeStep );
+    std::vector<const feVectorType*> vectors ( 1, this->M_unknowns[ 1 ] );
 
     if ( this->M_orderDerivative == 2 )
     {
-        extrapolation += ( this->M_timeStep * this->M_timeStep ) / 2.0 * ( *this->M_unknowns[2]);
+        coefficients.push_back ( ( this->M_timeStep * this->M_timeStep ) / 2.0 );
+        vectors.push_back ( this->M_unknowns[ 2 ] );
     }
+
+    timeAdvanceLinearCombination ( extrapolation, coefficients, vectors, 1. );
 }
 
 
@@ -687,8 +696,13 @@ TimeAdvanceNewmark<feVectorType>::extrapolationFirstDerivative (feVector_Type& e
     ASSERT ( this->M_orderDerivative == 2,
              "extrapolationFirstDerivative: this method must be used with the second order problem." )
 
-    extrapolation = *this->M_unknowns[1];
-    extrapolation += this->M_timeStep * ( *this->M_unknowns[ 2 ]);
+    std::vector<Real> coefficients ( 2, 1. );
+    std::vector<const feVectorType*> vectors ( 1, this->M_unknowns[ 1 ] );
+
+    coefficients[1] = this->M_timeStep;
+    vectors.push_back ( this->M_unknowns[ 2 ] );
+
+    timeAdvanceLinearCombination ( extrapolation, coefficients, vectors );
 }
 
 // ===================================================
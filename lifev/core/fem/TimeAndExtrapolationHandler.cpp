@@ -49,29 +49,25 @@ TimeAndExtrapolationHandler::initialize(const std::vector<vector_Type> InitialDa
 
     ASSERT( InitialData.size() == M_sizeStencil, "Wrong initial data dimension, it has to be of size equal max(M_BDForder, M_maximumExtrapolationOrder)");
 
-    for ( int i = 0; i < M_sizeStencil; ++i )
-        M_states.push_back(InitialData[i]);
+    // the initial data goes from u_{n-(p-1)} to u_n, the pool from u_n to u_{n-(p-1)}
+    M_states.setup( std::vector<vector_Type>( InitialData.rbegin(), InitialData.rend() ) );
 }
 
 void
-TimeAndExtrapolationHandler::shift(const vector_Type newVector)
+TimeAndExtrapolationHandler::shift(const vector_Type& newVector)
 {
-    switch (M_sizeStencil) {
-        case 1: // size 1: we just replace the last entry by the new vector
-            M_states[M_sizeStencil-1] = newVector;
-            break;
-        case 2: // size 2
-            M_states[M_sizeStencil-2] = M_states[M_sizeStencil-1];
-            M_states[M_sizeStencil-1] = newVector;
-            break;
-        case 3: // size 3
-        	M_states[M_sizeStencil-3] = M_states[M_sizeStencil-2];
-        	M_states[M_sizeStencil-2] = M_states[M_sizeStencil-1];
-        	M_states[M_sizeStencil-1] = newVector;
-        	break;
-        default:
-            break;
-    }
+    M_states.shift(newVector);
+}
+
+std::vector<TimeAndExtrapolationHandler::vector_Type>
+TimeAndExtrapolationHandler::state()
+{
+    std::vector<vector_Type> states;
+
+    for ( UInt i = M_states.size(); i > 0; --i )
+        states.push_back(M_states[i-1]);
+
+    return states;
 }
 
 void
@@ -80,13 +76,14 @@ TimeAndExtrapolationHandler::extrapolate(const UInt order, vector_Type& extrapol
     ASSERT( order <= M_maximumExtrapolationOrder, "Order of extrapolation is higher than the maximum order previously set");
     switch (order) {
         case 1:
-            extrapolation = M_states[M_sizeStencil-1]; // u_star = u_n
+            extrapolation = M_states[0]; // u_star = u_n
             break;
         case 2:
-            extrapolation = 2*M_states[M_sizeStencil-1] - M_states[M_sizeStencil-2]; // u_star = 2*u_n - u_{n-1}
+            extrapolation.linearCombination(2.0, M_states[0], -1.0, M_states[1]); // u_star = 2*u_n - u_{n-1}
             break;
         case 3:
-        	extrapolation = 3*M_states[M_sizeStencil-1] - 3*M_states[M_sizeStencil-2] + M_states[M_sizeStencil-3]; // u_star = 3*u_n - 3*u_{n-1} + u_{n-2}
+        	extrapolation.linearCombination(3.0, M_states[0], -3.0, M_states[1]); // u_star = 3*u_n - 3*u_{n-1} + u_{n-2}
+        	extrapolation.linearCombination(1.0, M_states[2], 1.0);
         	break;
         default:
             break;
@@ -100,13 +97,14 @@ TimeAndExtrapolationHandler::rhsContribution(vector_Type& rhs_bdf)
 
     switch (M_BDForder) {
         case 1:
-            rhs_bdf = 1/M_timeStep*M_states[M_sizeStencil-1]; // u_rhs = 1/dt*u_n
+            rhs_bdf = 1/M_timeStep*M_states[0]; // u_rhs = 1/dt*u_n
             break;
         case 2:
-            rhs_bdf = 1/M_timeStep*(2*M_states[M_sizeStencil-1] - (1.0/2.0)*M_states[M_sizeStencil-2]); // u_rhs = 1/dt*(2*u_n - 0.5*u_{n-1})
+            rhs_bdf.linearCombination(2.0/M_timeStep, M_states[0], -0.5/M_timeStep, M_states[1]); // u_rhs = 1/dt*(2*u_n - 0.5*u_{n-1})
             break;
         case 3:
-        	rhs_bdf = 1/M_timeStep*(3*M_states[M_sizeStencil-1] - (3.0/2.0)*M_states[M_sizeStencil-2] + (1.0/3.0)*M_states[M_sizeStencil-3]); // u_rhs = 1/dt*(3*u_n - 3/2*u_{n-1} + 1/3*u_{n-2})
+        	rhs_bdf.linearCombination(3.0/M_timeStep, M_states[0], -1.5/M_timeStep, M_states[1]); // u_rhs = 1/dt*(3*u_n - 3/2*u_{n-1} + 1/3*u_{n-2})
+        	rhs_bdf.linearCombination(1.0/(3.0*M_timeStep), M_states[2], 1.0);
         	break;
         default:
             break;
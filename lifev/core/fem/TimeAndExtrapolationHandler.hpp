@@ -14,6 +14,7 @@
 #include <lifev/core/LifeV.hpp>
 
 #include <lifev/core/array/VectorEpetra.hpp>
+#include <lifev/core/fem/TimeAdvanceHistory.hpp>
 
 namespace LifeV
 {
@@ -25,6 +26,8 @@ class TimeAndExtrapolationHandler
 
     typedef std::shared_ptr<vector_Type> vectorPtr_Type;
 
+    typedef TimeAdvanceHistory<vector_Type> history_Type;
+
 public:
 
     // empty constructor
@@ -45,11 +48,15 @@ public:
     // initialize the time handler class with initial data, need a vector of M_order vectorEpetra
     void initialize(const std::vector<vector_Type> InitialData);
 
-    // shift - to be used when a timestep is solved
-    void shift(const vector_Type newVector);
+    // shift - to be used when a timestep is solved (the oldest state is overwritten, no allocation).
+    // The new state is taken by reference (it was taken by value): it may also be one of the stored states
+    void shift(const vector_Type& newVector);
+
+    // getter for the state, from u_{n-(p-1)} to u_n (copy of the states)
+    std::vector<vector_Type> state();
 
-    // getter for the state
-    std::vector<vector_Type> state()
+    // getter for the pool of the states: history()[i] is u_{n-i}
+    const history_Type& history() const
     {
         return M_states;
     }
@@ -74,8 +81,8 @@ private:
     // maximum order used for extrapolation
     UInt M_maximumExtrapolationOrder;
 
-    // vector with the state variable at time n, n-1, .., n-(p-1)
-    std::vector<vector_Type> M_states;
+    // pool with the state variable at time n, n-1, .., n-(p-1)
+    history_Type M_states;
 
     // variable that contains the bigger value between M_BDForder and M_maximumExtrapolationOrder
     UInt M_sizeStencil;
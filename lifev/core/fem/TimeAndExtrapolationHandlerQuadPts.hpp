@@ -12,6 +12,7 @@
  */
 
 #include <lifev/core/LifeV.hpp>
+#include <lifev/core/fem/TimeAdvanceHistory.hpp>
 
 namespace LifeV
 {
@@ -24,6 +25,8 @@ class TimeAndExtrapolationHandlerQuadPts
 
     typedef std::shared_ptr<vector_Type> vectorPtr_Type;
 
+    typedef TimeAdvanceHistory<vector_Type> history_Type;
+
 public:
 
     // empty constructor
@@ -41,11 +44,21 @@ public:
     // initialize the time handler class with initial data, need a vector of M_order vectorEpetra
     void initialize(const std::vector<vector_Type> InitialData);
 
-    // shift - to be used when a timestep is solved
-    void shift(const vector_Type newVector);
+    // shift - to be used when a timestep is solved (the oldest state is overwritten, no allocation).
+    // The new state is taken by reference (it was taken by value): it may also be one of the stored states
+    void shift(const vector_Type& newVector);
 
-    // getter for the state
+    // getter for the state, from u_{n-(p-1)} to u_n (copy of the states)
     std::vector<vector_Type> state()
+    {
+        std::vector<vector_Type> states;
+        for ( UInt i = M_states.size(); i > 0; --i )
+            states.push_back(M_states[i-1]);
+        return states;
+    }
+
+    // getter for the pool of the states: history()[i] is u_{n-i}
+    const history_Type& history() const
     {
         return M_states;
     }
@@ -67,8 +80,8 @@ private:
     // order of the BDF scheme used
     UInt M_BDForder;
 
-    // vector with the state variable at time n, n-1, .., n-(p-1)
-    std::vector<vector_Type> M_states;
+    // pool with the state variable at time n, n-1, .., n-(p-1)
+    history_Type M_states;
 
     // variable that contains the bigger value between M_BDForder and M_maximumExtrapolationOrder
     UInt M_sizeStencil;
@@ -120,30 +133,15 @@ TimeAndExtrapolationHandlerQuadPts<DIM>::initialize(const std::vector<vector_Typ
 
     ASSERT( InitialData.size() == M_sizeStencil, "Wrong initial data dimension, it has to be of size equal max(M_BDForder, M_maximumExtrapolationOrder)");
 
-    for ( int i = 0; i < M_sizeStencil; ++i )
-        M_states.push_back(InitialData[i]);
+    // the initial data goes from u_{n-(p-1)} to u_n, the pool from u_n to u_{n-(p-1)}
+    M_states.setup( std::vector<vector_Type>( InitialData.rbegin(), InitialData.rend() ) );
 }
 
 template <UInt DIM>
 void
-TimeAndExtrapolationHandlerQuadPts<DIM>::shift(const vector_Type newVector)
+TimeAndExtrapolationHandlerQuadPts<DIM>::shift(const vector_Type& newVector)
 {
-    switch (M_sizeStencil) {
-            case 1: // size 1: we just replace the last entry by the new vector
-            M_states[M_sizeStencil-1] = newVector;
-            break;
-            case 2: // size 2
-            M_states[M_sizeStencil-2] = M_states[M_sizeStencil-1];
-            M_states[M_sizeStencil-1] = newVector;
-            break;
-            case 3: // size 3
-            M_states[M_sizeStencil-3] = M_states[M_sizeStencil-2];
-            M_states[M_sizeStencil-2] = M_states[M_sizeStencil-1];
-            M_states[M_sizeStencil-1] = newVector;
-            break;
-        default:
-            break;
-    }
+    M_states.shift(newVector);
 }
 
 template <UInt DIM>
@@ -165,7 +163,7 @@ TimeAndExtrapolationHandlerQuadPts<DIM>::rhsContribution(vector_Type& rhs_bdf)
                 {
                     for (int k = 0 ; k < DIM; ++k ) // loop quadrature points
                     {
-                        rhs_bdf[i][j](k) = 1/M_timeStep*M_states[M_sizeStencil-1][i][j](k); // u_rhs = 1/dt*u_n
+                        rhs_bdf[i][j](k) = 1/M_timeStep*M_states[0][i][j](k); // u_rhs = 1/dt*u_n
                     }
                 }
             }
@@ -177,7 +175,7 @@ TimeAndExtrapolationHandlerQuadPts<DIM>::rhsContribution(vector_Type& rhs_bdf)
                 {
                     for (int k = 0 ; k < DIM; ++k ) // loop quadrature points
                     {
-                        rhs_bdf[i][j](k) = 1/M_timeStep*(2*M_states[M_sizeStencil-1][i][j](k) - (1.0/2.0)*M_states[M_sizeStencil-2][i][j](k));
+                        rhs_bdf[i][j](k) = 1/M_timeStep*(2*M_states[0][i][j](k) - (1.0/2.0)*M_states[1][i][j](k));
                         // u_rhs = 1/dt*(2*u_n - 0.5*u_{n-1})
                     }
                 }
@@ -190,8 +188,8 @@ TimeAndExtrapolationHandlerQuadPts<DIM>::rhsContribution(vector_Type& rhs_bdf)
                 {
                     for (int k = 0 ; k < DIM; ++k ) // loop quadrature points
                     {
-                        rhs_bdf[i][j](k) = 1/M_timeStep*(3*M_states[M_sizeStencil-1][i][j](k) - (3.0/2.0)*M_states[M_sizeStencil-2][i][j](k) +
-                                                         (1.0/3.0)*M_states[M_sizeStencil-3][i][j](k) );
+                        rhs_bdf[i][j](k) = 1/M_timeStep*(3*M_states[0][i][j](k) - (3.0/2.0)*M_states[1][i][j](k) +
+                                                         (1.0/3.0)*M_states[2][i][j](k) );
                         // u_rhs = 1/dt*(3*u_n - 3/2*u_{n-1} + 1/3*u_{n-2})
                     }
                 }
@@ -216,7 +214,7 @@ TimeAndExtrapolationHandlerQuadPts<DIM>::extrapolate(vector_Type& extrapolation)
                 {
                     for (int k = 0 ; k < DIM; ++k ) // loop quadrature points
                     {
-                        extrapolation[i][j](k) = M_states[M_sizeStencil-1][i][j](k); // u_star = u_n
+                        extrapolation[i][j](k) = M_states[0][i][j](k); // u_star = u_n
                     }
                 }
             }
@@ -228,7 +226,7 @@ TimeAndExtrapolationHandlerQuadPts<DIM>::extrapolate(vector_Type& extrapolation)
                 {
                     for (int k = 0 ; k < DIM; ++k ) // loop quadrature points
                     {
-                        extrapolation[i][j](k) = 2*M_states[M_sizeStencil-1][i][j](k) - M_states[M_sizeStencil-2][i][j](k);
+                        extrapolation[i][j](k) = 2*M_states[0][i][j](k) - M_states[1][i][j](k);
                         // u_star = 2*u_n - u_{n-1}
                     }
                 }
@@ -241,8 +239,8 @@ TimeAndExtrapolationHandlerQuadPts<DIM>::extrapolate(vector_Type& extrapolation)
                 {
                     for (int k = 0 ; k < DIM; ++k ) // loop quadrature points
                     {
-                        extrapolation[i][j](k) = 3.0*M_states[M_sizeStencil-1][i][j](k) - 3.0*M_states[M_sizeStencil-2][i][j](k) +
-                                                     M_states[M_sizeStencil-3][i][j](k);
+                        extrapolation[i][j](k) = 3.0*M_states[0][i][j](k) - 3.0*M_states[1][i][j](k) +
+                                                     M_states[2][i][j](k);
                         // u_star = 3*u_n - 3*u_{n-1} + u_{n-2}
                     }
                 }
@@ -378,32 +378,25 @@ void RBFrescaledVectorial<mesh_Type>::interpolate()
     precRawPtr->setDataFromGetPot ( M_datafile, "prec" );
     precPtr.reset ( precRawPtr );
 
-    LinearSolver solverRBF1;
-    solverRBF1.setCommunicator ( M_knownField->mapPtr()->commPtr() );
-    solverRBF1.setParameters ( *M_belosList );
-    solverRBF1.setPreconditioner ( precPtr );
-
-    solverRBF1.setOperator (M_interpolationOperator);
-    solverRBF1.setRightHandSide (M_RhsF1);
-    solverRBF1.solve (gamma_f1);
-
-    LinearSolver solverRBF2;
-    solverRBF2.setCommunicator ( M_knownField->mapPtr()->commPtr() );
-    solverRBF2.setParameters ( *M_belosList );
-    solverRBF2.setPreconditioner ( precPtr );
-
-    solverRBF2.setOperator (M_interpolationOperator);
-    solverRBF2.setRightHandSide (M_RhsF2);
-    solverRBF2.solve (gamma_f2);
-
-    LinearSolver solverRBF3;
-    solverRBF3.setCommunicator ( M_knownField->mapPtr()->commPtr() );
-    solverRBF3.setParameters ( *M_belosList );
-    solverRBF3.setPreconditioner ( precPtr );
-
-    solverRBF3.setOperator (M_interpolationOperator);
-    solverRBF3.setRightHandSide (M_RhsF3);
-    solverRBF3.solve (gamma_f3);
+    // Solve the three components together
+    LinearSolver solverRBF;
+    solverRBF.setCommunicator ( M_knownField->mapPtr()->commPtr() );
+    solverRBF.setParameters ( *M_belosList );
+    solverRBF.setPreconditioner ( precPtr );
+
+    solverRBF.setOperator (M_interpolationOperator);
+
+    std::vector<vectorPtr_Type> rightHandSides;
+    rightHandSides.push_back (M_RhsF1);
+    rightHandSides.push_back (M_RhsF2);
+    rightHandSides.push_back (M_RhsF3);
+
+    std::vector<vectorPtr_Type> gammas;
+    gammas.push_back (gamma_f1);
+    gammas.push_back (gamma_f2);
+    gammas.push_back (gamma_f3);
+
+    solverRBF.solve (rightHandSides, gammas);
 
 
     vectorPtr_Type rbf_f1;
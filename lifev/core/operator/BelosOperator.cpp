@@ -56,7 +56,10 @@ namespace Operators
 
 BelosOperator::BelosOperator() :
     SolverOperator(),
-    M_linProblem ( Teuchos::rcp ( new LinearProblem ) )
+    M_linProblem ( Teuchos::rcp ( new LinearProblem ) ),
+    M_solverManagerType ( NotAValidSolverManager ),
+    M_recycle ( false ),
+    M_recycleMap ()
 {
     M_name = "BelosOperator";
 }
@@ -116,6 +119,21 @@ void BelosOperator::doSetOperator()
 {
     Teuchos::RCP<OP> tmpPtr ( M_oper.get(), false );
     M_linProblem->setOperator ( tmpPtr );
+
+    const Epetra_Map& domainMap ( M_oper->OperatorDomainMap() );
+
+    // Same map data (the stored copy shares it): nothing to compare
+    if ( M_recycleMap && M_recycleMap->DataPtr() == domainMap.DataPtr() )
+    {
+        return;
+    }
+
+    // A recycled subspace computed for an operator with another layout is meaningless
+    if ( M_recycleMap && !M_recycleMap->SameAs ( domainMap ) )
+    {
+        resetRecycleSpace();
+    }
+    M_recycleMap.reset ( new Epetra_Map ( domainMap ) );
 }
 
 void BelosOperator::doSetPreconditioner()
@@ -140,7 +158,25 @@ void BelosOperator::doSetParameterList()
     }
 
     std::string solverType ( M_pList->get<std::string> ( "Solver Manager Type" ) );
-    allocateSolver ( getSolverManagerTypeFromString ( solverType ) );
+    SolverManagerType solverManagerType ( getSolverManagerTypeFromString ( solverType ) );
+
+    // Recycling is only available with GCRODR
+    M_recycle = M_pList->get ( "Recycle Krylov Subspace", false );
+    if ( M_recycle && solverManagerType != GCRODR )
+    {
+        if ( M_comm->MyPID() == 0 )
+        {
+            std::cout << "SLV-  WARNING: Krylov subspace recycling requires GCRODR, "
+                      << solverType << " is replaced by GCRODR" << std::endl;
+        }
+        solverManagerType = GCRODR;
+    }
+
+    // The solver manager stores the recycled subspace: it is kept if possible
+    if ( !M_recycle || M_solverManager.is_null() || solverManagerType != M_solverManagerType )
+    {
+        allocateSolver ( solverManagerType );
+    }
     M_solverManager->setParameters ( sublist ( M_pList, "Trilinos: Belos List", true ) );
 
     std::string precSideStr ( M_pList->get<std::string> ( "Preconditioner Side" ) );
@@ -173,6 +209,8 @@ void BelosOperator::allocateSolver ( const SolverManagerType& solverManagerType
         M_solverManager = Teuchos::null;
     }
 
+    M_solverManagerType = solverManagerType;
+
     switch ( solverManagerType )
     {
         case NotAValidSolverManager:
@@ -287,9 +325,19 @@ BelosOperator::getPreconditionerSideFromString ( const std::string& str )
     }
 }
 
+void
+BelosOperator::resetRecycleSpace()
+{
+    if ( M_recycle && !M_solverManager.is_null() )
+    {
+        M_solverManager->reset ( Belos::RecycleSubspace );
+    }
+}
+
 void
 BelosOperator::doResetSolver()
 {
+    // Only the problem is reset: the recycled subspace, if any, is kept
     M_solverManager->reset (Belos::Problem);
     M_belosPrec = Teuchos::null;
 }
@@ -50,6 +50,27 @@ namespace Operators
 //! @class BelosOperator
 /*! @brief Class which defines the interface of an Invertible Linear Operator through belos.
  *
+ *  When the parameter "Recycle Krylov Subspace" of the operator list is true, the
+ *  GCRODR solver manager is used and it is kept alive between the calls to
+ *  ApplyInverse: the deflation subspace computed by a solve is recycled by the next
+ *  ones, which is useful for a sequence of slowly varying systems (e.g. time steps).
+ *  The image of the recycled subspace is recomputed by Belos at each solve with the
+ *  current operator and preconditioner; the subspace itself is discarded when the
+ *  operator maps change or when resetRecycleSpace is called.
+ *  The size of the subspace is set by "Num Recycled Blocks" in the "Trilinos: Belos List".
+ *
+ *  Example of operator list:
+ *  @verbatim
+    <ParameterList name="Solver: Operator List">
+        <Parameter name="Solver Manager Type" type="string" value="GCRODR"/>
+        <Parameter name="Recycle Krylov Subspace" type="bool" value="true"/>
+        <Parameter name="Preconditioner Side" type="string" value="Right"/>
+        <ParameterList name="Trilinos: Belos List">
+            <Parameter name="Num Blocks" type="int" value="50"/>
+            <Parameter name="Num Recycled Blocks" type="int" value="10"/>
+        </ParameterList>
+    </ParameterList>
+    @endverbatim
  */
 
 class BelosOperator : public SolverOperator
@@ -74,6 +95,24 @@ public:
     ~BelosOperator();
     //@}
 
+    //! @name Methods
+    //@{
+
+    //! Discard the recycled Krylov subspace
+    /*!
+      The next solve builds a new subspace from scratch. This should be called when
+      the operator changes abruptly (e.g. after a remeshing).
+     */
+    void resetRecycleSpace();
+
+    //! Returns true if the Krylov subspace is recycled between the solves
+    bool recycleKrylovSubspace() const
+    {
+        return M_recycle;
+    }
+
+    //@}
+
 protected:
 
     typedef Epetra_MultiVector MV;
@@ -96,6 +135,12 @@ protected:
     SolverType_ptr M_solverManager;
     //! Cast to a Belos Preconditioner
     Teuchos::RCP<Belos::EpetraPrecOp> M_belosPrec;
+    //! Type of the allocated solver manager
+    SolverManagerType M_solverManagerType;
+    //! Recycle the Krylov subspace between the solves
+    bool M_recycle;
+    //! Domain map of the operator for which the recycled subspace has been computed
+    std::shared_ptr<Epetra_Map> M_recycleMap;
 
     static SolverManagerType  getSolverManagerTypeFromString ( const std::string& str );
     static PreconditionerSide getPreconditionerSideFromString ( const std::string& str );
@@ -0,0 +1,651 @@
+//@HEADER
+/*
+*******************************************************************************
+
+    Copyright (C) 2004, 2005, 2007 EPFL, Politecnico di Milano, INRIA
+    Copyright (C) 2010 EPFL, Politecnico di Milano, Emory University
+
+    This file is part of LifeV.
+
+    LifeV is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    LifeV is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with LifeV.  If not, see <http://www.gnu.org/licenses/>.
+
+*******************************************************************************
+*/
+//@HEADER
+
+/*!
+    @file
+    @brief PipelinedKrylovOperator
+
+    @date 10-2026
+ */
+
+#include <algorithm>
+#include <cmath>
+
+#include <lifev/core/operator/PipelinedKrylovOperator.hpp>
+
+namespace LifeV
+{
+namespace Operators
+{
+
+namespace
+{
+
+//! Sum of a set of values over the processors, non blocking when MPI allows it
+class SumReduction
+{
+public:
+
+    explicit SumReduction ( const Epetra_Comm& comm ) :
+        M_comm ( comm ),
+        M_local (),
+        M_global ()
+#if defined(HAVE_MPI) && MPI_VERSION >= 3
+        , M_mpiComm ( MPI_COMM_NULL ),
+        M_request ( MPI_REQUEST_NULL )
+#endif
+    {
+#if defined(HAVE_MPI) && MPI_VERSION >= 3
+        const Epetra_MpiComm* mpiComm = dynamic_cast<const Epetra_MpiComm*> ( &comm );
+        if ( mpiComm )
+        {
+            M_mpiComm = mpiComm->Comm();
+        }
+#endif
+    }
+
+    //! Start the reduction of the local values
+    void start ( const std::vector<Real>& local )
+    {
+        // The buffers must stay alive until the end of the reduction
+        M_local = local;
+        M_global.resize ( M_local.size() );
+
+#if defined(HAVE_MPI) && MPI_VERSION >= 3
+        if ( M_mpiComm != MPI_COMM_NULL )
+        {
+            MPI_Iallreduce ( &M_local[0], &M_global[0], M_local.size(), MPI_DOUBLE, MPI_SUM, M_mpiComm, &M_request );
+            return;
+        }
+#endif
+        M_comm.SumAll ( &M_local[0], &M_global[0], M_local.size() );
+    }
+
+    //! Wait for the end of the reduction and return the global values
+    const std::vector<Real>& wait()
+    {
+#if defined(HAVE_MPI) && MPI_VERSION >= 3
+        if ( M_request != MPI_REQUEST_NULL )
+        {
+            MPI_Wait ( &M_request, MPI_STATUS_IGNORE );
+        }
+#endif
+        return M_global;
+    }
+
+private:
+
+    const Epetra_Comm& M_comm;
+    std::vector<Real>  M_local;
+    std::vector<Real>  M_global;
+#if defined(HAVE_MPI) && MPI_VERSION >= 3
+    MPI_Comm           M_mpiComm;
+    MPI_Request        M_request;
+#endif
+};
+
+//! Dot product of the local parts of two vectors
+Real localDot ( const Epetra_Vector& x, const Epetra_Vector& y )
+{
+    const Real* xValues ( x.Values() );
+    const Real* yValues ( y.Values() );
+    const Int length ( x.MyLength() );
+
+    Real dot ( 0. );
+    for ( Int i ( 0 ); i < length; ++i )
+    {
+        dot += xValues[i] * yValues[i];
+    }
+    return dot;
+}
+
+//! Solve G y = c with a Cholesky factorization truncated at the first vanishing pivot
+/*!
+  G is a dense n x n Gram matrix stored by rows. It is scaled to have a unit diagonal,
+  so that the pivot k measures how far the vector k is from the span of the previous ones.
+  @return The number of vectors actually used (y has this size)
+ */
+Int truncatedCholeskySolve ( const std::vector<Real>& G, const Int& n, const std::vector<Real>& c, std::vector<Real>& y )
+{
+    const Real pivotTolerance ( 1e-10 );
+
+    std::vector<Real> scaling ( n, 0. );
+    for ( Int k ( 0 ); k < n; ++k )
+    {
+        if ( G[k * n + k] > 0. )
+        {
+            scaling[k] = 1. / std::sqrt ( G[k * n + k] );
+        }
+    }
+
+    // Left-looking factorization of the leading block
+    std::vector<Real> L ( n * n, 0. );
+    Int dimension ( 0 );
+    for ( ; dimension < n; ++dimension )
+    {
+        const Int k ( dimension );
+        if ( scaling[k] == 0. )
+        {
+            break;
+        }
+
+        Real pivot ( scaling[k] * scaling[k] * G[k * n + k] );
+        for ( Int j ( 0 ); j < k; ++j )
+        {
+            pivot -= L[k * n + j] * L[k * n + j];
+        }
+        if ( pivot <= pivotTolerance )
+        {
+            break;
+        }
+        L[k * n + k] = std::sqrt ( pivot );
+
+        for ( Int i ( k + 1 ); i < n; ++i )
+        {
+            Real value ( scaling[i] * scaling[k] * G[i * n + k] );
+            for ( Int j ( 0 ); j < k; ++j )
+            {
+                value -= L[i * n + j] * L[k * n + j];
+            }
+            L[i * n + k] = value / L[k * n + k];
+        }
+    }
+
+    // Forward and backward substitutions on the scaled system
+    y.assign ( dimension, 0. );
+    for ( Int i ( 0 ); i < dimension; ++i )
+    {
+        Real value ( scaling[i] * c[i] );
+        for ( Int j ( 0 ); j < i; ++j )
+        {
+            value -= L[i * n + j] * y[j];
+        }
+        y[i] = value / L[i * n + i];
+    }
+    for ( Int i ( dimension - 1 ); i >= 0; --i )
+    {
+        Real value ( y[i] );
+        for ( Int j ( i + 1 ); j < dimension; ++j )
+        {
+            value -= L[j * n + i] * y[j];
+        }
+        y[i] = value / L[i * n + i];
+    }
+    for ( Int i ( 0 ); i < dimension; ++i )
+    {
+        y[i] *= scaling[i];
+    }
+
+    return dimension;
+}
+
+} // anonymous namespace
+
+const int PipelinedKrylovOperator::S_maxStepsPerReduction = 8;
+
+PipelinedKrylovOperator::PipelinedKrylovOperator() :
+    SolverOperator(),
+    M_method ( PipelinedCG ),
+    M_convergenceTolerance ( 1e-6 ),
+    M_maximumIterations ( 200 ),
+    M_stepsPerReduction ( 4 )
+{
+    M_name = "PipelinedKrylovOperator";
+}
+
+int
+PipelinedKrylovOperator::doApplyInverse ( const vector_Type& X, vector_Type& Y ) const
+{
+    vector_Type Xcopy ( X );
+    Y.PutScalar ( 0.0 );
+
+    M_numIterations  = 0;
+    M_lossOfAccuracy = no;
+    bool allConverged ( true );
+
+    for ( Int i ( 0 ); i < Xcopy.NumVectors(); ++i )
+    {
+        const column_Type& b = * ( Xcopy ( i ) );
+        column_Type& x = * ( Y ( i ) );
+
+        bool converged ( false );
+        int numIterations ( 0 );
+        switch ( M_method )
+        {
+            case PipelinedCG:
+                numIterations = solvePipelinedCG ( b, x, converged );
+                break;
+            case SStepGmres:
+                numIterations = solveSStepGmres ( b, x, converged );
+                break;
+            default:
+                ERROR_MSG ( "PipelinedKrylovOperator: method not found!" );
+        }
+        M_numIterations = std::max ( M_numIterations, numIterations );
+
+        // The recursive residual may drift away from the true one
+        column_Type residual ( b.Map(), false );
+        Real referenceNorm;
+        b.Norm2 ( &referenceNorm );
+        if ( converged && trueResidualNorm ( b, x, residual ) > 10. * M_convergenceTolerance * referenceNorm )
+        {
+            M_lossOfAccuracy = yes;
+        }
+
+        allConverged = allConverged && converged;
+    }
+
+    if ( allConverged )
+    {
+        M_converged = yes;
+        return 0;
+    }
+
+    M_converged = no;
+    return -1;
+}
+
+void
+PipelinedKrylovOperator::doSetOperator()
+{
+
+}
+
+void
+PipelinedKrylovOperator::doSetPreconditioner()
+{
+
+}
+
+void
+PipelinedKrylovOperator::doSetParameterList()
+{
+    Teuchos::ParameterList& list = M_pList->sublist ( "Pipelined Krylov List" );
+
+    M_method = getMethodFromString ( list.get ( "Method", std::string ( "PipelinedCG" ) ) );
+    if ( M_method == NotAValidMethod )
+    {
+        ERROR_MSG ( "PipelinedKrylovOperator: unknown Method (PipelinedCG, SStepGmres)" );
+    }
+
+    M_convergenceTolerance = list.get ( "Convergence Tolerance", 1e-6 );
+    if ( M_tolerance > 0 )
+    {
+        M_convergenceTolerance = M_tolerance;
+    }
+    M_maximumIterations = list.get ( "Maximum Iterations", 200 );
+    M_stepsPerReduction = list.get ( "Steps Per Reduction", 4 );
+    ASSERT ( M_stepsPerReduction > 0, "PipelinedKrylovOperator: Steps Per Reduction must be positive" );
+
+    // The monomial basis of a block gets ill conditioned quickly: beyond 8 steps
+    // the Gram matrix is not accurate enough for the orthogonalization
+    if ( M_stepsPerReduction > S_maxStepsPerReduction )
+    {
+        if ( M_comm->MyPID() == 0 )
+        {
+            std::cout << "SLV-  WARNING: " << M_stepsPerReduction << " steps per reduction are too many for SStepGmres, "
+                      << S_maxStepsPerReduction << " are used" << std::endl;
+        }
+        M_stepsPerReduction = S_maxStepsPerReduction;
+    }
+}
+
+void
+PipelinedKrylovOperator::doResetSolver()
+{
+
+}
+
+//============================================================================//
+//                     Protected or Private Methods                           //
+//============================================================================//
+int
+PipelinedKrylovOperator::solvePipelinedCG ( const column_Type& b, column_Type& x, bool& converged ) const
+{
+    const Epetra_BlockMap& map ( b.Map() );
+
+    // The initial guess is zero, hence r = b
+    column_Type r ( b );
+    column_Type u ( map ), w ( map ), m ( map ), n ( map );
+    column_Type z ( map ), q ( map ), s ( map ), p ( map );
+
+    applyPreconditioner ( r, u );
+    M_oper->Apply ( u, w );
+
+    SumReduction reduction ( b.Comm() );
+    std::vector<Real> local ( 3 );
+
+    Real gammaOld ( 0. );
+    Real alphaOld ( 0. );
+    Real referenceNorm ( 0. );
+    converged = false;
+
+    int iteration ( 0 );
+    for ( ; ; ++iteration )
+    {
+        // gamma = (r, u), delta = (w, u) and |r|^2 in a single reduction...
+        local[0] = localDot ( r, u );
+        local[1] = localDot ( w, u );
+        local[2] = localDot ( r, r );
+        reduction.start ( local );
+
+        // ...overlapped with m = M^{-1} w and n = A m
+        applyPreconditioner ( w, m );
+        M_oper->Apply ( m, n );
+
+        const std::vector<Real>& global = reduction.wait();
+        const Real gamma ( global[0] );
+        const Real delta ( global[1] );
+        const Real residualNorm ( std::sqrt ( global[2] ) );
+
+        if ( iteration == 0 )
+        {
+            referenceNorm = residualNorm;
+        }
+        if ( residualNorm <= M_convergenceTolerance * referenceNorm )
+        {
+            converged = true;
+            break;
+        }
+        if ( iteration == M_maximumIterations )
+        {
+            break;
+        }
+
+        Real beta ( 0. );
+        Real denominator ( delta );
+        if ( iteration > 0 )
+        {
+            beta = gamma / gammaOld;
+            denominator = delta - beta * gamma / alphaOld;
+        }
+        if ( ! ( std::abs ( denominator ) > 0. ) )
+        {
+            // Breakdown
+            break;
+        }
+        const Real alpha ( gamma / denominator );
+
+        z.Update ( 1., n, beta );
+        q.Update ( 1., m, beta );
+        s.Update ( 1., w, beta );
+        p.Update ( 1., u, beta );
+
+        x.Update (  alpha, p, 1. );
+        r.Update ( -alpha, s, 1. );
+        u.Update ( -alpha, q, 1. );
+        w.Update ( -alpha, z, 1. );
+
+        gammaOld = gamma;
+        alphaOld = alpha;
+    }
+
+    return iteration;
+}
+
+int
+PipelinedKrylovOperator::solveSStepGmres ( const column_Type& b, column_Type& x, bool& converged ) const
+{
+    const Epetra_BlockMap& map ( b.Map() );
+    const Int steps ( M_stepsPerReduction );
+
+    // The initial guess is zero, hence r = b
+    column_Type r ( b );
+
+    // Krylov vectors of the previous and of the current block, with W = A Z. The slot
+    // after the last vector of a block holds its extension M^{-1} W_last (and A of it),
+    // so that M^{-1} W_k is always the vector k + 1 of the same block
+    std::vector<columnPtr_Type> previousZ ( steps + 1 ), previousW ( steps + 1 );
+    std::vector<columnPtr_Type> currentZ ( steps + 1 ), currentW ( steps + 1 );
+    for ( Int j ( 0 ); j <= steps; ++j )
+    {
+        previousZ[j].reset ( new column_Type ( map, false ) );
+        previousW[j].reset ( new column_Type ( map, false ) );
+        currentZ[j].reset ( new column_Type ( map, false ) );
+        currentW[j].reset ( new column_Type ( map, false ) );
+    }
+    columnPtr_Type nextZ ( new column_Type ( map, false ) );
+    columnPtr_Type nextW ( new column_Type ( map, false ) );
+    Int numPrevious ( 0 );
+    std::vector<Real> previousGram;
+
+    std::vector<const column_Type*> Z ( 2 * steps ), W ( 2 * steps );
+    std::vector<const column_Type*> shiftedZ ( 2 * steps ), shiftedW ( 2 * steps );
+    std::vector<Real> y;
+
+    // |b|^2 is reduced during the generation of the first block
+    SumReduction reduction ( b.Comm() );
+    std::vector<Real> local ( 1, localDot ( b, b ) );
+    reduction.start ( local );
+    bool normPending ( true );
+    Real targetNorm ( 0. );
+
+    converged = false;
+
+    // True if the first vector of the current block is already available
+    bool firstVectorReady ( false );
+
+    int iteration ( 0 );
+    while ( iteration < M_maximumIterations )
+    {
+        // Generation of the block without communication
+        const Int numCurrent ( std::min ( steps, M_maximumIterations - iteration ) );
+        if ( !firstVectorReady )
+        {
+            applyPreconditioner ( r, *currentZ[0] );
+            M_oper->Apply ( *currentZ[0], *currentW[0] );
+        }
+        for ( Int j ( 1 ); j < numCurrent; ++j )
+        {
+            applyPreconditioner ( *currentW[j - 1], *currentZ[j] );
+            M_oper->Apply ( *currentZ[j], *currentW[j] );
+        }
+        iteration += numCurrent;
+
+        if ( normPending )
+        {
+            targetNorm = M_convergenceTolerance * std::sqrt ( reduction.wait() [0] );
+            normPending = false;
+            if ( targetNorm == 0. )
+            {
+                converged = true;
+                return 0;
+            }
+        }
+
+        // Basis [previous block, current block]
+        const Int n ( numPrevious + numCurrent );
+        for ( Int k ( 0 ); k < numPrevious; ++k )
+        {
+            Z[k] = previousZ[k].get();
+            W[k] = previousW[k].get();
+            shiftedZ[k] = previousZ[k + 1].get();
+            shiftedW[k] = previousW[k + 1].get();
+        }
+        for ( Int k ( 0 ); k < numCurrent; ++k )
+        {
+            Z[numPrevious + k] = currentZ[k].get();
+            W[numPrevious + k] = currentW[k].get();
+            shiftedZ[numPrevious + k] = currentZ[k + 1].get();
+            shiftedW[numPrevious + k] = currentW[k + 1].get();
+        }
+
+        // |r|^2, (W, r) and the new entries of the Gram matrix in a single reduction...
+        local.clear();
+        local.push_back ( localDot ( r, r ) );
+        for ( Int k ( 0 ); k < n; ++k )
+        {
+            local.push_back ( localDot ( *W[k], r ) );
+        }
+        for ( Int k ( 0 ); k < n; ++k )
+        {
+            for ( Int l ( std::max ( k, numPrevious ) ); l < n; ++l )
+            {
+                local.push_back ( localDot ( *W[k], *W[l] ) );
+            }
+        }
+        reduction.start ( local );
+
+        // ...overlapped with the extension of the block, which gives the first vector
+        // of the next block without waiting for the coefficients of the minimization
+        const bool extendBlock ( iteration < M_maximumIterations );
+        if ( extendBlock )
+        {
+            applyPreconditioner ( *currentW[numCurrent - 1], *currentZ[numCurrent] );
+            M_oper->Apply ( *currentZ[numCurrent], *currentW[numCurrent] );
+        }
+
+        const std::vector<Real>& global = reduction.wait();
+
+        const Real residualSquared ( global[0] );
+        std::vector<Real> c ( global.begin() + 1, global.begin() + 1 + n );
+        std::vector<Real> G ( n * n );
+        for ( Int k ( 0 ); k < numPrevious; ++k )
+        {
+            for ( Int l ( 0 ); l < numPrevious; ++l )
+            {
+                G[k * n + l] = previousGram[k * numPrevious + l];
+            }
+        }
+        Int position ( 1 + n );
+        for ( Int k ( 0 ); k < n; ++k )
+        {
+            for ( Int l ( std::max ( k, numPrevious ) ); l < n; ++l )
+            {
+                G[k * n + l] = global[position];
+                G[l * n + k] = global[position];
+                ++position;
+            }
+        }
+
+        // Minimization of |r - W y| over the block
+        const Int dimension ( truncatedCholeskySolve ( G, n, c, y ) );
+        if ( dimension == 0 )
+        {
+            // Stagnation
+            break;
+        }
+
+        Real newResidualSquared ( residualSquared );
+        for ( Int k ( 0 ); k < dimension; ++k )
+        {
+            x.Update (  y[k], *Z[k], 1. );
+            r.Update ( -y[k], *W[k], 1. );
+            newResidualSquared -= c[k] * y[k];
+        }
+
+        // First vector of the next block: M^{-1} r = M^{-1} r_old - sum_k y_k M^{-1} W_k
+        // (the preconditioner has to be linear)
+        if ( extendBlock )
+        {
+            nextZ->Update ( 1., *currentZ[0], 0. );
+            nextW->Update ( 1., *currentW[0], 0. );
+            for ( Int k ( 0 ); k < dimension; ++k )
+            {
+                nextZ->Update ( -y[k], *shiftedZ[k], 1. );
+                nextW->Update ( -y[k], *shiftedW[k], 1. );
+            }
+        }
+
+        // The solved part of the current block becomes the previous block
+        const Int numNewPrevious ( std::max ( dimension - numPrevious, 0 ) );
+        std::vector<Real> newPreviousGram ( numNewPrevious * numNewPrevious );
+        for ( Int k ( 0 ); k < numNewPrevious; ++k )
+        {
+            for ( Int l ( 0 ); l < numNewPrevious; ++l )
+            {
+                newPreviousGram[k * numNewPrevious + l] = G[ ( numPrevious + k ) * n + numPrevious + l];
+            }
+        }
+        previousGram.swap ( newPreviousGram );
+        previousZ.swap ( currentZ );
+        previousW.swap ( currentW );
+        numPrevious = numNewPrevious;
+
+        currentZ[0].swap ( nextZ );
+        currentW[0].swap ( nextW );
+        firstVectorReady = extendBlock;
+
+        // The recursive residual is replaced by the true one to confirm the convergence
+        if ( newResidualSquared <= targetNorm * targetNorm )
+        {
+            if ( trueResidualNorm ( b, x, r ) <= targetNorm )
+            {
+                converged = true;
+                break;
+            }
+            // The next block has to start from the true residual
+            firstVectorReady = false;
+        }
+    }
+
+    return iteration;
+}
+
+void
+PipelinedKrylovOperator::applyPreconditioner ( const column_Type& x, column_Type& y ) const
+{
+    if ( M_prec )
+    {
+        M_prec->ApplyInverse ( x, y );
+    }
+    else
+    {
+        y.Update ( 1., x, 0. );
+    }
+}
+
+Real
+PipelinedKrylovOperator::trueResidualNorm ( const column_Type& b, const column_Type& x, column_Type& r ) const
+{
+    M_oper->Apply ( x, r );
+    r.Update ( 1., b, -1. );
+
+    Real norm;
+    r.Norm2 ( &norm );
+    return norm;
+}
+
+PipelinedKrylovOperator::Method
+PipelinedKrylovOperator::getMethodFromString ( const std::string& str )
+{
+    if ( str == "PipelinedCG" )
+    {
+        return PipelinedCG;
+    }
+    else if ( str == "SStepGmres" )
+    {
+        return SStepGmres;
+    }
+    else
+    {
+        return NotAValidMethod;
+    }
+}
+
+} // Namespace Operators
+
+} // Namespace LifeV
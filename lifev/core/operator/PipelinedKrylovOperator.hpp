@@ -0,0 +1,153 @@
+//@HEADER
+/*
+*******************************************************************************
+
+    Copyright (C) 2004, 2005, 2007 EPFL, Politecnico di Milano, INRIA
+    Copyright (C) 2010 EPFL, Politecnico di Milano, Emory University
+
+    This file is part of LifeV.
+
+    LifeV is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    LifeV is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with LifeV.  If not, see <http://www.gnu.org/licenses/>.
+
+*******************************************************************************
+*/
+//@HEADER
+
+/*!
+    @file
+    @brief PipelinedKrylovOperator
+
+    @date 10-2026
+ */
+
+#ifndef _PIPELINEDKRYLOVOPERATOR_HPP_
+#define _PIPELINEDKRYLOVOPERATOR_HPP_
+
+#include <vector>
+
+#include <Epetra_Vector.h>
+#include <Teuchos_ParameterList.hpp>
+
+#include <lifev/core/operator/SolverOperator.hpp>
+
+namespace LifeV
+{
+namespace Operators
+{
+//! @class PipelinedKrylovOperator
+/*! @brief Krylov solvers with few global reductions, for runs on a large number of processes.
+ *
+ *  Two methods are available, with right preconditioning:
+ *  <ul>
+ *  <li> PipelinedCG: the pipelined conjugate gradient of Ghysels and Vanroose (symmetric
+ *       positive definite systems and preconditioners). The three dot products of an
+ *       iteration are reduced together by a non blocking reduction, which is overlapped
+ *       with the application of the preconditioner and of the operator.
+ *  <li> SStepGmres: a minimal residual method on blocks of s Krylov vectors (s-step
+ *       GMRES, truncated to the previous block). The s vectors are generated without
+ *       communication; the residual is minimized over them and over the vectors of the
+ *       previous block with a Gram matrix computed by a single non blocking reduction.
+ *       The reduction is overlapped with the application of the preconditioner and of
+ *       the operator to the last vector of the block, from which the first vector of the
+ *       next block is recovered once the coefficients are known (this requires a linear
+ *       preconditioner). The method needs one reduction every s applications of the
+ *       operator instead of O(s) for GMRES.
+ *  </ul>
+ *  The convergence is checked on the residual relative to the right hand side. When the
+ *  recursively updated residual of SStepGmres converges, it is replaced by the true one
+ *  before stopping. A loss of accuracy is reported if the true residual of the solution
+ *  is larger than ten times the tolerance.
+ *
+ *  The parameters are read from the sublist "Pipelined Krylov List" of the operator list:
+ *  @verbatim
+    <ParameterList name="Solver: Operator List">
+        <ParameterList name="Pipelined Krylov List">
+            <Parameter name="Method" type="string" value="SStepGmres"/>
+            <Parameter name="Convergence Tolerance" type="double" value="1e-6"/>
+            <Parameter name="Maximum Iterations" type="int" value="200"/>
+            <Parameter name="Steps Per Reduction" type="int" value="4"/>
+        </ParameterList>
+    </ParameterList>
+    @endverbatim
+ *  The number of steps per reduction is capped to 8: the monomial basis of a block
+ *  becomes too ill conditioned beyond.
+ *  The solver is selected in LinearSolver with "Solver Type" set to "Pipelined".
+ */
+class PipelinedKrylovOperator : public SolverOperator
+{
+public:
+
+    //! @name Public Typedefs and Enumerators
+    //@{
+
+    enum Method { NotAValidMethod, PipelinedCG, SStepGmres };
+
+    //@}
+
+    //! null constructor and destructor
+    //@{
+    PipelinedKrylovOperator();
+    ~PipelinedKrylovOperator() {}
+    //@}
+
+protected:
+
+    typedef Epetra_Vector                       column_Type;
+    typedef std::shared_ptr<column_Type>        columnPtr_Type;
+
+    virtual int doApplyInverse ( const vector_Type& X, vector_Type& Y ) const;
+    virtual void doSetOperator();
+    virtual void doSetPreconditioner();
+    virtual void doSetParameterList();
+    virtual void doResetSolver();
+
+    //! Solve for one right hand side with the pipelined CG, return the number of iterations
+    int solvePipelinedCG ( const column_Type& b, column_Type& x, bool& converged ) const;
+
+    //! Solve for one right hand side with the s-step GMRES, return the number of iterations
+    int solveSStepGmres ( const column_Type& b, column_Type& x, bool& converged ) const;
+
+    //! Apply the preconditioner: y = M^{-1} x (copy if there is no preconditioner)
+    void applyPreconditioner ( const column_Type& x, column_Type& y ) const;
+
+    //! Compute the norm of the true residual b - A x
+    Real trueResidualNorm ( const column_Type& b, const column_Type& x, column_Type& r ) const;
+
+    static Method getMethodFromString ( const std::string& str );
+
+    //! The Krylov method
+    Method M_method;
+    //! Relative tolerance on the residual
+    Real M_convergenceTolerance;
+    //! Maximum number of applications of the operator
+    int M_maximumIterations;
+    //! Number of Krylov vectors generated between two reductions (SStepGmres)
+    int M_stepsPerReduction;
+
+    //! Largest number of steps per reduction (larger values are capped)
+    static const int S_maxStepsPerReduction;
+};
+
+inline SolverOperator* createPipelinedKrylovOperator()
+{
+    return new PipelinedKrylovOperator();
+}
+namespace
+{
+static bool registerPipelinedKrylov = SolverOperatorFactory::instance().registerProduct ( "Pipelined", &createPipelinedKrylovOperator );
+}
+
+} /*end namespace Operators */
+} /*end namespace LifeV */
+#endif /* _PIPELINEDKRYLOVOPERATOR_HPP_ */
@@ -0,0 +1,216 @@
+//@HEADER
+/*
+*******************************************************************************
+
+    Copyright (C) 2004, 2005, 2007 EPFL, Politecnico di Milano, INRIA
+    Copyright (C) 2010 EPFL, Politecnico di Milano, Emory University
+
+    This file is part of LifeV.
+
+    LifeV is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    LifeV is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with LifeV.  If not, see <http://www.gnu.org/licenses/>.
+
+*******************************************************************************
+*/
+//@HEADER
+
+/* ========================================================
+
+Test of the assembly of a vector field in a MatrixEpetraBlockCRS
+
+*/
+
+
+/**
+   @file test_blockcrs.cpp
+   @date 2026-10
+
+   The stiff strain of a P1 vector field (which couples all the components)
+   is assembled by nodal blocks with assembleMatrix in an open and in a
+   closed MatrixEpetraBlockCRS, and by the ADRAssembler in a MatrixEpetra.
+   The products by a vector, and the ones of the operator returned by
+   fieldOperator for a multivector, are compared.
+*/
+
+
+// ===================================================
+//! Includes
+// ===================================================
+
+#include <Epetra_ConfigDefs.h>
+#ifdef EPETRA_MPI
+#include <mpi.h>
+#include <Epetra_MpiComm.h>
+#else
+#include <Epetra_SerialComm.h>
+#endif
+
+#include <lifev/core/LifeV.hpp>
+
+#include <lifev/core/array/MatrixElemental.hpp>
+#include <lifev/core/array/MatrixEpetra.hpp>
+#include <lifev/core/array/MatrixEpetraBlockCRS.hpp>
+#include <lifev/core/array/VectorEpetra.hpp>
+
+#include <lifev/core/fem/Assembly.hpp>
+#include <lifev/core/fem/AssemblyElemental.hpp>
+#include <lifev/core/fem/FESpace.hpp>
+
+#include <lifev/core/mesh/MeshPartitioner.hpp>
+#include <lifev/core/mesh/RegionMesh3DStructured.hpp>
+#include <lifev/core/mesh/RegionMesh.hpp>
+
+#include <lifev/core/solver/ADRAssembler.hpp>
+
+using namespace LifeV;
+
+typedef RegionMesh<LinearTetra> mesh_Type;
+typedef MatrixEpetra<Real> matrix_Type;
+typedef std::shared_ptr<matrix_Type> matrixPtr_Type;
+typedef MatrixEpetraBlockCRS<Real> blockMatrix_Type;
+typedef VectorEpetra vector_Type;
+typedef FESpace<mesh_Type, MapEpetra> feSpace_Type;
+typedef std::shared_ptr<feSpace_Type> feSpacePtr_Type;
+
+// ===================================================
+//! Helpers
+// ===================================================
+
+//! Assemble the stiff strain of the space in the block matrix, element by element
+void assembleStiffStrain ( blockMatrix_Type& matrix, const feSpace_Type& space )
+{
+    const UInt fieldDim ( space.fieldDim() );
+
+    CurrentFE currentFE ( space.refFE(), space.fe().geoMap(), space.qr() );
+    MatrixElemental localMatrix ( space.fe().nbFEDof(), fieldDim, fieldDim );
+
+    for ( UInt iElement ( 0 ); iElement < space.mesh()->numElements(); ++iElement )
+    {
+        currentFE.update ( space.mesh()->element ( iElement ), UPDATE_DPHI | UPDATE_WDET );
+
+        localMatrix.zero();
+        AssemblyElemental::stiffStrain ( localMatrix, currentFE, 2.0, fieldDim );
+
+        assembleMatrix ( matrix, localMatrix, currentFE, space.dof() );
+    }
+}
+
+//! Norm of A x - B x
+Real productDifference ( const matrix_Type& A, const blockMatrix_Type& B, const vector_Type& x )
+{
+    vector_Type Ax ( x.map(), Unique );
+    vector_Type Bx ( x.map(), Unique );
+    A.multiply ( false, x, Ax );
+    B.multiply ( false, x, Bx );
+    Ax -= Bx;
+    return Ax.normInf();
+}
+
+// ===================================================
+//! Main
+// ===================================================
+int main ( int argc, char** argv )
+{
+#ifdef HAVE_MPI
+    MPI_Init ( &argc, &argv );
+    std::shared_ptr<Epetra_Comm> comm ( new Epetra_MpiComm ( MPI_COMM_WORLD ) );
+#else
+    std::shared_ptr<Epetra_Comm> comm ( new Epetra_SerialComm );
+#endif
+
+    const bool verbose ( comm->MyPID() == 0 );
+
+    // Mesh and FE space
+    std::shared_ptr<mesh_Type> fullMeshPtr ( new mesh_Type );
+    regularMesh3D ( *fullMeshPtr, 1, 5, 5, 5, false,
+                    1.0,   1.0,   1.0,
+                    0.0,   0.0,   0.0 );
+
+    std::shared_ptr<mesh_Type> meshPtr;
+    {
+        MeshPartitioner<mesh_Type> meshPart ( fullMeshPtr, comm );
+        meshPtr = meshPart.meshPartition();
+    }
+    fullMeshPtr.reset();
+
+    feSpacePtr_Type wFESpace ( new feSpace_Type ( meshPtr, "P1", 3, comm ) );
+
+    // Reference matrix
+    ADRAssembler<mesh_Type, matrix_Type, vector_Type> adrAssembler;
+    adrAssembler.setup ( wFESpace, wFESpace );
+
+    matrixPtr_Type reference ( new matrix_Type ( wFESpace->map() ) );
+    adrAssembler.addStiffStrain ( reference, 1.0 );
+    reference->globalAssemble();
+
+    vector_Type x ( wFESpace->map(), Unique );
+    x.epetraVector().Random();
+
+    // Open block matrix
+    blockMatrix_Type blockMatrix ( wFESpace->map(), 3 );
+    assembleStiffStrain ( blockMatrix, *wFESpace );
+    blockMatrix.globalAssemble();
+
+    const Real openError ( productDifference ( *reference, blockMatrix, x ) );
+
+    // Same block matrix, closed
+    blockMatrix.zero();
+    assembleStiffStrain ( blockMatrix, *wFESpace );
+    blockMatrix.globalAssemble();
+
+    const Real closedError ( productDifference ( *reference, blockMatrix, x ) );
+
+    // Operator on the vectors of the field, applied to two vectors at once
+    std::shared_ptr<Epetra_Operator> blockOperator ( blockMatrix.fieldOperator() );
+
+    Epetra_MultiVector X ( blockOperator->OperatorDomainMap(), 2 );
+    Epetra_MultiVector Y ( blockOperator->OperatorRangeMap(), 2 );
+    Epetra_MultiVector Z ( blockOperator->OperatorRangeMap(), 2 );
+    X.Random();
+
+    blockOperator->Apply ( X, Y );
+    reference->matrixPtr()->Multiply ( false, X, Z );
+    Y.Update ( -1.0, Z, 1.0 );
+
+    std::vector<Real> operatorErrors ( 2 );
+    Y.NormInf ( &operatorErrors[0] );
+    const Real operatorError ( std::max ( operatorErrors[0], operatorErrors[1] ) );
+
+    if ( verbose )
+    {
+        std::cout << " Error (open block matrix): " << openError << std::endl;
+        std::cout << " Error (closed block matrix): " << closedError << std::endl;
+        std::cout << " Error (field operator): " << operatorError << std::endl;
+    }
+
+#ifdef HAVE_MPI
+    MPI_Finalize();
+#endif
+
+    const Real testTolerance ( 1e-12 );
+
+    if ( openError >= testTolerance || closedError >= testTolerance || operatorError >= testTolerance )
+    {
+        if ( verbose )
+        {
+            std::cout << "Test status: FAILURE" << std::endl;
+        }
+        return EXIT_FAILURE;
+    }
+
+    if ( verbose )
+    {
+        std::cout << "Test status: SUCCESS" << std::endl;
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,201 @@
+//@HEADER
+/*
+*******************************************************************************
+
+    Copyright (C) 2004, 2005, 2007 EPFL, Politecnico di Milano, INRIA
+    Copyright (C) 2010 EPFL, Politecnico di Milano, Emory University
+
+    This file is part of LifeV.
+
+    LifeV is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    LifeV is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with LifeV.  If not, see <http://www.gnu.org/licenses/>.
+
+*******************************************************************************
+*/
+//@HEADER
+
+/* ========================================================
+
+Test of MatrixEpetra::diagonalize with rows given by other processes
+
+*/
+
+
+/**
+   @file test_diagonalize.cpp
+   @date 2026-10
+
+   A 1D laplacian is distributed with an uneven row map. Each process gives
+   the rows of the next process which are multiple of 7, and its first and
+   last rows: some of them are in the column map of the giving process, the
+   other ones are not. The test is done with the row map as domain map, and
+   with an even domain map, different from the row map.
+*/
+
+
+// ===================================================
+//! Includes
+// ===================================================
+
+#include <Epetra_ConfigDefs.h>
+#ifdef EPETRA_MPI
+#include <mpi.h>
+#include <Epetra_MpiComm.h>
+#else
+#include <Epetra_SerialComm.h>
+#endif
+
+#include <lifev/core/LifeV.hpp>
+#include <lifev/core/array/MapEpetra.hpp>
+#include <lifev/core/array/MatrixEpetra.hpp>
+
+using namespace LifeV;
+
+typedef MatrixEpetra<Real> matrix_Type;
+
+// ===================================================
+//! Helpers
+// ===================================================
+
+//! Tridiagonal matrix (-1, 2, -1) on the row map
+std::shared_ptr<matrix_Type> laplacian ( const MapEpetra& rowMap, const Int numGlobalRows )
+{
+    std::shared_ptr<matrix_Type> matrix ( new matrix_Type ( rowMap, 3 ) );
+    const Epetra_Map& map ( *rowMap.map ( Unique ) );
+
+    for ( Int i ( 0 ); i < map.NumMyElements(); ++i )
+    {
+        const Int row ( map.GID ( i ) );
+        matrix->addToCoefficient ( row, row, 2.0 );
+        if ( row > 0 )
+        {
+            matrix->addToCoefficient ( row, row - 1, -1.0 );
+        }
+        if ( row < numGlobalRows - 1 )
+        {
+            matrix->addToCoefficient ( row, row + 1, -1.0 );
+        }
+    }
+
+    return matrix;
+}
+
+//! Largest difference between the diagonalized matrix and the expected one
+Real diagonalizeError ( matrix_Type& matrix, const Epetra_Comm& comm )
+{
+    const Epetra_Map& rowMap ( matrix.matrixPtr()->RowMap() );
+    const Int numProcs ( comm.NumProc() );
+    const Int nextProc ( ( comm.MyPID() + 1 ) % numProcs );
+
+    // First and last rows of all the processes
+    Int myBounds[2] = { rowMap.MinMyGID(), rowMap.MaxMyGID() };
+    std::vector<Int> bounds ( 2 * numProcs );
+    comm.GatherAll ( myBounds, &bounds[0], 2 );
+
+    // Rows of the next process
+    std::vector<UInt> rows;
+    for ( Int row ( bounds[2 * nextProc] ); row <= bounds[2 * nextProc + 1]; ++row )
+    {
+        if ( row % 7 == 0 || row == bounds[2 * nextProc] || row == bounds[2 * nextProc + 1] )
+        {
+            rows.push_back ( row );
+        }
+    }
+
+    matrix.diagonalize ( rows, 1.0 );
+
+    Real error ( 0.0 );
+    std::vector<Real> values ( 3 );
+    std::vector<Int> indices ( 3 );
+
+    for ( Int i ( 0 ); i < rowMap.NumMyElements(); ++i )
+    {
+        const Int row ( rowMap.GID ( i ) );
+        const bool diagonalized ( row % 7 == 0 || row == myBounds[0] || row == myBounds[1] );
+
+        Int numEntries;
+        matrix.matrixPtr()->ExtractGlobalRowCopy ( row, 3, numEntries, &values[0], &indices[0] );
+
+        for ( Int j ( 0 ); j < numEntries; ++j )
+        {
+            const bool diagonal ( indices[j] == row );
+            const Real expected ( diagonalized ? ( diagonal ? 1.0 : 0.0 ) : ( diagonal ? 2.0 : -1.0 ) );
+            error = std::max ( error, std::abs ( values[j] - expected ) );
+        }
+    }
+
+    Real localError ( error );
+    comm.MaxAll ( &localError, &error, 1 );
+
+    return error;
+}
+
+// ===================================================
+//! Main
+// ===================================================
+int main ( int argc, char** argv )
+{
+#ifdef HAVE_MPI
+    MPI_Init ( &argc, &argv );
+    std::shared_ptr<Epetra_Comm> comm ( new Epetra_MpiComm ( MPI_COMM_WORLD ) );
+#else
+    std::shared_ptr<Epetra_Comm> comm ( new Epetra_SerialComm );
+#endif
+
+    const bool verbose ( comm->MyPID() == 0 );
+
+    // The first process has more rows than the other ones
+    const Int numGlobalRows ( 100 );
+    const Int numProcs ( comm->NumProc() );
+    const Int numOtherRows ( numGlobalRows / ( 2 * numProcs ) );
+    const Int numMyRows ( comm->MyPID() == 0 ? numGlobalRows - ( numProcs - 1 ) * numOtherRows : numOtherRows );
+
+    MapEpetra rowMap ( numGlobalRows, numMyRows, 0, comm );
+    std::shared_ptr<const MapEpetra> evenMap ( new MapEpetra ( numGlobalRows, comm ) );
+    std::shared_ptr<const MapEpetra> unevenMap ( new MapEpetra ( rowMap ) );
+
+    // Domain map equal to the row map
+    std::shared_ptr<matrix_Type> sameMapsMatrix ( laplacian ( rowMap, numGlobalRows ) );
+    sameMapsMatrix->globalAssemble();
+    const Real sameMapsError ( diagonalizeError ( *sameMapsMatrix, *comm ) );
+
+    // Domain map different from the row map
+    std::shared_ptr<matrix_Type> otherMapsMatrix ( laplacian ( rowMap, numGlobalRows ) );
+    otherMapsMatrix->globalAssemble ( evenMap, unevenMap );
+    const Real otherMapsError ( diagonalizeError ( *otherMapsMatrix, *comm ) );
+
+    if ( verbose )
+    {
+        std::cout << " Error (same row and domain maps): " << sameMapsError << std::endl;
+        std::cout << " Error (different row and domain maps): " << otherMapsError << std::endl;
+    }
+
+#ifdef HAVE_MPI
+    MPI_Finalize();
+#endif
+
+    if ( sameMapsError > 0.0 || otherMapsError > 0.0 )
+    {
+        if ( verbose )
+        {
+            std::cout << "Test status: FAILURE" << std::endl;
+        }
+        return EXIT_FAILURE;
+    }
+
+    if ( verbose )
+    {
+        std::cout << "Test status: SUCCESS" << std::endl;
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,274 @@
+//@HEADER
+/*
+*******************************************************************************
+
+    Copyright (C) 2004, 2005, 2007 EPFL, Politecnico di Milano, INRIA
+    Copyright (C) 2010 EPFL, Politecnico di Milano, Emory University
+
+    This file is part of LifeV.
+
+    LifeV is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    LifeV is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with LifeV.  If not, see <http://www.gnu.org/licenses/>.
+
+*******************************************************************************
+*/
+//@HEADER
+
+/*!
+    @file
+    @brief Test of the states of the time advance schemes after several time steps
+
+    The states of a solution quadratic in time are given to the schemes
+    step by step. After several shifts, the schemes must give the exact
+    values of the polynomial, for which they are exact:
+    - BDF of order 3 (VectorEpetra and Real): extrapolation and first derivative;
+    - Newmark: extrapolation, extrapolation of the first derivative, first
+      and second derivatives;
+    - TimeAndExtrapolationHandler: extrapolation of order 3, also when the
+      new state is given as one of the stored states.
+
+    @date 10-2026
+ */
+
+// ===================================================
+//! Includes
+// ===================================================
+
+#include <Epetra_ConfigDefs.h>
+#ifdef EPETRA_MPI
+#include <mpi.h>
+#include <Epetra_MpiComm.h>
+#else
+#include <Epetra_SerialComm.h>
+#endif
+
+#include <lifev/core/LifeV.hpp>
+#include <lifev/core/array/MapEpetra.hpp>
+#include <lifev/core/array/VectorEpetra.hpp>
+
+#include <lifev/core/fem/TimeAdvanceBDF.hpp>
+#include <lifev/core/fem/TimeAdvanceNewmark.hpp>
+#include <lifev/core/fem/TimeAndExtrapolationHandler.hpp>
+
+using namespace LifeV;
+
+typedef VectorEpetra vector_Type;
+
+// ===================================================
+//! Exact solution
+// ===================================================
+
+//! u ( t ) = a + b t + c t^2, with coefficients depending on the entry
+Real a ( const Int gid )
+{
+    return 1. + gid;
+}
+
+Real b ( const Int gid )
+{
+    return 0.5 - 0.1 * gid;
+}
+
+Real c ( const Int gid )
+{
+    return 0.3 * ( 1 + gid % 3 );
+}
+
+//! Fill the vector with the derivative of order "derivative" of u at time t
+void exactSolution ( vector_Type& vector, const Real& t, const UInt derivative = 0 )
+{
+    const Epetra_BlockMap& map ( vector.blockMap() );
+
+    for ( Int i ( 0 ); i < map.NumMyElements(); ++i )
+    {
+        const Int gid ( map.GID ( i ) );
+
+        switch ( derivative )
+        {
+            case 0:
+                vector.epetraVector() [0][i] = a ( gid ) + b ( gid ) * t + c ( gid ) * t * t;
+                break;
+            case 1:
+                vector.epetraVector() [0][i] = b ( gid ) + 2. * c ( gid ) * t;
+                break;
+            default:
+                vector.epetraVector() [0][i] = 2. * c ( gid );
+        }
+    }
+}
+
+//! Largest difference with the derivative of order "derivative" of u at time t
+Real error ( const vector_Type& vector, const Real& t, const UInt derivative = 0 )
+{
+    vector_Type difference ( vector );
+    exactSolution ( difference, t, derivative );
+    difference -= vector;
+    return difference.normInf();
+}
+
+// ===================================================
+//! Main
+// ===================================================
+int main ( int argc, char** argv )
+{
+#ifdef HAVE_MPI
+    MPI_Init ( &argc, &argv );
+    std::shared_ptr<Epetra_Comm> comm ( new Epetra_MpiComm ( MPI_COMM_WORLD ) );
+#else
+    std::shared_ptr<Epetra_Comm> comm ( new Epetra_SerialComm );
+#endif
+
+    const bool verbose ( comm->MyPID() == 0 );
+
+    MapEpetra map ( 30, comm );
+
+    const Real timeStep ( 0.1 );
+    const UInt numSteps ( 6 );
+
+    vector_Type state ( map, Unique );
+
+    // BDF of order 3, started from a constant state: after 4 steps, only the
+    // states of the polynomial are used
+    TimeAdvanceBDF<vector_Type> bdf;
+    bdf.setup ( 3, 1 );
+    bdf.setTimeStep ( timeStep );
+    exactSolution ( state, 0. );
+    bdf.setInitialCondition ( state );
+
+    TimeAdvanceBDF<Real> scalarBdf;
+    scalarBdf.setup ( 3, 1 );
+    scalarBdf.setTimeStep ( timeStep );
+    scalarBdf.setInitialCondition ( a ( 0 ) );
+
+    for ( UInt n ( 1 ); n <= numSteps; ++n )
+    {
+        const Real t ( n * timeStep );
+
+        bdf.updateRHSContribution ( timeStep );
+        exactSolution ( state, t );
+        bdf.shiftRight ( state );
+
+        scalarBdf.updateRHSContribution ( timeStep );
+        scalarBdf.shiftRight ( a ( 0 ) + b ( 0 ) * t + c ( 0 ) * t * t );
+    }
+
+    const Real finalTime ( numSteps * timeStep );
+
+    vector_Type bdfExtrapolation ( map, Unique );
+    bdf.extrapolation ( bdfExtrapolation );
+
+    Real bdfError ( error ( bdfExtrapolation, finalTime + timeStep ) );
+    bdfError = std::max ( bdfError, error ( bdf.firstDerivative(), finalTime, 1 ) );
+
+    for ( UInt i ( 0 ); i < 3; ++i )
+    {
+        bdfError = std::max ( bdfError, error ( bdf.singleElement ( i ), finalTime - i * timeStep ) );
+    }
+
+    Real scalarExtrapolation ( 0. );
+    scalarBdf.extrapolation ( scalarExtrapolation );
+
+    const Real nextTime ( finalTime + timeStep );
+    Real scalarBdfError ( std::abs ( scalarExtrapolation - ( a ( 0 ) + b ( 0 ) * nextTime + c ( 0 ) * nextTime * nextTime ) ) );
+    scalarBdfError = std::max ( scalarBdfError, std::abs ( scalarBdf.firstDerivative() - ( b ( 0 ) + 2. * c ( 0 ) * finalTime ) ) );
+
+    // Newmark (average acceleration), started from the exact state
+    std::vector<Real> newmarkCoefficients ( 2 );
+    newmarkCoefficients[0] = 0.25;
+    newmarkCoefficients[1] = 0.5;
+
+    TimeAdvanceNewmark<vector_Type> newmark;
+    newmark.setup ( newmarkCoefficients, 2 );
+    newmark.setTimeStep ( timeStep );
+
+    vector_Type velocity ( map, Unique );
+    vector_Type acceleration ( map, Unique );
+    exactSolution ( state, 0. );
+    exactSolution ( velocity, 0., 1 );
+    exactSolution ( acceleration, 0., 2 );
+    newmark.setInitialCondition ( state, velocity, acceleration );
+
+    for ( UInt n ( 1 ); n <= numSteps; ++n )
+    {
+        newmark.updateRHSContribution ( timeStep );
+        exactSolution ( state, n * timeStep );
+        newmark.shiftRight ( state );
+    }
+
+    vector_Type newmarkExtrapolation ( newmark.solution() );
+    newmark.extrapolation ( newmarkExtrapolation );
+    vector_Type newmarkExtrapolationFirstDerivative ( map, Unique );
+    newmark.extrapolationFirstDerivative ( newmarkExtrapolationFirstDerivative );
+
+    Real newmarkError ( error ( newmarkExtrapolation, finalTime + timeStep ) );
+    newmarkError = std::max ( newmarkError, error ( newmarkExtrapolationFirstDerivative, finalTime + timeStep, 1 ) );
+    newmarkError = std::max ( newmarkError, error ( newmark.firstDerivative(), finalTime, 1 ) );
+    newmarkError = std::max ( newmarkError, error ( newmark.secondDerivative(), finalTime, 2 ) );
+
+    // Extrapolation handler: the last shift gives one of the stored states,
+    // the one at the time finalTime - 2 * timeStep
+    TimeAndExtrapolationHandler handler ( 3, 3 );
+    handler.setTimeStep ( timeStep );
+
+    std::vector<vector_Type> initialStates ( 3, state );
+    for ( UInt i ( 0 ); i < 3; ++i )
+    {
+        exactSolution ( initialStates[i], ( static_cast<Real> ( i ) - 2. ) * timeStep );
+    }
+    handler.initialize ( initialStates );
+
+    for ( UInt n ( 1 ); n <= numSteps; ++n )
+    {
+        exactSolution ( state, n * timeStep );
+        handler.shift ( state );
+    }
+
+    vector_Type handlerExtrapolation ( map, Unique );
+    handler.extrapolate ( 3, handlerExtrapolation );
+    Real handlerError ( error ( handlerExtrapolation, finalTime + timeStep ) );
+
+    handler.shift ( handler.history() [2] );
+    handlerError = std::max ( handlerError, error ( handler.history() [0], finalTime - 2. * timeStep ) );
+    handlerError = std::max ( handlerError, error ( handler.history() [1], finalTime ) );
+    handlerError = std::max ( handlerError, error ( handler.history() [2], finalTime - timeStep ) );
+
+    if ( verbose )
+    {
+        std::cout << " Error (BDF): " << bdfError << std::endl;
+        std::cout << " Error (BDF, Real): " << scalarBdfError << std::endl;
+        std::cout << " Error (Newmark): " << newmarkError << std::endl;
+        std::cout << " Error (extrapolation handler): " << handlerError << std::endl;
+    }
+
+#ifdef HAVE_MPI
+    MPI_Finalize();
+#endif
+
+    const Real testTolerance ( 1e-10 );
+
+    if ( bdfError >= testTolerance || scalarBdfError >= testTolerance
+            || newmarkError >= testTolerance || handlerError >= testTolerance )
+    {
+        if ( verbose )
+        {
+            std::cout << "Test status: FAILURE" << std::endl;
+        }
+        return ( EXIT_FAILURE );
+    }
+
+    if ( verbose )
+    {
+        std::cout << "Test status: SUCCESS" << std::endl;
+    }
+    return ( EXIT_SUCCESS );
+}
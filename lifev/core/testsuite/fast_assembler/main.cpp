@@ -0,0 +1,217 @@
+//@HEADER
+/*
+*******************************************************************************
+
+    Copyright (C) 2004, 2005, 2007 EPFL, Politecnico di Milano, INRIA
+    Copyright (C) 2010 EPFL, Politecnico di Milano, Emory University
+
+    This file is part of LifeV.
+
+    LifeV is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    LifeV is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with LifeV.  If not, see <http://www.gnu.org/licenses/>.
+
+*******************************************************************************
+*/
+//@HEADER
+
+/*!
+    @file
+    @brief Test for the chunked buffers of the FastAssembler
+
+    The Navier-Stokes constant terms, the convective term and the SUPG terms
+    are assembled by a FastAssembler processing all the elements at once
+    (chunk size 0) and by one processing them in chunks of 7 elements. The
+    matrices are compared entry by entry. The SUPG terms are assembled twice,
+    to check that each assembly gives the same values.
+
+    @date 10-2026
+ */
+
+#include <map>
+
+#include <Epetra_ConfigDefs.h>
+#ifdef EPETRA_MPI
+#include <mpi.h>
+#include <Epetra_MpiComm.h>
+#else
+#include <Epetra_SerialComm.h>
+#endif
+
+#include <lifev/core/LifeV.hpp>
+
+#include <lifev/core/array/MatrixEpetra.hpp>
+#include <lifev/core/array/VectorEpetra.hpp>
+
+#include <lifev/core/fem/FESpace.hpp>
+#include <lifev/core/fem/FastAssembler.hpp>
+
+#include <lifev/core/mesh/MeshPartitioner.hpp>
+#include <lifev/core/mesh/RegionMesh3DStructured.hpp>
+#include <lifev/core/mesh/RegionMesh.hpp>
+
+using namespace LifeV;
+
+typedef RegionMesh<LinearTetra> mesh_Type;
+typedef MatrixEpetra<Real> matrix_Type;
+typedef std::shared_ptr<matrix_Type> matrixPtr_Type;
+typedef VectorEpetra vector_Type;
+typedef FESpace<mesh_Type, MapEpetra> feSpace_Type;
+typedef std::shared_ptr<feSpace_Type> feSpacePtr_Type;
+
+//! Largest difference between the entries of two closed matrices, relative to the largest entry of A
+Real entryDifference ( const matrix_Type& A, const matrix_Type& B )
+{
+    const Epetra_FECrsMatrix& a ( *A.matrixPtr() );
+    const Epetra_FECrsMatrix& b ( *B.matrixPtr() );
+
+    Real difference ( 0.0 );
+    Real largestEntry ( 0.0 );
+
+    for ( Int row ( 0 ); row < a.NumMyRows(); ++row )
+    {
+        std::map<Int, Real> entries;
+
+        Int numEntries;
+        Real* values;
+        Int* indices;
+
+        a.ExtractMyRowView ( row, numEntries, values, indices );
+        for ( Int i ( 0 ); i < numEntries; ++i )
+        {
+            entries[a.ColMap().GID ( indices[i] )] += values[i];
+            largestEntry = std::max ( largestEntry, std::abs ( values[i] ) );
+        }
+
+        b.ExtractMyRowView ( b.LRID ( a.GRID ( row ) ), numEntries, values, indices );
+        for ( Int i ( 0 ); i < numEntries; ++i )
+        {
+            entries[b.ColMap().GID ( indices[i] )] -= values[i];
+        }
+
+        for ( std::map<Int, Real>::const_iterator it ( entries.begin() ); it != entries.end(); ++it )
+        {
+            difference = std::max ( difference, std::abs ( it->second ) );
+        }
+    }
+
+    Real localValues[2] = { difference, largestEntry };
+    Real globalValues[2];
+    a.Comm().MaxAll ( localValues, globalValues, 2 );
+
+    return globalValues[0] / globalValues[1];
+}
+
+int
+main ( int argc, char** argv )
+{
+#ifdef HAVE_MPI
+    MPI_Init ( &argc, &argv );
+    std::shared_ptr<Epetra_Comm> Comm ( new Epetra_MpiComm ( MPI_COMM_WORLD ) );
+#else
+    std::shared_ptr<Epetra_Comm> Comm ( new Epetra_SerialComm );
+#endif
+
+    const bool verbose ( Comm->MyPID() == 0 );
+
+    // Mesh and FE space
+    std::shared_ptr<mesh_Type> fullMeshPtr ( new mesh_Type );
+    regularMesh3D ( *fullMeshPtr, 1, 5, 5, 5, false,
+                    1.0,   1.0,   1.0,
+                    0.0,   0.0,   0.0 );
+
+    std::shared_ptr<mesh_Type> meshPtr;
+    {
+        MeshPartitioner<mesh_Type> meshPart ( fullMeshPtr, Comm );
+        meshPtr = meshPart.meshPartition();
+    }
+    fullMeshPtr.reset();
+
+    feSpacePtr_Type uFESpace ( new feSpace_Type ( meshPtr, "P1", 3, Comm ) );
+
+    // A non constant velocity for the convective and SUPG terms
+    vector_Type velocity ( uFESpace->map(), Unique );
+    const Epetra_BlockMap& velocityMap ( velocity.blockMap() );
+    for ( Int i ( 0 ); i < velocityMap.NumMyElements(); ++i )
+    {
+        velocity[velocityMap.GID ( i )] = 1.0 + 0.1 * ( velocityMap.GID ( i ) % 11 );
+    }
+    const vector_Type velocityRepeated ( velocity, Repeated );
+
+    // All the elements at once and chunks of 7 elements
+    const int chunkSizes[] = { 0, 7 };
+    std::vector<matrixPtr_Type> constantTerms ( 2 );
+    std::vector<matrixPtr_Type> convectiveTerms ( 2 );
+    std::vector<matrixPtr_Type> supgTerms ( 2 );
+    std::vector<matrixPtr_Type> supgTermsAgain ( 2 );
+
+    for ( UInt iChunk ( 0 ); iChunk < 2; ++iChunk )
+    {
+        FastAssembler fastAssembler ( meshPtr, Comm, & ( uFESpace->refFE() ), & ( uFESpace->qr() ) );
+        fastAssembler.setChunkSize ( chunkSizes[iChunk] );
+        fastAssembler.allocateSpace ( meshPtr->numElements(), & ( uFESpace->fe() ), uFESpace );
+        fastAssembler.setConstants_NavierStokes ( 1.0, 0.01, 0.01, 2, 30.0 );
+        fastAssembler.allocateSpace_SUPG ( & ( uFESpace->fe() ) );
+
+        constantTerms[iChunk].reset ( new matrix_Type ( uFESpace->map() ) );
+        fastAssembler.NS_constant_terms_00 ( constantTerms[iChunk] );
+        constantTerms[iChunk]->globalAssemble();
+
+        convectiveTerms[iChunk].reset ( new matrix_Type ( uFESpace->map() ) );
+        fastAssembler.assembleConvective ( convectiveTerms[iChunk], velocityRepeated );
+        convectiveTerms[iChunk]->globalAssemble();
+
+        supgTerms[iChunk].reset ( new matrix_Type ( uFESpace->map() ) );
+        fastAssembler.assemble_SUPG_block00 ( supgTerms[iChunk], velocityRepeated );
+        supgTerms[iChunk]->globalAssemble();
+
+        supgTermsAgain[iChunk].reset ( new matrix_Type ( uFESpace->map() ) );
+        fastAssembler.assemble_SUPG_block00 ( supgTermsAgain[iChunk], velocityRepeated );
+        supgTermsAgain[iChunk]->globalAssemble();
+    }
+
+    const Real constantDiff ( entryDifference ( *constantTerms[0], *constantTerms[1] ) );
+    const Real convectiveDiff ( entryDifference ( *convectiveTerms[0], *convectiveTerms[1] ) );
+    const Real supgDiff ( entryDifference ( *supgTerms[0], *supgTerms[1] ) );
+    const Real supgRepeatDiff ( std::max ( entryDifference ( *supgTerms[0], *supgTermsAgain[0] ),
+                                           entryDifference ( *supgTerms[1], *supgTermsAgain[1] ) ) );
+
+    if ( verbose )
+    {
+        std::cout << " Error (NS constant terms): " << constantDiff << std::endl;
+        std::cout << " Error (convective term): " << convectiveDiff << std::endl;
+        std::cout << " Error (SUPG terms): " << supgDiff << std::endl;
+        std::cout << " Error (repeated SUPG assembly): " << supgRepeatDiff << std::endl;
+    }
+
+#ifdef HAVE_MPI
+    MPI_Finalize();
+#endif
+
+    const Real testTolerance ( 1e-12 );
+
+    if ( constantDiff >= testTolerance || convectiveDiff >= testTolerance
+            || supgDiff >= testTolerance || supgRepeatDiff >= testTolerance )
+    {
+        if ( verbose )
+        {
+            std::cout << "Test status: FAILURE" << std::endl;
+        }
+        return ( EXIT_FAILURE );
+    }
+
+    if ( verbose )
+    {
+        std::cout << "Test status: SUCCESS" << std::endl;
+    }
+    return ( EXIT_SUCCESS );
+}
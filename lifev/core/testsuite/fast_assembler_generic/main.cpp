@@ -0,0 +1,299 @@
+//@HEADER
+/*
+*******************************************************************************
+
+    Copyright (C) 2004, 2005, 2007 EPFL, Politecnico di Milano, INRIA
+    Copyright (C) 2010 EPFL, Politecnico di Milano, Emory University
+
+    This file is part of LifeV.
+
+    LifeV is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    LifeV is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with LifeV.  If not, see <http://www.gnu.org/licenses/>.
+
+*******************************************************************************
+*/
+//@HEADER
+
+/*!
+    @file
+    @brief Test for the generic fast assembler
+
+    The matrices and the vectors assembled by FastAssemblerGeneric with the
+    standard kernels and with a user kernel are compared with the ones of
+    the ADRAssembler, in open and closed matrices (with insertion offsets),
+    for a scalar and a vector field.
+
+    @date 10-2026
+ */
+
+#include <Epetra_ConfigDefs.h>
+#ifdef EPETRA_MPI
+#include <mpi.h>
+#include <Epetra_MpiComm.h>
+#else
+#include <Epetra_SerialComm.h>
+#endif
+
+#include <lifev/core/LifeV.hpp>
+
+#include <lifev/core/array/MatrixEpetra.hpp>
+#include <lifev/core/array/VectorEpetra.hpp>
+
+#include <lifev/core/fem/FESpace.hpp>
+#include <lifev/core/fem/FastAssemblerGeneric.hpp>
+#include <lifev/core/fem/FastAssemblerKernels.hpp>
+
+#include <lifev/core/mesh/MeshPartitioner.hpp>
+#include <lifev/core/mesh/RegionMesh3DStructured.hpp>
+#include <lifev/core/mesh/RegionMesh.hpp>
+
+#include <lifev/core/solver/ADRAssembler.hpp>
+
+using namespace LifeV;
+
+typedef RegionMesh<LinearTetra> mesh_Type;
+typedef MatrixEpetra<Real> matrix_Type;
+typedef std::shared_ptr<matrix_Type> matrixPtr_Type;
+typedef VectorEpetra vector_Type;
+typedef FESpace<mesh_Type, MapEpetra> feSpace_Type;
+typedef std::shared_ptr<feSpace_Type> feSpacePtr_Type;
+
+//! User kernel: grad(phi_j) . grad(phi_i) + reaction * phi_j phi_i
+class DiffusionReactionKernel
+{
+public:
+
+    static const UInt S_fieldDim = 1;
+    static const bool S_blockDiagonal = true;
+
+    explicit DiffusionReactionKernel ( const Real& reaction ) :
+        M_reaction ( reaction )
+    {}
+
+    void computeMatrix ( FastAssemblerElement& element, Real* values ) const
+    {
+        const UInt nbDof ( element.nbDof() );
+
+        for ( UInt i ( 0 ); i < nbDof; ++i )
+        {
+            for ( UInt j ( 0 ); j < nbDof; ++j )
+            {
+                Real integral ( 0.0 );
+                for ( UInt q ( 0 ); q < element.nbQuadPt(); ++q )
+                {
+                    Real product ( M_reaction * element.phi ( i, q ) * element.phi ( j, q ) );
+                    for ( UInt d ( 0 ); d < element.nbDimensions(); ++d )
+                    {
+                        product += element.dphi ( i, d, q ) * element.dphi ( j, d, q );
+                    }
+                    integral += product * element.wDetJacobian ( q );
+                }
+                values[i * nbDof + j] = integral;
+            }
+        }
+    }
+
+private:
+
+    Real M_reaction;
+};
+
+//! Norm of (A - B) x
+Real productDifference ( const matrix_Type& A, const matrix_Type& B, const vector_Type& x )
+{
+    vector_Type Ax ( x.map(), Unique );
+    vector_Type Bx ( x.map(), Unique );
+    A.multiply ( false, x, Ax );
+    B.multiply ( false, x, Bx );
+    Ax -= Bx;
+    return Ax.normInf();
+}
+
+int
+main ( int argc, char** argv )
+{
+#ifdef HAVE_MPI
+    MPI_Init ( &argc, &argv );
+    std::shared_ptr<Epetra_Comm> Comm ( new Epetra_MpiComm ( MPI_COMM_WORLD ) );
+#else
+    std::shared_ptr<Epetra_Comm> Comm ( new Epetra_SerialComm );
+#endif
+
+    const bool verbose ( Comm->MyPID() == 0 );
+
+    // Mesh and FE spaces
+    std::shared_ptr<mesh_Type> fullMeshPtr ( new mesh_Type );
+    regularMesh3D ( *fullMeshPtr, 1, 6, 6, 6, false,
+                    2.0,   2.0,   2.0,
+                    -1.0,  -1.0,  -1.0 );
+
+    std::shared_ptr<mesh_Type> meshPtr;
+    {
+        MeshPartitioner<mesh_Type> meshPart ( fullMeshPtr, Comm );
+        meshPtr = meshPart.meshPartition();
+    }
+    fullMeshPtr.reset();
+
+    feSpacePtr_Type uFESpace ( new feSpace_Type ( meshPtr, "P2", 1, Comm ) );
+    feSpacePtr_Type wFESpace ( new feSpace_Type ( meshPtr, "P1", 3, Comm ) );
+    feSpacePtr_Type sFESpace ( new feSpace_Type ( meshPtr, "P1", 1, Comm ) );
+
+    // Reference matrices
+    ADRAssembler<mesh_Type, matrix_Type, vector_Type> uAssembler;
+    uAssembler.setup ( uFESpace, wFESpace );
+    ADRAssembler<mesh_Type, matrix_Type, vector_Type> sAssembler;
+    sAssembler.setup ( sFESpace, wFESpace );
+
+    matrixPtr_Type laplacian ( new matrix_Type ( uFESpace->map() ) );
+    uAssembler.addDiffusion ( laplacian, 1.0 );
+    laplacian->globalAssemble();
+
+    matrixPtr_Type diffusionReaction ( new matrix_Type ( uFESpace->map() ) );
+    uAssembler.addDiffusion ( diffusionReaction, 1.0 );
+    uAssembler.addMass ( diffusionReaction, 2.0 );
+    diffusionReaction->globalAssemble();
+
+    matrixPtr_Type scalarMass ( new matrix_Type ( sFESpace->map() ) );
+    sAssembler.addMass ( scalarMass, 1.0 );
+    scalarMass->globalAssemble();
+
+    vector_Type x ( uFESpace->map(), Unique );
+    x.epetraVector().Random();
+
+    // Laplacian, in an open matrix and twice in a closed one with the insertion offsets
+    FastAssemblerGeneric<mesh_Type> uAssemblerFast ( *uFESpace, uFESpace->qr() );
+    uAssemblerFast.allocateSpace();
+    uAssemblerFast.setUseInsertionOffsets ( true );
+
+    matrix_Type openLaplacian ( uFESpace->map() );
+    uAssemblerFast.assembleMatrix ( openLaplacian, FastAssemblerKernelGradGrad<1>() );
+    openLaplacian.globalAssemble();
+
+    Real laplacianDiff ( productDifference ( openLaplacian, *laplacian, x ) );
+
+    matrix_Type closedLaplacian ( *laplacian );
+    for ( UInt iAssembly ( 0 ); iAssembly < 2; ++iAssembly )
+    {
+        closedLaplacian.zero();
+        uAssemblerFast.assembleMatrix ( closedLaplacian, FastAssemblerKernelGradGrad<1>() );
+        closedLaplacian.globalAssemble();
+
+        laplacianDiff = std::max ( laplacianDiff, productDifference ( closedLaplacian, *laplacian, x ) );
+    }
+
+    if ( verbose )
+    {
+        std::cout << " Error (laplacian): " << laplacianDiff << std::endl;
+    }
+
+    // User kernel
+    matrix_Type userMatrix ( uFESpace->map() );
+    uAssemblerFast.assembleMatrix ( userMatrix, DiffusionReactionKernel ( 2.0 ) );
+    userMatrix.globalAssemble();
+
+    const Real userKernelDiff ( productDifference ( userMatrix, *diffusionReaction, x ) );
+
+    if ( verbose )
+    {
+        std::cout << " Error (user kernel): " << userKernelDiff << std::endl;
+    }
+
+    // Vector mass matrix: each component is the scalar mass matrix
+    FastAssemblerGeneric<mesh_Type> wAssemblerFast ( *wFESpace, sFESpace->qr() );
+    wAssemblerFast.allocateSpace();
+
+    matrix_Type vectorMass ( wFESpace->map() );
+    wAssemblerFast.assembleMatrix ( vectorMass, FastAssemblerKernelMass<3>() );
+    vectorMass.globalAssemble();
+
+    vector_Type xs ( sFESpace->map(), Unique );
+    xs.epetraVector().Random();
+    vector_Type Mxs ( sFESpace->map(), Unique );
+    scalarMass->multiply ( false, xs, Mxs );
+
+    const UInt nbScalarDofs ( sFESpace->dof().numTotalDof() );
+    const Epetra_BlockMap& scalarMap ( xs.blockMap() );
+
+    vector_Type xw ( wFESpace->map(), Unique );
+    for ( UInt c ( 0 ); c < 3; ++c )
+    {
+        for ( Int i ( 0 ); i < scalarMap.NumMyElements(); ++i )
+        {
+            xw[scalarMap.GID ( i ) + c * nbScalarDofs] = ( c + 1. ) * xs[scalarMap.GID ( i )];
+        }
+    }
+    vector_Type Mxw ( wFESpace->map(), Unique );
+    vectorMass.multiply ( false, xw, Mxw );
+
+    Real vectorMassDiff ( 0.0 );
+    for ( UInt c ( 0 ); c < 3; ++c )
+    {
+        for ( Int i ( 0 ); i < scalarMap.NumMyElements(); ++i )
+        {
+            const Int gid ( scalarMap.GID ( i ) );
+            vectorMassDiff = std::max ( vectorMassDiff, std::abs ( Mxw[gid + c * nbScalarDofs] - ( c + 1. ) * Mxs[gid] ) );
+        }
+    }
+    Real localVectorMassDiff ( vectorMassDiff );
+    Comm->MaxAll ( &localVectorMassDiff, &vectorMassDiff, 1 );
+
+    if ( verbose )
+    {
+        std::cout << " Error (vector mass): " << vectorMassDiff << std::endl;
+    }
+
+    // Source term f = 1: the right hand side is the sum of the rows of the mass matrix
+    FastAssemblerGeneric<mesh_Type> sAssemblerFast ( *sFESpace, sFESpace->qr() );
+    sAssemblerFast.allocateSpace();
+
+    vector_Type ones ( sFESpace->map(), Repeated );
+    ones = 1.0;
+
+    vector_Type rhs ( sFESpace->map(), Repeated );
+    rhs *= 0.0;
+    sAssemblerFast.assembleVector ( rhs, FastAssemblerKernelSource<1> ( ones ) );
+    rhs.globalAssemble();
+
+    vector_Type massTimesOnes ( sFESpace->map(), Unique );
+    scalarMass->multiply ( false, vector_Type ( ones, Unique ), massTimesOnes );
+    massTimesOnes -= vector_Type ( rhs, Unique );
+
+    const Real rhsDiff ( massTimesOnes.normInf() );
+
+    if ( verbose )
+    {
+        std::cout << " Error (source): " << rhsDiff << std::endl;
+    }
+
+#ifdef HAVE_MPI
+    MPI_Finalize();
+#endif
+
+    const Real testTolerance ( 1e-10 );
+
+    if ( laplacianDiff >= testTolerance || userKernelDiff >= testTolerance
+            || vectorMassDiff >= testTolerance || rhsDiff >= testTolerance )
+    {
+        if ( verbose )
+        {
+            std::cout << "Test status: FAILURE" << std::endl;
+        }
+        return ( EXIT_FAILURE );
+    }
+
+    if ( verbose )
+    {
+        std::cout << "Test status: SUCCESS" << std::endl;
+    }
+    return ( EXIT_SUCCESS );
+}
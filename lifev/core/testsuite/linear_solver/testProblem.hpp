@@ -0,0 +1,141 @@
+//@HEADER
+/*
+*******************************************************************************
+
+    Copyright (C) 2004, 2005, 2007 EPFL, Politecnico di Milano, INRIA
+    Copyright (C) 2010 EPFL, Politecnico di Milano, Emory University
+
+    This file is part of LifeV.
+
+    LifeV is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    LifeV is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with LifeV.  If not, see <http://www.gnu.org/licenses/>.
+
+*******************************************************************************
+*/
+//@HEADER
+
+/*!
+    @file
+    @brief Small systems shared by the LinearSolver tests
+
+    P1 scalar problems on the unit cube, without boundary conditions:
+    diffusion * K + reaction * M, with K the stiffness matrix and M the
+    mass matrix, and Ifpack preconditioners set up without data file.
+
+    @date 10-2026
+ */
+
+#ifndef LINEARSOLVER_TESTPROBLEM_HPP
+#define LINEARSOLVER_TESTPROBLEM_HPP
+
+#include <Teuchos_ParameterList.hpp>
+
+#include <lifev/core/LifeV.hpp>
+#include <lifev/core/array/MatrixEpetra.hpp>
+#include <lifev/core/array/VectorEpetra.hpp>
+#include <lifev/core/fem/FESpace.hpp>
+#include <lifev/core/mesh/MeshPartitioner.hpp>
+#include <lifev/core/mesh/RegionMesh3DStructured.hpp>
+#include <lifev/core/mesh/RegionMesh.hpp>
+#include <lifev/core/solver/ADRAssembler.hpp>
+#include <lifev/core/algorithm/PreconditionerIfpack.hpp>
+
+namespace LifeV
+{
+
+namespace LinearSolverTest
+{
+
+typedef RegionMesh<LinearTetra>           mesh_Type;
+typedef std::shared_ptr<mesh_Type>        meshPtr_Type;
+typedef MatrixEpetra<Real>                matrix_Type;
+typedef std::shared_ptr<matrix_Type>      matrixPtr_Type;
+typedef VectorEpetra                      vector_Type;
+typedef std::shared_ptr<vector_Type>      vectorPtr_Type;
+typedef FESpace< mesh_Type, MapEpetra >   fespace_Type;
+typedef std::shared_ptr< fespace_Type >   fespacePtr_Type;
+typedef PreconditionerIfpack              prec_Type;
+typedef std::shared_ptr<prec_Type>        precPtr_Type;
+
+//! P1 scalar FE space on a partitioned regular mesh of the unit cube
+inline fespacePtr_Type
+buildFESpace ( const std::shared_ptr<Epetra_Comm>& comm, const UInt& numElements )
+{
+    meshPtr_Type fullMeshPtr ( new mesh_Type ( comm ) );
+    regularMesh3D ( *fullMeshPtr, 1, numElements, numElements, numElements, false,
+                    1.0, 1.0, 1.0,
+                    0.0, 0.0, 0.0 );
+
+    meshPtr_Type meshPtr;
+    {
+        MeshPartitioner< mesh_Type > meshPart ( fullMeshPtr, comm );
+        meshPtr = meshPart.meshPartition();
+    }
+
+    return fespacePtr_Type ( new fespace_Type ( meshPtr, "P1", 1, comm ) );
+}
+
+//! Closed matrix diffusion * K + reaction * M
+inline matrixPtr_Type
+assembleSystem ( const fespacePtr_Type& feSpace, const Real& diffusion, const Real& reaction )
+{
+    ADRAssembler<mesh_Type, matrix_Type, vector_Type> adrAssembler;
+    adrAssembler.setup ( feSpace, feSpace );
+
+    matrixPtr_Type systemMatrix ( new matrix_Type ( feSpace->map() ) );
+    if ( diffusion != 0. )
+    {
+        adrAssembler.addDiffusion ( systemMatrix, diffusion );
+    }
+    if ( reaction != 0. )
+    {
+        adrAssembler.addMass ( systemMatrix, reaction );
+    }
+    systemMatrix->globalAssemble();
+
+    return systemMatrix;
+}
+
+//! Ifpack preconditioner without overlap ("point relaxation" is Jacobi, "ILU" is ILU(0))
+inline precPtr_Type
+ifpackPreconditioner ( const std::shared_ptr<Epetra_Comm>& comm, const std::string& precType )
+{
+    Teuchos::ParameterList list;
+    list.set ( "prectype", precType );
+    list.set ( "overlap level", 0 );
+    list.set ( "relaxation: type", "Jacobi" );
+    list.set ( "relaxation: sweeps", 1 );
+    list.set ( "fact: level-of-fill", 0 );
+    list.set ( "schwarz: compute condest", false );
+
+    precPtr_Type precPtr ( new prec_Type ( comm ) );
+    precPtr->setParametersList ( list );
+
+    return precPtr;
+}
+
+//! Norm of b - A x over the norm of b
+inline Real
+relativeResidual ( const matrix_Type& A, const vector_Type& b, const vector_Type& x )
+{
+    vector_Type residual ( b.map(), Unique );
+    A.multiply ( false, x, residual );
+    residual -= b;
+    return residual.norm2() / b.norm2();
+}
+
+} // namespace LinearSolverTest
+
+} // namespace LifeV
+
+#endif // LINEARSOLVER_TESTPROBLEM_HPP
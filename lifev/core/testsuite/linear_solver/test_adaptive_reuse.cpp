@@ -0,0 +1,167 @@
+//@HEADER
+/*
+*******************************************************************************
+
+    Copyright (C) 2004, 2005, 2007 EPFL, Politecnico di Milano, INRIA
+    Copyright (C) 2010 EPFL, Politecnico di Milano, Emory University
+
+    This file is part of LifeV.
+
+    LifeV is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    LifeV is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with LifeV.  If not, see <http://www.gnu.org/licenses/>.
+
+*******************************************************************************
+*/
+//@HEADER
+
+/*!
+    @file
+    @brief Test for the adaptive reuse of the preconditioner of LinearSolver
+
+    A Jacobi preconditioner is built on the mass matrix, for which a few
+    iterations are enough, and then reused for a diffusion dominated matrix,
+    which needs many more iterations. The setup of a Jacobi preconditioner
+    being almost free, the second solve costs more than the average cost per
+    solve since the setup: with the adaptive policy the preconditioner must be
+    recomputed before the third solve, so that solvesSinceSetup() is back to
+    one after it. With the threshold policy (and a large threshold) the
+    preconditioner is reused for the three solves.
+
+    @date 10-2026
+ */
+
+#include <Epetra_ConfigDefs.h>
+#ifdef EPETRA_MPI
+#include <mpi.h>
+#include <Epetra_MpiComm.h>
+#else
+#include <Epetra_SerialComm.h>
+#endif
+
+#include <Teuchos_ParameterList.hpp>
+#include <Teuchos_XMLParameterListHelpers.hpp>
+#include <Teuchos_RCP.hpp>
+
+#include <lifev/core/LifeV.hpp>
+#include <lifev/core/algorithm/LinearSolver.hpp>
+
+#include "testProblem.hpp"
+
+using namespace LifeV;
+using namespace LifeV::LinearSolverTest;
+
+//! Solve with the mass matrix, then twice with the diffusion matrix, and return the number of solves since the last setup
+std::vector<UInt> reuseSequence ( const std::shared_ptr<Epetra_Comm>& comm, const fespacePtr_Type& feSpace,
+                                  const std::string& reusePolicy, std::vector<Int>& numIters, bool& converged )
+{
+    matrixPtr_Type massMatrix ( assembleSystem ( feSpace, 0., 1. ) );
+    matrixPtr_Type diffusionMatrix ( assembleSystem ( feSpace, 1., 1e-3 ) );
+
+    Teuchos::RCP< Teuchos::ParameterList > solverList = Teuchos::getParametersFromXmlFile ( "SolverParamList2.xml" );
+    solverList->set ( "Reuse Preconditioner", true );
+    solverList->set ( "Reuse Policy", reusePolicy );
+    solverList->set ( "Max Iterations For Reuse", 10000 );
+    solverList->set ( "Silent", true );
+    Teuchos::ParameterList& belosList = solverList->sublist ( "Solver: Operator List" ).sublist ( "Trilinos: Belos List" );
+    belosList.set ( "Maximum Iterations", 2000 );
+    belosList.set ( "Maximum Restarts", 20 );
+    belosList.set ( "Verbosity", 0 );
+
+    LinearSolver linearSolver ( comm );
+    linearSolver.setParameters ( *solverList );
+    linearSolver.setPreconditioner ( ifpackPreconditioner ( comm, "point relaxation" ) );
+
+    vectorPtr_Type rhs ( new vector_Type ( feSpace->map(), Unique ) );
+    rhs->epetraVector().Random();
+    linearSolver.setRightHandSide ( rhs );
+
+    std::vector<UInt> solvesSinceSetup;
+    numIters.clear();
+    converged = true;
+
+    for ( UInt iSolve ( 0 ); iSolve < 3; ++iSolve )
+    {
+        linearSolver.setOperator ( iSolve == 0 ? massMatrix : diffusionMatrix );
+
+        vectorPtr_Type solution ( new vector_Type ( feSpace->map(), Unique ) );
+        *solution = 0.;
+        numIters.push_back ( linearSolver.solve ( solution ) );
+        solvesSinceSetup.push_back ( linearSolver.solvesSinceSetup() );
+
+        converged = converged && linearSolver.hasConverged() == LinearSolver::SolverOperator_Type::yes;
+    }
+
+    return solvesSinceSetup;
+}
+
+int
+main ( int argc, char** argv )
+{
+#ifdef HAVE_MPI
+    MPI_Init ( &argc, &argv );
+#endif
+
+    bool success ( true );
+
+    {
+#ifdef HAVE_MPI
+        std::shared_ptr<Epetra_Comm> comm ( new Epetra_MpiComm ( MPI_COMM_WORLD ) );
+#else
+        std::shared_ptr<Epetra_Comm> comm ( new Epetra_SerialComm );
+#endif
+
+        const bool verbose ( comm->MyPID() == 0 );
+
+        fespacePtr_Type feSpace ( buildFESpace ( comm, 10 ) );
+
+        const std::string policies[] = { "Threshold", "Adaptive" };
+        std::vector<UInt> solvesSinceSetup[2];
+        std::vector<Int> numIters[2];
+        bool converged[2];
+
+        for ( UInt iPolicy ( 0 ); iPolicy < 2; ++iPolicy )
+        {
+            solvesSinceSetup[iPolicy] = reuseSequence ( comm, feSpace, policies[iPolicy], numIters[iPolicy], converged[iPolicy] );
+
+            if ( verbose )
+            {
+                for ( UInt iSolve ( 0 ); iSolve < 3; ++iSolve )
+                {
+                    std::cout << " " << policies[iPolicy] << " policy, solve " << iSolve
+                              << ": " << numIters[iPolicy][iSolve] << " iterations, "
+                              << solvesSinceSetup[iPolicy][iSolve] << " solves since the setup" << std::endl;
+                }
+            }
+        }
+
+        // The diffusion matrix must be much harder than the mass matrix for the preconditioner
+        success = converged[0] && converged[1] && numIters[1][1] > 2 * numIters[1][0];
+
+        // Threshold policy: the preconditioner is never recomputed
+        success = success && solvesSinceSetup[0][0] == 1 && solvesSinceSetup[0][1] == 2 && solvesSinceSetup[0][2] == 3;
+
+        // Adaptive policy: the second solve does not pay off, the preconditioner is recomputed for the third one
+        success = success && solvesSinceSetup[1][0] == 1 && solvesSinceSetup[1][1] == 2 && solvesSinceSetup[1][2] == 1;
+
+        if ( verbose )
+        {
+            std::cout << ( success ? "Test status: SUCCESS" : "Test status: FAILURE" ) << std::endl;
+        }
+    }
+
+#ifdef HAVE_MPI
+    MPI_Finalize();
+#endif
+
+    return ( success ? EXIT_SUCCESS : EXIT_FAILURE );
+}
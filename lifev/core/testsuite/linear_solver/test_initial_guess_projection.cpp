@@ -0,0 +1,187 @@
+//@HEADER
+/*
+*******************************************************************************
+
+    Copyright (C) 2004, 2005, 2007 EPFL, Politecnico di Milano, INRIA
+    Copyright (C) 2010 EPFL, Politecnico di Milano, Emory University
+
+    This file is part of LifeV.
+
+    LifeV is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    LifeV is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with LifeV.  If not, see <http://www.gnu.org/licenses/>.
+
+*******************************************************************************
+*/
+//@HEADER
+
+/*!
+    @file
+    @brief Test for the projection of the initial guess on the previous solutions
+
+    A sequence of nearby systems ( 1 + 0.01 k ) K + 0.1 M x = b + 0.01 k c
+    is solved with and without "Projection History Size". The solutions
+    must be the same (the tolerance of the correction being relative to the
+    norm of the rhs) and, after the first system, the projection must reduce
+    the total number of iterations.
+
+    @date 10-2026
+ */
+
+#include <Epetra_ConfigDefs.h>
+#ifdef EPETRA_MPI
+#include <mpi.h>
+#include <Epetra_MpiComm.h>
+#else
+#include <Epetra_SerialComm.h>
+#endif
+
+#include <Teuchos_ParameterList.hpp>
+
+#include <lifev/core/LifeV.hpp>
+#include <lifev/core/algorithm/LinearSolver.hpp>
+
+#include "testProblem.hpp"
+
+using namespace LifeV;
+using namespace LifeV::LinearSolverTest;
+
+//! LinearSolver with Belos GMRES and a projection on the last projectionSize solutions
+std::shared_ptr<LinearSolver> buildSolver ( const std::shared_ptr<Epetra_Comm>& comm, const Int projectionSize )
+{
+    Teuchos::ParameterList solverList;
+    solverList.set ( "Reuse Preconditioner", false );
+    solverList.set ( "Silent", true );
+    solverList.set ( "Solver Type", "Belos" );
+    solverList.set ( "Projection History Size", projectionSize );
+    solverList.set ( "Projection Norm", "Energy" );
+
+    Teuchos::ParameterList& operatorList = solverList.sublist ( "Solver: Operator List" );
+    operatorList.set ( "Solver Manager Type", "BlockGmres" );
+    operatorList.set ( "Preconditioner Side", "Right" );
+
+    Teuchos::ParameterList& belosList = operatorList.sublist ( "Trilinos: Belos List" );
+    belosList.set ( "Convergence Tolerance", 1e-10 );
+    belosList.set ( "Maximum Iterations", 2000 );
+    belosList.set ( "Maximum Restarts", 20 );
+    belosList.set ( "Num Blocks", 100 );
+    belosList.set ( "Block Size", 1 );
+    belosList.set ( "Verbosity", 0 );
+
+    std::shared_ptr<LinearSolver> linearSolver ( new LinearSolver ( comm ) );
+    linearSolver->setParameters ( solverList );
+    linearSolver->setPreconditioner ( ifpackPreconditioner ( comm, "point relaxation" ) );
+
+    return linearSolver;
+}
+
+int
+main ( int argc, char** argv )
+{
+#ifdef HAVE_MPI
+    MPI_Init ( &argc, &argv );
+#endif
+
+    bool success ( true );
+
+    {
+#ifdef HAVE_MPI
+        std::shared_ptr<Epetra_Comm> comm ( new Epetra_MpiComm ( MPI_COMM_WORLD ) );
+#else
+        std::shared_ptr<Epetra_Comm> comm ( new Epetra_SerialComm );
+#endif
+
+        const bool verbose ( comm->MyPID() == 0 );
+
+        fespacePtr_Type feSpace ( buildFESpace ( comm, 10 ) );
+
+        std::shared_ptr<LinearSolver> referenceSolver ( buildSolver ( comm, 0 ) );
+        std::shared_ptr<LinearSolver> projectionSolver ( buildSolver ( comm, 5 ) );
+
+        vector_Type b ( feSpace->map(), Unique );
+        vector_Type c ( feSpace->map(), Unique );
+        b.epetraVector().Random();
+        c.epetraVector().Random();
+
+        const UInt numSystems ( 8 );
+        Int referenceNumIters ( 0 );
+        Int projectionNumIters ( 0 );
+        Real solutionDiff ( 0. );
+        Real residual ( 0. );
+        bool converged ( true );
+
+        for ( UInt k ( 0 ); k < numSystems; ++k )
+        {
+            matrixPtr_Type systemMatrix ( assembleSystem ( feSpace, 1. + 0.01 * k, 0.1 ) );
+
+            vectorPtr_Type rhs ( new vector_Type ( b ) );
+            rhs->linearCombination ( 0.01 * k, c, 1. );
+
+            vectorPtr_Type referenceSolution ( new vector_Type ( feSpace->map(), Unique ) );
+            vectorPtr_Type projectionSolution ( new vector_Type ( feSpace->map(), Unique ) );
+            *referenceSolution = 0.;
+            *projectionSolution = 0.;
+
+            referenceSolver->setOperator ( systemMatrix );
+            referenceSolver->setRightHandSide ( rhs );
+            const Int referenceIters ( referenceSolver->solve ( referenceSolution ) );
+
+            projectionSolver->setOperator ( systemMatrix );
+            projectionSolver->setRightHandSide ( rhs );
+            const Int projectionIters ( projectionSolver->solve ( projectionSolution ) );
+
+            converged = converged && referenceSolver->hasConverged() == LinearSolver::SolverOperator_Type::yes
+                        && projectionSolver->hasConverged() == LinearSolver::SolverOperator_Type::yes;
+
+            // The first system has no previous solution to project on
+            if ( k > 0 )
+            {
+                referenceNumIters  += referenceIters;
+                projectionNumIters += projectionIters;
+            }
+
+            residual = std::max ( residual, relativeResidual ( *systemMatrix, *rhs, *projectionSolution ) );
+
+            vector_Type difference ( *projectionSolution );
+            difference -= *referenceSolution;
+            solutionDiff = std::max ( solutionDiff, difference.norm2() / referenceSolution->norm2() );
+
+            if ( verbose )
+            {
+                std::cout << " System " << k << ": " << referenceIters << " iterations without projection, "
+                          << projectionIters << " with projection" << std::endl;
+            }
+        }
+
+        if ( verbose )
+        {
+            std::cout << " Iterations after the first system: " << referenceNumIters << " without projection, "
+                      << projectionNumIters << " with projection" << std::endl;
+            std::cout << " Relative residual (projection): " << residual << std::endl;
+            std::cout << " Relative difference of the solutions: " << solutionDiff << std::endl;
+        }
+
+        success = converged && residual < 1e-8 && solutionDiff < 1e-6
+                  && projectionNumIters < referenceNumIters;
+
+        if ( verbose )
+        {
+            std::cout << ( success ? "Test status: SUCCESS" : "Test status: FAILURE" ) << std::endl;
+        }
+    }
+
+#ifdef HAVE_MPI
+    MPI_Finalize();
+#endif
+
+    return ( success ? EXIT_SUCCESS : EXIT_FAILURE );
+}
@@ -0,0 +1,165 @@
+//@HEADER
+/*
+*******************************************************************************
+
+    Copyright (C) 2004, 2005, 2007 EPFL, Politecnico di Milano, INRIA
+    Copyright (C) 2010 EPFL, Politecnico di Milano, Emory University
+
+    This file is part of LifeV.
+
+    LifeV is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    LifeV is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with LifeV.  If not, see <http://www.gnu.org/licenses/>.
+
+*******************************************************************************
+*/
+//@HEADER
+
+/*!
+    @file
+    @brief Test for the recycling of the Krylov subspace with GCRODR
+
+    The same diffusion matrix is solved for two right hand sides with
+    GCRODR, with and without "Recycle Krylov Subspace". With recycling the
+    second solve starts with the deflation subspace of the first one and
+    needs fewer iterations, both than the first solve and than the second
+    solve without recycling. The true residuals are checked.
+
+    @date 10-2026
+ */
+
+#include <Epetra_ConfigDefs.h>
+#ifdef EPETRA_MPI
+#include <mpi.h>
+#include <Epetra_MpiComm.h>
+#else
+#include <Epetra_SerialComm.h>
+#endif
+
+#include <Teuchos_ParameterList.hpp>
+
+#include <lifev/core/LifeV.hpp>
+#include <lifev/core/algorithm/LinearSolver.hpp>
+
+#include "testProblem.hpp"
+
+using namespace LifeV;
+using namespace LifeV::LinearSolverTest;
+
+//! Solve the system for the right hand sides one after the other and return the numbers of iterations
+std::vector<Int> solveSequence ( const std::shared_ptr<Epetra_Comm>& comm, const matrixPtr_Type& systemMatrix,
+                                 const std::vector<vectorPtr_Type>& rhs, const bool recycle, Real& residual )
+{
+    Teuchos::ParameterList solverList;
+    solverList.set ( "Reuse Preconditioner", true );
+    solverList.set ( "Max Iterations For Reuse", 10000 );
+    solverList.set ( "Silent", true );
+    solverList.set ( "Solver Type", "Belos" );
+
+    Teuchos::ParameterList& operatorList = solverList.sublist ( "Solver: Operator List" );
+    operatorList.set ( "Solver Manager Type", "GCRODR" );
+    operatorList.set ( "Recycle Krylov Subspace", recycle );
+    operatorList.set ( "Preconditioner Side", "Right" );
+
+    Teuchos::ParameterList& belosList = operatorList.sublist ( "Trilinos: Belos List" );
+    belosList.set ( "Convergence Tolerance", 1e-10 );
+    belosList.set ( "Maximum Iterations", 2000 );
+    belosList.set ( "Maximum Restarts", 100 );
+    belosList.set ( "Num Blocks", 30 );
+    belosList.set ( "Num Recycled Blocks", 10 );
+    belosList.set ( "Verbosity", 0 );
+
+    LinearSolver linearSolver ( comm );
+    linearSolver.setParameters ( solverList );
+    linearSolver.setPreconditioner ( ifpackPreconditioner ( comm, "point relaxation" ) );
+    linearSolver.setOperator ( systemMatrix );
+
+    std::vector<Int> numIters;
+    residual = 0.;
+
+    for ( UInt iRhs ( 0 ); iRhs < rhs.size(); ++iRhs )
+    {
+        vectorPtr_Type solution ( new vector_Type ( rhs[iRhs]->map(), Unique ) );
+        *solution = 0.;
+
+        linearSolver.setRightHandSide ( rhs[iRhs] );
+        numIters.push_back ( linearSolver.solve ( solution ) );
+
+        if ( linearSolver.hasConverged() != LinearSolver::SolverOperator_Type::yes )
+        {
+            residual = 1.;
+        }
+        residual = std::max ( residual, relativeResidual ( *systemMatrix, *rhs[iRhs], *solution ) );
+    }
+
+    return numIters;
+}
+
+int
+main ( int argc, char** argv )
+{
+#ifdef HAVE_MPI
+    MPI_Init ( &argc, &argv );
+#endif
+
+    bool success ( true );
+
+    {
+#ifdef HAVE_MPI
+        std::shared_ptr<Epetra_Comm> comm ( new Epetra_MpiComm ( MPI_COMM_WORLD ) );
+#else
+        std::shared_ptr<Epetra_Comm> comm ( new Epetra_SerialComm );
+#endif
+
+        const bool verbose ( comm->MyPID() == 0 );
+
+        fespacePtr_Type feSpace ( buildFESpace ( comm, 10 ) );
+        matrixPtr_Type systemMatrix ( assembleSystem ( feSpace, 1., 1e-3 ) );
+
+        std::vector<vectorPtr_Type> rhs ( 2 );
+        for ( UInt iRhs ( 0 ); iRhs < rhs.size(); ++iRhs )
+        {
+            rhs[iRhs].reset ( new vector_Type ( feSpace->map(), Unique ) );
+            rhs[iRhs]->epetraVector().Random();
+        }
+
+        Real residual;
+        Real recycledResidual;
+        const std::vector<Int> numIters ( solveSequence ( comm, systemMatrix, rhs, false, residual ) );
+        const std::vector<Int> recycledNumIters ( solveSequence ( comm, systemMatrix, rhs, true, recycledResidual ) );
+
+        if ( verbose )
+        {
+            std::cout << " Without recycling: " << numIters[0] << " and " << numIters[1]
+                      << " iterations, relative residual " << residual << std::endl;
+            std::cout << " With recycling:    " << recycledNumIters[0] << " and " << recycledNumIters[1]
+                      << " iterations, relative residual " << recycledResidual << std::endl;
+        }
+
+        const Real testTolerance ( 1e-8 );
+
+        success = residual < testTolerance && recycledResidual < testTolerance
+                  && recycledNumIters[1] < recycledNumIters[0]
+                  && recycledNumIters[1] < numIters[1];
+
+        if ( verbose )
+        {
+            std::cout << ( success ? "Test status: SUCCESS" : "Test status: FAILURE" ) << std::endl;
+        }
+    }
+
+#ifdef HAVE_MPI
+    MPI_Finalize();
+#endif
+
+    return ( success ? EXIT_SUCCESS : EXIT_FAILURE );
+}
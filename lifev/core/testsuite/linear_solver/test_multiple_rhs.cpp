@@ -0,0 +1,190 @@
+//@HEADER
+/*
+*******************************************************************************
+
+    Copyright (C) 2004, 2005, 2007 EPFL, Politecnico di Milano, INRIA
+    Copyright (C) 2010 EPFL, Politecnico di Milano, Emory University
+
+    This file is part of LifeV.
+
+    LifeV is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    LifeV is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with LifeV.  If not, see <http://www.gnu.org/licenses/>.
+
+*******************************************************************************
+*/
+//@HEADER
+
+/*!
+    @file
+    @brief Test for the solve of LinearSolver with several right hand sides
+
+    A diffusion system is solved for three right hand sides at once and
+    column by column with solve(), with Belos BlockGmres (block size set to
+    the number of right hand sides), Belos PseudoBlockGmres and AztecOO.
+    The solutions must agree up to the tolerance of the solver.
+
+    @date 10-2026
+ */
+
+#include <Epetra_ConfigDefs.h>
+#ifdef EPETRA_MPI
+#include <mpi.h>
+#include <Epetra_MpiComm.h>
+#else
+#include <Epetra_SerialComm.h>
+#endif
+
+#include <Teuchos_ParameterList.hpp>
+
+#include <lifev/core/LifeV.hpp>
+#include <lifev/core/algorithm/LinearSolver.hpp>
+
+#include "testProblem.hpp"
+
+using namespace LifeV;
+using namespace LifeV::LinearSolverTest;
+
+//! Parameters of LinearSolver for a Belos solver manager or for AztecOO ("AztecOO")
+Teuchos::ParameterList solverParameters ( const std::string& solverManagerType )
+{
+    Teuchos::ParameterList solverList;
+    solverList.set ( "Reuse Preconditioner", true );
+    solverList.set ( "Max Iterations For Reuse", 10000 );
+    solverList.set ( "Silent", true );
+
+    Teuchos::ParameterList& operatorList = solverList.sublist ( "Solver: Operator List" );
+
+    if ( solverManagerType == "AztecOO" )
+    {
+        solverList.set ( "Solver Type", "AztecOO" );
+
+        Teuchos::ParameterList& aztecList = operatorList.sublist ( "Trilinos: AztecOO List" );
+        aztecList.set ( "solver", "gmres" );
+        aztecList.set ( "conv", "rhs" );
+        aztecList.set ( "scaling", "none" );
+        aztecList.set ( "output", "none" );
+        aztecList.set ( "tol", 1e-10 );
+        aztecList.set ( "max_iter", 2000 );
+        aztecList.set ( "kspace", 100 );
+    }
+    else
+    {
+        solverList.set ( "Solver Type", "Belos" );
+        operatorList.set ( "Solver Manager Type", solverManagerType );
+        operatorList.set ( "Preconditioner Side", "Right" );
+
+        Teuchos::ParameterList& belosList = operatorList.sublist ( "Trilinos: Belos List" );
+        belosList.set ( "Convergence Tolerance", 1e-10 );
+        belosList.set ( "Maximum Iterations", 2000 );
+        belosList.set ( "Maximum Restarts", 20 );
+        belosList.set ( "Num Blocks", 100 );
+        belosList.set ( "Block Size", 1 );
+        belosList.set ( "Verbosity", 0 );
+    }
+
+    return solverList;
+}
+
+//! Largest relative difference between the solutions at once and column by column
+Real multipleRhsError ( const std::shared_ptr<Epetra_Comm>& comm, const matrixPtr_Type& systemMatrix,
+                        const std::vector<vectorPtr_Type>& rhs, const std::string& solverManagerType, bool& converged )
+{
+    LinearSolver linearSolver ( comm );
+    linearSolver.setParameters ( solverParameters ( solverManagerType ) );
+    linearSolver.setPreconditioner ( ifpackPreconditioner ( comm, "point relaxation" ) );
+    linearSolver.setOperator ( systemMatrix );
+
+    // All the right hand sides at once
+    std::vector<vectorPtr_Type> solutions ( rhs.size() );
+    for ( UInt i ( 0 ); i < rhs.size(); ++i )
+    {
+        solutions[i].reset ( new vector_Type ( rhs[i]->map(), Unique ) );
+        *solutions[i] = 0.;
+    }
+    const Int numIters ( linearSolver.solve ( rhs, solutions ) );
+    converged = linearSolver.hasConverged() == LinearSolver::SolverOperator_Type::yes;
+
+    // One right hand side at a time
+    Real error ( 0. );
+    for ( UInt i ( 0 ); i < rhs.size(); ++i )
+    {
+        vectorPtr_Type solution ( new vector_Type ( rhs[i]->map(), Unique ) );
+        *solution = 0.;
+        linearSolver.setRightHandSide ( rhs[i] );
+        linearSolver.solve ( solution );
+        converged = converged && linearSolver.hasConverged() == LinearSolver::SolverOperator_Type::yes;
+
+        vector_Type difference ( *solutions[i] );
+        difference -= *solution;
+        error = std::max ( error, difference.norm2() / solution->norm2() );
+    }
+
+    if ( comm->MyPID() == 0 )
+    {
+        std::cout << " " << solverManagerType << ": " << numIters << " iterations for "
+                  << rhs.size() << " right hand sides, relative difference " << error << std::endl;
+    }
+
+    return error;
+}
+
+int
+main ( int argc, char** argv )
+{
+#ifdef HAVE_MPI
+    MPI_Init ( &argc, &argv );
+#endif
+
+    bool success ( true );
+
+    {
+#ifdef HAVE_MPI
+        std::shared_ptr<Epetra_Comm> comm ( new Epetra_MpiComm ( MPI_COMM_WORLD ) );
+#else
+        std::shared_ptr<Epetra_Comm> comm ( new Epetra_SerialComm );
+#endif
+
+        const bool verbose ( comm->MyPID() == 0 );
+
+        fespacePtr_Type feSpace ( buildFESpace ( comm, 8 ) );
+        matrixPtr_Type systemMatrix ( assembleSystem ( feSpace, 1., 0.1 ) );
+
+        std::vector<vectorPtr_Type> rhs ( 3 );
+        for ( UInt i ( 0 ); i < rhs.size(); ++i )
+        {
+            rhs[i].reset ( new vector_Type ( feSpace->map(), Unique ) );
+            rhs[i]->epetraVector().Random();
+        }
+
+        const std::string solvers[] = { "BlockGmres", "PseudoBlockGmres", "AztecOO" };
+        const Real testTolerance ( 1e-6 );
+
+        for ( UInt iSolver ( 0 ); iSolver < 3; ++iSolver )
+        {
+            bool converged;
+            const Real error ( multipleRhsError ( comm, systemMatrix, rhs, solvers[iSolver], converged ) );
+            success = success && converged && error < testTolerance;
+        }
+
+        if ( verbose )
+        {
+            std::cout << ( success ? "Test status: SUCCESS" : "Test status: FAILURE" ) << std::endl;
+        }
+    }
+
+#ifdef HAVE_MPI
+    MPI_Finalize();
+#endif
+
+    return ( success ? EXIT_SUCCESS : EXIT_FAILURE );
+}
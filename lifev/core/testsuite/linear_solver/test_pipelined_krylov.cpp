@@ -0,0 +1,193 @@
+//@HEADER
+/*
+*******************************************************************************
+
+    Copyright (C) 2004, 2005, 2007 EPFL, Politecnico di Milano, INRIA
+    Copyright (C) 2010 EPFL, Politecnico di Milano, Emory University
+
+    This file is part of LifeV.
+
+    LifeV is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    LifeV is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with LifeV.  If not, see <http://www.gnu.org/licenses/>.
+
+*******************************************************************************
+*/
+//@HEADER
+
+/*!
+    @file
+    @brief Test for the pipelined Krylov solvers
+
+    A symmetric positive definite diffusion system is solved with
+    PipelinedCG and SStepGmres, with and without a Jacobi preconditioner,
+    and with Belos GMRES as reference. The solvers must converge, the true
+    residuals must be below the tolerance and the solutions must agree with
+    the reference. SStepGmres is also run with 12 steps per reduction, which
+    are capped to 8.
+
+    @date 10-2026
+ */
+
+#include <Epetra_ConfigDefs.h>
+#ifdef EPETRA_MPI
+#include <mpi.h>
+#include <Epetra_MpiComm.h>
+#else
+#include <Epetra_SerialComm.h>
+#endif
+
+#include <Teuchos_ParameterList.hpp>
+
+#include <lifev/core/LifeV.hpp>
+#include <lifev/core/algorithm/LinearSolver.hpp>
+
+#include "testProblem.hpp"
+
+using namespace LifeV;
+using namespace LifeV::LinearSolverTest;
+
+//! Solve the system with a pipelined method ("Belos" for the reference) and return the solution
+vectorPtr_Type solveSystem ( const std::shared_ptr<Epetra_Comm>& comm, const matrixPtr_Type& systemMatrix,
+                             const vectorPtr_Type& rhs, const std::string& method, const Int stepsPerReduction,
+                             const bool preconditioned, bool& converged )
+{
+    const Real tolerance ( 1e-10 );
+
+    Teuchos::ParameterList solverList;
+    solverList.set ( "Reuse Preconditioner", false );
+    solverList.set ( "Silent", true );
+
+    Teuchos::ParameterList& operatorList = solverList.sublist ( "Solver: Operator List" );
+
+    if ( method == "Belos" )
+    {
+        solverList.set ( "Solver Type", "Belos" );
+        operatorList.set ( "Solver Manager Type", "BlockGmres" );
+        operatorList.set ( "Preconditioner Side", "Right" );
+
+        Teuchos::ParameterList& belosList = operatorList.sublist ( "Trilinos: Belos List" );
+        belosList.set ( "Convergence Tolerance", tolerance );
+        belosList.set ( "Maximum Iterations", 2000 );
+        belosList.set ( "Maximum Restarts", 20 );
+        belosList.set ( "Num Blocks", 100 );
+        belosList.set ( "Block Size", 1 );
+        belosList.set ( "Verbosity", 0 );
+    }
+    else
+    {
+        solverList.set ( "Solver Type", "Pipelined" );
+
+        Teuchos::ParameterList& pipelinedList = operatorList.sublist ( "Pipelined Krylov List" );
+        pipelinedList.set ( "Method", method );
+        pipelinedList.set ( "Convergence Tolerance", tolerance );
+        pipelinedList.set ( "Maximum Iterations", 2000 );
+        pipelinedList.set ( "Steps Per Reduction", stepsPerReduction );
+    }
+
+    LinearSolver linearSolver ( comm );
+    linearSolver.setParameters ( solverList );
+    if ( preconditioned )
+    {
+        linearSolver.setPreconditioner ( ifpackPreconditioner ( comm, "point relaxation" ) );
+    }
+    linearSolver.setOperator ( systemMatrix );
+    linearSolver.setRightHandSide ( rhs );
+
+    vectorPtr_Type solution ( new vector_Type ( rhs->map(), Unique ) );
+    *solution = 0.;
+    const Int numIters ( linearSolver.solve ( solution ) );
+    converged = linearSolver.hasConverged() == LinearSolver::SolverOperator_Type::yes;
+
+    if ( comm->MyPID() == 0 )
+    {
+        std::cout << " " << method;
+        if ( method == "SStepGmres" )
+        {
+            std::cout << " (" << stepsPerReduction << " steps per reduction)";
+        }
+        std::cout << ( preconditioned ? ", Jacobi" : ", no preconditioner" ) << ": "
+                  << numIters << " iterations" << std::endl;
+    }
+
+    return solution;
+}
+
+int
+main ( int argc, char** argv )
+{
+#ifdef HAVE_MPI
+    MPI_Init ( &argc, &argv );
+#endif
+
+    bool success ( true );
+
+    {
+#ifdef HAVE_MPI
+        std::shared_ptr<Epetra_Comm> comm ( new Epetra_MpiComm ( MPI_COMM_WORLD ) );
+#else
+        std::shared_ptr<Epetra_Comm> comm ( new Epetra_SerialComm );
+#endif
+
+        const bool verbose ( comm->MyPID() == 0 );
+
+        fespacePtr_Type feSpace ( buildFESpace ( comm, 8 ) );
+        matrixPtr_Type systemMatrix ( assembleSystem ( feSpace, 1., 0.1 ) );
+
+        vectorPtr_Type rhs ( new vector_Type ( feSpace->map(), Unique ) );
+        rhs->epetraVector().Random();
+
+        const std::string methods[] = { "PipelinedCG", "SStepGmres", "SStepGmres" };
+        const Int steps[] = { 4, 4, 12 };
+
+        for ( UInt iPrec ( 0 ); iPrec < 2; ++iPrec )
+        {
+            const bool preconditioned ( iPrec == 1 );
+
+            bool referenceConverged;
+            vectorPtr_Type reference ( solveSystem ( comm, systemMatrix, rhs, "Belos", 0, preconditioned, referenceConverged ) );
+            success = success && referenceConverged;
+
+            for ( UInt iMethod ( 0 ); iMethod < 3; ++iMethod )
+            {
+                bool converged;
+                vectorPtr_Type solution ( solveSystem ( comm, systemMatrix, rhs, methods[iMethod], steps[iMethod],
+                                                        preconditioned, converged ) );
+
+                const Real residual ( relativeResidual ( *systemMatrix, *rhs, *solution ) );
+
+                vector_Type difference ( *solution );
+                difference -= *reference;
+                const Real solutionDiff ( difference.norm2() / reference->norm2() );
+
+                if ( verbose )
+                {
+                    std::cout << "   relative residual " << residual
+                              << ", relative difference with Belos " << solutionDiff << std::endl;
+                }
+
+                success = success && converged && residual < 1e-8 && solutionDiff < 1e-5;
+            }
+        }
+
+        if ( verbose )
+        {
+            std::cout << ( success ? "Test status: SUCCESS" : "Test status: FAILURE" ) << std::endl;
+        }
+    }
+
+#ifdef HAVE_MPI
+    MPI_Finalize();
+#endif
+
+    return ( success ? EXIT_SUCCESS : EXIT_FAILURE );
+}
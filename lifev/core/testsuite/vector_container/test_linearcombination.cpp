@@ -0,0 +1,216 @@
+//@HEADER
+/*
+*******************************************************************************
+
+    Copyright (C) 2004, 2005, 2007 EPFL, Politecnico di Milano, INRIA
+    Copyright (C) 2010 EPFL, Politecnico di Milano, Emory University
+
+    This file is part of LifeV.
+
+    LifeV is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    LifeV is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with LifeV.  If not, see <http://www.gnu.org/licenses/>.
+
+*******************************************************************************
+*/
+//@HEADER
+
+/*!
+ *  @file
+ *  @brief Test of VectorEpetra::linearCombination
+ *
+ *  @date 10-2026
+ *
+ *  The combinations with one, two and several vectors are compared with the
+ *  values computed entry by entry: on the same map, with a vector on another
+ *  map (unique vector combined in a repeated one), with the current vector
+ *  among the inputs, and with a zero coefficient for the current vector
+ *  (whose values are then ignored, even if they are not finite).
+ */
+
+#include <limits>
+
+#include <Epetra_ConfigDefs.h>
+#ifdef HAVE_MPI
+#include <mpi.h>
+#include <Epetra_MpiComm.h>
+#else
+#include <Epetra_SerialComm.h>
+#endif
+
+#include <lifev/core/LifeV.hpp>
+#include <lifev/core/array/MapEpetra.hpp>
+#include <lifev/core/array/VectorEpetra.hpp>
+
+using namespace LifeV;
+
+typedef VectorEpetra vector_Type;
+
+//! Fill the vector with value ( gid ) = a * gid + b
+void fill ( vector_Type& vector, const Real& a, const Real& b )
+{
+    const Epetra_BlockMap& map ( vector.blockMap() );
+    for ( Int i ( 0 ); i < map.NumMyElements(); ++i )
+    {
+        vector.epetraVector() [0][i] = a * map.GID ( i ) + b;
+    }
+}
+
+//! Largest difference between the vector and value ( gid ) = a * gid + b, on all the processes
+Real error ( const vector_Type& vector, const Real& a, const Real& b )
+{
+    const Epetra_BlockMap& map ( vector.blockMap() );
+
+    Real localError ( 0. );
+    for ( Int i ( 0 ); i < map.NumMyElements(); ++i )
+    {
+        const Real difference ( std::abs ( vector.epetraVector() [0][i] - ( a * map.GID ( i ) + b ) ) );
+        // A NaN is an error as well
+        localError = std::max ( localError, ( difference == difference ) ? difference : 1. );
+    }
+
+    Real globalError ( 0. );
+    map.Comm().MaxAll ( &localError, &globalError, 1 );
+    return globalError;
+}
+
+Int
+main ( Int argc, char** argv )
+{
+#ifdef HAVE_MPI
+    MPI_Init ( &argc, &argv );
+    std::shared_ptr<Epetra_Comm> comm ( new Epetra_MpiComm ( MPI_COMM_WORLD ) );
+#else
+    std::shared_ptr<Epetra_Comm> comm ( new Epetra_SerialComm );
+#endif
+
+    const bool verbose ( comm->MyPID() == 0 );
+
+    // Linear map, and a repeated map with one more entry on each side
+    const Int numGlobalElements ( 20 );
+    MapEpetra linearMap ( numGlobalElements, comm );
+
+    MapEpetraData mapData;
+    const Epetra_Map& uniqueMap ( *linearMap.map ( Unique ) );
+    for ( Int i ( 0 ); i < uniqueMap.NumMyElements(); ++i )
+    {
+        mapData.unique.push_back ( uniqueMap.GID ( i ) );
+    }
+    mapData.repeated = mapData.unique;
+    if ( uniqueMap.MinMyGID() > 0 )
+    {
+        mapData.repeated.push_back ( uniqueMap.MinMyGID() - 1 );
+    }
+    if ( uniqueMap.MaxMyGID() < numGlobalElements - 1 )
+    {
+        mapData.repeated.push_back ( uniqueMap.MaxMyGID() + 1 );
+    }
+    MapEpetra map ( mapData, comm );
+
+    vector_Type x ( map, Unique );
+    vector_Type y ( map, Unique );
+    vector_Type w ( map, Unique );
+    fill ( x, 1., 1. );
+    fill ( y, 2., 0. );
+    fill ( w, -1., 4. );
+
+    // Same map: one, two and three vectors
+    vector_Type z ( map, Unique );
+    fill ( z, 1., 0. );
+
+    z.linearCombination ( 2., x, 3. );
+    Real sameMapError ( error ( z, 5., 2. ) );
+
+    z.linearCombination ( 1., x, -1., y );
+    sameMapError = std::max ( sameMapError, error ( z, -1., 1. ) );
+
+    std::vector<Real> coefficients ( 3 );
+    std::vector<const vector_Type*> vectors ( 3 );
+    coefficients[0] = 2.;
+    coefficients[1] = -3.;
+    coefficients[2] = 0.5;
+    vectors[0] = &x;
+    vectors[1] = &y;
+    vectors[2] = &w;
+
+    z.linearCombination ( coefficients, vectors, 1. );
+    sameMapError = std::max ( sameMapError, error ( z, -1. + 2. - 6. - 0.5, 1. + 2. + 2. ) );
+
+    // Other map: the unique vectors are combined in a repeated one
+    vector_Type r ( map, Repeated );
+    fill ( r, 1., 0. );
+
+    r.linearCombination ( 2., x, 1. );
+    Real otherMapError ( error ( r, 3., 2. ) );
+
+    r.linearCombination ( 1., x, 1., y, 0. );
+    otherMapError = std::max ( otherMapError, error ( r, 3., 1. ) );
+
+    r.linearCombination ( coefficients, vectors, -1. );
+    otherMapError = std::max ( otherMapError, error ( r, -3. + 2. - 6. - 0.5, -1. + 2. + 2. ) );
+
+    // The current vector among the inputs
+    fill ( z, 1., 0. );
+    vectors[2] = &z;
+
+    z.linearCombination ( coefficients, vectors, 1. );
+    Real aliasError ( error ( z, 1. + 2. - 6. + 0.5, 2. ) );
+
+    z.linearCombination ( 1., z, 2., z, 0. );
+    aliasError = std::max ( aliasError, error ( z, 3. * ( 1. + 2. - 6. + 0.5 ), 6. ) );
+
+    // Zero coefficient: the current values are not used
+    vectors[2] = &w;
+    const Real notANumber ( std::numeric_limits<Real>::quiet_NaN() );
+
+    z = notANumber;
+    z.linearCombination ( 2., x );
+    Real zeroCoefficientError ( error ( z, 2., 2. ) );
+
+    z = notANumber;
+    z.linearCombination ( 1., x, -1., y );
+    zeroCoefficientError = std::max ( zeroCoefficientError, error ( z, -1., 1. ) );
+
+    z = notANumber;
+    z.linearCombination ( coefficients, vectors );
+    zeroCoefficientError = std::max ( zeroCoefficientError, error ( z, 2. - 6. - 0.5, 2. + 2. ) );
+
+    if ( verbose )
+    {
+        std::cout << " Error (same map): " << sameMapError << std::endl;
+        std::cout << " Error (other map): " << otherMapError << std::endl;
+        std::cout << " Error (current vector as input): " << aliasError << std::endl;
+        std::cout << " Error (zero coefficient): " << zeroCoefficientError << std::endl;
+    }
+
+#ifdef HAVE_MPI
+    MPI_Finalize();
+#endif
+
+    const Real testTolerance ( 1e-12 );
+
+    if ( sameMapError >= testTolerance || otherMapError >= testTolerance
+            || aliasError >= testTolerance || zeroCoefficientError >= testTolerance )
+    {
+        if ( verbose )
+        {
+            std::cout << "Test status: FAILURE" << std::endl;
+        }
+        return ( EXIT_FAILURE );
+    }
+
+    if ( verbose )
+    {
+        std::cout << "Test status: SUCCESS" << std::endl;
+    }
+    return ( EXIT_SUCCESS );
+}
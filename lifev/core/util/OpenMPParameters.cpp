@@ -62,4 +62,9 @@ void OpenMPParameters::restorePreviousNumThreads()
 #endif
 }
 
+void OpenMPParameters::setElementColors (const elementColors_Type& colors)
+{
+    elementColors.reset (new elementColors_Type (colors) );
+}
+
 } // namespace LifeV
@@ -40,12 +40,18 @@ along with LifeV.  If not, see <http://www.gnu.org/licenses/>.
 #include <omp.h>
 #endif
 
+#include <lifev/core/LifeV.hpp>
+
 namespace LifeV
 {
 
 //! OpenMP parameter class
 struct OpenMPParameters
 {
+    // Lists of local element indices, one list per color
+    typedef std::vector<std::vector<UInt> > elementColors_Type;
+    typedef std::shared_ptr<const elementColors_Type> elementColorsPtr_Type;
+
     // Default constructor
     OpenMPParameters();
 
@@ -54,6 +60,20 @@ struct OpenMPParameters
     // Apply OpenMP parameters
     void restorePreviousNumThreads();
 
+    // Set the element colors (e.g. from MeshColoring::getColorsForAssembly)
+    /*
+     * Elements sharing the same color must not share any vertex. When the
+     * colors are set, the assembly loops process one color at a time and
+     * the threads write concurrently in the global structures.
+     */
+    void setElementColors (const elementColors_Type& colors);
+
+    // True if a coloring of the elements is available
+    bool useColoring() const
+    {
+        return elementColors.get() != 0 && !elementColors->empty();
+    }
+
     // Data
     int numThreads;
     int numThreads_backup;
@@ -61,6 +81,7 @@ struct OpenMPParameters
     omp_sched_t scheduler;
 #endif
     int chunkSize;
+    elementColorsPtr_Type elementColors;
 };
 
 } // namespace LifeV
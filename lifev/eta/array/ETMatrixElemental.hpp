@@ -137,6 +137,42 @@ public:
                                   M_rawData, Epetra_FECrsMatrix::ROW_MAJOR);
     }
 
+    //! Assembly procedure for a matrix or a block of a matrix
+    /*!
+    This method puts the values stored in this elemental matrix into the global
+    matrix passed as argument, using the positions given in the global indices
+    stored.
+    The method is used when the global matrix is closed and no other thread
+    writes in the same rows at the same time (colored assembly)
+    */
+    // Method defined in class to allow compiler optimization
+    // as this class is used repeatedly during the assembly
+    template <typename MatrixType>
+    void pushToClosedGlobalLockFree (MatrixType& mat)
+    {
+        mat.sumIntoCoefficientsLockFree ( M_nbRow, M_nbColumn,
+                                          rowIndices(), columnIndices(),
+                                          M_rawData );
+    }
+
+    //! Assembly procedure for a matrix or a block of a matrix, using cached insertion offsets
+    /*!
+    This method puts the values stored in this elemental matrix into the global
+    matrix passed as argument, at the positions stored in the offsets for the
+    given slot (see MatrixEpetraOffsets). The positions are recorded from the
+    global indices stored the first time the slot is used.
+    The method is used when the global matrix is closed
+    */
+    // Method defined in class to allow compiler optimization
+    // as this class is used repeatedly during the assembly
+    template <typename MatrixType, typename OffsetsType>
+    void pushToClosedGlobal (MatrixType& mat, OffsetsType& offsets, const UInt slot)
+    {
+        offsets.sumIntoCoefficients ( slot, mat, M_nbRow, M_nbColumn,
+                                      rowIndices(), columnIndices(),
+                                      M_rawData );
+    }
+
     //! Assembly procedure for a matrix or a block of a matrix passed in a shared_ptr
     /*!
     This method puts the values stored in this elemental matrix into the global
@@ -174,6 +210,49 @@ public:
                                    M_rawData, Epetra_FECrsMatrix::ROW_MAJOR);
     }
 
+    //! Assembly procedure for a matrix or a block of a matrix passed in a shared_ptr
+    /*!
+    This method puts the values stored in this elemental matrix into the global
+    matrix passed as argument, using the positions given in the global indices
+    stored.
+    The method is used when the global matrix is closed and no other thread
+    writes in the same rows at the same time (colored assembly)
+
+    This is a partial specialization of the other assembly procedure of this class.
+    */
+    // Method defined in class to allow compiler optimization
+    // as this class is used repeatedly during the assembly
+    template <typename MatrixType>
+    void pushToClosedGlobalLockFree (std::shared_ptr<MatrixType> mat)
+    {
+        mat->sumIntoCoefficientsLockFree ( M_nbRow, M_nbColumn,
+                                           rowIndices(), columnIndices(),
+                                           M_rawData );
+    }
+
+    //! Matrix-free product with the elemental matrix
+    /*!
+    This method multiplies this elemental matrix by the values of the vector x
+    in the global positions of the columns, and sums the result into the vector
+    y in the global positions of the rows. The vector x must contain (at least)
+    the values of the columns (e.g. a vector with a repeated map).
+    */
+    // Method defined in class to allow compiler optimization
+    // as this class is used repeatedly during the assembly
+    template <typename VectorType>
+    void pushProductToGlobal (const VectorType& x, VectorType& y)
+    {
+        for (UInt i (0); i < M_nbRow; ++i)
+        {
+            Real rowProduct (0.0);
+            for (UInt j (0); j < M_nbColumn; ++j)
+            {
+                rowProduct += M_rawData[i][j] * x[M_columnIndices[j]];
+            }
+            y.sumIntoGlobalValues (M_rowIndices[i], rowProduct);
+        }
+    }
+
     //! Ouput method for the sizes and the stored values
     void showMe ( std::ostream& out = std::cout ) const;
 
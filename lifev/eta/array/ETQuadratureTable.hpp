@@ -0,0 +1,285 @@
+//@HEADER
+/*
+*******************************************************************************
+
+   Copyright (C) 2004, 2005, 2007 EPFL, Politecnico di Milano, INRIA
+   Copyright (C) 2010 EPFL, Politecnico di Milano, Emory UNiversity
+
+   This file is part of the LifeV library
+
+   LifeV is free software; you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+
+   LifeV is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with this library; if not, see <http://www.gnu.org/licenses/>
+
+
+*******************************************************************************
+*/
+//@HEADER
+
+/*!
+ *   @file
+     @brief This file contains the definition of the ETQuadratureTable class
+ */
+
+#ifndef ET_QUADRATURE_TABLE_HPP
+#define ET_QUADRATURE_TABLE_HPP
+
+#include <cstddef>
+#include <new>
+
+#include <lifev/core/LifeV.hpp>
+
+namespace LifeV
+{
+
+//! class ETQuadratureTable  A contiguous table of values indexed by quadrature node and basis function
+/*!
+    This class stores the values of the basis functions (or of their derivatives)
+    in the quadrature nodes, for all the basis functions of an element. The values
+    are stored in a single block of memory, quadrature node by quadrature node:
+    the value for the quadrature node q and the basis function i is stored at the
+    position q * nbDof() + i. When DataType is itself a small fixed size array
+    (VectorSmall, MatrixSmall), the resulting layout is [q][i][d].
+
+    The beginning of the block is aligned on S_alignment bytes, so that the loops
+    of the Evaluation classes over the quadrature nodes and the basis functions
+    stream over contiguous, aligned memory.
+
+    The syntax table[q][i] is kept, so that the table can replace the nested
+    std::vector used before.
+*/
+template <typename DataType>
+class ETQuadratureTable
+{
+
+public:
+
+    //! @name Public Types
+    //@{
+
+    typedef DataType data_Type;
+
+    //@}
+
+
+    //! @name Static constants
+    //@{
+
+    //! Alignment (in bytes) of the stored values
+    static const std::size_t S_alignment = 64;
+
+    //@}
+
+
+    //! @name Constructors & Destructor
+    //@{
+
+    //! Empty constructor
+    ETQuadratureTable()
+        :   M_nbQuadPt (0),
+            M_nbDof (0),
+            M_buffer (0),
+            M_data (0)
+    {}
+
+    //! Constructor with the sizes
+    ETQuadratureTable (const UInt& nbQuadPt, const UInt& nbDof)
+        :   M_nbQuadPt (0),
+            M_nbDof (0),
+            M_buffer (0),
+            M_data (0)
+    {
+        resize (nbQuadPt, nbDof);
+    }
+
+    //! Copy constructor (including deep copy of the data)
+    ETQuadratureTable (const ETQuadratureTable<DataType>& table)
+        :   M_nbQuadPt (0),
+            M_nbDof (0),
+            M_buffer (0),
+            M_data (0)
+    {
+        allocate (table.M_nbQuadPt, table.M_nbDof, table.M_data);
+    }
+
+    //! Destructor
+    ~ETQuadratureTable()
+    {
+        release();
+    }
+
+    //@}
+
+
+    //! @name Operators
+    //@{
+
+    //! Assignement operator (including deep copy of the data)
+    ETQuadratureTable<DataType>& operator= (const ETQuadratureTable<DataType>& table)
+    {
+        if (this != &table)
+        {
+            release();
+            allocate (table.M_nbQuadPt, table.M_nbDof, table.M_data);
+        }
+        return *this;
+    }
+
+    //! Access (read-write) to the values of the qth quadrature node
+    DataType* operator[] (const UInt& q)
+    {
+        ASSERT (q < M_nbQuadPt, "No quadrature point with this index");
+        return M_data + q * M_nbDof;
+    }
+
+    //! Access (read-only) to the values of the qth quadrature node
+    const DataType* operator[] (const UInt& q) const
+    {
+        ASSERT (q < M_nbQuadPt, "No quadrature point with this index");
+        return M_data + q * M_nbDof;
+    }
+
+    //@}
+
+
+    //! @name Methods
+    //@{
+
+    //! Reshape the table
+    /*!
+      If the sizes are not changed, the stored values are kept. Otherwise,
+      the values are reset to their default value (zero for the Real,
+      VectorSmall and MatrixSmall types).
+     */
+    void resize (const UInt& nbQuadPt, const UInt& nbDof)
+    {
+        if (nbQuadPt == M_nbQuadPt && nbDof == M_nbDof)
+        {
+            return;
+        }
+        release();
+        allocate (nbQuadPt, nbDof, 0);
+    }
+
+    //@}
+
+
+    //! @name Get Methods
+    //@{
+
+    //! Getter for the number of quadrature nodes
+    UInt nbQuadPt() const
+    {
+        return M_nbQuadPt;
+    }
+
+    //! Getter for the number of basis functions
+    UInt nbDof() const
+    {
+        return M_nbDof;
+    }
+
+    //! Getter for the number of quadrature nodes (std::vector like interface)
+    UInt size() const
+    {
+        return M_nbQuadPt;
+    }
+
+    //! Getter for the stored values (contiguous, aligned block)
+    const DataType* data() const
+    {
+        return M_data;
+    }
+
+    //! Getter for the stored values (contiguous, aligned block)
+    DataType* data()
+    {
+        return M_data;
+    }
+
+    //@}
+
+private:
+
+    //! @name Private Methods
+    //@{
+
+    //! Allocate the block and build the values (copied from the source, if any)
+    void allocate (const UInt& nbQuadPt, const UInt& nbDof, const DataType* source)
+    {
+        const std::size_t nbValues (nbQuadPt * nbDof);
+
+        M_nbQuadPt = nbQuadPt;
+        M_nbDof = nbDof;
+
+        if (nbValues == 0)
+        {
+            return;
+        }
+
+        M_buffer = new char[nbValues * sizeof (DataType) + S_alignment];
+
+        const std::size_t misalignment (reinterpret_cast<std::size_t> (M_buffer) % S_alignment);
+        M_data = reinterpret_cast<DataType*> (M_buffer + (S_alignment - misalignment) % S_alignment);
+
+        for (std::size_t iValue (0); iValue < nbValues; ++iValue)
+        {
+            if (source != 0)
+            {
+                new (M_data + iValue) DataType (source[iValue]);
+            }
+            else
+            {
+                new (M_data + iValue) DataType();
+            }
+        }
+    }
+
+    //! Destroy the values and free the block
+    void release()
+    {
+        const std::size_t nbValues (M_nbQuadPt * M_nbDof);
+
+        for (std::size_t iValue (0); iValue < nbValues && M_data != 0; ++iValue)
+        {
+            M_data[iValue].~DataType();
+        }
+
+        delete [] M_buffer;
+
+        M_buffer = 0;
+        M_data = 0;
+        M_nbQuadPt = 0;
+        M_nbDof = 0;
+    }
+
+    //@}
+
+    // Number of quadrature nodes
+    UInt M_nbQuadPt;
+
+    // Number of basis functions
+    UInt M_nbDof;
+
+    // Raw memory block
+    char* M_buffer;
+
+    // Aligned beginning of the values in the block
+    DataType* M_data;
+};
+
+template <typename DataType>
+const std::size_t ETQuadratureTable<DataType>::S_alignment;
+
+} // Namespace LifeV
+
+#endif
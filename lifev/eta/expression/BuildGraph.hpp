@@ -151,6 +151,83 @@ GraphElement < MeshType,
             ompParams, offsetUp, offsetLeft);
 }
 
+//! Function to precompute the matrix graph from the topology only
+/*!
+  @author Radu Popescu <radu.popescu@epfl.ch>
+
+  This is a helper function to precompute the Crs graph used to build
+  a FECrsMatrix in closed optimized form. The graph is derived from the
+  connectivity between the elements and the degrees of freedom, so that
+  neither a quadrature nor an expression is required.
+ */
+template < typename MeshType,
+         typename TestSpaceType,
+         typename SolutionSpaceType >
+GraphElement < MeshType,
+             TestSpaceType,
+             SolutionSpaceType,
+             ExpressionScalar >
+             buildGraph ( const RequestLoopElement<MeshType>& request,
+                          const std::shared_ptr<TestSpaceType>& testSpace,
+                          const std::shared_ptr<SolutionSpaceType>& solutionSpace,
+                          const UInt offsetUp = 0,
+                          const UInt offsetLeft = 0);
+template < typename MeshType,
+         typename TestSpaceType,
+         typename SolutionSpaceType >
+GraphElement < MeshType,
+             TestSpaceType,
+             SolutionSpaceType,
+             ExpressionScalar >
+             buildGraph ( const RequestLoopElement<MeshType>& request,
+                          const std::shared_ptr<TestSpaceType>& testSpace,
+                          const std::shared_ptr<SolutionSpaceType>& solutionSpace,
+                          const UInt offsetUp,
+                          const UInt offsetLeft)
+{
+    return GraphElement < MeshType,
+           TestSpaceType,
+           SolutionSpaceType,
+           ExpressionScalar >
+           (request.mesh(), testSpace, solutionSpace,
+            OpenMPParameters(), offsetUp, offsetLeft );
+}
+
+template < typename MeshType,
+         typename TestSpaceType,
+         typename SolutionSpaceType >
+GraphElement < MeshType,
+             TestSpaceType,
+             SolutionSpaceType,
+             ExpressionScalar >
+             buildGraph ( const RequestLoopElement<MeshType>& request,
+                          const std::shared_ptr<TestSpaceType>& testSpace,
+                          const std::shared_ptr<SolutionSpaceType>& solutionSpace,
+                          const OpenMPParameters& ompParams,
+                          const UInt offsetUp = 0,
+                          const UInt offsetLeft = 0);
+template < typename MeshType,
+         typename TestSpaceType,
+         typename SolutionSpaceType >
+GraphElement < MeshType,
+             TestSpaceType,
+             SolutionSpaceType,
+             ExpressionScalar >
+             buildGraph ( const RequestLoopElement<MeshType>& request,
+                          const std::shared_ptr<TestSpaceType>& testSpace,
+                          const std::shared_ptr<SolutionSpaceType>& solutionSpace,
+                          const OpenMPParameters& ompParams,
+                          const UInt offsetUp,
+                          const UInt offsetLeft)
+{
+    return GraphElement < MeshType,
+           TestSpaceType,
+           SolutionSpaceType,
+           ExpressionScalar >
+           (request.mesh(), testSpace, solutionSpace,
+            ompParams, offsetUp, offsetLeft);
+}
+
 } // Namespace ExpressionAssembly
 
 } // Namespace LifeV
@@ -38,6 +38,8 @@
 
 #include <lifev/core/LifeV.hpp>
 
+#include <lifev/eta/array/ETQuadratureTable.hpp>
+
 #include <lifev/eta/fem/ETCurrentFE.hpp>
 #include <lifev/eta/fem/ETCurrentFlag.hpp>
 #include <lifev/core/fem/QuadratureRule.hpp>
@@ -177,7 +179,7 @@ public:
     const return_Type& value_qi (const UInt& q, const UInt& i) const
     {
         ASSERT ( q < M_valuesPtr->size(), "Quadrature point index invalid");
-        ASSERT ( i < (*M_valuesPtr) [q].size(), "Dof index invalid");
+        ASSERT ( i < M_valuesPtr->nbDof(), "Dof index invalid");
         return (*M_valuesPtr) [q][i];
     }
 
@@ -185,7 +187,7 @@ public:
     const return_Type& value_qij (const UInt& q, const UInt& i, const UInt& /*j*/) const
     {
         ASSERT ( q < M_valuesPtr->size(), "Quadrature point index invalid");
-        ASSERT ( i < (*M_valuesPtr) [q].size(), "Dof index invalid");
+        ASSERT ( i < M_valuesPtr->nbDof(), "Dof index invalid");
         return (*M_valuesPtr) [q][i];
     }
 
@@ -194,7 +196,7 @@ public:
 private:
 
     //! Storage of the pointer to the data
-    std::vector< std::vector < return_Type > > const* M_valuesPtr;
+    ETQuadratureTable< return_Type > const* M_valuesPtr;
 
 };
 
@@ -312,7 +314,7 @@ public:
     const return_Type& value_qi (const UInt& q, const UInt& i) const
     {
         ASSERT ( q < M_valuesPtr->size(), "Quadrature point index invalid");
-        ASSERT ( i < (*M_valuesPtr) [q].size(), "Dof index invalid");
+        ASSERT ( i < M_valuesPtr->nbDof(), "Dof index invalid");
         return (*M_valuesPtr) [q][i];
     }
 
@@ -320,7 +322,7 @@ public:
     const return_Type& value_qij (const UInt& q, const UInt& i, const UInt& /*j*/) const
     {
         ASSERT ( q < M_valuesPtr->size(), "Quadrature point index invalid");
-        ASSERT ( i < (*M_valuesPtr) [q].size(), "Dof index invalid");
+        ASSERT ( i < M_valuesPtr->nbDof(), "Dof index invalid");
         return (*M_valuesPtr) [q][i];
     }
 
@@ -329,7 +331,7 @@ public:
 private:
 
     //! Storage of the pointer to the data
-    std::vector< std::vector < return_Type > > const* M_valuesPtr;
+    ETQuadratureTable< return_Type > const* M_valuesPtr;
 
 };
 
@@ -39,6 +39,8 @@
 
 #include <lifev/core/LifeV.hpp>
 
+#include <lifev/eta/array/ETQuadratureTable.hpp>
+
 #include <lifev/eta/fem/ETCurrentFE.hpp>
 #include <lifev/eta/fem/ETCurrentFlag.hpp>
 #include <lifev/core/fem/QuadratureRule.hpp>
@@ -185,7 +187,7 @@ public:
 private:
 
     //! Pointer to the data
-    std::vector< std::vector < return_Type > > const* M_valuesPtr;
+    ETQuadratureTable< return_Type > const* M_valuesPtr;
 
 };
 
@@ -311,7 +313,7 @@ public:
 private:
 
     //! Pointer to the data
-    std::vector< std::vector < return_Type > > const* M_valuesPtr;
+    ETQuadratureTable< return_Type > const* M_valuesPtr;
 
 };
 
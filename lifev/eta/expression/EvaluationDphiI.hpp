@@ -38,6 +38,8 @@
 
 #include <lifev/core/LifeV.hpp>
 
+#include <lifev/eta/array/ETQuadratureTable.hpp>
+
 #include <lifev/eta/fem/ETCurrentFE.hpp>
 #include <lifev/eta/fem/ETCurrentFlag.hpp>
 #include <lifev/core/fem/QuadratureRule.hpp>
@@ -156,7 +158,7 @@ public:
     const return_Type& value_qi (const UInt& q, const UInt& i) const
     {
         ASSERT ( q < M_valuesPtr->size(), "Quadrature point index invalid");
-        ASSERT ( i < (*M_valuesPtr) [q].size(), "Dof index invalid");
+        ASSERT ( i < M_valuesPtr->nbDof(), "Dof index invalid");
         return (*M_valuesPtr) [q][i];
     }
 
@@ -164,7 +166,7 @@ public:
     const return_Type& value_qij (const UInt& q, const UInt& i, const UInt& /*j*/) const
     {
         ASSERT ( q < M_valuesPtr->size(), "Quadrature point index invalid");
-        ASSERT ( i < (*M_valuesPtr) [q].size(), "Dof index invalid");
+        ASSERT ( i < M_valuesPtr->nbDof(), "Dof index invalid");
         return (*M_valuesPtr) [q][i];
     }
 
@@ -173,7 +175,7 @@ public:
 private:
 
     //! Storage of the pointer to the data
-    std::vector< std::vector < return_Type > > const* M_valuesPtr;
+    ETQuadratureTable< return_Type > const* M_valuesPtr;
 
 };
 
@@ -291,7 +293,7 @@ public:
     const return_Type& value_qi (const UInt& q, const UInt& i) const
     {
         ASSERT ( q < M_valuesPtr->size(), "Quadrature point index invalid");
-        ASSERT ( i < (*M_valuesPtr) [q].size(), "Dof index invalid");
+        ASSERT ( i < M_valuesPtr->nbDof(), "Dof index invalid");
         return (*M_valuesPtr) [q][i];
     }
 
@@ -299,7 +301,7 @@ public:
     const return_Type& value_qij (const UInt& q, const UInt& i, const UInt& /*j*/) const
     {
         ASSERT ( q < M_valuesPtr->size(), "Quadrature point index invalid");
-        ASSERT ( i < (*M_valuesPtr) [q].size(), "Dof index invalid");
+        ASSERT ( i < M_valuesPtr->nbDof(), "Dof index invalid");
         return (*M_valuesPtr) [q][i];
     }
 
@@ -308,7 +310,7 @@ public:
 private:
 
     //! Storage of the pointer to the data
-    std::vector< std::vector < VectorSmall<spaceDim> > > const* M_valuesPtr;
+    ETQuadratureTable< VectorSmall<spaceDim> > const* M_valuesPtr;
 
 };
 
@@ -39,6 +39,8 @@
 
 #include <lifev/core/LifeV.hpp>
 
+#include <lifev/eta/array/ETQuadratureTable.hpp>
+
 #include <lifev/eta/fem/ETCurrentFE.hpp>
 #include <lifev/eta/fem/ETCurrentFlag.hpp>
 #include <lifev/core/fem/QuadratureRule.hpp>
@@ -165,7 +167,7 @@ public:
 private:
 
     //! Pointer to the data
-    std::vector< std::vector < return_Type > > const* M_valuesPtr;
+    ETQuadratureTable< return_Type > const* M_valuesPtr;
 
 };
 
@@ -291,7 +293,7 @@ public:
 private:
 
     //! Pointer to the data
-    std::vector< std::vector < VectorSmall<spaceDim> > > const* M_valuesPtr;
+    ETQuadratureTable< VectorSmall<spaceDim> > const* M_valuesPtr;
 
 };
 
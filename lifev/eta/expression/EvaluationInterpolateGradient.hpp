@@ -47,6 +47,7 @@
 #include <lifev/eta/fem/ETFESpace.hpp>
 #include <lifev/core/fem/QuadratureRule.hpp>
 
+#include <lifev/eta/expression/EvaluationSharedInterpolation.hpp>
 #include <lifev/eta/expression/ExpressionInterpolateGradient.hpp>
 
 #include <boost/shared_ptr.hpp>
@@ -91,6 +92,9 @@ public:
     //! Type of the vector to be used
     typedef VectorEpetra vector_Type;
 
+    //! Type of the data of the interpolation
+    typedef EvaluationSharedInterpolation<ETCurrentFE<SpaceDim, FieldDim>, return_Type> shared_Type;
+
     //@}
 
 
@@ -116,11 +120,11 @@ public:
     EvaluationInterpolateGradient (const EvaluationInterpolateGradient<MeshType, MapType, SpaceDim, FieldDim>& evaluation)
         :
         M_fespace ( evaluation.M_fespace),
-        M_vector ( evaluation.M_vector, Repeated),
         M_quadrature (0),
-        M_currentFE (evaluation.M_currentFE),
-        M_interpolatedGradients (evaluation.M_interpolatedGradients)
+        M_shared (shared_Type::share (sharedKey(), * (evaluation.M_shared) ) )
     {
+        M_shared->addUser();
+
         if (evaluation.M_quadrature != 0)
         {
             M_quadrature = new QuadratureRule (* (evaluation.M_quadrature) );
@@ -131,15 +135,17 @@ public:
     explicit EvaluationInterpolateGradient (const ExpressionInterpolateGradient<MeshType, MapType, SpaceDim, FieldDim>& expression)
         :
         M_fespace ( expression.fespace() ),
-        M_vector ( expression.vector(), Repeated ),
         M_quadrature (0),
-        M_currentFE (M_fespace->refFE(), M_fespace->geoMap() ),
-        M_interpolatedGradients (0)
-    {}
+        M_shared (new shared_Type (expression.vector(), *M_fespace) )
+    {
+        M_shared->addUser();
+    }
 
     //! Destructor
     ~EvaluationInterpolateGradient()
     {
+        M_shared->removeUser();
+
         if (M_quadrature != 0)
         {
             delete M_quadrature;
@@ -154,24 +160,34 @@ public:
     //! Internal update: computes the interpolated gradients
     void update (const UInt& iElement)
     {
+        if (!M_shared->needsUpdate (iElement) )
+        {
+            return;
+        }
+
+        ETCurrentFE<SpaceDim, FieldDim>& currentFE (M_shared->currentFE() );
+        std::vector<return_Type>& interpolatedGradients (M_shared->values() );
+
         zero();
 
-        M_currentFE.update (M_fespace->mesh()->element (iElement), ET_UPDATE_DPHI);
+        currentFE.update (M_fespace->mesh()->element (iElement), ET_UPDATE_DPHI);
+
+        // Nodal values of the element, component by component
+        const Real* nodalValues (M_shared->gather (iElement, M_fespace->dof(), 0) );
 
-        for (UInt i (0); i < M_fespace->refFE().nbDof(); ++i)
+        for (UInt q (0); q < M_quadrature->nbQuadPt(); ++q)
         {
-            for (UInt q (0); q < M_quadrature->nbQuadPt(); ++q)
+            for (UInt i (0); i < currentFE.nbFEDof(); ++i)
             {
-                for (UInt iDim (0); iDim < SpaceDim; ++iDim)
+                for (UInt jDim (0); jDim < FieldDim; ++jDim)
                 {
-                    for (UInt jDim (0); jDim < FieldDim; ++jDim)
-                    {
-                        UInt globalID (M_fespace->dof().localToGlobalMap (iElement, i)
-                                       + jDim * M_fespace->dof().numTotalDof() );
+                    const UInt localDof (jDim * currentFE.nbFEDof() + i);
 
-                        M_interpolatedGradients[q][jDim][iDim] +=
-                            M_currentFE.dphi (jDim * M_currentFE.nbFEDof() + i, jDim, iDim, q)
-                            * M_vector[globalID];
+                    for (UInt iDim (0); iDim < SpaceDim; ++iDim)
+                    {
+                        interpolatedGradients[q][jDim][iDim] +=
+                            currentFE.dphi (localDof, jDim, iDim, q)
+                            * nodalValues[localDof];
                     }
                 }
             }
@@ -187,7 +203,7 @@ public:
             {
                 for (UInt j (0); j < FieldDim; ++j)
                 {
-                    M_interpolatedGradients[q][j][i] = 0.0;
+                    M_shared->values()[q][j][i] = 0.0;
                 }
             }
         }
@@ -200,7 +216,7 @@ public:
 
         for (UInt i (0); i < M_quadrature->nbQuadPt(); ++i)
         {
-            std::cout << M_interpolatedGradients[i] << std::endl;
+            std::cout << M_shared->values()[i] << std::endl;
         }
     }
 
@@ -239,8 +255,7 @@ public:
             delete M_quadrature;
         }
         M_quadrature = new QuadratureRule (qr);
-        M_currentFE.setQuadratureRule (qr);
-        M_interpolatedGradients.resize (qr.nbQuadPt() );
+        M_shared->setQuadrature (qr);
     }
 
     //@}
@@ -252,19 +267,19 @@ public:
     //! Getter for a value
     return_Type value_q (const UInt& q) const
     {
-        return M_interpolatedGradients[q];
+        return M_shared->values()[q];
     }
 
     //! Getter for the value for a vector
     return_Type value_qi (const UInt& q, const UInt& /*i*/) const
     {
-        return M_interpolatedGradients[q];
+        return M_shared->values()[q];
     }
 
     //! Getter for the value for a matrix
     return_Type value_qij (const UInt& q, const UInt& /*i*/, const UInt& /*j*/) const
     {
-        return M_interpolatedGradients[q];
+        return M_shared->values()[q];
     }
 
     //@}
@@ -278,18 +293,20 @@ private:
     //! No empty constructor
     EvaluationInterpolateGradient();
 
+    //! Key of the group of nodes sharing the interpolation
+    typename shared_Type::key_Type sharedKey() const
+    {
+        return typename shared_Type::key_Type (M_fespace.get(), 0);
+    }
+
     //@}
 
     //! Data storage
     fespacePtr_Type M_fespace;
-    vector_Type M_vector;
     QuadratureRule* M_quadrature;
 
-    //! Structure for the computations
-    ETCurrentFE<SpaceDim, FieldDim> M_currentFE;
-
-    //! Storage for the temporary values
-    std::vector<return_Type> M_interpolatedGradients;
+    //! Interpolated vector, current FE and values (possibly shared with other nodes)
+    std::shared_ptr<shared_Type> M_shared;
 };
 
 template<typename MeshType, typename MapType, UInt SpaceDim, UInt FieldDim>
@@ -340,6 +357,9 @@ public:
     //! Type of the vector to be used
     typedef VectorEpetra vector_Type;
 
+    //! Type of the data of the interpolation
+    typedef EvaluationSharedInterpolation<ETCurrentFE<SpaceDim, 1>, return_Type> shared_Type;
+
     //@}
 
 
@@ -365,12 +385,12 @@ public:
     EvaluationInterpolateGradient (const EvaluationInterpolateGradient<MeshType, MapType, SpaceDim, 1>& evaluation)
         :
         M_fespace ( evaluation.M_fespace),
-        M_vector ( evaluation.M_vector, Repeated),
         M_offset ( evaluation.M_offset ),
         M_quadrature (0),
-        M_currentFE (evaluation.M_currentFE),
-        M_interpolatedGradients (evaluation.M_interpolatedGradients)
+        M_shared (shared_Type::share (sharedKey(), * (evaluation.M_shared) ) )
     {
+        M_shared->addUser();
+
         if (evaluation.M_quadrature != 0)
         {
             M_quadrature = new QuadratureRule (* (evaluation.M_quadrature) );
@@ -381,16 +401,18 @@ public:
     explicit EvaluationInterpolateGradient (const ExpressionInterpolateGradient<MeshType, MapType, SpaceDim, 1>& expression)
         :
         M_fespace ( expression.fespace() ),
-        M_vector ( expression.vector(), Repeated ),
         M_offset ( expression.offset() ),
         M_quadrature (0),
-        M_currentFE (M_fespace->refFE(), M_fespace->geoMap() ),
-        M_interpolatedGradients (0)
-    {}
+        M_shared (new shared_Type (expression.vector(), *M_fespace) )
+    {
+        M_shared->addUser();
+    }
 
     //! Destructor
     ~EvaluationInterpolateGradient()
     {
+        M_shared->removeUser();
+
         if (M_quadrature != 0)
         {
             delete M_quadrature;
@@ -406,21 +428,29 @@ public:
     //! Internal update: computes the interpolated gradients
     void update (const UInt& iElement)
     {
+        if (!M_shared->needsUpdate (iElement) )
+        {
+            return;
+        }
+
+        ETCurrentFE<SpaceDim, 1>& currentFE (M_shared->currentFE() );
+        std::vector<return_Type>& interpolatedGradients (M_shared->values() );
+
         zero();
 
-        M_currentFE.update (M_fespace->mesh()->element (iElement), ET_UPDATE_DPHI);
+        currentFE.update (M_fespace->mesh()->element (iElement), ET_UPDATE_DPHI);
+
+        const Real* nodalValues (M_shared->gather (iElement, M_fespace->dof(), M_offset) );
 
-        for (UInt i (0); i < M_fespace->refFE().nbDof(); ++i)
+        for (UInt q (0); q < M_quadrature->nbQuadPt(); ++q)
         {
-            for (UInt q (0); q < M_quadrature->nbQuadPt(); ++q)
+            for (UInt i (0); i < M_fespace->refFE().nbDof(); ++i)
             {
-                UInt globalID (M_fespace->dof().localToGlobalMap (iElement, i) + M_offset);
-
                 for (UInt iDim (0); iDim < SpaceDim; ++iDim)
                 {
-                    M_interpolatedGradients[q][iDim] +=
-                        M_currentFE.dphi (i, iDim, q)
-                        * M_vector[globalID];
+                    interpolatedGradients[q][iDim] +=
+                        currentFE.dphi (i, iDim, q)
+                        * nodalValues[i];
                 }
             }
         }
@@ -433,7 +463,7 @@ public:
         {
             for (UInt i (0); i < SpaceDim; ++i)
             {
-                M_interpolatedGradients[q][i] = 0.0;
+                M_shared->values()[q][i] = 0.0;
             }
         }
     }
@@ -445,7 +475,7 @@ public:
 
         for (UInt i (0); i < M_quadrature->nbQuadPt(); ++i)
         {
-            std::cout << M_interpolatedGradients[i] << std::endl;
+            std::cout << M_shared->values()[i] << std::endl;
         }
     }
 
@@ -484,8 +514,7 @@ public:
             delete M_quadrature;
         }
         M_quadrature = new QuadratureRule (qr);
-        M_currentFE.setQuadratureRule (qr);
-        M_interpolatedGradients.resize (qr.nbQuadPt() );
+        M_shared->setQuadrature (qr);
     }
 
     //@}
@@ -497,19 +526,19 @@ public:
     //! Getter for a value
     return_Type value_q (const UInt& q) const
     {
-        return M_interpolatedGradients[q];
+        return M_shared->values()[q];
     }
 
     //! Getter for the value for a vector
     return_Type value_qi (const UInt& q, const UInt& /*i*/) const
     {
-        return M_interpolatedGradients[q];
+        return M_shared->values()[q];
     }
 
     //! Getter for the value for a matrix
     return_Type value_qij (const UInt& q, const UInt& /*i*/, const UInt& /*j*/) const
     {
-        return M_interpolatedGradients[q];
+        return M_shared->values()[q];
     }
 
     //@}
@@ -522,19 +551,21 @@ private:
     //! No empty constructor
     EvaluationInterpolateGradient();
 
+    //! Key of the group of nodes sharing the interpolation
+    typename shared_Type::key_Type sharedKey() const
+    {
+        return typename shared_Type::key_Type (M_fespace.get(), M_offset);
+    }
+
     //@}
 
     //! Data storage
     fespacePtr_Type M_fespace;
-    vector_Type M_vector;
     UInt M_offset;
     QuadratureRule* M_quadrature;
 
-    //! Structure for the computations
-    ETCurrentFE<SpaceDim, 1> M_currentFE;
-
-    //! Storage for the temporary values
-    std::vector<return_Type> M_interpolatedGradients;
+    //! Interpolated vector, current FE and values (possibly shared with other nodes)
+    std::shared_ptr<shared_Type> M_shared;
 };
 
 
@@ -588,6 +619,9 @@ public:
     //! Type of the vector to be used
     typedef VectorEpetra vector_Type;
 
+    //! Type of the data of the interpolation
+    typedef EvaluationSharedInterpolation<ETCurrentFE<3, 3>, return_Type> shared_Type;
+
     //@}
 
 
@@ -613,12 +647,12 @@ public:
     EvaluationInterpolateGradient (const EvaluationInterpolateGradient<MeshType, MapType, 3, 3>& evaluation)
         :
         M_fespace ( evaluation.M_fespace),
-        M_vector ( evaluation.M_vector, Repeated),
         M_offset ( evaluation.M_offset ),
         M_quadrature (0),
-        M_currentFE (evaluation.M_currentFE),
-        M_interpolatedGradients (evaluation.M_interpolatedGradients)
+        M_shared (shared_Type::share (sharedKey(), * (evaluation.M_shared) ) )
     {
+        M_shared->addUser();
+
         if (evaluation.M_quadrature != 0)
         {
             M_quadrature = new QuadratureRule (* (evaluation.M_quadrature) );
@@ -629,16 +663,18 @@ public:
     explicit EvaluationInterpolateGradient (const ExpressionInterpolateGradient<MeshType, MapType, 3, 3>& expression)
         :
         M_fespace ( expression.fespace() ),
-        M_vector ( expression.vector(), Repeated ),
         M_offset ( expression.offset() ),
         M_quadrature (0),
-        M_currentFE (M_fespace->refFE(), M_fespace->geoMap() ),
-        M_interpolatedGradients (0)
-    {}
+        M_shared (new shared_Type (expression.vector(), *M_fespace) )
+    {
+        M_shared->addUser();
+    }
 
     //! Destructor
     ~EvaluationInterpolateGradient()
     {
+        M_shared->removeUser();
+
         if (M_quadrature != 0)
         {
             delete M_quadrature;
@@ -654,10 +690,20 @@ public:
     //! Internal update: computes the interpolated gradients
     void update (const UInt& iElement)
     {
+        if (!M_shared->needsUpdate (iElement) )
+        {
+            return;
+        }
+
+        ETCurrentFE<3, 3>& currentFE (M_shared->currentFE() );
+        std::vector<return_Type>& interpolatedGradients (M_shared->values() );
+
         zero();
 
-        M_currentFE.update (M_fespace->mesh()->element (iElement), ET_UPDATE_DPHI);
-        Real nbFEDof (M_fespace->refFE().nbDof() );
+        currentFE.update (M_fespace->mesh()->element (iElement), ET_UPDATE_DPHI);
+        UInt nbFEDof (M_fespace->refFE().nbDof() );
+
+        const Real* elementValues (M_shared->gather (iElement, M_fespace->dof(), M_offset) );
 
         VectorSmall<3> nodalValues;
         MatrixSmall<3, 3> nodalGradMatrix;
@@ -666,19 +712,17 @@ public:
         {
             for (UInt iField (0); iField < 3; ++iField)
             {
-                UInt globalID (M_fespace->dof().localToGlobalMap (iElement, i) + iField * M_fespace->dof().numTotalDof() + M_offset);
-                nodalValues[iField] = M_vector[globalID];
+                nodalValues[iField] = elementValues[iField * nbFEDof + i];
             }
 
 
-
             for (UInt q (0); q < M_quadrature->nbQuadPt(); ++q)
             {
-                nodalGradMatrix = M_currentFE.dphi (i, q)
-                                  + M_currentFE.dphi (i + nbFEDof, q)
-                                  + M_currentFE.dphi (i + 2 * nbFEDof, q);
+                nodalGradMatrix = currentFE.dphi (i, q)
+                                  + currentFE.dphi (i + nbFEDof, q)
+                                  + currentFE.dphi (i + 2 * nbFEDof, q);
 
-                M_interpolatedGradients[q] += nodalGradMatrix.emult (nodalValues);
+                interpolatedGradients[q] += nodalGradMatrix.emult (nodalValues);
 
             }
 
@@ -694,7 +738,7 @@ public:
             {
                 for (UInt i (0); i < 3; ++i)
                 {
-                    M_interpolatedGradients[q][j][i] = 0.0;
+                    M_shared->values()[q][j][i] = 0.0;
                 }
             }
         }
@@ -707,7 +751,7 @@ public:
 
         for (UInt i (0); i < M_quadrature->nbQuadPt(); ++i)
         {
-            std::cout << M_interpolatedGradients[i] << std::endl;
+            std::cout << M_shared->values()[i] << std::endl;
         }
     }
 
@@ -746,8 +790,7 @@ public:
             delete M_quadrature;
         }
         M_quadrature = new QuadratureRule (qr);
-        M_currentFE.setQuadratureRule (qr);
-        M_interpolatedGradients.resize (qr.nbQuadPt() );
+        M_shared->setQuadrature (qr);
     }
 
     //@}
@@ -759,19 +802,19 @@ public:
     //! Getter for a value
     return_Type value_q (const UInt& q) const
     {
-        return M_interpolatedGradients[q];
+        return M_shared->values()[q];
     }
 
     //! Getter for the value for a vector
     return_Type value_qi (const UInt& q, const UInt& /*i*/) const
     {
-        return M_interpolatedGradients[q];
+        return M_shared->values()[q];
     }
 
     //! Getter for the value for a matrix
     return_Type value_qij (const UInt& q, const UInt& /*i*/, const UInt& /*j*/) const
     {
-        return M_interpolatedGradients[q];
+        return M_shared->values()[q];
     }
 
     //@}
@@ -784,19 +827,21 @@ private:
     //! No empty constructor
     EvaluationInterpolateGradient();
 
+    //! Key of the group of nodes sharing the interpolation
+    typename shared_Type::key_Type sharedKey() const
+    {
+        return typename shared_Type::key_Type (M_fespace.get(), M_offset);
+    }
+
     //@}
 
     //! Data storage
     fespacePtr_Type M_fespace;
-    vector_Type M_vector;
     UInt M_offset;
     QuadratureRule* M_quadrature;
 
-    //! Structure for the computations
-    ETCurrentFE<3, 3> M_currentFE;
-
-    //! Storage for the temporary values
-    std::vector<return_Type> M_interpolatedGradients;
+    //! Interpolated vector, current FE and values (possibly shared with other nodes)
+    std::shared_ptr<shared_Type> M_shared;
 };
 
 
@@ -46,6 +46,7 @@
 #include <lifev/eta/fem/ETFESpace.hpp>
 #include <lifev/core/fem/QuadratureRule.hpp>
 
+#include <lifev/eta/expression/EvaluationSharedInterpolation.hpp>
 #include <lifev/eta/expression/ExpressionInterpolateValue.hpp>
 
 #include <boost/shared_ptr.hpp>
@@ -88,6 +89,9 @@ public:
     //! Vector of the values
     typedef VectorEpetra vector_Type;
 
+    //! Type of the data of the interpolation
+    typedef EvaluationSharedInterpolation<ETCurrentFE<SpaceDim, 1>, return_Type> shared_Type;
+
     //@}
 
 
@@ -113,16 +117,14 @@ public:
     EvaluationInterpolateValue (const EvaluationInterpolateValue<MeshType, MapType, SpaceDim, FieldDim>& evaluation)
         :
         M_fespace ( evaluation.M_fespace),
-        M_vector ( evaluation.M_vector, Repeated),
         M_quadrature (0),
-        //M_currentFE(M_fespace->refFE(),M_fespace->geoMap()),
-        M_currentFE (evaluation.M_currentFE),
-        M_interpolatedValues (evaluation.M_interpolatedValues)
+        M_shared (shared_Type::share (sharedKey(), * (evaluation.M_shared) ) )
     {
+        M_shared->addUser();
+
         if (evaluation.M_quadrature != 0)
         {
             M_quadrature = new QuadratureRule (* (evaluation.M_quadrature) );
-            //M_currentFE.setQuadratureRule(*(evaluation.M_quadrature));
         }
     }
 
@@ -130,15 +132,17 @@ public:
     explicit EvaluationInterpolateValue (const ExpressionInterpolateValue<MeshType, MapType, SpaceDim, FieldDim>& expression)
         :
         M_fespace ( expression.fespace() ),
-        M_vector ( expression.vector(), Repeated ),
         M_quadrature (0),
-        M_currentFE (M_fespace->refFE(), M_fespace->geoMap() ),
-        M_interpolatedValues (0)
-    {}
+        M_shared (new shared_Type (expression.vector(), *M_fespace) )
+    {
+        M_shared->addUser();
+    }
 
     //! Destructor
     ~EvaluationInterpolateValue()
     {
+        M_shared->removeUser();
+
         if (M_quadrature != 0)
         {
             delete M_quadrature;
@@ -154,21 +158,24 @@ public:
     //! Interal update, computes the interpolated values.
     void update (const UInt& iElement)
     {
-        zero();
+        if (!M_shared->needsUpdate (iElement) )
+        {
+            return;
+        }
 
-        for (UInt i (0); i < M_fespace->refFE().nbDof(); ++i)
+        std::vector<return_Type>& interpolatedValues (M_shared->values() );
+
+        // Nodal values of the element, component by component
+        const Real* nodalValues (M_shared->gather (iElement, M_fespace->dof(), 0) );
+        const UInt nbFEDof (M_fespace->refFE().nbDof() );
+
+        for (UInt iDim (0); iDim < FieldDim; ++iDim)
         {
+            const Real* quadValues (M_shared->interpolateComponent (nodalValues + iDim * nbFEDof) );
+
             for (UInt q (0); q < M_quadrature->nbQuadPt(); ++q)
             {
-                for (UInt iDim (0); iDim < FieldDim; ++iDim)
-                {
-                    UInt globalID (M_fespace->dof().localToGlobalMap (iElement, i)
-                                   + iDim * M_fespace->dof().numTotalDof() );
-
-                    M_interpolatedValues[q][iDim] +=
-                        M_currentFE.phi (i, q)
-                        * M_vector[globalID];
-                }
+                interpolatedValues[q][iDim] = quadValues[q];
             }
         }
     }
@@ -180,7 +187,7 @@ public:
         {
             for (UInt iDim (0); iDim < FieldDim; ++iDim)
             {
-                M_interpolatedValues[q][iDim] = 0.0;
+                M_shared->values()[q][iDim] = 0.0;
             }
         }
     }
@@ -192,7 +199,7 @@ public:
 
         for (UInt i (0); i < M_quadrature->nbQuadPt(); ++i)
         {
-            std::cout << M_interpolatedValues[i] << std::endl;
+            std::cout << M_shared->values()[i] << std::endl;
         }
     }
 
@@ -231,8 +238,8 @@ public:
             delete M_quadrature;
         }
         M_quadrature = new QuadratureRule (qr);
-        M_currentFE.setQuadratureRule (qr);
-        M_interpolatedValues.resize (qr.nbQuadPt() );
+        M_shared->setQuadrature (qr);
+        M_shared->updatePhiTable();
     }
 
     //@}
@@ -244,19 +251,19 @@ public:
     //! Getter for a value
     return_Type value_q (const UInt& q) const
     {
-        return M_interpolatedValues[q];
+        return M_shared->values()[q];
     }
 
     //! Getter for the value for a vector
     return_Type value_qi (const UInt& q, const UInt& /*i*/) const
     {
-        return M_interpolatedValues[q];
+        return M_shared->values()[q];
     }
 
     //! Getter for the value for a matrix
     return_Type value_qij (const UInt& q, const UInt& /*i*/, const UInt& /*j*/) const
     {
-        return M_interpolatedValues[q];
+        return M_shared->values()[q];
     }
 
     //@}
@@ -269,15 +276,20 @@ private:
     //! No empty constructor
     EvaluationInterpolateValue();
 
+    //! Key of the group of nodes sharing the interpolation
+    typename shared_Type::key_Type sharedKey() const
+    {
+        return typename shared_Type::key_Type (M_fespace.get(), 0);
+    }
+
     //@}
 
     fespacePtr_Type M_fespace;
-    vector_Type M_vector;
 
     QuadratureRule* M_quadrature;
-    ETCurrentFE<SpaceDim, 1> M_currentFE;
 
-    std::vector<return_Type> M_interpolatedValues;
+    //! Interpolated vector, current FE and values (possibly shared with other nodes)
+    std::shared_ptr<shared_Type> M_shared;
 };
 
 
@@ -313,6 +325,9 @@ public:
     //! Type of the vector to be used
     typedef VectorEpetra vector_Type;
 
+    //! Type of the data of the interpolation
+    typedef EvaluationSharedInterpolation<ETCurrentFE<SpaceDim, 1>, return_Type> shared_Type;
+
     //@}
 
 
@@ -338,16 +353,14 @@ public:
     EvaluationInterpolateValue (const EvaluationInterpolateValue<MeshType, MapType, SpaceDim, 1>& evaluation)
         :
         M_fespace ( evaluation.M_fespace),
-        M_vector ( evaluation.M_vector, Repeated),
         M_quadrature (0),
-        //M_currentFE(M_fespace->refFE(),M_fespace->geoMap()),
-        M_currentFE (evaluation.M_currentFE),
-        M_interpolatedValues (evaluation.M_interpolatedValues)
+        M_shared (shared_Type::share (sharedKey(), * (evaluation.M_shared) ) )
     {
+        M_shared->addUser();
+
         if (evaluation.M_quadrature != 0)
         {
             M_quadrature = new QuadratureRule (* (evaluation.M_quadrature) );
-            //M_currentFE.setQuadratureRule(*(evaluation.M_quadrature));
         }
     }
 
@@ -355,15 +368,17 @@ public:
     explicit EvaluationInterpolateValue (const ExpressionInterpolateValue<MeshType, MapType, SpaceDim, 1>& expression)
         :
         M_fespace ( expression.fespace() ),
-        M_vector ( expression.vector(), Repeated ),
         M_quadrature (0),
-        M_currentFE (M_fespace->refFE(), M_fespace->geoMap() ),
-        M_interpolatedValues (0)
-    {}
+        M_shared (new shared_Type (expression.vector(), *M_fespace) )
+    {
+        M_shared->addUser();
+    }
 
     //! Destructor
     ~EvaluationInterpolateValue()
     {
+        M_shared->removeUser();
+
         if (M_quadrature != 0)
         {
             delete M_quadrature;
@@ -379,19 +394,16 @@ public:
     //! Internal update: computes the interpolated value
     void update (const UInt& iElement)
     {
-        zero();
-
-        for (UInt i (0); i < M_fespace->refFE().nbDof(); ++i)
+        if (!M_shared->needsUpdate (iElement) )
         {
-            for (UInt q (0); q < M_quadrature->nbQuadPt(); ++q)
-            {
-                UInt globalID (M_fespace->dof().localToGlobalMap (iElement, i) );
-
-                M_interpolatedValues[q] +=
-                    M_currentFE.phi (i, q)
-                    * M_vector[globalID];
-            }
+            return;
         }
+
+        // Values in the quadrature nodes: (phi(i,q)) * nodal values
+        const Real* nodalValues (M_shared->gather (iElement, M_fespace->dof(), 0) );
+        const Real* quadValues (M_shared->interpolateComponent (nodalValues) );
+
+        std::copy (quadValues, quadValues + M_quadrature->nbQuadPt(), M_shared->values().begin() );
     }
 
     //! Erase the interpolated values stored internally
@@ -399,7 +411,7 @@ public:
     {
         for (UInt q (0); q < M_quadrature->nbQuadPt(); ++q)
         {
-            M_interpolatedValues[q] = 0.0;
+            M_shared->values()[q] = 0.0;
         }
     }
 
@@ -410,7 +422,7 @@ public:
 
         for (UInt i (0); i < M_quadrature->nbQuadPt(); ++i)
         {
-            std::cout << M_interpolatedValues[i] << std::endl;
+            std::cout << M_shared->values()[i] << std::endl;
         }
     }
 
@@ -449,8 +461,8 @@ public:
             delete M_quadrature;
         }
         M_quadrature = new QuadratureRule (qr);
-        M_currentFE.setQuadratureRule (qr);
-        M_interpolatedValues.resize (qr.nbQuadPt() );
+        M_shared->setQuadrature (qr);
+        M_shared->updatePhiTable();
     }
 
     //@}
@@ -462,19 +474,19 @@ public:
     //! Getter for a value
     return_Type value_q (const UInt& q) const
     {
-        return M_interpolatedValues[q];
+        return M_shared->values()[q];
     }
 
     //! Getter for the value for a vector
     return_Type value_qi (const UInt& q, const UInt& /*i*/) const
     {
-        return M_interpolatedValues[q];
+        return M_shared->values()[q];
     }
 
     //! Getter for the value for a matrix
     return_Type value_qij (const UInt& q, const UInt& /*i*/, const UInt& /*j*/) const
     {
-        return M_interpolatedValues[q];
+        return M_shared->values()[q];
     }
 
     //@}
@@ -487,18 +499,20 @@ private:
     //! No empty constructor
     EvaluationInterpolateValue();
 
+    //! Key of the group of nodes sharing the interpolation
+    typename shared_Type::key_Type sharedKey() const
+    {
+        return typename shared_Type::key_Type (M_fespace.get(), 0);
+    }
+
     //@}
 
     //! Data storage
     fespacePtr_Type M_fespace;
-    vector_Type M_vector;
     QuadratureRule* M_quadrature;
 
-    //! Structure for the computations
-    ETCurrentFE<SpaceDim, 1> M_currentFE;
-
-    //! Storage for the temporary values
-    std::vector<return_Type> M_interpolatedValues;
+    //! Interpolated vector, current FE and values (possibly shared with other nodes)
+    std::shared_ptr<shared_Type> M_shared;
 };
 
 
@@ -38,6 +38,8 @@
 
 #include <lifev/core/LifeV.hpp>
 
+#include <lifev/eta/array/ETQuadratureTable.hpp>
+
 #include <lifev/eta/fem/ETCurrentFE.hpp>
 #include <lifev/eta/fem/ETCurrentFlag.hpp>
 #include <lifev/core/fem/QuadratureRule.hpp>
@@ -164,7 +166,7 @@ public:
 private:
 
     //! Storage of the pointer to the data
-    std::vector< std::vector < VectorSmall<fieldDim> > > const* M_valuesPtr;
+    ETQuadratureTable< VectorSmall<fieldDim> > const* M_valuesPtr;
 
 };
 
@@ -288,7 +290,7 @@ public:
 private:
 
     //! Storage of the pointer to the data
-    std::vector< std::vector < Real > > const* M_valuesPtr;
+    ETQuadratureTable< Real > const* M_valuesPtr;
 
 };
 
@@ -39,6 +39,8 @@
 
 #include <lifev/core/LifeV.hpp>
 
+#include <lifev/eta/array/ETQuadratureTable.hpp>
+
 #include <lifev/eta/fem/ETCurrentFE.hpp>
 #include <lifev/eta/fem/ETCurrentFlag.hpp>
 #include <lifev/core/fem/QuadratureRule.hpp>
@@ -157,7 +159,7 @@ public:
     const return_Type& value_qij (const UInt& q, const UInt& /*i*/, const UInt& j) const
     {
         ASSERT ( q < M_valuesPtr->size(), "Quadrature point index invalid");
-        ASSERT ( j < (*M_valuesPtr) [q].size(), "Dof index invalid");
+        ASSERT ( j < M_valuesPtr->nbDof(), "Dof index invalid");
         return (*M_valuesPtr) [q][j];
     }
 
@@ -166,7 +168,7 @@ public:
 private:
 
     //! Storage for the pointer to the data
-    std::vector< std::vector < return_Type > > const* M_valuesPtr;
+    ETQuadratureTable< return_Type > const* M_valuesPtr;
 
 };
 
@@ -276,7 +278,7 @@ public:
     const return_Type& value_qij (const UInt& q, const UInt& /*i*/, const UInt& j) const
     {
         ASSERT ( q < M_valuesPtr->size(), "Quadrature point index invalid");
-        ASSERT ( j < (*M_valuesPtr) [q].size(), "Dof index invalid");
+        ASSERT ( j < M_valuesPtr->nbDof(), "Dof index invalid");
         return (*M_valuesPtr) [q][j];
     }
 
@@ -285,7 +287,7 @@ public:
 private:
 
     //! Storage for the pointer to the data
-    std::vector< std::vector < Real > > const* M_valuesPtr;
+    ETQuadratureTable< Real > const* M_valuesPtr;
 
 };
 
@@ -0,0 +1,487 @@
+//@HEADER
+/*
+*******************************************************************************
+
+   Copyright (C) 2004, 2005, 2007 EPFL, Politecnico di Milano, INRIA
+   Copyright (C) 2010 EPFL, Politecnico di Milano, Emory UNiversity
+
+   This file is part of the LifeV library
+
+   LifeV is free software; you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+
+   LifeV is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with this library; if not, see <http://www.gnu.org/licenses/>
+
+
+*******************************************************************************
+*/
+//@HEADER
+
+/*!
+ *   @file
+     @brief This file contains the definition of the EvaluationSharedInterpolation classes.
+
+     @date 10/2026
+ */
+
+#ifndef EVALUATION_SHARED_INTERPOLATION_HPP
+#define EVALUATION_SHARED_INTERPOLATION_HPP
+
+#include <algorithm>
+#include <map>
+#include <utility>
+#include <vector>
+
+#include <lifev/core/LifeV.hpp>
+
+#include <lifev/core/array/VectorEpetra.hpp>
+#include <lifev/core/fem/DOF.hpp>
+#include <lifev/core/fem/QuadratureRule.hpp>
+
+namespace LifeV
+{
+
+namespace ExpressionAssembly
+{
+
+//! SharedInterpolationScope - Scope in which the interpolations of a FE function are shared
+/*!
+  While an object of this class is alive, the interpolation nodes of the
+  evaluation trees (value and gradient of a FE function) which are copied by
+  the current thread share their data when they interpolate the same values
+  on the same ETFESpace. The interpolation is then computed only once per
+  element for the whole tree, e.g. for the deformation gradient appearing
+  in all the terms of an hyperelastic Jacobian.
+
+  The nodes of a group assume that they are all updated on the same element
+  before being evaluated: only one evaluation tree must be copied in a scope
+  (see copyWithSharedInterpolations).
+
+  Outside of a scope, each node owns its data, as usual.
+ */
+class SharedInterpolationScope
+{
+public:
+
+    //! Open the scope
+    SharedInterpolationScope()
+    {
+        ++depth();
+    }
+
+    //! Close the scope: the groups of this scope are not joined any more
+    ~SharedInterpolationScope()
+    {
+        if (--depth() == 0)
+        {
+            ++generationRef();
+        }
+    }
+
+    //! True if a scope is open in the current thread
+    static bool isActive()
+    {
+        return depth() > 0;
+    }
+
+    //! Identifier of the current scope in the current thread
+    static UInt generation()
+    {
+        return generationRef();
+    }
+
+private:
+
+    //! No copy
+    SharedInterpolationScope (const SharedInterpolationScope&);
+
+    static UInt& depth()
+    {
+        static thread_local UInt S_depth (0);
+        return S_depth;
+    }
+
+    static UInt& generationRef()
+    {
+        static thread_local UInt S_generation (0);
+        return S_generation;
+    }
+};
+
+//! Copy an evaluation tree, sharing the interpolations of the same FE function between its nodes
+template <typename EvaluationType>
+inline EvaluationType copyWithSharedInterpolations (const EvaluationType& evaluation)
+{
+    SharedInterpolationScope scope;
+    return EvaluationType (evaluation);
+}
+
+
+//! Small dense product y = A x, with A (nbRows x nbColumns) stored row by row
+inline void denseMatrixVectorProduct (const UInt& nbRows, const UInt& nbColumns,
+                                      const Real* A, const Real* x, Real* y)
+{
+    for (UInt i (0); i < nbRows; ++i)
+    {
+        const Real* row (A + i * nbColumns);
+        Real sum (0.0);
+        for (UInt j (0); j < nbColumns; ++j)
+        {
+            sum += row[j] * x[j];
+        }
+        y[i] = sum;
+    }
+}
+
+
+//! EvaluationSharedInterpolation - Data of the interpolation of a FE function
+/*!
+  This class stores the (repeated) vector, the current FE and the values at
+  the quadrature nodes used by the interpolation nodes EvaluationInterpolateValue
+  and EvaluationInterpolateGradient. It can be used by a single node or shared
+  by several nodes of the same evaluation tree (see SharedInterpolationScope).
+
+  When it is shared by N nodes, the values are computed by the first node
+  updated on an element and reused by the N-1 others.
+
+  The nodal values of an element are gathered with the local identifiers
+  precomputed by the ETFESpace (see ETFESpace::localDofTable) when the vector
+  is defined on the map of the space, and with global identifiers otherwise.
+ */
+template <typename CurrentFEType, typename ReturnType>
+class EvaluationSharedInterpolation
+{
+public:
+
+    //! @name Public Types
+    //@{
+
+    typedef VectorEpetra vector_Type;
+
+    typedef std::shared_ptr<EvaluationSharedInterpolation<CurrentFEType, ReturnType> > sharedPtr_Type;
+
+    //! Groups are searched by FE space and offset in the vector
+    typedef std::pair<const void*, UInt> key_Type;
+
+    //@}
+
+
+    //! @name Constructors, destructor
+    //@{
+
+    //! Constructor with the vector to be interpolated and its FE space
+    template <typename FESpaceType>
+    EvaluationSharedInterpolation (const vector_Type& vector, const FESpaceType& fespace)
+        :
+        M_vector (vector, Repeated),
+        M_localValues (M_vector.epetraVector() [0]),
+        M_localDofTable (0),
+        M_nbDof (fespace.refFE().nbDof() ),
+        M_nodalValues (M_nbDof * FESpaceType::field_dim, 0.0),
+        M_currentFE (fespace.refFE(), fespace.geoMap() ),
+        M_phi(),
+        M_quadValues(),
+        M_values(),
+        M_element (0),
+        M_numUsers (0),
+        M_remainingUses (0)
+    {
+        if (haveSameLocalElements (M_vector.blockMap(), *fespace.map().map (Repeated) ) )
+        {
+            M_localDofTable = &fespace.localDofTable();
+        }
+    }
+
+    //! Copy constructor (deep copy, without the users)
+    EvaluationSharedInterpolation (const EvaluationSharedInterpolation<CurrentFEType, ReturnType>& shared)
+        :
+        M_vector (shared.M_vector, Repeated),
+        M_localValues (M_vector.epetraVector() [0]),
+        M_localDofTable (shared.M_localDofTable),
+        M_nbDof (shared.M_nbDof),
+        M_nodalValues (shared.M_nodalValues),
+        M_currentFE (shared.M_currentFE),
+        M_phi (shared.M_phi),
+        M_quadValues (shared.M_quadValues),
+        M_values (shared.M_values),
+        M_element (0),
+        M_numUsers (0),
+        M_remainingUses (0)
+    {}
+
+    //! Destructor
+    ~EvaluationSharedInterpolation() {}
+
+    //@}
+
+
+    //! @name Methods
+    //@{
+
+    //! Data for a copy of a node using "shared"
+    /*!
+      Within a SharedInterpolationScope, returns the data already used by a node
+      of the same group (same key and same values of the vector), if any.
+      Otherwise, returns a deep copy of "shared".
+     */
+    static sharedPtr_Type share (const key_Type& key, const EvaluationSharedInterpolation<CurrentFEType, ReturnType>& shared)
+    {
+        if (!SharedInterpolationScope::isActive() )
+        {
+            return sharedPtr_Type (new EvaluationSharedInterpolation<CurrentFEType, ReturnType> (shared) );
+        }
+
+        registry_Type& registry (S_registry() );
+        if (registry.first != SharedInterpolationScope::generation() )
+        {
+            registry.first = SharedInterpolationScope::generation();
+            registry.second.clear();
+        }
+
+        std::vector<std::weak_ptr<EvaluationSharedInterpolation<CurrentFEType, ReturnType> > >& groups (registry.second[key]);
+        for (UInt iGroup (0); iGroup < groups.size(); ++iGroup)
+        {
+            sharedPtr_Type group (groups[iGroup].lock() );
+            if (group && group->hasSameValues (shared) )
+            {
+                return group;
+            }
+        }
+
+        sharedPtr_Type group (new EvaluationSharedInterpolation<CurrentFEType, ReturnType> (shared) );
+        groups.push_back (group);
+        return group;
+    }
+
+    //! Register a node using these data
+    void addUser()
+    {
+        ++M_numUsers;
+        M_remainingUses = 0;
+    }
+
+    //! Unregister a node using these data
+    void removeUser()
+    {
+        --M_numUsers;
+        M_remainingUses = 0;
+    }
+
+    //! True if the values have to be computed for this element
+    /*!
+      Returns false if the values have already been computed by another node
+      of the group during the current update of the tree.
+     */
+    bool needsUpdate (const UInt& iElement)
+    {
+        if (M_remainingUses > 0 && iElement == M_element)
+        {
+            --M_remainingUses;
+            return false;
+        }
+        M_element = iElement;
+        M_remainingUses = M_numUsers - 1;
+        return true;
+    }
+
+    //! Gather the values of the vector in the dofs of an element
+    /*!
+      @param iElement Local identifier of the element
+      @param dof Dof numbering of the FE space
+      @param offset Offset of the FE function in the vector
+      @return The nodal values, component by component: the value of the
+              component iDim of the local dof i is in position iDim * nbDof + i
+     */
+    const Real* gather (const UInt& iElement, const DOF& dof, const UInt& offset)
+    {
+        const UInt nbValues (M_nodalValues.size() );
+
+        if (M_localDofTable != 0 && offset == 0)
+        {
+            const Int* localDofs (& (*M_localDofTable) [iElement * nbValues]);
+            for (UInt k (0); k < nbValues; ++k)
+            {
+                M_nodalValues[k] = M_localValues[localDofs[k]];
+            }
+        }
+        else
+        {
+            const UInt nbTotalDof (dof.numTotalDof() );
+            for (UInt k (0); k < nbValues; ++k)
+            {
+                M_nodalValues[k] = M_vector[dof.localToGlobalMap (iElement, k % M_nbDof)
+                                            + (k / M_nbDof) * nbTotalDof + offset];
+            }
+        }
+        return &M_nodalValues[0];
+    }
+
+    //! Interpolate the nodal values of a component in the quadrature nodes
+    /*!
+      Requires the table of the basis functions (see updatePhiTable).
+      @return The values in the quadrature nodes
+     */
+    const Real* interpolateComponent (const Real* nodalValues)
+    {
+        denseMatrixVectorProduct (M_quadValues.size(), M_nbDof, &M_phi[0], nodalValues, &M_quadValues[0]);
+        return &M_quadValues[0];
+    }
+
+    //! Fill the table of the values of the basis functions in the quadrature nodes
+    /*!
+      Only used for the interpolation of values, after setQuadrature.
+     */
+    void updatePhiTable()
+    {
+        const UInt nbQuadPt (M_values.size() );
+
+        M_phi.resize (nbQuadPt * M_nbDof);
+        M_quadValues.resize (nbQuadPt);
+
+        for (UInt q (0); q < nbQuadPt; ++q)
+        {
+            for (UInt i (0); i < M_nbDof; ++i)
+            {
+                M_phi[q * M_nbDof + i] = M_currentFE.phi (i, q);
+            }
+        }
+    }
+
+    //@}
+
+
+    //! @name Set Methods
+    //@{
+
+    //! Setter for the quadrature rule
+    void setQuadrature (const QuadratureRule& qr)
+    {
+        M_currentFE.setQuadratureRule (qr);
+        M_values.resize (qr.nbQuadPt() );
+        M_remainingUses = 0;
+    }
+
+    //@}
+
+
+    //! @name Get Methods
+    //@{
+
+    //! Interpolated vector (repeated map)
+    const vector_Type& vector() const
+    {
+        return M_vector;
+    }
+
+    //! Current FE used for the interpolation
+    CurrentFEType& currentFE()
+    {
+        return M_currentFE;
+    }
+
+    //! Current FE used for the interpolation
+    const CurrentFEType& currentFE() const
+    {
+        return M_currentFE;
+    }
+
+    //! Values at the quadrature nodes
+    std::vector<ReturnType>& values()
+    {
+        return M_values;
+    }
+
+    //! Values at the quadrature nodes
+    const std::vector<ReturnType>& values() const
+    {
+        return M_values;
+    }
+
+    //@}
+
+private:
+
+    typedef std::map<key_Type, std::vector<std::weak_ptr<EvaluationSharedInterpolation<CurrentFEType, ReturnType> > > > groups_Type;
+    typedef std::pair<UInt, groups_Type> registry_Type;
+
+    //! No empty constructor
+    EvaluationSharedInterpolation();
+
+    //! Groups of the current scope in the current thread
+    static registry_Type& S_registry()
+    {
+        static thread_local registry_Type S_groups (0, groups_Type() );
+        return S_groups;
+    }
+
+    //! True if the two maps have the same global identifiers (in the same order) on this process
+    static bool haveSameLocalElements (const Epetra_BlockMap& map, const Epetra_BlockMap& otherMap)
+    {
+        if (&map == &otherMap || map.DataPtr() == otherMap.DataPtr() )
+        {
+            return true;
+        }
+        if (map.NumMyElements() != otherMap.NumMyElements() )
+        {
+            return false;
+        }
+        return std::equal (map.MyGlobalElements(), map.MyGlobalElements() + map.NumMyElements(),
+                           otherMap.MyGlobalElements() );
+    }
+
+    //! True if the local values of the vectors are the same
+    bool hasSameValues (const EvaluationSharedInterpolation<CurrentFEType, ReturnType>& shared) const
+    {
+        const Epetra_FEVector& vector (M_vector.epetraVector() );
+        const Epetra_FEVector& otherVector (shared.M_vector.epetraVector() );
+
+        if (&vector == &otherVector)
+        {
+            return true;
+        }
+        if (vector.MyLength() != otherVector.MyLength() )
+        {
+            return false;
+        }
+        return std::equal (vector[0], vector[0] + vector.MyLength(), otherVector[0]);
+    }
+
+    vector_Type M_vector;
+
+    // Direct access to the local values of the vector
+    const Real* M_localValues;
+
+    // Local identifiers of the dofs (from the FE space), 0 if the maps differ
+    const std::vector<Int>* M_localDofTable;
+
+    // Nodal values of the current element
+    UInt M_nbDof;
+    std::vector<Real> M_nodalValues;
+
+    CurrentFEType M_currentFE;
+
+    // Basis functions in the quadrature nodes (for the values) and buffer for one component
+    std::vector<Real> M_phi;
+    std::vector<Real> M_quadValues;
+
+    std::vector<ReturnType> M_values;
+
+    // Element of the last computation and number of nodes that have still to use it
+    UInt M_element;
+    UInt M_numUsers;
+    UInt M_remainingUses;
+};
+
+} // Namespace ExpressionAssembly
+
+} // Namespace LifeV
+
+#endif
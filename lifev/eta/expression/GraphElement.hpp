@@ -40,6 +40,10 @@
 #include <omp.h>
 #endif
 
+#include <map>
+#include <vector>
+#include <algorithm>
+
 #include <lifev/core/LifeV.hpp>
 #include <lifev/core/util/OpenMPParameters.hpp>
 
@@ -48,6 +52,7 @@
 #include <lifev/eta/fem/MeshGeometricMap.hpp>
 
 #include <lifev/eta/expression/ExpressionToEvaluation.hpp>
+#include <lifev/eta/expression/ExpressionScalar.hpp>
 
 #include <lifev/eta/array/ETMatrixElemental.hpp>
 
@@ -68,6 +73,12 @@ namespace ExpressionAssembly
 
   This class is used to store the data required for building the graph of a
   matrix
+
+  The graph depends only on the connectivity between the elements and the
+  degrees of freedom: neither the quadrature nor the expression are evaluated.
+  Each thread collects the sorted column indices of the rows it touches in its
+  own storage; these rows are inserted in the graph only once per thread, after
+  the loop over the elements.
  */
 template < typename MeshType,
          typename TestSpaceType,
@@ -86,6 +97,9 @@ public:
             SolutionSpaceType::field_dim,
             3 >::evaluation_Type  evaluation_Type;
 
+    //! Type of the thread-local storage for the rows (sorted column indices)
+    typedef std::map<Int, std::vector<Int> > rowStorage_Type;
+
     //@}
 
 
@@ -102,6 +116,14 @@ public:
                   const UInt offsetUp = 0,
                   const UInt offsetLeft = 0);
 
+    //! Constructor for a graph depending only on the topology (no quadrature, no expression)
+    GraphElement (const std::shared_ptr<MeshType>& mesh,
+                  const std::shared_ptr<TestSpaceType>& testSpace,
+                  const std::shared_ptr<SolutionSpaceType>& solutionSpace,
+                  const OpenMPParameters& ompParams,
+                  const UInt offsetUp = 0,
+                  const UInt offsetLeft = 0);
+
     //! Copy constructor
     GraphElement (const GraphElement < MeshType,
                   TestSpaceType,
@@ -165,6 +187,11 @@ private:
     //! No empty constructor
     GraphElement();
 
+    //! Insert the given columns in the (sorted) rows of the local storage
+    static void insertInRows (rowStorage_Type& rows,
+                              const std::vector<Int>& rowIdx,
+                              const std::vector<Int>& colIdx);
+
     //@}
 
     // Pointer on the mesh
@@ -214,6 +241,24 @@ GraphElement (const std::shared_ptr<MeshType>& mesh,
 {
 }
 
+template < typename MeshType, typename TestSpaceType, typename SolutionSpaceType, typename ExpressionType>
+GraphElement<MeshType, TestSpaceType, SolutionSpaceType, ExpressionType>::
+GraphElement (const std::shared_ptr<MeshType>& mesh,
+              const std::shared_ptr<TestSpaceType>& testSpace,
+              const std::shared_ptr<SolutionSpaceType>& solutionSpace,
+              const OpenMPParameters& ompParams,
+              const UInt offsetUp,
+              const UInt offsetLeft)
+    :   M_mesh (mesh),
+        M_quadrature(),
+        M_testSpace (testSpace),
+        M_solutionSpace (solutionSpace),
+        M_ompParams (ompParams),
+        M_offsetUp (offsetUp),
+        M_offsetLeft (offsetLeft)
+{
+}
+
 template < typename MeshType, typename TestSpaceType, typename SolutionSpaceType, typename ExpressionType>
 GraphElement<MeshType, TestSpaceType, SolutionSpaceType, ExpressionType>::
 GraphElement (const GraphElement<MeshType, TestSpaceType, SolutionSpaceType, ExpressionType>& integrator)
@@ -260,50 +305,75 @@ addTo (GraphType& graph)
 
     #pragma omp parallel
     {
-        ETMatrixElemental elementalMatrix (TestSpaceType::field_dim * M_testSpace->refFE().nbDof(),
-                                           SolutionSpaceType::field_dim * M_solutionSpace->refFE().nbDof() );
+        std::vector<Int> rowIdx (TestSpaceType::field_dim * nbTestDof);
+        std::vector<Int> colIdx (SolutionSpaceType::field_dim * nbSolutionDof);
 
-        #pragma omp for schedule(runtime)
+        // Rows touched by this thread
+        rowStorage_Type rows;
+
+        #pragma omp for schedule(runtime) nowait
         for (UInt iElement = 0; iElement < nbElements; ++iElement)
         {
-            // Zeros out the matrix
-            elementalMatrix.zero();
-
-            // Loop on the blocks
+            // Set the row global indices
             for (UInt iblock (0); iblock < TestSpaceType::field_dim; ++iblock)
             {
-                for (UInt jblock (0); jblock < SolutionSpaceType::field_dim; ++jblock)
+                for (UInt i (0); i < nbTestDof; ++i)
                 {
+                    rowIdx[i + iblock * nbTestDof] =
+                        M_testSpace->dof().localToGlobalMap (iElement, i) + iblock * M_testSpace->dof().numTotalDof() + M_offsetUp;
+                }
+            }
 
-                    // Set the row global indices in the local matrix
-                    for (UInt i (0); i < nbTestDof; ++i)
-                    {
-                        elementalMatrix.setRowIndex
-                        (i + iblock * nbTestDof,
-                         M_testSpace->dof().localToGlobalMap (iElement, i) + iblock * M_testSpace->dof().numTotalDof() + M_offsetUp);
-                    }
-
-                    // Set the column global indices in the local matrix
-                    for (UInt j (0); j < nbSolutionDof; ++j)
-                    {
-                        elementalMatrix.setColumnIndex
-                        (j + jblock * nbSolutionDof,
-                         M_solutionSpace->dof().localToGlobalMap (iElement, j) + jblock * M_solutionSpace->dof().numTotalDof() + M_offsetLeft);
-                    }
+            // Set the column global indices
+            for (UInt jblock (0); jblock < SolutionSpaceType::field_dim; ++jblock)
+            {
+                for (UInt j (0); j < nbSolutionDof; ++j)
+                {
+                    colIdx[j + jblock * nbSolutionDof] =
+                        M_solutionSpace->dof().localToGlobalMap (iElement, j) + jblock * M_solutionSpace->dof().numTotalDof() + M_offsetLeft;
                 }
             }
-            const std::vector<Int>& rowIdx = elementalMatrix.rowIndices();
-            const std::vector<Int>& colIdx = elementalMatrix.columnIndices();
-            #pragma omp critical
+
+            insertInRows (rows, rowIdx, colIdx);
+        }
+
+        // Each thread inserts its rows once, the graph does not support
+        // concurrent insertions
+        #pragma omp critical
+        {
+            for (typename rowStorage_Type::const_iterator it = rows.begin(); it != rows.end(); ++it)
             {
-                graph.InsertGlobalIndices (rowIdx.size(), &rowIdx[0],
-                                           colIdx.size(), &colIdx[0]);
+                const Int row (it->first);
+                graph.InsertGlobalIndices (1, &row,
+                                           it->second.size(), &it->second[0]);
             }
         }
     }
     M_ompParams.restorePreviousNumThreads();
 }
 
+template < typename MeshType, typename TestSpaceType, typename SolutionSpaceType, typename ExpressionType>
+void
+GraphElement<MeshType, TestSpaceType, SolutionSpaceType, ExpressionType>::
+insertInRows (rowStorage_Type& rows,
+              const std::vector<Int>& rowIdx,
+              const std::vector<Int>& colIdx)
+{
+    for (UInt i (0); i < rowIdx.size(); ++i)
+    {
+        std::vector<Int>& row = rows[rowIdx[i]];
+
+        for (UInt j (0); j < colIdx.size(); ++j)
+        {
+            std::vector<Int>::iterator position = std::lower_bound (row.begin(), row.end(), colIdx[j]);
+            if (position == row.end() || *position != colIdx[j])
+            {
+                row.insert (position, colIdx[j]);
+            }
+        }
+    }
+}
+
 
 } // Namespace ExpressionAssembly
 
@@ -266,6 +266,62 @@ integrate ( const RequestLoopElement<MeshType>& request,
            (request.mesh(), QRAdapterNeverAdapt (quadrature), testSpace, expression, offset);
 }
 
+//! Integrate function for vectorial expressions (multi-threaded path)
+/*!
+  This class is an helper function to instantiate the class
+  for performing an integration, here to assemble a vector
+  with a loop on the elements.
+
+  This is an overload of the integrate function for vectors, which
+  uses multiple threads to compute the elemental vectors
+
+  This function is repeated 4 times:
+  versions with and without QR adapter
+  versions with and without Offset
+
+ */
+template < typename MeshType, typename TestSpaceType, typename ExpressionType, typename QRAdapterType>
+IntegrateVectorElement<MeshType, TestSpaceType, ExpressionType, QRAdapterType>
+integrate ( const RequestLoopElement<MeshType>& request,
+            const QRAdapterBase<QRAdapterType>& qrAdapterBase,
+            const std::shared_ptr<TestSpaceType>& testSpace,
+            const ExpressionType& expression,
+            const OpenMPParameters& ompParams,
+            const UInt offset = 0);
+template < typename MeshType, typename TestSpaceType, typename ExpressionType, typename QRAdapterType>
+IntegrateVectorElement<MeshType, TestSpaceType, ExpressionType, QRAdapterType>
+integrate ( const RequestLoopElement<MeshType>& request,
+            const QRAdapterBase<QRAdapterType>& qrAdapterBase,
+            const std::shared_ptr<TestSpaceType>& testSpace,
+            const ExpressionType& expression,
+            const OpenMPParameters& ompParams,
+            const UInt offset)
+{
+    return IntegrateVectorElement<MeshType, TestSpaceType, ExpressionType, QRAdapterType>
+           (request.mesh(), qrAdapterBase.implementation(), testSpace, expression, ompParams, offset);
+}
+
+template < typename MeshType, typename TestSpaceType, typename ExpressionType>
+IntegrateVectorElement<MeshType, TestSpaceType, ExpressionType, QRAdapterNeverAdapt>
+integrate ( const RequestLoopElement<MeshType>& request,
+            const QuadratureRule& quadrature,
+            const std::shared_ptr<TestSpaceType>& testSpace,
+            const ExpressionType& expression,
+            const OpenMPParameters& ompParams,
+            const UInt offset = 0);
+template < typename MeshType, typename TestSpaceType, typename ExpressionType>
+IntegrateVectorElement<MeshType, TestSpaceType, ExpressionType, QRAdapterNeverAdapt>
+integrate ( const RequestLoopElement<MeshType>& request,
+            const QuadratureRule& quadrature,
+            const std::shared_ptr<TestSpaceType>& testSpace,
+            const ExpressionType& expression,
+            const OpenMPParameters& ompParams,
+            const UInt offset)
+{
+    return IntegrateVectorElement<MeshType, TestSpaceType, ExpressionType, QRAdapterNeverAdapt>
+           (request.mesh(), QRAdapterNeverAdapt (quadrature), testSpace, expression, ompParams, offset);
+}
+
 //! Compute stress function for vectorial expressions
 /*!
   @author Samuel Quinodoz <samuel.quinodoz@epfl.ch>
@@ -451,6 +507,41 @@ integrate ( const RequestLoopElement<MeshType>& request,
            (request.mesh(), QRAdapterNeverAdapt (quadrature), expression);
 }
 
+//! Integrate function for benchmark expressions (multi-threaded path)
+/*!
+  This class is an helper function to instantiate the class
+  for performing an integration, here to assemble a benchmark
+  with a loop on the elements.
+
+  This is an overload of the integrate function for values, which
+  uses multiple threads and a reduction in a fixed order
+
+  This function is repeated 2 times:
+  versions with and without QR adapter
+
+ */
+template < typename MeshType, typename ExpressionType, typename QRAdapterType>
+IntegrateValueElement<MeshType, ExpressionType, QRAdapterType>
+integrate ( const RequestLoopElement<MeshType>& request,
+            const QRAdapterBase<QRAdapterType>& qrAdapterBase,
+            const ExpressionType& expression,
+            const OpenMPParameters& ompParams)
+{
+    return IntegrateValueElement<MeshType, ExpressionType, QRAdapterType>
+           (request.mesh(), qrAdapterBase.implementation(), expression, ompParams);
+}
+
+template < typename MeshType, typename ExpressionType>
+IntegrateValueElement<MeshType, ExpressionType, QRAdapterNeverAdapt>
+integrate ( const RequestLoopElement<MeshType>& request,
+            const QuadratureRule& quadrature,
+            const ExpressionType& expression,
+            const OpenMPParameters& ompParams)
+{
+    return IntegrateValueElement<MeshType, ExpressionType, QRAdapterNeverAdapt>
+           (request.mesh(), QRAdapterNeverAdapt (quadrature), expression, ompParams);
+}
+
 // =============================================================
 // Methods to integrate over a portion of the mesh
 // =============================================================
@@ -526,6 +617,34 @@ integrate ( const RequestLoopFaceID<MeshType>& request,
            (request.mesh(), request.id(), quadratureBoundary, testSpace, solutionSpace, expression);
 }
 
+/* Integration on the boundary of the domain (multi-threaded) */
+
+template < typename MeshType, typename TestSpaceType, typename ExpressionType>
+IntegrateVectorFaceID<MeshType, TestSpaceType, ExpressionType>
+integrate ( const RequestLoopFaceID<MeshType>& request,
+            const QuadratureBoundary& quadratureBoundary,
+            const std::shared_ptr<TestSpaceType>& testSpace,
+            const ExpressionType& expression,
+            const OpenMPParameters& ompParams)
+{
+    return IntegrateVectorFaceID<MeshType, TestSpaceType, ExpressionType>
+           (request.mesh(), request.id(), quadratureBoundary, testSpace, expression, ompParams);
+}
+
+
+template < typename MeshType, typename TestSpaceType, typename SolutionSpaceType, typename ExpressionType>
+IntegrateMatrixFaceID<MeshType, TestSpaceType, SolutionSpaceType, ExpressionType>
+integrate ( const RequestLoopFaceID<MeshType>& request,
+            const QuadratureBoundary& quadratureBoundary,
+            const std::shared_ptr<TestSpaceType> testSpace,
+            const std::shared_ptr<SolutionSpaceType> solutionSpace,
+            const ExpressionType& expression,
+            const OpenMPParameters& ompParams)
+{
+    return IntegrateMatrixFaceID<MeshType, TestSpaceType, SolutionSpaceType, ExpressionType>
+           (request.mesh(), request.id(), quadratureBoundary, testSpace, solutionSpace, expression, ompParams);
+}
+
 
 template < typename MeshType,
          typename TestSpaceType,
@@ -40,16 +40,21 @@
 #include <omp.h>
 #endif
 
+#include <memory>
+
 #include <lifev/core/LifeV.hpp>
 
 #include <lifev/core/util/OpenMPParameters.hpp>
 
+#include <lifev/core/array/MatrixEpetraOffsets.hpp>
+
 #include <lifev/core/fem/QuadratureRule.hpp>
 #include <lifev/eta/fem/ETCurrentFE.hpp>
 #include <lifev/eta/fem/MeshGeometricMap.hpp>
 #include <lifev/eta/fem/QRAdapterBase.hpp>
 
 #include <lifev/eta/expression/ExpressionToEvaluation.hpp>
+#include <lifev/eta/expression/EvaluationSharedInterpolation.hpp>
 
 #include <lifev/eta/array/ETMatrixElemental.hpp>
 
@@ -210,7 +215,14 @@ public:
       performed: update the values, update the local matrix,
       sum over the quadrature nodes, assemble in the global
       matrix.
-      The method is used for closed matrices
+      The method is used for closed matrices.
+
+      If the OpenMPParameters contain a coloring of the elements
+      (see OpenMPParameters::setElementColors), the elements are
+      processed color by color and the threads sum their contributions
+      in the matrix without critical region. Otherwise, the elements
+      are distributed among the threads without any ordering and
+      added with addToCoefficients, as for an open matrix.
      */
     template <typename MatrixType>
     void addToClosed (MatrixType& mat);
@@ -258,6 +270,65 @@ public:
         addToClosed (*mat);
     }
 
+    //! Method that performs the assembly using cached insertion offsets
+    /*!
+      Same as addToClosed, but the elemental matrices are summed into the
+      values of the matrix at the positions stored in the offsets (see
+      MatrixEpetraOffsets), the slots being the elements. The positions
+      are recorded during the first assembly (or if the structure of the
+      matrix changed), the following assemblies avoid the search of the
+      indices in the matrix.
+
+      The offsets must be used only for this matrix and for integrations
+      with the same spaces and block offsets.
+     */
+    template <typename MatrixType>
+    void addToClosed (MatrixType& mat, MatrixEpetraOffsets<Real>& offsets);
+
+    //! Method that performs the assembly using cached insertion offsets
+    /*!
+      Specialized for the case where the matrix and the offsets are passed as shared_ptr
+     */
+    template <typename MatrixType>
+    inline void addToClosed (std::shared_ptr<MatrixType> mat, std::shared_ptr<MatrixEpetraOffsets<Real> > offsets)
+    {
+        ASSERT (mat != 0, " Cannot assemble with an empty matrix");
+        ASSERT (offsets != 0, " Cannot assemble with empty offsets");
+        addToClosed (*mat, *offsets);
+    }
+
+    //! Method that performs the product with the matrix, without assembling it
+    /*!
+      The loop over the elements is the same as in the assembly, but the
+      elemental matrices are directly multiplied by the local values of x
+      and the results are summed into y (see ETMatrixElemental::pushProductToGlobal).
+      The global matrix is never stored.
+
+      The vector x must contain the values of all the dofs of the solution
+      space on the local elements (e.g. a VectorEpetra with a Repeated map).
+      The contributions are summed in y, which has to be assembled afterwards
+      (e.g. by a conversion to a Unique map). This method is serial.
+     */
+    template <typename VectorType>
+    void multiply (const VectorType& x, VectorType& y);
+
+    //@}
+
+
+    //! @name Get Methods
+    //@{
+
+    //! Getter for the test space
+    const std::shared_ptr<TestSpaceType>& testSpace() const
+    {
+        return M_testSpace;
+    }
+
+    //! Getter for the solution space
+    const std::shared_ptr<SolutionSpaceType>& solutionSpace() const
+    {
+        return M_solutionSpace;
+    }
 
     //@}
 
@@ -283,6 +354,51 @@ private:
                             ETCurrentFE<MeshType::S_geoDimensions, 1>& globalCFE,
                             ETCurrentFE<TestSpaceType::space_dim, TestSpaceType::field_dim>& testCFE,
                             ETCurrentFE<SolutionSpaceType::space_dim, SolutionSpaceType::field_dim>& solutionCFE);
+
+    //! Sum the contributions of the quadrature nodes for one block of the elemental matrix
+    /*!
+     * This method selects a version of the loops with sizes known at compile
+     * time (see accumulateBlockFixed) for the most common combinations of
+     * finite elements and quadrature rules (P1 and P2 on tetrahedra, Q1 and
+     * Q2 on hexahedra). For the other cases, generic loops are used.
+     */
+    void accumulateBlock (const UInt nbQuadPt,
+                          const UInt nbTestDof,
+                          const UInt nbSolutionDof,
+                          const UInt iblock,
+                          const UInt jblock,
+                          ETMatrixElemental& elementalMatrix,
+                          evaluation_Type& evaluation,
+                          const ETCurrentFE<MeshType::S_geoDimensions, 1>& globalCFE);
+
+    //! Sum the contributions of the quadrature nodes for one block, with fixed sizes
+    /*!
+     * As the trip counts are compile time constants, the loops over the
+     * quadrature nodes and the basis functions can be unrolled and vectorized.
+     */
+    template <UInt NbQuadPt, UInt NbTestDof, UInt NbSolutionDof>
+    void accumulateBlockFixed (const UInt iblock,
+                               const UInt jblock,
+                               ETMatrixElemental& elementalMatrix,
+                               evaluation_Type& evaluation,
+                               const ETCurrentFE<MeshType::S_geoDimensions, 1>& globalCFE);
+
+    //! Attach the geometric cache of the test space (if any) to the current FEs
+    /*!
+     * The cache is indexed with the local identifiers of the elements,
+     * so it is used only if the integration is performed on the mesh
+     * of the test space.
+     */
+    void attachGeometryCache();
+
+    //! Loop over the elements for the assembly in a closed matrix
+    /*!
+      The elemental matrices are summed in the matrix with push (elementalMatrix, iElement, lockFree),
+      lockFree being true when the elements are processed by colors.
+     */
+    template <typename PushType>
+    void addToClosedLoop (const PushType& push);
+
     //@}
 
     // Pointer on the mesh
@@ -392,6 +508,8 @@ IntegrateMatrixElement (const std::shared_ptr<MeshType>& mesh,
     M_evaluation.setGlobalCFE (M_globalCFE_std);
     M_evaluation.setTestCFE (M_testCFE_std);
     M_evaluation.setSolutionCFE (M_solutionCFE_std);
+
+    attachGeometryCache();
 }
 
 
@@ -457,6 +575,8 @@ IntegrateMatrixElement (const std::shared_ptr<MeshType>& mesh,
     M_evaluation.setGlobalCFE (M_globalCFE_std);
     M_evaluation.setTestCFE (M_testCFE_std);
     M_evaluation.setSolutionCFE (M_solutionCFE_std);
+
+    attachGeometryCache();
 }
 
 
@@ -514,6 +634,8 @@ IntegrateMatrixElement (const IntegrateMatrixElement<MeshType, TestSpaceType, So
     M_evaluation.setGlobalCFE (M_globalCFE_std);
     M_evaluation.setTestCFE (M_testCFE_std);
     M_evaluation.setSolutionCFE (M_solutionCFE_std);
+
+    attachGeometryCache();
 }
 
 template < typename MeshType, typename TestSpaceType, typename SolutionSpaceType, typename ExpressionType, typename QRAdapterType>
@@ -544,6 +666,26 @@ check (std::ostream& out)
     out << std::endl;
 }
 
+template < typename MeshType, typename TestSpaceType, typename SolutionSpaceType, typename ExpressionType, typename QRAdapterType>
+void
+IntegrateMatrixElement<MeshType, TestSpaceType, SolutionSpaceType, ExpressionType, QRAdapterType>::
+attachGeometryCache()
+{
+    if (M_mesh != M_testSpace->mesh() )
+    {
+        return;
+    }
+
+    std::shared_ptr<ETGeometryCache> geometryCache (M_testSpace->geometryCache (M_qrAdapter.standardQR() ) );
+
+    if (geometryCache)
+    {
+        M_globalCFE_std->setGeometryCache (geometryCache);
+        M_testCFE_std->setGeometryCache (geometryCache);
+        M_solutionCFE_std->setGeometryCache (geometryCache);
+    }
+}
+
 template < typename MeshType, typename TestSpaceType, typename SolutionSpaceType, typename ExpressionType, typename QRAdapterType>
 void
 IntegrateMatrixElement<MeshType, TestSpaceType, SolutionSpaceType, ExpressionType, QRAdapterType>::
@@ -589,23 +731,142 @@ integrateElement (const UInt iElement, const UInt nbQuadPt,
                  M_solutionSpace->dof().localToGlobalMap (iElement, j) + jblock * M_solutionSpace->dof().numTotalDof() + M_offsetLeft);
             }
 
-            for (UInt iQuadPt (0); iQuadPt < nbQuadPt; ++iQuadPt)
+            accumulateBlock (nbQuadPt, nbTestDof, nbSolutionDof, iblock, jblock,
+                             elementalMatrix, evaluation, globalCFE);
+        }
+    }
+}
+
+template < typename MeshType, typename TestSpaceType, typename SolutionSpaceType, typename ExpressionType, typename QRAdapterType>
+void
+IntegrateMatrixElement<MeshType, TestSpaceType, SolutionSpaceType, ExpressionType, QRAdapterType>::
+accumulateBlock (const UInt nbQuadPt,
+                 const UInt nbTestDof,
+                 const UInt nbSolutionDof,
+                 const UInt iblock,
+                 const UInt jblock,
+                 ETMatrixElemental& elementalMatrix,
+                 evaluation_Type& evaluation,
+                 const ETCurrentFE<MeshType::S_geoDimensions, 1>& globalCFE)
+{
+    // Fixed size versions: P1 (4 dofs) and P2 (10 dofs) on tetrahedra
+    // with the 4, 5 and 15 points rules, P2-P1 blocks (e.g. Taylor-Hood)
+    // with the 15 points rule, Q1 (8 dofs) and Q2 (27 dofs) on hexahedra
+    // with the 8 points rule.
+    if (nbTestDof == 4 && nbSolutionDof == 4)
+    {
+        switch (nbQuadPt)
+        {
+            case 4:
+                accumulateBlockFixed<4, 4, 4> (iblock, jblock, elementalMatrix, evaluation, globalCFE);
+                return;
+            case 5:
+                accumulateBlockFixed<5, 4, 4> (iblock, jblock, elementalMatrix, evaluation, globalCFE);
+                return;
+            case 15:
+                accumulateBlockFixed<15, 4, 4> (iblock, jblock, elementalMatrix, evaluation, globalCFE);
+                return;
+        }
+    }
+    else if (nbTestDof == 10 && nbSolutionDof == 10)
+    {
+        switch (nbQuadPt)
+        {
+            case 4:
+                accumulateBlockFixed<4, 10, 10> (iblock, jblock, elementalMatrix, evaluation, globalCFE);
+                return;
+            case 5:
+                accumulateBlockFixed<5, 10, 10> (iblock, jblock, elementalMatrix, evaluation, globalCFE);
+                return;
+            case 15:
+                accumulateBlockFixed<15, 10, 10> (iblock, jblock, elementalMatrix, evaluation, globalCFE);
+                return;
+        }
+    }
+    else if (nbTestDof == 10 && nbSolutionDof == 4 && nbQuadPt == 15)
+    {
+        accumulateBlockFixed<15, 10, 4> (iblock, jblock, elementalMatrix, evaluation, globalCFE);
+        return;
+    }
+    else if (nbTestDof == 4 && nbSolutionDof == 10 && nbQuadPt == 15)
+    {
+        accumulateBlockFixed<15, 4, 10> (iblock, jblock, elementalMatrix, evaluation, globalCFE);
+        return;
+    }
+    else if (nbTestDof == 8 && nbSolutionDof == 8 && nbQuadPt == 8)
+    {
+        accumulateBlockFixed<8, 8, 8> (iblock, jblock, elementalMatrix, evaluation, globalCFE);
+        return;
+    }
+    else if (nbTestDof == 27 && nbSolutionDof == 27 && nbQuadPt == 8)
+    {
+        accumulateBlockFixed<8, 27, 27> (iblock, jblock, elementalMatrix, evaluation, globalCFE);
+        return;
+    }
+
+    // Generic version
+    for (UInt iQuadPt (0); iQuadPt < nbQuadPt; ++iQuadPt)
+    {
+        for (UInt i (0); i < nbTestDof; ++i)
+        {
+            for (UInt j (0); j < nbSolutionDof; ++j)
             {
-                for (UInt i (0); i < nbTestDof; ++i)
-                {
-                    for (UInt j (0); j < nbSolutionDof; ++j)
-                    {
-                        elementalMatrix.element (i + iblock * nbTestDof, j + jblock * nbSolutionDof) +=
-                            evaluation.value_qij (iQuadPt, i + iblock * nbTestDof, j + jblock * nbSolutionDof)
-                            * globalCFE.wDet (iQuadPt);
+                elementalMatrix.element (i + iblock * nbTestDof, j + jblock * nbSolutionDof) +=
+                    evaluation.value_qij (iQuadPt, i + iblock * nbTestDof, j + jblock * nbSolutionDof)
+                    * globalCFE.wDet (iQuadPt);
 
-                    }
-                }
             }
         }
     }
 }
 
+template < typename MeshType, typename TestSpaceType, typename SolutionSpaceType, typename ExpressionType, typename QRAdapterType>
+template <UInt NbQuadPt, UInt NbTestDof, UInt NbSolutionDof>
+void
+IntegrateMatrixElement<MeshType, TestSpaceType, SolutionSpaceType, ExpressionType, QRAdapterType>::
+accumulateBlockFixed (const UInt iblock,
+                      const UInt jblock,
+                      ETMatrixElemental& elementalMatrix,
+                      evaluation_Type& evaluation,
+                      const ETCurrentFE<MeshType::S_geoDimensions, 1>& globalCFE)
+{
+    const UInt rowOffset (iblock * NbTestDof);
+    const UInt columnOffset (jblock * NbSolutionDof);
+
+    // Accumulate in a local block, the sums are performed
+    // in the same order as in the generic version
+    Real localBlock[NbTestDof][NbSolutionDof];
+
+    for (UInt i (0); i < NbTestDof; ++i)
+    {
+        for (UInt j (0); j < NbSolutionDof; ++j)
+        {
+            localBlock[i][j] = elementalMatrix.element (rowOffset + i, columnOffset + j);
+        }
+    }
+
+    for (UInt iQuadPt (0); iQuadPt < NbQuadPt; ++iQuadPt)
+    {
+        const Real wDet (globalCFE.wDet (iQuadPt) );
+
+        for (UInt i (0); i < NbTestDof; ++i)
+        {
+            for (UInt j (0); j < NbSolutionDof; ++j)
+            {
+                localBlock[i][j] += evaluation.value_qij (iQuadPt, rowOffset + i, columnOffset + j) * wDet;
+            }
+        }
+    }
+
+    for (UInt i (0); i < NbTestDof; ++i)
+    {
+        for (UInt j (0); j < NbSolutionDof; ++j)
+        {
+            elementalMatrix.element (rowOffset + i, columnOffset + j) = localBlock[i][j];
+        }
+    }
+}
+
 
 template < typename MeshType, typename TestSpaceType, typename SolutionSpaceType, typename ExpressionType, typename QRAdapterType>
 template <typename MatrixType>
@@ -626,7 +887,7 @@ addTo (MatrixType& mat)
     ETMatrixElemental elementalMatrix (TestSpaceType::field_dim * M_testSpace->refFE().nbDof(),
                                        SolutionSpaceType::field_dim * M_solutionSpace->refFE().nbDof() );
 
-    evaluation_Type evaluation (M_evaluation);
+    evaluation_Type evaluation (copyWithSharedInterpolations (M_evaluation) );
 
     // Defaulted to true for security
     bool isPreviousAdapted (true);
@@ -682,17 +943,130 @@ addTo (MatrixType& mat)
     }
 }
 
+template < typename MeshType, typename TestSpaceType, typename SolutionSpaceType, typename ExpressionType, typename QRAdapterType>
+template <typename VectorType>
+void
+IntegrateMatrixElement<MeshType, TestSpaceType, SolutionSpaceType, ExpressionType, QRAdapterType>::
+multiply (const VectorType& x, VectorType& y)
+{
+    UInt nbElements (M_mesh->numElements() );
+    UInt nbTestDof (M_testSpace->refFE().nbDof() );
+    UInt nbSolutionDof (M_solutionSpace->refFE().nbDof() );
+
+    ETMatrixElemental elementalMatrix (TestSpaceType::field_dim * M_testSpace->refFE().nbDof(),
+                                       SolutionSpaceType::field_dim * M_solutionSpace->refFE().nbDof() );
+
+    evaluation_Type evaluation (copyWithSharedInterpolations (M_evaluation) );
+
+    // Defaulted to true for security
+    bool isPreviousAdapted (true);
+
+    for (UInt iElement (0); iElement < nbElements; ++iElement)
+    {
+        // Update the quadrature rule adapter
+        M_qrAdapter.update (iElement);
+
+        if (M_qrAdapter.isAdaptedElement() )
+        {
+            // Set the quadrature rule everywhere
+            evaluation.setQuadrature ( M_qrAdapter.adaptedQR() );
+            M_globalCFE_adapted -> setQuadratureRule ( M_qrAdapter.adaptedQR() );
+            M_testCFE_adapted -> setQuadratureRule ( M_qrAdapter.adaptedQR() );
+            M_solutionCFE_adapted -> setQuadratureRule ( M_qrAdapter.adaptedQR() );
+
+            // Reset the CurrentFEs in the evaluation
+            evaluation.setGlobalCFE ( M_globalCFE_adapted );
+            evaluation.setTestCFE ( M_testCFE_adapted );
+            evaluation.setSolutionCFE ( M_solutionCFE_adapted );
+
+            integrateElement (iElement, M_qrAdapter.adaptedQR().nbQuadPt(), nbTestDof, nbSolutionDof,
+                              elementalMatrix, evaluation, *M_globalCFE_adapted,
+                              *M_testCFE_adapted, *M_solutionCFE_adapted);
+
+            isPreviousAdapted = true;
+        }
+        else
+        {
+            // Change in the evaluation if needed
+            if (isPreviousAdapted)
+            {
+                evaluation.setQuadrature ( M_qrAdapter.standardQR() );
+                evaluation.setGlobalCFE ( M_globalCFE_std );
+                evaluation.setTestCFE ( M_testCFE_std );
+                evaluation.setSolutionCFE ( M_solutionCFE_std );
+
+                isPreviousAdapted = false;
+            }
+
+            integrateElement (iElement, M_qrAdapter.standardQR().nbQuadPt(), nbTestDof, nbSolutionDof,
+                              elementalMatrix, evaluation, *M_globalCFE_std,
+                              *M_testCFE_std, *M_solutionCFE_std);
+        }
+
+        elementalMatrix.pushProductToGlobal (x, y);
+    }
+}
+
 template < typename MeshType, typename TestSpaceType, typename SolutionSpaceType, typename ExpressionType, typename QRAdapterType>
 template <typename MatrixType>
 void
 IntegrateMatrixElement<MeshType, TestSpaceType, SolutionSpaceType, ExpressionType, QRAdapterType>::
 addToClosed (MatrixType& mat)
+{
+    addToClosedLoop ([&mat] (ETMatrixElemental & elementalMatrix, const UInt /*iElement*/, const bool lockFree)
+    {
+        if (lockFree)
+        {
+            elementalMatrix.pushToClosedGlobalLockFree (mat);
+        }
+        else
+        {
+            elementalMatrix.pushToGlobal (mat);
+        }
+    });
+}
+
+template < typename MeshType, typename TestSpaceType, typename SolutionSpaceType, typename ExpressionType, typename QRAdapterType>
+template <typename MatrixType>
+void
+IntegrateMatrixElement<MeshType, TestSpaceType, SolutionSpaceType, ExpressionType, QRAdapterType>::
+addToClosed (MatrixType& mat, MatrixEpetraOffsets<Real>& offsets)
+{
+    // The slots of the offsets are the elements
+    if ( !offsets.isValidFor (mat) )
+    {
+        offsets.reset (mat, M_mesh->numElements() );
+    }
+
+    addToClosedLoop ([&mat, &offsets] (ETMatrixElemental & elementalMatrix, const UInt iElement, const bool /*lockFree*/)
+    {
+        elementalMatrix.pushToClosedGlobal (mat, offsets, iElement);
+    });
+}
+
+template < typename MeshType, typename TestSpaceType, typename SolutionSpaceType, typename ExpressionType, typename QRAdapterType>
+template <typename PushType>
+void
+IntegrateMatrixElement<MeshType, TestSpaceType, SolutionSpaceType, ExpressionType, QRAdapterType>::
+addToClosedLoop (const PushType& push)
 {
     UInt nbElements (M_mesh->numElements() );
     //UInt nbQuadPt (M_qrAdapter.standardQR().nbQuadPt() );
     UInt nbTestDof (M_testSpace->refFE().nbDof() );
     UInt nbSolutionDof (M_solutionSpace->refFE().nbDof() );
 
+#ifdef HAVE_LIFEV_DEBUG
+    if ( M_ompParams.useColoring() )
+    {
+        UInt nbColoredElements (0);
+        for (UInt iColor (0); iColor < M_ompParams.elementColors->size(); ++iColor)
+        {
+            nbColoredElements += (*M_ompParams.elementColors) [iColor].size();
+        }
+        ASSERT (nbColoredElements == nbElements, "The element colors do not match the mesh");
+    }
+#endif
+
     // OpenMP setup and pragmas around the loop
     M_ompParams.apply();
 
@@ -746,7 +1120,7 @@ addToClosed (MatrixType& mat)
         solutionCFE_adapted (M_solutionSpace->refFE(), M_testSpace->geoMap(),
                              M_qrAdapter.standardQR() );
 
-        evaluation_Type evaluation (M_evaluation);
+        evaluation_Type evaluation (copyWithSharedInterpolations (M_evaluation) );
         // Update the evaluation is done within the if statement
         /*
         evaluation.setQuadrature (M_qrAdapter.standardQR());
@@ -761,8 +1135,8 @@ addToClosed (MatrixType& mat)
         // Defaulted to true for security
         bool isPreviousAdapted (true);
 
-        #pragma omp for schedule(runtime)
-        for (UInt iElement = 0; iElement < nbElements; ++iElement)
+        // Computation of the elemental matrix, shared by the colored and the standard loops
+        auto assembleElement = [&] (const UInt iElement)
         {
             // Update the quadrature rule adapter
             qrAdapter.update (iElement);
@@ -809,8 +1183,37 @@ addToClosed (MatrixType& mat)
                                   testCFE_std, solutionCFE_std);
 
             }
+        };
 
-            elementalMatrix.pushToGlobal (mat);
+        if ( M_ompParams.useColoring() )
+        {
+            // Elements of the same color do not share any dof: the threads
+            // sum concurrently in the matrix, the implicit barrier at the
+            // end of each "omp for" separates the colors.
+            const OpenMPParameters::elementColors_Type& colors (*M_ompParams.elementColors);
+
+            for (UInt iColor = 0; iColor < colors.size(); ++iColor)
+            {
+                const UInt nbColorElements (colors[iColor].size() );
+
+                #pragma omp for schedule(runtime)
+                for (UInt iColorElement = 0; iColorElement < nbColorElements; ++iColorElement)
+                {
+                    assembleElement (colors[iColor][iColorElement]);
+
+                    push (elementalMatrix, colors[iColor][iColorElement], true);
+                }
+            }
+        }
+        else
+        {
+            #pragma omp for schedule(runtime)
+            for (UInt iElement = 0; iElement < nbElements; ++iElement)
+            {
+                assembleElement (iElement);
+
+                push (elementalMatrix, iElement, false);
+            }
         }
 
         M_ompParams.restorePreviousNumThreads();
@@ -834,7 +1237,7 @@ addToSubdomain ( MatrixType& mat )
     ETMatrixElemental elementalMatrix (TestSpaceType::field_dim * M_testSpace->refFE().nbDof(),
                                        SolutionSpaceType::field_dim * M_solutionSpace->refFE().nbDof() );
 
-    evaluation_Type evaluation (M_evaluation);
+    evaluation_Type evaluation (copyWithSharedInterpolations (M_evaluation) );
 
     if( M_volumeElements != nullptr )
     {
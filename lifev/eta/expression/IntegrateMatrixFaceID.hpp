@@ -36,8 +36,14 @@
 #ifndef INTEGRATE_MATRIX_FACE_ID_HPP
 #define INTEGRATE_MATRIX_FACE_ID_HPP
 
+#if defined(_OPENMP)
+#include <omp.h>
+#endif
+
 #include <lifev/core/LifeV.hpp>
 
+#include <lifev/core/util/OpenMPParameters.hpp>
+
 #include <lifev/eta/fem/QuadratureBoundary.hpp>
 #include <lifev/eta/fem/ETCurrentFE.hpp>
 #include <lifev/eta/fem/ETCurrentBDFE.hpp>
@@ -66,6 +72,12 @@ namespace ExpressionAssembly
   perform that assembly with a loop over the elements, and then, for each elements,
   using the Evaluation corresponding to the Expression (this convertion is done
   within a typedef).
+
+  The boundary faces carrying the requested identifier are selected once, when
+  the integrator is built, and the loop runs over this cached list. When built
+  with OpenMPParameters asking for more than one thread, the faces are shared
+  among the threads, each of them using its own copies of the CurrentFEs and of
+  the evaluation tree.
  */
 template < typename MeshType, typename TestSpaceType, typename SolutionSpaceType, typename ExpressionType>
 class IntegrateMatrixFaceID
@@ -95,6 +107,15 @@ public:
                            const std::shared_ptr<SolutionSpaceType> solutionSpace,
                            const ExpressionType& expression);
 
+    //! Full data constructor (multi-threaded assembly)
+    IntegrateMatrixFaceID (const std::shared_ptr<MeshType>& mesh,
+                           const UInt boundaryID,
+                           const QuadratureBoundary& quadratureBD,
+                           const std::shared_ptr<TestSpaceType> testSpace,
+                           const std::shared_ptr<SolutionSpaceType> solutionSpace,
+                           const ExpressionType& expression,
+                           const OpenMPParameters& ompParams);
+
     //! Copy constructor
     IntegrateMatrixFaceID ( const IntegrateMatrixFaceID < MeshType, TestSpaceType, SolutionSpaceType, ExpressionType>& integrator);
 
@@ -137,6 +158,10 @@ public:
       performed: update the values, update the local vector,
       sum over the quadrature nodes, assemble in the global
       vector.
+
+      In the multi-threaded mode, the elemental matrices are summed
+      directly by the threads if the matrix is closed. Otherwise, they
+      are computed by chunks and inserted by a single thread.
      */
     template <typename MatrixType>
     void addTo (MatrixType& mat);
@@ -158,14 +183,49 @@ private:
     // No default constructor
     IntegrateMatrixFaceID();
 
+    //! Select the boundary faces carrying the identifier
+    void cacheBoundaryFaces();
+
+    //! Build the CurrentFEs for the four faces of the reference tetrahedron
+    void createCurrentFEs (std::vector<ETCurrentBDFE<3>*>& globalCFE,
+                           std::vector<ETCurrentFE<3, TestSpaceType::field_dim>*>& testCFE,
+                           std::vector<ETCurrentFE<3, SolutionSpaceType::field_dim>*>& solutionCFE) const;
+
+    //! Free the CurrentFEs built with createCurrentFEs
+    void deleteCurrentFEs (std::vector<ETCurrentBDFE<3>*>& globalCFE,
+                           std::vector<ETCurrentFE<3, TestSpaceType::field_dim>*>& testCFE,
+                           std::vector<ETCurrentFE<3, SolutionSpaceType::field_dim>*>& solutionCFE) const;
+
+    //! Perform the computations for a single boundary face
+    /*!
+     * This method computes the elemental matrix for a given boundary
+     * face index
+     */
+    void integrateFace (const UInt iFace,
+                        ETMatrixElemental& elementalMatrix,
+                        evaluation_Type& evaluation,
+                        std::vector<ETCurrentBDFE<3>*>& globalCFE,
+                        std::vector<ETCurrentFE<3, TestSpaceType::field_dim>*>& testCFE,
+                        std::vector<ETCurrentFE<3, SolutionSpaceType::field_dim>*>& solutionCFE);
+
+    //! Multi-threaded loop over the boundary faces
+    template <typename MatrixType>
+    void addToThreaded (MatrixType& mat);
+
     //@}
 
+    // Number of faces buffered per thread when the matrix is not closed
+    static const UInt S_facesPerThreadChunk = 256;
+
     // Pointer on the mesh
     std::shared_ptr<MeshType> M_mesh;
 
     // Identifier for the boundary
     UInt M_boundaryId;
 
+    // Boundary faces carrying the identifier
+    std::vector<UInt> M_boundaryFaces;
+
     // Quadrature to be used
     QuadratureBoundary M_quadratureBoundary;
 
@@ -182,6 +242,9 @@ private:
     std::vector<ETCurrentFE<3, SolutionSpaceType::field_dim>*> M_solutionCFE;
 
     ETMatrixElemental M_elementalMatrix;
+
+    // Data for multi-threaded assembly
+    OpenMPParameters M_ompParams;
 };
 
 
@@ -203,6 +266,7 @@ IntegrateMatrixFaceID (const std::shared_ptr<MeshType>& mesh,
                        const ExpressionType& expression)
     :   M_mesh (mesh),
         M_boundaryId (boundaryID),
+        M_boundaryFaces(),
         M_quadratureBoundary (quadratureBD),
         M_testSpace (testSpace),
         M_solutionSpace (solutionSpace),
@@ -212,59 +276,49 @@ IntegrateMatrixFaceID (const std::shared_ptr<MeshType>& mesh,
         M_testCFE (4),
         M_solutionCFE (4),
 
-        M_elementalMatrix (TestSpaceType::field_dim * testSpace->refFE().nbDof(), SolutionSpaceType::field_dim * solutionSpace->refFE().nbDof() )
+        M_elementalMatrix (TestSpaceType::field_dim * testSpace->refFE().nbDof(), SolutionSpaceType::field_dim * solutionSpace->refFE().nbDof() ),
+
+        M_ompParams()
 {
-    for (UInt i (0); i < 4; ++i)
-    {
-        M_globalCFE[i] = new ETCurrentBDFE<3> (geometricMapFromMesh<MeshType>()
-                                               , M_quadratureBoundary.qr (i) );
-
-        M_testCFE[i] = new ETCurrentFE<3, TestSpaceType::field_dim> (testSpace->refFE()
-                                                                     , testSpace->geoMap()
-                                                                     , M_quadratureBoundary.qr (i) );
-        M_solutionCFE[i] = new ETCurrentFE<3, SolutionSpaceType::field_dim> (solutionSpace->refFE()
-                                                                             , solutionSpace->geoMap()
-                                                                             , M_quadratureBoundary.qr (i) );
-    }
+    cacheBoundaryFaces();
 
-    // Set the tangent on the different faces
-    std::vector< VectorSmall<3> > t0 (2, VectorSmall<3> (0.0, 0.0, 0.0) );
-    t0[0][0] = 1;
-    t0[0][1] = 0;
-    t0[0][2] = 0;
-    t0[1][0] = 0;
-    t0[1][1] = 1;
-    t0[1][2] = 0;
-    std::vector< VectorSmall<3> > t1 (2, VectorSmall<3> (0.0, 0.0, 0.0) );
-    t1[0][0] = 0;
-    t1[0][1] = 0;
-    t1[0][2] = 1;
-    t1[1][0] = 1;
-    t1[1][1] = 0;
-    t1[1][2] = 0;
-    std::vector< VectorSmall<3> > t2 (2, VectorSmall<3> (0.0, 0.0, 0.0) );
-    //t2[0][0]=-1/std::sqrt(6);    t2[0][1]=-1/std::sqrt(6);    t2[0][2]=2/std::sqrt(6);
-    //t2[1][0]=-1/std::sqrt(2);    t2[1][1]=1/std::sqrt(2);    t2[1][2]=0;
-    t2[0][0] = -1;
-    t2[0][1] = 0;
-    t2[0][2] = 1;
-    t2[1][0] = -1;
-    t2[1][1] = 1;
-    t2[1][2] = 0;
+    createCurrentFEs (M_globalCFE, M_testCFE, M_solutionCFE);
+
+    M_evaluation.setQuadrature (M_quadratureBoundary.qr (0) );
+    M_evaluation.setGlobalCFE (M_globalCFE[0]);
+    M_evaluation.setTestCFE (M_testCFE[0]);
+    M_evaluation.setSolutionCFE (M_solutionCFE[0]);
+}
 
-    std::vector< VectorSmall<3> > t3 (2, VectorSmall<3> (0.0, 0.0, 0.0) );
-    t3[0][0] = 0;
-    t3[0][1] = 1;
-    t3[0][2] = 0;
-    t3[1][0] = 0;
-    t3[1][1] = 0;
-    t3[1][2] = 1;
 
-    M_globalCFE[0]->setRefTangents (t0);
-    M_globalCFE[1]->setRefTangents (t1);
-    M_globalCFE[2]->setRefTangents (t2);
-    M_globalCFE[3]->setRefTangents (t3);
+template < typename MeshType, typename TestSpaceType, typename SolutionSpaceType, typename ExpressionType>
+IntegrateMatrixFaceID < MeshType, TestSpaceType, SolutionSpaceType, ExpressionType>::
+IntegrateMatrixFaceID (const std::shared_ptr<MeshType>& mesh,
+                       const UInt boundaryID,
+                       const QuadratureBoundary& quadratureBD,
+                       const std::shared_ptr<TestSpaceType> testSpace,
+                       const std::shared_ptr<SolutionSpaceType> solutionSpace,
+                       const ExpressionType& expression,
+                       const OpenMPParameters& ompParams)
+    :   M_mesh (mesh),
+        M_boundaryId (boundaryID),
+        M_boundaryFaces(),
+        M_quadratureBoundary (quadratureBD),
+        M_testSpace (testSpace),
+        M_solutionSpace (solutionSpace),
+        M_evaluation (expression),
+
+        M_globalCFE (4),
+        M_testCFE (4),
+        M_solutionCFE (4),
+
+        M_elementalMatrix (TestSpaceType::field_dim * testSpace->refFE().nbDof(), SolutionSpaceType::field_dim * solutionSpace->refFE().nbDof() ),
+
+        M_ompParams (ompParams)
+{
+    cacheBoundaryFaces();
 
+    createCurrentFEs (M_globalCFE, M_testCFE, M_solutionCFE);
 
     M_evaluation.setQuadrature (M_quadratureBoundary.qr (0) );
     M_evaluation.setGlobalCFE (M_globalCFE[0]);
@@ -278,6 +332,7 @@ IntegrateMatrixFaceID < MeshType, TestSpaceType, SolutionSpaceType, ExpressionTy
 IntegrateMatrixFaceID ( const IntegrateMatrixFaceID < MeshType, TestSpaceType, SolutionSpaceType, ExpressionType>& integrator)
     :   M_mesh (integrator.M_mesh),
         M_boundaryId (integrator.M_boundaryId),
+        M_boundaryFaces (integrator.M_boundaryFaces),
         M_quadratureBoundary (integrator.M_quadratureBoundary),
         M_testSpace (integrator.M_testSpace),
         M_solutionSpace (integrator.M_solutionSpace),
@@ -287,18 +342,107 @@ IntegrateMatrixFaceID ( const IntegrateMatrixFaceID < MeshType, TestSpaceType, S
         M_testCFE (4),
         M_solutionCFE (4),
 
-        M_elementalMatrix (integrator.M_elementalMatrix)
+        M_elementalMatrix (integrator.M_elementalMatrix),
+
+        M_ompParams (integrator.M_ompParams)
+{
+    createCurrentFEs (M_globalCFE, M_testCFE, M_solutionCFE);
+
+    M_evaluation.setQuadrature (M_quadratureBoundary.qr (0) );
+    M_evaluation.setGlobalCFE (M_globalCFE[0]);
+    M_evaluation.setTestCFE (M_testCFE[0]);
+    M_evaluation.setSolutionCFE (M_solutionCFE[0]);
+}
+
+
+template < typename MeshType, typename TestSpaceType, typename SolutionSpaceType, typename ExpressionType>
+IntegrateMatrixFaceID < MeshType, TestSpaceType, SolutionSpaceType, ExpressionType>::
+~IntegrateMatrixFaceID()
+{
+    deleteCurrentFEs (M_globalCFE, M_testCFE, M_solutionCFE);
+}
+
+// ===================================================
+// Methods
+// ===================================================
+
+template < typename MeshType, typename TestSpaceType, typename SolutionSpaceType, typename ExpressionType>
+void
+IntegrateMatrixFaceID < MeshType, TestSpaceType, SolutionSpaceType, ExpressionType>::
+check (std::ostream& out)
+{
+    out << " Checking the integration : " << std::endl;
+    M_evaluation.display (out);
+    out << std::endl;
+    out << " Elemental matrix : " << std::endl;
+    M_elementalMatrix.showMe (out);
+    out << std::endl;
+}
+
+template < typename MeshType, typename TestSpaceType, typename SolutionSpaceType, typename ExpressionType>
+template <typename MatrixType>
+void
+IntegrateMatrixFaceID < MeshType, TestSpaceType, SolutionSpaceType, ExpressionType>::
+addTo (MatrixType& mat)
+{
+    if (M_ompParams.numThreads > 1)
+    {
+        addToThreaded (mat);
+        return;
+    }
+
+    const UInt nbFaces (M_boundaryFaces.size() );
+
+    for (UInt iFace (0); iFace < nbFaces; ++iFace)
+    {
+        integrateFace (M_boundaryFaces[iFace], M_elementalMatrix, M_evaluation,
+                       M_globalCFE, M_testCFE, M_solutionCFE);
+
+        M_elementalMatrix.pushToGlobal (mat);
+    }
+}
+
+// ===================================================
+// Private Methods
+// ===================================================
+
+template < typename MeshType, typename TestSpaceType, typename SolutionSpaceType, typename ExpressionType>
+void
+IntegrateMatrixFaceID < MeshType, TestSpaceType, SolutionSpaceType, ExpressionType>::
+cacheBoundaryFaces()
+{
+    const UInt nbBoundaryFaces (M_mesh->numBFaces() );
+
+    M_boundaryFaces.clear();
+
+    for (UInt iFace (0); iFace < nbBoundaryFaces; ++iFace)
+    {
+        // Check the identifier
+        if ( M_mesh->face (iFace).markerID() == M_boundaryId )
+        {
+            M_boundaryFaces.push_back (iFace);
+        }
+    }
+}
+
+template < typename MeshType, typename TestSpaceType, typename SolutionSpaceType, typename ExpressionType>
+void
+IntegrateMatrixFaceID < MeshType, TestSpaceType, SolutionSpaceType, ExpressionType>::
+createCurrentFEs (std::vector<ETCurrentBDFE<3>*>& globalCFE,
+                  std::vector<ETCurrentFE<3, TestSpaceType::field_dim>*>& testCFE,
+                  std::vector<ETCurrentFE<3, SolutionSpaceType::field_dim>*>& solutionCFE) const
 {
     for (UInt i (0); i < 4; ++i)
     {
-        M_globalCFE[i] = new ETCurrentBDFE<3> (geometricMapFromMesh<MeshType>()
-                                               , M_quadratureBoundary.qr (i) );
-        M_testCFE[i] = new ETCurrentFE<3, TestSpaceType::field_dim> (M_testSpace->refFE()
-                                                                     , M_testSpace->geoMap()
-                                                                     , M_quadratureBoundary.qr (i) );
-        M_solutionCFE[i] = new ETCurrentFE<3, SolutionSpaceType::field_dim> (M_solutionSpace->refFE()
-                                                                             , M_solutionSpace->geoMap()
-                                                                             , M_quadratureBoundary.qr (i) );
+        globalCFE[i] = new ETCurrentBDFE<3> (geometricMapFromMesh<MeshType>()
+                                             , M_quadratureBoundary.qr (i) );
+
+        testCFE[i] = new ETCurrentFE<3, TestSpaceType::field_dim> (M_testSpace->refFE()
+                                                                   , M_testSpace->geoMap()
+                                                                   , M_quadratureBoundary.qr (i) );
+        solutionCFE[i] = new ETCurrentFE<3, SolutionSpaceType::field_dim> (M_solutionSpace->refFE()
+                                                                           , M_solutionSpace->geoMap()
+                                                                           , M_quadratureBoundary.qr (i) );
     }
 
     // Set the tangent on the different faces
@@ -334,132 +478,173 @@ IntegrateMatrixFaceID ( const IntegrateMatrixFaceID < MeshType, TestSpaceType, S
     t3[1][1] = 0;
     t3[1][2] = 1;
 
-    M_globalCFE[0]->setRefTangents (t0);
-    M_globalCFE[1]->setRefTangents (t1);
-    M_globalCFE[2]->setRefTangents (t2);
-    M_globalCFE[3]->setRefTangents (t3);
-
-
-    M_evaluation.setQuadrature (M_quadratureBoundary.qr (0) );
-    M_evaluation.setGlobalCFE (M_globalCFE[0]);
-    M_evaluation.setTestCFE (M_testCFE[0]);
-    M_evaluation.setSolutionCFE (M_solutionCFE[0]);
+    globalCFE[0]->setRefTangents (t0);
+    globalCFE[1]->setRefTangents (t1);
+    globalCFE[2]->setRefTangents (t2);
+    globalCFE[3]->setRefTangents (t3);
 }
 
-
 template < typename MeshType, typename TestSpaceType, typename SolutionSpaceType, typename ExpressionType>
+void
 IntegrateMatrixFaceID < MeshType, TestSpaceType, SolutionSpaceType, ExpressionType>::
-~IntegrateMatrixFaceID()
+deleteCurrentFEs (std::vector<ETCurrentBDFE<3>*>& globalCFE,
+                  std::vector<ETCurrentFE<3, TestSpaceType::field_dim>*>& testCFE,
+                  std::vector<ETCurrentFE<3, SolutionSpaceType::field_dim>*>& solutionCFE) const
 {
     for (UInt i (0); i < 4; ++i)
     {
-        delete M_globalCFE[i];
-        delete M_testCFE[i];
-        delete M_solutionCFE[i];
+        delete globalCFE[i];
+        delete testCFE[i];
+        delete solutionCFE[i];
     }
 }
 
-// ===================================================
-// Methods
-// ===================================================
-
 template < typename MeshType, typename TestSpaceType, typename SolutionSpaceType, typename ExpressionType>
 void
 IntegrateMatrixFaceID < MeshType, TestSpaceType, SolutionSpaceType, ExpressionType>::
-check (std::ostream& out)
+integrateFace (const UInt iFace,
+               ETMatrixElemental& elementalMatrix,
+               evaluation_Type& evaluation,
+               std::vector<ETCurrentBDFE<3>*>& globalCFE,
+               std::vector<ETCurrentFE<3, TestSpaceType::field_dim>*>& testCFE,
+               std::vector<ETCurrentFE<3, SolutionSpaceType::field_dim>*>& solutionCFE)
 {
-    out << " Checking the integration : " << std::endl;
-    M_evaluation.display (out);
-    out << std::endl;
-    out << " Elemental matrix : " << std::endl;
-    M_elementalMatrix.showMe (out);
-    out << std::endl;
+    const UInt nbTestDof (M_testSpace->refFE().nbDof() );
+    const UInt nbSolutionDof (M_solutionSpace->refFE().nbDof() );
+
+    // Zeros out the elemental vector
+    elementalMatrix.zero();
+
+    // Get the number of the face in the adjacent element
+    UInt faceIDinAdjacentElement (M_mesh->face (iFace).firstAdjacentElementPosition() );
+
+    // Get the ID of the adjacent element
+    UInt adjacentElementID (M_mesh->face (iFace).firstAdjacentElementIdentity() );
+
+    // Update the currentFEs
+    globalCFE[faceIDinAdjacentElement]
+    ->update (M_mesh->element (adjacentElementID) );
+    testCFE[faceIDinAdjacentElement]
+    ->update (M_mesh->element (adjacentElementID), evaluation_Type::S_testUpdateFlag);
+    solutionCFE[faceIDinAdjacentElement]
+    ->update (M_mesh->element (adjacentElementID), evaluation_Type::S_solutionUpdateFlag);
+
+
+    // Update the evaluation
+    evaluation.setQuadrature (M_quadratureBoundary.qr (faceIDinAdjacentElement) );
+    evaluation.setGlobalCFE (globalCFE[faceIDinAdjacentElement]);
+    evaluation.setTestCFE (testCFE[faceIDinAdjacentElement]);
+    evaluation.setSolutionCFE (solutionCFE[faceIDinAdjacentElement]);
+
+    evaluation.update (adjacentElementID);
+
+    // Loop on the blocks
+    for (UInt iblock (0); iblock < TestSpaceType::field_dim; ++iblock)
+    {
+        for (UInt jblock (0); jblock < SolutionSpaceType::field_dim; ++jblock)
+        {
+
+            // Set the row global indices in the local matrix
+            for (UInt i (0); i < nbTestDof; ++i)
+            {
+                elementalMatrix.setRowIndex
+                (i + iblock * nbTestDof,
+                 M_testSpace->dof().localToGlobalMap (adjacentElementID, i) + iblock * M_testSpace->dof().numTotalDof() );
+            }
+
+            for (UInt j (0); j < nbSolutionDof; ++j)
+            {
+                elementalMatrix.setColumnIndex
+                (j + jblock * nbSolutionDof,
+                 M_solutionSpace->dof().localToGlobalMap (adjacentElementID, j) + jblock * M_solutionSpace->dof().numTotalDof() );
+            }
+
+
+            // Make the assembly
+            for (UInt iQuadPt (0); iQuadPt < M_quadratureBoundary.qr (faceIDinAdjacentElement).nbQuadPt(); ++iQuadPt)
+            {
+                for (UInt i (0); i < nbTestDof; ++i)
+                {
+                    for (UInt j (0); j < nbSolutionDof; ++j)
+                    {
+                        elementalMatrix.element (i + iblock * nbTestDof, j + jblock * nbSolutionDof) +=
+                            evaluation.value_qij (iQuadPt, i + iblock * nbTestDof, j + jblock * nbSolutionDof)
+                            * globalCFE[faceIDinAdjacentElement]->M_wMeas[iQuadPt];
+                    }
+                }
+            }
+        }
+    }
 }
 
 template < typename MeshType, typename TestSpaceType, typename SolutionSpaceType, typename ExpressionType>
 template <typename MatrixType>
 void
 IntegrateMatrixFaceID < MeshType, TestSpaceType, SolutionSpaceType, ExpressionType>::
-addTo (MatrixType& mat)
+addToThreaded (MatrixType& mat)
 {
-    UInt nbBoundaryFaces (M_mesh->numBFaces() );
-    UInt nbTestDof (M_testSpace->refFE().nbDof() );
-    UInt nbSolutionDof (M_solutionSpace->refFE().nbDof() );
+    const UInt nbFaces (M_boundaryFaces.size() );
+    const bool closedMatrix (mat.filled() );
+    const UInt chunkSize (closedMatrix ? 0 : S_facesPerThreadChunk * M_ompParams.numThreads);
 
-    for (UInt iFace (0); iFace < nbBoundaryFaces; ++iFace)
-    {
-        // Check the identifier
-        if ( M_mesh->face (iFace).markerID() != M_boundaryId )
-        {
-            continue;
-        }
+    // Elemental matrices of one chunk of faces (only for an open matrix)
+    std::vector<ETMatrixElemental> chunkMatrices (chunkSize, M_elementalMatrix);
 
-        // Zeros out the elemental vector
-        M_elementalMatrix.zero();
+    // OpenMP setup and pragmas around the loop
+    M_ompParams.apply();
 
-        // Get the number of the face in the adjacent element
-        UInt faceIDinAdjacentElement (M_mesh->face (iFace).firstAdjacentElementPosition() );
-
-        // Get the ID of the adjacent element
-        UInt adjacentElementID (M_mesh->face (iFace).firstAdjacentElementIdentity() );
+    #pragma omp parallel
+    {
+        std::vector<ETCurrentBDFE<3>*> globalCFE (4);
+        std::vector<ETCurrentFE<3, TestSpaceType::field_dim>*> testCFE (4);
+        std::vector<ETCurrentFE<3, SolutionSpaceType::field_dim>*> solutionCFE (4);
 
-        // Update the currentFEs
-        M_globalCFE[faceIDinAdjacentElement]
-        ->update (M_mesh->element (adjacentElementID) );
-        M_testCFE[faceIDinAdjacentElement]
-        ->update (M_mesh->element (adjacentElementID), evaluation_Type::S_testUpdateFlag);
-        M_solutionCFE[faceIDinAdjacentElement]
-        ->update (M_mesh->element (adjacentElementID), evaluation_Type::S_solutionUpdateFlag);
+        createCurrentFEs (globalCFE, testCFE, solutionCFE);
 
+        evaluation_Type evaluation (M_evaluation);
 
-        // Update the evaluation
-        M_evaluation.setQuadrature (M_quadratureBoundary.qr (faceIDinAdjacentElement) );
-        M_evaluation.setGlobalCFE (M_globalCFE[faceIDinAdjacentElement]);
-        M_evaluation.setTestCFE (M_testCFE[faceIDinAdjacentElement]);
-        M_evaluation.setSolutionCFE (M_solutionCFE[faceIDinAdjacentElement]);
+        if (closedMatrix)
+        {
+            ETMatrixElemental elementalMatrix (M_elementalMatrix);
 
-        M_evaluation.update (adjacentElementID);
+            #pragma omp for schedule(runtime)
+            for (UInt iFace = 0; iFace < nbFaces; ++iFace)
+            {
+                integrateFace (M_boundaryFaces[iFace], elementalMatrix, evaluation,
+                               globalCFE, testCFE, solutionCFE);
 
-        // Loop on the blocks
-        for (UInt iblock (0); iblock < TestSpaceType::field_dim; ++iblock)
+                elementalMatrix.pushToClosedGlobal (mat);
+            }
+        }
+        else
         {
-            for (UInt jblock (0); jblock < SolutionSpaceType::field_dim; ++jblock)
+            for (UInt chunkBegin = 0; chunkBegin < nbFaces; chunkBegin += chunkSize)
             {
+                const UInt chunkEnd (std::min (chunkBegin + chunkSize, nbFaces) );
 
-                // Set the row global indices in the local matrix
-                for (UInt i (0); i < nbTestDof; ++i)
+                #pragma omp for schedule(runtime)
+                for (UInt iFace = chunkBegin; iFace < chunkEnd; ++iFace)
                 {
-                    M_elementalMatrix.setRowIndex
-                    (i + iblock * nbTestDof,
-                     M_testSpace->dof().localToGlobalMap (adjacentElementID, i) + iblock * M_testSpace->dof().numTotalDof() );
+                    integrateFace (M_boundaryFaces[iFace], chunkMatrices[iFace - chunkBegin], evaluation,
+                                   globalCFE, testCFE, solutionCFE);
                 }
 
-                for (UInt j (0); j < nbSolutionDof; ++j)
+                // Insertion in the global matrix, in the same order as the serial loop
+                // (the implicit barriers make the buffers safe to reuse)
+                #pragma omp single
                 {
-                    M_elementalMatrix.setColumnIndex
-                    (j + jblock * nbSolutionDof,
-                     M_solutionSpace->dof().localToGlobalMap (adjacentElementID, j) + jblock * M_solutionSpace->dof().numTotalDof() );
-                }
-
-
-                // Make the assembly
-                for (UInt iQuadPt (0); iQuadPt < M_quadratureBoundary.qr (faceIDinAdjacentElement).nbQuadPt(); ++iQuadPt)
-                {
-                    for (UInt i (0); i < nbTestDof; ++i)
+                    for (UInt iFace = chunkBegin; iFace < chunkEnd; ++iFace)
                     {
-                        for (UInt j (0); j < nbSolutionDof; ++j)
-                        {
-                            M_elementalMatrix.element (i + iblock * nbTestDof, j + jblock * nbSolutionDof) +=
-                                M_evaluation.value_qij (iQuadPt, i + iblock * nbTestDof, j + jblock * nbSolutionDof)
-                                * M_globalCFE[faceIDinAdjacentElement]->M_wMeas[iQuadPt];
-                        }
+                        chunkMatrices[iFace - chunkBegin].pushToGlobal (mat);
                     }
                 }
             }
         }
 
-        M_elementalMatrix.pushToGlobal (mat);
+        deleteCurrentFEs (globalCFE, testCFE, solutionCFE);
     }
+
+    M_ompParams.restorePreviousNumThreads();
 }
 
 
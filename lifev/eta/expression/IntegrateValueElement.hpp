@@ -36,14 +36,21 @@
 #ifndef INTEGRATE_VALUE_ELEMENT_HPP
 #define INTEGRATE_VALUE_ELEMENT_HPP
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 #include <lifev/core/LifeV.hpp>
 
+#include <lifev/core/util/OpenMPParameters.hpp>
+
 #include <lifev/core/fem/QuadratureRule.hpp>
 #include <lifev/eta/fem/ETCurrentFE.hpp>
 #include <lifev/eta/fem/MeshGeometricMap.hpp>
 #include <lifev/eta/fem/QRAdapterBase.hpp>
 
 #include <lifev/eta/expression/ExpressionToEvaluation.hpp>
+#include <lifev/eta/expression/EvaluationSharedInterpolation.hpp>
 
 #include <boost/shared_ptr.hpp>
 
@@ -63,6 +70,11 @@ namespace ExpressionAssembly
   perform that assembly with a loop over the elements, and then, for each elements,
   using the Evaluation corresponding to the Expression (This convertion is done
   within a typedef).
+
+  When the class is built with OpenMPParameters, the elements are split in blocks
+  of fixed size. The partial sum of each block is computed by one thread, then the
+  partial sums are added following the order of the blocks. The value obtained
+  does not depend on the number of threads nor on the scheduling.
  */
 template < typename MeshType, typename ExpressionType, typename QRAdapterType>
 class IntegrateValueElement
@@ -89,6 +101,12 @@ public:
                            const QRAdapterType& qrAdapter,
                            const ExpressionType& expression);
 
+    //! Full data constructor (multi-threaded reduction)
+    IntegrateValueElement (const std::shared_ptr<MeshType>& mesh,
+                           const QRAdapterType& qrAdapter,
+                           const ExpressionType& expression,
+                           const OpenMPParameters& ompParams);
+
     //! Copy constructor
     IntegrateValueElement ( const IntegrateValueElement < MeshType, ExpressionType, QRAdapterType>& integrator);
 
@@ -135,8 +153,20 @@ private:
     //! No empty constructor
     IntegrateValueElement();
 
+    //! Compute the contribution of a single element
+    Real integrateElement (const UInt iElement,
+                           const UInt nbQuadPt,
+                           evaluation_Type& evaluation,
+                           ETCurrentFE<MeshType::S_geoDimensions, 1>& globalCFE);
+
+    //! Multi-threaded loop over the elements
+    void addToThreaded (Real& value);
+
     //@}
 
+    // Number of elements in a block of the multi-threaded reduction
+    static const UInt S_elementsPerBlock = 256;
+
     // Pointer on the mesh
     std::shared_ptr<MeshType> M_mesh;
 
@@ -152,6 +182,12 @@ private:
     // CurrentFE for the adapted quadrature
     ETCurrentFE<MeshType::S_geoDimensions, 1>* M_globalCFE_adapted;
 
+    // Data for multi-threaded reduction
+    OpenMPParameters M_ompParams;
+
+    // True if the reduction is multi-threaded
+    bool M_useThreads;
+
 };
 
 
@@ -170,7 +206,52 @@ IntegrateValueElement (const std::shared_ptr<MeshType>& mesh,
                        const ExpressionType& expression)
     :   M_mesh (mesh),
         M_qrAdapter (qrAdapter),
-        M_evaluation (expression)
+        M_evaluation (expression),
+        M_ompParams(),
+        M_useThreads (false)
+
+{
+    switch (MeshType::geoShape_Type::BasRefSha::S_shape)
+    {
+        case LINE:
+            M_globalCFE_std = new ETCurrentFE<MeshType::S_geoDimensions, 1> (feSegP0, geometricMapFromMesh<MeshType>(), qrAdapter.standardQR() );
+            M_globalCFE_adapted = new ETCurrentFE<MeshType::S_geoDimensions, 1> (feSegP0, geometricMapFromMesh<MeshType>(), qrAdapter.standardQR() );
+            break;
+        case TRIANGLE:
+            M_globalCFE_std = new ETCurrentFE<MeshType::S_geoDimensions, 1> (feTriaP0, geometricMapFromMesh<MeshType>(), qrAdapter.standardQR() );
+            M_globalCFE_adapted = new ETCurrentFE<MeshType::S_geoDimensions, 1> (feTriaP0, geometricMapFromMesh<MeshType>(), qrAdapter.standardQR() );
+            break;
+        case QUAD:
+            M_globalCFE_std = new ETCurrentFE<MeshType::S_geoDimensions, 1> (feQuadQ0, geometricMapFromMesh<MeshType>(), qrAdapter.standardQR() );
+            M_globalCFE_adapted = new ETCurrentFE<MeshType::S_geoDimensions, 1> (feQuadQ0, geometricMapFromMesh<MeshType>(), qrAdapter.standardQR() );
+            break;
+        case TETRA:
+            M_globalCFE_std = new ETCurrentFE<MeshType::S_geoDimensions, 1> (feTetraP0, geometricMapFromMesh<MeshType>(), qrAdapter.standardQR() );
+            M_globalCFE_adapted = new ETCurrentFE<MeshType::S_geoDimensions, 1> (feTetraP0, geometricMapFromMesh<MeshType>(), qrAdapter.standardQR() );
+            break;
+        case HEXA:
+            M_globalCFE_std = new ETCurrentFE<MeshType::S_geoDimensions, 1> (feHexaQ0, geometricMapFromMesh<MeshType>(), qrAdapter.standardQR() );
+            M_globalCFE_adapted = new ETCurrentFE<MeshType::S_geoDimensions, 1> (feHexaQ0, geometricMapFromMesh<MeshType>(), qrAdapter.standardQR() );
+            break;
+        default:
+            ERROR_MSG ("Unrecognized element shape");
+    }
+    M_evaluation.setQuadrature (qrAdapter.standardQR() );
+    M_evaluation.setGlobalCFE (M_globalCFE_std);
+}
+
+
+template < typename MeshType, typename ExpressionType, typename QRAdapterType>
+IntegrateValueElement < MeshType, ExpressionType, QRAdapterType>::
+IntegrateValueElement (const std::shared_ptr<MeshType>& mesh,
+                       const QRAdapterType& qrAdapter,
+                       const ExpressionType& expression,
+                       const OpenMPParameters& ompParams)
+    :   M_mesh (mesh),
+        M_qrAdapter (qrAdapter),
+        M_evaluation (expression),
+        M_ompParams (ompParams),
+        M_useThreads (true)
 
 {
     switch (MeshType::geoShape_Type::BasRefSha::S_shape)
@@ -208,7 +289,9 @@ IntegrateValueElement < MeshType, ExpressionType, QRAdapterType>::
 IntegrateValueElement ( const IntegrateValueElement < MeshType, ExpressionType, QRAdapterType>& integrator)
     :   M_mesh (integrator.M_mesh),
         M_qrAdapter (integrator.M_qrAdapter),
-        M_evaluation (integrator.M_evaluation)
+        M_evaluation (integrator.M_evaluation),
+        M_ompParams (integrator.M_ompParams),
+        M_useThreads (integrator.M_useThreads)
 {
     switch (MeshType::geoShape_Type::BasRefSha::S_shape)
     {
@@ -269,6 +352,12 @@ void
 IntegrateValueElement < MeshType, ExpressionType, QRAdapterType>::
 addTo (Real& value)
 {
+    if (M_useThreads)
+    {
+        addToThreaded (value);
+        return;
+    }
+
     UInt nbElements (M_mesh->numElements() );
     UInt nbQuadPt_std (M_qrAdapter.standardQR().nbQuadPt() );
 
@@ -340,6 +429,137 @@ addTo (Real& value)
 }
 
 
+template < typename MeshType, typename ExpressionType, typename QRAdapterType>
+Real
+IntegrateValueElement < MeshType, ExpressionType, QRAdapterType>::
+integrateElement (const UInt iElement,
+                  const UInt nbQuadPt,
+                  evaluation_Type& evaluation,
+                  ETCurrentFE<MeshType::S_geoDimensions, 1>& globalCFE)
+{
+    // Update the currentFE
+    globalCFE.update (M_mesh->element (iElement), evaluation_Type::S_globalUpdateFlag | ET_UPDATE_WDET);
+
+    // Update the evaluation
+    evaluation.update (iElement);
+
+    Real elementValue (0.0);
+    for (UInt iQuadPt (0); iQuadPt < nbQuadPt; ++iQuadPt)
+    {
+        elementValue += evaluation.value_q (iQuadPt)
+                        * globalCFE.wDet (iQuadPt);
+    }
+    return elementValue;
+}
+
+
+template < typename MeshType, typename ExpressionType, typename QRAdapterType>
+void
+IntegrateValueElement < MeshType, ExpressionType, QRAdapterType>::
+addToThreaded (Real& value)
+{
+    const UInt nbElements (M_mesh->numElements() );
+    const UInt nbBlocks ( (nbElements + S_elementsPerBlock - 1) / S_elementsPerBlock);
+
+    // One partial sum per block (not per thread), so that the
+    // result does not depend on the distribution of the blocks
+    std::vector<Real> blockValues (nbBlocks, 0.0);
+
+    // OpenMP setup and pragmas around the loop
+    M_ompParams.apply();
+
+    #pragma omp parallel
+    {
+        QRAdapterType qrAdapter (M_qrAdapter);
+
+        std::unique_ptr<ETCurrentFE<MeshType::S_geoDimensions, 1> > globalCFE_std;
+        std::unique_ptr<ETCurrentFE<MeshType::S_geoDimensions, 1> > globalCFE_adapted;
+
+        switch (MeshType::geoShape_Type::BasRefSha::S_shape)
+        {
+            case LINE:
+                globalCFE_std.reset ( new ETCurrentFE<MeshType::S_geoDimensions, 1> (feSegP0, geometricMapFromMesh<MeshType>(), qrAdapter.standardQR() ) );
+                globalCFE_adapted.reset ( new ETCurrentFE<MeshType::S_geoDimensions, 1> (feSegP0, geometricMapFromMesh<MeshType>(), qrAdapter.standardQR() ) );
+                break;
+            case TRIANGLE:
+                globalCFE_std.reset ( new ETCurrentFE<MeshType::S_geoDimensions, 1> (feTriaP0, geometricMapFromMesh<MeshType>(), qrAdapter.standardQR() ) );
+                globalCFE_adapted.reset ( new ETCurrentFE<MeshType::S_geoDimensions, 1> (feTriaP0, geometricMapFromMesh<MeshType>(), qrAdapter.standardQR() ) );
+                break;
+            case QUAD:
+                globalCFE_std.reset ( new ETCurrentFE<MeshType::S_geoDimensions, 1> (feQuadQ0, geometricMapFromMesh<MeshType>(), qrAdapter.standardQR() ) );
+                globalCFE_adapted.reset ( new ETCurrentFE<MeshType::S_geoDimensions, 1> (feQuadQ0, geometricMapFromMesh<MeshType>(), qrAdapter.standardQR() ) );
+                break;
+            case TETRA:
+                globalCFE_std.reset ( new ETCurrentFE<MeshType::S_geoDimensions, 1> (feTetraP0, geometricMapFromMesh<MeshType>(), qrAdapter.standardQR() ) );
+                globalCFE_adapted.reset ( new ETCurrentFE<MeshType::S_geoDimensions, 1> (feTetraP0, geometricMapFromMesh<MeshType>(), qrAdapter.standardQR() ) );
+                break;
+            case HEXA:
+                globalCFE_std.reset ( new ETCurrentFE<MeshType::S_geoDimensions, 1> (feHexaQ0, geometricMapFromMesh<MeshType>(), qrAdapter.standardQR() ) );
+                globalCFE_adapted.reset ( new ETCurrentFE<MeshType::S_geoDimensions, 1> (feHexaQ0, geometricMapFromMesh<MeshType>(), qrAdapter.standardQR() ) );
+                break;
+            default:
+                ERROR_MSG ("Unrecognized element shape");
+        }
+
+        evaluation_Type evaluation (copyWithSharedInterpolations (M_evaluation) );
+
+        // Defaulted to true for security
+        bool isPreviousAdapted (true);
+
+        #pragma omp for schedule(runtime)
+        for (UInt iBlock = 0; iBlock < nbBlocks; ++iBlock)
+        {
+            const UInt blockEnd (std::min ( (iBlock + 1) * S_elementsPerBlock, nbElements) );
+
+            Real blockValue (0.0);
+
+            for (UInt iElement (iBlock * S_elementsPerBlock); iElement < blockEnd; ++iElement)
+            {
+                // Update the quadrature adapter
+                qrAdapter.update (iElement);
+
+                if ( qrAdapter.isAdaptedElement() )
+                {
+                    // Set the adapted QR and the right CFE
+                    evaluation.setQuadrature ( qrAdapter.adaptedQR() );
+                    globalCFE_adapted->setQuadratureRule ( qrAdapter.adaptedQR() );
+                    evaluation.setGlobalCFE ( globalCFE_adapted.get() );
+
+                    blockValue += integrateElement (iElement, qrAdapter.adaptedQR().nbQuadPt(),
+                                                    evaluation, *globalCFE_adapted);
+
+                    isPreviousAdapted = true;
+                }
+                else
+                {
+                    // Check if the previous one was adapted
+                    if (isPreviousAdapted)
+                    {
+                        evaluation.setQuadrature ( qrAdapter.standardQR() );
+                        evaluation.setGlobalCFE ( globalCFE_std.get() );
+
+                        isPreviousAdapted = false;
+                    }
+
+                    blockValue += integrateElement (iElement, qrAdapter.standardQR().nbQuadPt(),
+                                                    evaluation, *globalCFE_std);
+                }
+            }
+
+            blockValues[iBlock] = blockValue;
+        }
+    }
+
+    M_ompParams.restorePreviousNumThreads();
+
+    // Sum of the partial sums, always in the same order
+    for (UInt iBlock (0); iBlock < nbBlocks; ++iBlock)
+    {
+        value += blockValues[iBlock];
+    }
+}
+
+
 } // Namespace ExpressionAssembly
 
 } // Namespace LifeV
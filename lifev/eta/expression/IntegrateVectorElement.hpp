@@ -36,14 +36,21 @@
 #ifndef INTEGRATE_VECTOR_ELEMENT_HPP
 #define INTEGRATE_VECTOR_ELEMENT_HPP
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 #include <lifev/core/LifeV.hpp>
 
+#include <lifev/core/util/OpenMPParameters.hpp>
+
 #include <lifev/core/fem/QuadratureRule.hpp>
 #include <lifev/eta/fem/ETCurrentFE.hpp>
 #include <lifev/eta/fem/MeshGeometricMap.hpp>
 #include <lifev/eta/fem/QRAdapterBase.hpp>
 
 #include <lifev/eta/expression/ExpressionToEvaluation.hpp>
+#include <lifev/eta/expression/EvaluationSharedInterpolation.hpp>
 #include <lifev/eta/expression/EvaluationPhiI.hpp>
 
 #include <lifev/eta/array/ETVectorElemental.hpp>
@@ -66,6 +73,11 @@ namespace ExpressionAssembly
   perform that assembly with a loop over the elements, and then, for each elements,
   using the Evaluation corresponding to the Expression (this convertion is done
   within a typedef).
+
+  When more than one thread is requested through the OpenMPParameters, the elemental
+  vectors are computed in parallel, stored in a buffer and then summed in the global
+  vector following the order of the elements. The result is therefore identical to
+  the one of the serial loop, independently of the number of threads.
  */
 template < typename MeshType, typename TestSpaceType, typename ExpressionType, typename QRAdapterType>
 class IntegrateVectorElement
@@ -94,6 +106,14 @@ public:
                             const ExpressionType& expression,
                             const UInt offset = 0);
 
+    //! Full data constructor (multi-threaded assembly)
+    IntegrateVectorElement (const std::shared_ptr<MeshType>& mesh,
+                            const QRAdapterType& qrAdapter,
+                            const std::shared_ptr<TestSpaceType>& testSpace,
+                            const ExpressionType& expression,
+                            const OpenMPParameters& ompParams,
+                            const UInt offset = 0);
+
     //! Copy constructor
     IntegrateVectorElement ( const IntegrateVectorElement < MeshType, TestSpaceType, ExpressionType, QRAdapterType>& integrator);
 
@@ -150,8 +170,66 @@ private:
     // No default constructor
     IntegrateVectorElement();
 
+    //! Perform the computations for a single element
+    /*!
+     * This method computes the elemental vector for a given element
+     * index
+     */
+    void integrateElement (const UInt iElement,
+                           const UInt nbQuadPt,
+                           const UInt nbTestDof,
+                           ETVectorElemental& elementalVector,
+                           evaluation_Type& evaluation,
+                           ETCurrentFE<MeshType::S_geoDimensions, 1>& globalCFE,
+                           ETCurrentFE<TestSpaceType::space_dim, TestSpaceType::field_dim>& testCFE);
+
+    //! Sum the contributions of the quadrature nodes for one block of the elemental vector
+    /*!
+     * This method selects a version of the loops with sizes known at compile
+     * time (see accumulateBlockFixed) for the most common combinations of
+     * finite elements and quadrature rules (P1 and P2 on tetrahedra, Q1 and
+     * Q2 on hexahedra). For the other cases, generic loops are used.
+     */
+    void accumulateBlock (const UInt nbQuadPt,
+                          const UInt nbTestDof,
+                          const UInt iblock,
+                          ETVectorElemental& elementalVector,
+                          evaluation_Type& evaluation,
+                          const ETCurrentFE<MeshType::S_geoDimensions, 1>& globalCFE);
+
+    //! Sum the contributions of the quadrature nodes for one block, with fixed sizes
+    template <UInt NbQuadPt, UInt NbTestDof>
+    void accumulateBlockFixed (const UInt iblock,
+                               ETVectorElemental& elementalVector,
+                               evaluation_Type& evaluation,
+                               const ETCurrentFE<MeshType::S_geoDimensions, 1>& globalCFE);
+
+    //! Attach the geometric cache of the test space (if any) to the current FEs
+    /*!
+     * The cache is indexed with the local identifiers of the elements,
+     * so it is used only if the integration is performed on the mesh
+     * of the test space.
+     */
+    void attachGeometryCache();
+
+    //! Serial loop over the elements
+    template <typename VectorType>
+    void addToSerial (VectorType& vec);
+
+    //! Multi-threaded loop over the elements
+    /*!
+     * The elements are processed by chunks: the elemental vectors of a chunk
+     * are computed by the threads and stored, then a single thread sums them
+     * in the global vector, element by element.
+     */
+    template <typename VectorType>
+    void addToThreaded (VectorType& vec);
+
     //@}
 
+    // Number of elements buffered per thread in the multi-threaded assembly
+    static const UInt S_elementsPerThreadChunk = 1024;
+
     // Pointer on the mesh
     std::shared_ptr<MeshType> M_mesh;
 
@@ -174,6 +252,9 @@ private:
 
     // Offset
     UInt M_offset;
+
+    // Data for multi-threaded assembly
+    OpenMPParameters M_ompParams;
 };
 
 
@@ -202,7 +283,63 @@ IntegrateVectorElement (const std::shared_ptr<MeshType>& mesh,
 
         M_elementalVector (TestSpaceType::field_dim * testSpace->refFE().nbDof() ),
 
-        M_offset (offset)
+        M_offset (offset),
+        M_ompParams()
+{
+    switch (MeshType::geoShape_Type::BasRefSha::S_shape)
+    {
+        case LINE:
+            M_globalCFE_std = new ETCurrentFE<MeshType::S_geoDimensions, 1> (feSegP0, geometricMapFromMesh<MeshType>(), qrAdapter.standardQR() );
+            M_globalCFE_adapted = new ETCurrentFE<MeshType::S_geoDimensions, 1> (feSegP0, geometricMapFromMesh<MeshType>(), qrAdapter.standardQR() );
+            break;
+        case TRIANGLE:
+            M_globalCFE_std = new ETCurrentFE<MeshType::S_geoDimensions, 1> (feTriaP0, geometricMapFromMesh<MeshType>(), qrAdapter.standardQR() );
+            M_globalCFE_adapted = new ETCurrentFE<MeshType::S_geoDimensions, 1> (feTriaP0, geometricMapFromMesh<MeshType>(), qrAdapter.standardQR() );
+            break;
+        case QUAD:
+            M_globalCFE_std = new ETCurrentFE<MeshType::S_geoDimensions, 1> (feQuadQ0, geometricMapFromMesh<MeshType>(), qrAdapter.standardQR() );
+            M_globalCFE_adapted = new ETCurrentFE<MeshType::S_geoDimensions, 1> (feQuadQ0, geometricMapFromMesh<MeshType>(), qrAdapter.standardQR() );
+            break;
+        case TETRA:
+            M_globalCFE_std = new ETCurrentFE<MeshType::S_geoDimensions, 1> (feTetraP0, geometricMapFromMesh<MeshType>(), qrAdapter.standardQR() );
+            M_globalCFE_adapted = new ETCurrentFE<MeshType::S_geoDimensions, 1> (feTetraP0, geometricMapFromMesh<MeshType>(), qrAdapter.standardQR() );
+            break;
+        case HEXA:
+            M_globalCFE_std = new ETCurrentFE<MeshType::S_geoDimensions, 1> (feHexaQ0, geometricMapFromMesh<MeshType>(), qrAdapter.standardQR() );
+            M_globalCFE_adapted = new ETCurrentFE<MeshType::S_geoDimensions, 1> (feHexaQ0, geometricMapFromMesh<MeshType>(), qrAdapter.standardQR() );
+            break;
+        default:
+            ERROR_MSG ("Unrecognized element shape");
+    }
+    M_evaluation.setQuadrature ( qrAdapter.standardQR() );
+
+    M_evaluation.setGlobalCFE (M_globalCFE_std);
+    M_evaluation.setTestCFE (M_testCFE_std);
+
+    attachGeometryCache();
+}
+
+
+template < typename MeshType, typename TestSpaceType, typename ExpressionType, typename QRAdapterType>
+IntegrateVectorElement < MeshType, TestSpaceType, ExpressionType, QRAdapterType>::
+IntegrateVectorElement (const std::shared_ptr<MeshType>& mesh,
+                        const QRAdapterType& qrAdapter,
+                        const std::shared_ptr<TestSpaceType>& testSpace,
+                        const ExpressionType& expression,
+                        const OpenMPParameters& ompParams,
+                        const UInt offset)
+    :   M_mesh (mesh),
+        M_qrAdapter (qrAdapter),
+        M_testSpace (testSpace),
+        M_evaluation (expression),
+
+        M_testCFE_std (new ETCurrentFE<TestSpaceType::space_dim, TestSpaceType::field_dim> (testSpace->refFE(), testSpace->geoMap(), qrAdapter.standardQR() ) ),
+        M_testCFE_adapted (new ETCurrentFE<TestSpaceType::space_dim, TestSpaceType::field_dim> (testSpace->refFE(), testSpace->geoMap(), qrAdapter.standardQR() ) ),
+
+        M_elementalVector (TestSpaceType::field_dim * testSpace->refFE().nbDof() ),
+
+        M_offset (offset),
+        M_ompParams (ompParams)
 {
     switch (MeshType::geoShape_Type::BasRefSha::S_shape)
     {
@@ -233,6 +370,8 @@ IntegrateVectorElement (const std::shared_ptr<MeshType>& mesh,
 
     M_evaluation.setGlobalCFE (M_globalCFE_std);
     M_evaluation.setTestCFE (M_testCFE_std);
+
+    attachGeometryCache();
 }
 
 
@@ -248,7 +387,8 @@ IntegrateVectorElement ( const IntegrateVectorElement < MeshType, TestSpaceType,
         M_testCFE_adapted (new ETCurrentFE<TestSpaceType::space_dim, TestSpaceType::field_dim> (M_testSpace->refFE(), M_testSpace->geoMap(), integrator.M_qrAdapter.standardQR() ) ),
 
         M_elementalVector (integrator.M_elementalVector),
-        M_offset (integrator.M_offset)
+        M_offset (integrator.M_offset),
+        M_ompParams (integrator.M_ompParams)
 {
     switch (MeshType::geoShape_Type::BasRefSha::S_shape)
     {
@@ -278,6 +418,8 @@ IntegrateVectorElement ( const IntegrateVectorElement < MeshType, TestSpaceType,
     M_evaluation.setQuadrature (integrator.M_qrAdapter.standardQR() );
     M_evaluation.setGlobalCFE (M_globalCFE_std);
     M_evaluation.setTestCFE (M_testCFE_std);
+
+    attachGeometryCache();
 }
 
 
@@ -308,14 +450,185 @@ check (std::ostream& out)
     out << std::endl;
 }
 
+template < typename MeshType, typename TestSpaceType, typename ExpressionType, typename QRAdapterType>
+void
+IntegrateVectorElement < MeshType, TestSpaceType, ExpressionType, QRAdapterType>::
+attachGeometryCache()
+{
+    if (M_mesh != M_testSpace->mesh() )
+    {
+        return;
+    }
+
+    std::shared_ptr<ETGeometryCache> geometryCache (M_testSpace->geometryCache (M_qrAdapter.standardQR() ) );
+
+    if (geometryCache)
+    {
+        M_globalCFE_std->setGeometryCache (geometryCache);
+        M_testCFE_std->setGeometryCache (geometryCache);
+    }
+}
+
+template < typename MeshType, typename TestSpaceType, typename ExpressionType, typename QRAdapterType>
+void
+IntegrateVectorElement < MeshType, TestSpaceType, ExpressionType, QRAdapterType>::
+integrateElement (const UInt iElement,
+                  const UInt nbQuadPt,
+                  const UInt nbTestDof,
+                  ETVectorElemental& elementalVector,
+                  evaluation_Type& evaluation,
+                  ETCurrentFE<MeshType::S_geoDimensions, 1>& globalCFE,
+                  ETCurrentFE<TestSpaceType::space_dim, TestSpaceType::field_dim>& testCFE)
+{
+    // Zeros out the elemental vector
+    elementalVector.zero();
+
+    // Update the currentFEs
+    globalCFE.update (M_mesh->element (iElement), evaluation_Type::S_globalUpdateFlag | ET_UPDATE_WDET);
+    testCFE.update (M_mesh->element (iElement), evaluation_Type::S_testUpdateFlag);
+
+    // Update the evaluation
+    evaluation.update (iElement);
+
+    // Loop on the blocks
+    for (UInt iblock (0); iblock < TestSpaceType::field_dim; ++iblock)
+    {
+        // Set the row global indices in the local vector
+        for (UInt i (0); i < nbTestDof; ++i)
+        {
+            elementalVector.setRowIndex
+            (i + iblock * nbTestDof,
+             M_testSpace->dof().localToGlobalMap (iElement, i) + iblock * M_testSpace->dof().numTotalDof() + M_offset);
+        }
+
+        // Make the assembly
+        accumulateBlock (nbQuadPt, nbTestDof, iblock, elementalVector, evaluation, globalCFE);
+    }
+}
+
+template < typename MeshType, typename TestSpaceType, typename ExpressionType, typename QRAdapterType>
+void
+IntegrateVectorElement < MeshType, TestSpaceType, ExpressionType, QRAdapterType>::
+accumulateBlock (const UInt nbQuadPt,
+                 const UInt nbTestDof,
+                 const UInt iblock,
+                 ETVectorElemental& elementalVector,
+                 evaluation_Type& evaluation,
+                 const ETCurrentFE<MeshType::S_geoDimensions, 1>& globalCFE)
+{
+    // Fixed size versions: P1 (4 dofs) and P2 (10 dofs) on tetrahedra
+    // with the 4, 5 and 15 points rules, Q1 (8 dofs) and Q2 (27 dofs)
+    // on hexahedra with the 8 points rule.
+    if (nbTestDof == 4)
+    {
+        switch (nbQuadPt)
+        {
+            case 4:
+                accumulateBlockFixed<4, 4> (iblock, elementalVector, evaluation, globalCFE);
+                return;
+            case 5:
+                accumulateBlockFixed<5, 4> (iblock, elementalVector, evaluation, globalCFE);
+                return;
+            case 15:
+                accumulateBlockFixed<15, 4> (iblock, elementalVector, evaluation, globalCFE);
+                return;
+        }
+    }
+    else if (nbTestDof == 10)
+    {
+        switch (nbQuadPt)
+        {
+            case 4:
+                accumulateBlockFixed<4, 10> (iblock, elementalVector, evaluation, globalCFE);
+                return;
+            case 5:
+                accumulateBlockFixed<5, 10> (iblock, elementalVector, evaluation, globalCFE);
+                return;
+            case 15:
+                accumulateBlockFixed<15, 10> (iblock, elementalVector, evaluation, globalCFE);
+                return;
+        }
+    }
+    else if (nbTestDof == 8 && nbQuadPt == 8)
+    {
+        accumulateBlockFixed<8, 8> (iblock, elementalVector, evaluation, globalCFE);
+        return;
+    }
+    else if (nbTestDof == 27 && nbQuadPt == 8)
+    {
+        accumulateBlockFixed<8, 27> (iblock, elementalVector, evaluation, globalCFE);
+        return;
+    }
+
+    // Generic version
+    for (UInt iQuadPt (0); iQuadPt < nbQuadPt; ++iQuadPt)
+    {
+        for (UInt i (0); i < nbTestDof; ++i)
+        {
+            elementalVector.element (i + iblock * nbTestDof) +=
+                evaluation.value_qi (iQuadPt, i + iblock * nbTestDof)
+                * globalCFE.wDet (iQuadPt);
+        }
+    }
+}
+
+template < typename MeshType, typename TestSpaceType, typename ExpressionType, typename QRAdapterType>
+template <UInt NbQuadPt, UInt NbTestDof>
+void
+IntegrateVectorElement < MeshType, TestSpaceType, ExpressionType, QRAdapterType>::
+accumulateBlockFixed (const UInt iblock,
+                      ETVectorElemental& elementalVector,
+                      evaluation_Type& evaluation,
+                      const ETCurrentFE<MeshType::S_geoDimensions, 1>& globalCFE)
+{
+    const UInt rowOffset (iblock * NbTestDof);
+
+    Real localBlock[NbTestDof];
+
+    for (UInt i (0); i < NbTestDof; ++i)
+    {
+        localBlock[i] = elementalVector.element (rowOffset + i);
+    }
+
+    for (UInt iQuadPt (0); iQuadPt < NbQuadPt; ++iQuadPt)
+    {
+        const Real wDet (globalCFE.wDet (iQuadPt) );
+
+        for (UInt i (0); i < NbTestDof; ++i)
+        {
+            localBlock[i] += evaluation.value_qi (iQuadPt, rowOffset + i) * wDet;
+        }
+    }
+
+    for (UInt i (0); i < NbTestDof; ++i)
+    {
+        elementalVector.element (rowOffset + i) = localBlock[i];
+    }
+}
+
 template < typename MeshType, typename TestSpaceType, typename ExpressionType, typename QRAdapterType>
 template <typename VectorType>
 void
 IntegrateVectorElement < MeshType, TestSpaceType, ExpressionType, QRAdapterType>::
 addTo (VectorType& vec)
+{
+    if (M_ompParams.numThreads > 1)
+    {
+        addToThreaded (vec);
+    }
+    else
+    {
+        addToSerial (vec);
+    }
+}
+
+template < typename MeshType, typename TestSpaceType, typename ExpressionType, typename QRAdapterType>
+template <typename VectorType>
+void
+IntegrateVectorElement < MeshType, TestSpaceType, ExpressionType, QRAdapterType>::
+addToSerial (VectorType& vec)
 {
     UInt nbElements (M_mesh->numElements() );
-    UInt nbQuadPt_std (M_qrAdapter.standardQR().nbQuadPt() );
     UInt nbTestDof (M_testSpace->refFE().nbDof() );
 
     // Defaulted to true for security
@@ -323,13 +636,9 @@ addTo (VectorType& vec)
 
     for (UInt iElement (0); iElement < nbElements; ++iElement)
     {
-        // Zeros out the elemental vector
-        M_elementalVector.zero();
-
         // Update the quadrature rule adapter
         M_qrAdapter.update (iElement);
 
-
         if (M_qrAdapter.isAdaptedElement() )
         {
             // Reset the quadrature in the different structures
@@ -341,37 +650,9 @@ addTo (VectorType& vec)
             M_evaluation.setGlobalCFE ( M_globalCFE_adapted );
             M_evaluation.setTestCFE ( M_testCFE_adapted );
 
-            // Update with the correct element
-            M_evaluation.update (iElement);
-
-            // Update the currentFEs
-            M_globalCFE_adapted->update (M_mesh->element (iElement), evaluation_Type::S_globalUpdateFlag | ET_UPDATE_WDET);
-            M_testCFE_adapted->update (M_mesh->element (iElement), evaluation_Type::S_testUpdateFlag);
-
-
-            // Assembly
-            for (UInt iblock (0); iblock < TestSpaceType::field_dim; ++iblock)
-            {
-                // Set the row global indices in the local vector
-                for (UInt i (0); i < nbTestDof; ++i)
-                {
-                    M_elementalVector.setRowIndex
-                    (i + iblock * nbTestDof,
-                     M_testSpace->dof().localToGlobalMap (iElement, i) + iblock * M_testSpace->dof().numTotalDof() );
-                }
-
-                // Make the assembly
-                for (UInt iQuadPt (0); iQuadPt < M_qrAdapter.adaptedQR().nbQuadPt(); ++iQuadPt)
-                {
-                    for (UInt i (0); i < nbTestDof; ++i)
-                    {
-                        M_elementalVector.element (i + iblock * nbTestDof) +=
-                            M_evaluation.value_qi (iQuadPt, i + iblock * nbTestDof)
-                            * M_globalCFE_adapted->wDet (iQuadPt);
-
-                    }
-                }
-            }
+            integrateElement (iElement, M_qrAdapter.adaptedQR().nbQuadPt(), nbTestDof,
+                              M_elementalVector, M_evaluation,
+                              *M_globalCFE_adapted, *M_testCFE_adapted);
 
             // Finally, set the flag
             isPreviousAdapted = true;
@@ -388,42 +669,146 @@ addTo (VectorType& vec)
                 isPreviousAdapted = false;
             }
 
+            integrateElement (iElement, M_qrAdapter.standardQR().nbQuadPt(), nbTestDof,
+                              M_elementalVector, M_evaluation,
+                              *M_globalCFE_std, *M_testCFE_std);
+        }
 
-            // Update the currentFEs
-            M_globalCFE_std->update (M_mesh->element (iElement), evaluation_Type::S_globalUpdateFlag | ET_UPDATE_WDET);
-            M_testCFE_std->update (M_mesh->element (iElement), evaluation_Type::S_testUpdateFlag);
+        M_elementalVector.pushToGlobal (vec);
+    }
+}
+
+template < typename MeshType, typename TestSpaceType, typename ExpressionType, typename QRAdapterType>
+template <typename VectorType>
+void
+IntegrateVectorElement < MeshType, TestSpaceType, ExpressionType, QRAdapterType>::
+addToThreaded (VectorType& vec)
+{
+    const UInt nbElements (M_mesh->numElements() );
+    const UInt nbTestDof (M_testSpace->refFE().nbDof() );
+    const UInt nbLocalRows (TestSpaceType::field_dim * nbTestDof);
+    const UInt chunkSize (S_elementsPerThreadChunk * M_ompParams.numThreads);
+
+    // Buffers for the elemental contributions of one chunk of elements
+    std::vector<Real> chunkValues (chunkSize * nbLocalRows);
+    std::vector<Int> chunkRows (chunkSize * nbLocalRows);
+
+    // OpenMP setup and pragmas around the loop
+    M_ompParams.apply();
+
+    #pragma omp parallel
+    {
+        QRAdapterType qrAdapter (M_qrAdapter);
 
-            // Update the evaluation
-            M_evaluation.update (iElement);
+        std::unique_ptr<ETCurrentFE<MeshType::S_geoDimensions, 1> > globalCFE_std;
+        std::unique_ptr<ETCurrentFE<MeshType::S_geoDimensions, 1> > globalCFE_adapted;
 
-            // Loop on the blocks
-            for (UInt iblock (0); iblock < TestSpaceType::field_dim; ++iblock)
+        switch (MeshType::geoShape_Type::BasRefSha::S_shape)
+        {
+            case LINE:
+                globalCFE_std.reset ( new ETCurrentFE<MeshType::S_geoDimensions, 1> (feSegP0, geometricMapFromMesh<MeshType>(), qrAdapter.standardQR() ) );
+                globalCFE_adapted.reset ( new ETCurrentFE<MeshType::S_geoDimensions, 1> (feSegP0, geometricMapFromMesh<MeshType>(), qrAdapter.standardQR() ) );
+                break;
+            case TRIANGLE:
+                globalCFE_std.reset ( new ETCurrentFE<MeshType::S_geoDimensions, 1> (feTriaP0, geometricMapFromMesh<MeshType>(), qrAdapter.standardQR() ) );
+                globalCFE_adapted.reset ( new ETCurrentFE<MeshType::S_geoDimensions, 1> (feTriaP0, geometricMapFromMesh<MeshType>(), qrAdapter.standardQR() ) );
+                break;
+            case QUAD:
+                globalCFE_std.reset ( new ETCurrentFE<MeshType::S_geoDimensions, 1> (feQuadQ0, geometricMapFromMesh<MeshType>(), qrAdapter.standardQR() ) );
+                globalCFE_adapted.reset ( new ETCurrentFE<MeshType::S_geoDimensions, 1> (feQuadQ0, geometricMapFromMesh<MeshType>(), qrAdapter.standardQR() ) );
+                break;
+            case TETRA:
+                globalCFE_std.reset ( new ETCurrentFE<MeshType::S_geoDimensions, 1> (feTetraP0, geometricMapFromMesh<MeshType>(), qrAdapter.standardQR() ) );
+                globalCFE_adapted.reset ( new ETCurrentFE<MeshType::S_geoDimensions, 1> (feTetraP0, geometricMapFromMesh<MeshType>(), qrAdapter.standardQR() ) );
+                break;
+            case HEXA:
+                globalCFE_std.reset ( new ETCurrentFE<MeshType::S_geoDimensions, 1> (feHexaQ0, geometricMapFromMesh<MeshType>(), qrAdapter.standardQR() ) );
+                globalCFE_adapted.reset ( new ETCurrentFE<MeshType::S_geoDimensions, 1> (feHexaQ0, geometricMapFromMesh<MeshType>(), qrAdapter.standardQR() ) );
+                break;
+            default:
+                ERROR_MSG ("Unrecognized element shape");
+        }
+
+        ETCurrentFE<TestSpaceType::space_dim, TestSpaceType::field_dim>
+        testCFE_std (M_testSpace->refFE(), M_testSpace->geoMap(), M_qrAdapter.standardQR() );
+
+        ETCurrentFE<TestSpaceType::space_dim, TestSpaceType::field_dim>
+        testCFE_adapted (M_testSpace->refFE(), M_testSpace->geoMap(), M_qrAdapter.standardQR() );
+
+        evaluation_Type evaluation (copyWithSharedInterpolations (M_evaluation) );
+
+        ETVectorElemental elementalVector (nbLocalRows);
+
+        // Defaulted to true for security
+        bool isPreviousAdapted (true);
+
+        for (UInt chunkBegin = 0; chunkBegin < nbElements; chunkBegin += chunkSize)
+        {
+            const UInt chunkEnd (std::min (chunkBegin + chunkSize, nbElements) );
+
+            #pragma omp for schedule(runtime)
+            for (UInt iElement = chunkBegin; iElement < chunkEnd; ++iElement)
             {
-                // Set the row global indices in the local vector
-                for (UInt i (0); i < nbTestDof; ++i)
+                // Update the quadrature rule adapter
+                qrAdapter.update (iElement);
+
+                if (qrAdapter.isAdaptedElement() )
                 {
-                    M_elementalVector.setRowIndex
-                    (i + iblock * nbTestDof,
-                     M_testSpace->dof().localToGlobalMap (iElement, i) + iblock * M_testSpace->dof().numTotalDof() + M_offset);
-                }
+                    // Reset the quadrature in the different structures
+                    evaluation.setQuadrature ( qrAdapter.adaptedQR() );
+                    globalCFE_adapted -> setQuadratureRule ( qrAdapter.adaptedQR() );
+                    testCFE_adapted.setQuadratureRule ( qrAdapter.adaptedQR() );
+
+                    // Reset the CurrentFEs in the evaluation
+                    evaluation.setGlobalCFE ( globalCFE_adapted.get() );
+                    evaluation.setTestCFE ( &testCFE_adapted );
 
-                // Make the assembly
-                for (UInt iQuadPt (0); iQuadPt < nbQuadPt_std; ++iQuadPt)
+                    integrateElement (iElement, qrAdapter.adaptedQR().nbQuadPt(), nbTestDof,
+                                      elementalVector, evaluation,
+                                      *globalCFE_adapted, testCFE_adapted);
+
+                    isPreviousAdapted = true;
+                }
+                else
                 {
-                	for (UInt i (0); i < nbTestDof; ++i)
+                    // Check if the last one was adapted
+                    if (isPreviousAdapted)
                     {
-                        M_elementalVector.element (i + iblock * nbTestDof) +=
-                            M_evaluation.value_qi (iQuadPt, i + iblock * nbTestDof)
-                            * M_globalCFE_std->wDet (iQuadPt);
+                        evaluation.setQuadrature ( qrAdapter.standardQR() );
+                        evaluation.setGlobalCFE ( globalCFE_std.get() );
+                        evaluation.setTestCFE ( &testCFE_std );
 
+                        isPreviousAdapted = false;
                     }
+
+                    integrateElement (iElement, qrAdapter.standardQR().nbQuadPt(), nbTestDof,
+                                      elementalVector, evaluation,
+                                      *globalCFE_std, testCFE_std);
+                }
+
+                // Store the contribution of the element in its slot of the buffer
+                const UInt position ( (iElement - chunkBegin) * nbLocalRows);
+                for (UInt iRow (0); iRow < nbLocalRows; ++iRow)
+                {
+                    chunkValues[position + iRow] = elementalVector[iRow];
+                    chunkRows[position + iRow] = elementalVector.rowIndices() [iRow];
                 }
             }
 
+            // Reduction in the global vector, in the same order as the serial loop
+            // (the implicit barriers make the buffers safe to reuse)
+            #pragma omp single
+            {
+                const UInt nbChunkRows ( (chunkEnd - chunkBegin) * nbLocalRows);
+                for (UInt iRow (0); iRow < nbChunkRows; ++iRow)
+                {
+                    vec.sumIntoGlobalValues ( chunkRows[iRow], chunkValues[iRow] );
+                }
+            }
         }
-
-        M_elementalVector.pushToGlobal (vec);
     }
+
+    M_ompParams.restorePreviousNumThreads();
 }
 
 
@@ -36,8 +36,14 @@
 #ifndef INTEGRATE_VECTOR_FACE_ID_HPP
 #define INTEGRATE_VECTOR_FACE_ID_HPP
 
+#if defined(_OPENMP)
+#include <omp.h>
+#endif
+
 #include <lifev/core/LifeV.hpp>
 
+#include <lifev/core/util/OpenMPParameters.hpp>
+
 #include <lifev/eta/fem/QuadratureBoundary.hpp>
 #include <lifev/eta/fem/ETCurrentFE.hpp>
 #include <lifev/eta/fem/ETCurrentBDFE.hpp>
@@ -65,6 +71,12 @@ namespace ExpressionAssembly
   perform that assembly with a loop over the elements, and then, for each elements,
   using the Evaluation corresponding to the Expression (this convertion is done
   within a typedef).
+
+  The boundary faces carrying the requested identifier are selected once, when
+  the integrator is built, and the loop runs over this cached list. When built
+  with OpenMPParameters asking for more than one thread, the elemental vectors
+  are computed by the threads and summed in the global vector in the same
+  order as the serial loop.
  */
 template < typename MeshType, typename TestSpaceType, typename ExpressionType>
 class IntegrateVectorFaceID
@@ -93,6 +105,14 @@ public:
                            const std::shared_ptr<TestSpaceType>& testSpace,
                            const ExpressionType& expression);
 
+    //! Full data constructor (multi-threaded assembly)
+    IntegrateVectorFaceID (const std::shared_ptr<MeshType>& mesh,
+                           const UInt boundaryID,
+                           const QuadratureBoundary& quadratureBD,
+                           const std::shared_ptr<TestSpaceType>& testSpace,
+                           const ExpressionType& expression,
+                           const OpenMPParameters& ompParams);
+
     //! Copy constructor
     IntegrateVectorFaceID ( const IntegrateVectorFaceID < MeshType, TestSpaceType, ExpressionType>& integrator);
 
@@ -149,14 +169,51 @@ private:
     // No default constructor
     IntegrateVectorFaceID();
 
+    //! Select the boundary faces carrying the identifier
+    void cacheBoundaryFaces();
+
+    //! Build the CurrentFEs for the four faces of the reference tetrahedron
+    void createCurrentFEs (std::vector<ETCurrentBDFE<3>*>& globalCFE,
+                           std::vector<ETCurrentFE<3, TestSpaceType::field_dim>*>& testCFE) const;
+
+    //! Free the CurrentFEs built with createCurrentFEs
+    void deleteCurrentFEs (std::vector<ETCurrentBDFE<3>*>& globalCFE,
+                           std::vector<ETCurrentFE<3, TestSpaceType::field_dim>*>& testCFE) const;
+
+    //! Perform the computations for a single boundary face
+    /*!
+     * This method computes the elemental vector for a given boundary
+     * face index
+     */
+    void integrateFace (const UInt iFace,
+                        ETVectorElemental& elementalVector,
+                        evaluation_Type& evaluation,
+                        std::vector<ETCurrentBDFE<3>*>& globalCFE,
+                        std::vector<ETCurrentFE<3, TestSpaceType::field_dim>*>& testCFE);
+
+    //! Multi-threaded loop over the boundary faces
+    /*!
+     * The faces are processed by chunks: the elemental vectors of a chunk
+     * are computed by the threads and stored, then a single thread sums them
+     * in the global vector, face by face.
+     */
+    template <typename VectorType>
+    void addToThreaded (VectorType& vec);
+
     //@}
 
+    // Number of faces buffered per thread in the multi-threaded assembly
+    static const UInt S_facesPerThreadChunk = 256;
+
     // Pointer on the mesh
     std::shared_ptr<MeshType> M_mesh;
 
     // Identifier for the boundary
     UInt M_boundaryId;
 
+    // Boundary faces carrying the identifier
+    std::vector<UInt> M_boundaryFaces;
+
     // Quadrature to be used
     QuadratureBoundary M_quadratureBoundary;
 
@@ -170,6 +227,9 @@ private:
     std::vector<ETCurrentFE<3, TestSpaceType::field_dim>*> M_testCFE;
 
     ETVectorElemental M_elementalVector;
+
+    // Data for multi-threaded assembly
+    OpenMPParameters M_ompParams;
 };
 
 
@@ -190,6 +250,7 @@ IntegrateVectorFaceID (const std::shared_ptr<MeshType>& mesh,
                        const ExpressionType& expression)
     :   M_mesh (mesh),
         M_boundaryId (boundaryID),
+        M_boundaryFaces(),
         M_quadratureBoundary (quadratureBD),
         M_testSpace (testSpace),
         M_evaluation (expression),
@@ -197,55 +258,45 @@ IntegrateVectorFaceID (const std::shared_ptr<MeshType>& mesh,
         M_globalCFE (4),
         M_testCFE (4),
 
-        M_elementalVector (TestSpaceType::field_dim * testSpace->refFE().nbDof() )
+        M_elementalVector (TestSpaceType::field_dim * testSpace->refFE().nbDof() ),
+
+        M_ompParams()
 {
-    for (UInt i (0); i < 4; ++i)
-    {
-        M_globalCFE[i] = new ETCurrentBDFE<3> (geometricMapFromMesh<MeshType>()
-                                               , M_quadratureBoundary.qr (i) );
-        M_testCFE[i] = new ETCurrentFE<3, TestSpaceType::field_dim> (testSpace->refFE()
-                                                                     , testSpace->geoMap()
-                                                                     , M_quadratureBoundary.qr (i) );
-    }
+    cacheBoundaryFaces();
 
-    // Set the tangent on the different faces
-    std::vector< VectorSmall<3> > t0 (2, VectorSmall<3> (0.0, 0.0, 0.0) );
-    t0[0][0] = 1;
-    t0[0][1] = 0;
-    t0[0][2] = 0;
-    t0[1][0] = 0;
-    t0[1][1] = 1;
-    t0[1][2] = 0;
-    std::vector< VectorSmall<3> > t1 (2, VectorSmall<3> (0.0, 0.0, 0.0) );
-    t1[0][0] = 0;
-    t1[0][1] = 0;
-    t1[0][2] = 1;
-    t1[1][0] = 1;
-    t1[1][1] = 0;
-    t1[1][2] = 0;
-    std::vector< VectorSmall<3> > t2 (2, VectorSmall<3> (0.0, 0.0, 0.0) );
-    //t2[0][0]=-1/std::sqrt(6);    t2[0][1]=-1/std::sqrt(6);    t2[0][2]=2/std::sqrt(6);
-    //t2[1][0]=-1/std::sqrt(2);    t2[1][1]=1/std::sqrt(2);    t2[1][2]=0;
-    t2[0][0] = -1;
-    t2[0][1] = 0;
-    t2[0][2] = 1;
-    t2[1][0] = -1;
-    t2[1][1] = 1;
-    t2[1][2] = 0;
+    createCurrentFEs (M_globalCFE, M_testCFE);
 
-    std::vector< VectorSmall<3> > t3 (2, VectorSmall<3> (0.0, 0.0, 0.0) );
-    t3[0][0] = 0;
-    t3[0][1] = 1;
-    t3[0][2] = 0;
-    t3[1][0] = 0;
-    t3[1][1] = 0;
-    t3[1][2] = 1;
+    M_evaluation.setQuadrature (M_quadratureBoundary.qr (0) );
+    M_evaluation.setGlobalCFE (M_globalCFE[0]);
+    M_evaluation.setTestCFE (M_testCFE[0]);
+}
 
-    M_globalCFE[0]->setRefTangents (t0);
-    M_globalCFE[1]->setRefTangents (t1);
-    M_globalCFE[2]->setRefTangents (t2);
-    M_globalCFE[3]->setRefTangents (t3);
 
+template < typename MeshType, typename TestSpaceType, typename ExpressionType>
+IntegrateVectorFaceID < MeshType, TestSpaceType, ExpressionType>::
+IntegrateVectorFaceID (const std::shared_ptr<MeshType>& mesh,
+                       const UInt boundaryID,
+                       const QuadratureBoundary& quadratureBD,
+                       const std::shared_ptr<TestSpaceType>& testSpace,
+                       const ExpressionType& expression,
+                       const OpenMPParameters& ompParams)
+    :   M_mesh (mesh),
+        M_boundaryId (boundaryID),
+        M_boundaryFaces(),
+        M_quadratureBoundary (quadratureBD),
+        M_testSpace (testSpace),
+        M_evaluation (expression),
+
+        M_globalCFE (4),
+        M_testCFE (4),
+
+        M_elementalVector (TestSpaceType::field_dim * testSpace->refFE().nbDof() ),
+
+        M_ompParams (ompParams)
+{
+    cacheBoundaryFaces();
+
+    createCurrentFEs (M_globalCFE, M_testCFE);
 
     M_evaluation.setQuadrature (M_quadratureBoundary.qr (0) );
     M_evaluation.setGlobalCFE (M_globalCFE[0]);
@@ -258,6 +309,7 @@ IntegrateVectorFaceID < MeshType, TestSpaceType, ExpressionType>::
 IntegrateVectorFaceID ( const IntegrateVectorFaceID < MeshType, TestSpaceType, ExpressionType>& integrator)
     :   M_mesh (integrator.M_mesh),
         M_boundaryId (integrator.M_boundaryId),
+        M_boundaryFaces (integrator.M_boundaryFaces),
         M_quadratureBoundary (integrator.M_quadratureBoundary),
         M_testSpace (integrator.M_testSpace),
         M_evaluation (integrator.M_evaluation),
@@ -265,15 +317,101 @@ IntegrateVectorFaceID ( const IntegrateVectorFaceID < MeshType, TestSpaceType, E
         M_globalCFE (4),
         M_testCFE (4),
 
-        M_elementalVector (integrator.M_elementalVector)
+        M_elementalVector (integrator.M_elementalVector),
+
+        M_ompParams (integrator.M_ompParams)
+{
+    createCurrentFEs (M_globalCFE, M_testCFE);
+
+    M_evaluation.setQuadrature (M_quadratureBoundary.qr (0) );
+    M_evaluation.setGlobalCFE (M_globalCFE[0]);
+    M_evaluation.setTestCFE (M_testCFE[0]);
+}
+
+
+template < typename MeshType, typename TestSpaceType, typename ExpressionType>
+IntegrateVectorFaceID < MeshType, TestSpaceType, ExpressionType>::
+~IntegrateVectorFaceID()
+{
+    deleteCurrentFEs (M_globalCFE, M_testCFE);
+}
+
+// ===================================================
+// Methods
+// ===================================================
+
+template < typename MeshType, typename TestSpaceType, typename ExpressionType>
+void
+IntegrateVectorFaceID < MeshType, TestSpaceType, ExpressionType>::
+check (std::ostream& out)
+{
+    out << " Checking the integration : " << std::endl;
+    M_evaluation.display (out);
+    out << std::endl;
+    out << " Elemental vector : " << std::endl;
+    M_elementalVector.showMe (out);
+    out << std::endl;
+}
+
+template < typename MeshType, typename TestSpaceType, typename ExpressionType>
+template <typename VectorType>
+void
+IntegrateVectorFaceID < MeshType, TestSpaceType, ExpressionType>::
+addTo (VectorType& vec)
+{
+    if (M_ompParams.numThreads > 1)
+    {
+        addToThreaded (vec);
+        return;
+    }
+
+    const UInt nbFaces (M_boundaryFaces.size() );
+
+    for (UInt iFace (0); iFace < nbFaces; ++iFace)
+    {
+        integrateFace (M_boundaryFaces[iFace], M_elementalVector, M_evaluation,
+                       M_globalCFE, M_testCFE);
+
+        M_elementalVector.pushToGlobal (vec);
+    }
+}
+
+// ===================================================
+// Private Methods
+// ===================================================
+
+template < typename MeshType, typename TestSpaceType, typename ExpressionType>
+void
+IntegrateVectorFaceID < MeshType, TestSpaceType, ExpressionType>::
+cacheBoundaryFaces()
+{
+    const UInt nbBoundaryFaces (M_mesh->numBFaces() );
+
+    M_boundaryFaces.clear();
+
+    for (UInt iFace (0); iFace < nbBoundaryFaces; ++iFace)
+    {
+        // Check the identifier
+        if ( M_mesh->face (iFace).markerID() == M_boundaryId )
+        {
+            M_boundaryFaces.push_back (iFace);
+        }
+    }
+}
+
+template < typename MeshType, typename TestSpaceType, typename ExpressionType>
+void
+IntegrateVectorFaceID < MeshType, TestSpaceType, ExpressionType>::
+createCurrentFEs (std::vector<ETCurrentBDFE<3>*>& globalCFE,
+                  std::vector<ETCurrentFE<3, TestSpaceType::field_dim>*>& testCFE) const
 {
     for (UInt i (0); i < 4; ++i)
     {
-        M_globalCFE[i] = new ETCurrentBDFE<3> (geometricMapFromMesh<MeshType>()
-                                               , M_quadratureBoundary.qr (i) );
-        M_testCFE[i] = new ETCurrentFE<3, TestSpaceType::field_dim> (M_testSpace->refFE()
-                                                                     , M_testSpace->geoMap()
-                                                                     , M_quadratureBoundary.qr (i) );
+        globalCFE[i] = new ETCurrentBDFE<3> (geometricMapFromMesh<MeshType>()
+                                             , M_quadratureBoundary.qr (i) );
+        testCFE[i] = new ETCurrentFE<3, TestSpaceType::field_dim> (M_testSpace->refFE()
+                                                                   , M_testSpace->geoMap()
+                                                                   , M_quadratureBoundary.qr (i) );
     }
 
     // Set the tangent on the different faces
@@ -309,117 +447,133 @@ IntegrateVectorFaceID ( const IntegrateVectorFaceID < MeshType, TestSpaceType, E
     t3[1][1] = 0;
     t3[1][2] = 1;
 
-    M_globalCFE[0]->setRefTangents (t0);
-    M_globalCFE[1]->setRefTangents (t1);
-    M_globalCFE[2]->setRefTangents (t2);
-    M_globalCFE[3]->setRefTangents (t3);
-
-
-    M_evaluation.setQuadrature (M_quadratureBoundary.qr (0) );
-    M_evaluation.setGlobalCFE (M_globalCFE[0]);
-    M_evaluation.setTestCFE (M_testCFE[0]);
+    globalCFE[0]->setRefTangents (t0);
+    globalCFE[1]->setRefTangents (t1);
+    globalCFE[2]->setRefTangents (t2);
+    globalCFE[3]->setRefTangents (t3);
 }
 
-
 template < typename MeshType, typename TestSpaceType, typename ExpressionType>
+void
 IntegrateVectorFaceID < MeshType, TestSpaceType, ExpressionType>::
-~IntegrateVectorFaceID()
+deleteCurrentFEs (std::vector<ETCurrentBDFE<3>*>& globalCFE,
+                  std::vector<ETCurrentFE<3, TestSpaceType::field_dim>*>& testCFE) const
 {
     for (UInt i (0); i < 4; ++i)
     {
-        delete M_globalCFE[i];
-        delete M_testCFE[i];
+        delete globalCFE[i];
+        delete testCFE[i];
     }
 }
 
-// ===================================================
-// Methods
-// ===================================================
-
 template < typename MeshType, typename TestSpaceType, typename ExpressionType>
 void
 IntegrateVectorFaceID < MeshType, TestSpaceType, ExpressionType>::
-check (std::ostream& out)
+integrateFace (const UInt iFace,
+               ETVectorElemental& elementalVector,
+               evaluation_Type& evaluation,
+               std::vector<ETCurrentBDFE<3>*>& globalCFE,
+               std::vector<ETCurrentFE<3, TestSpaceType::field_dim>*>& testCFE)
 {
-    out << " Checking the integration : " << std::endl;
-    M_evaluation.display (out);
-    out << std::endl;
-    out << " Elemental vector : " << std::endl;
-    M_elementalVector.showMe (out);
-    out << std::endl;
-}
+    const UInt nbTestDof (M_testSpace->refFE().nbDof() );
 
-template < typename MeshType, typename TestSpaceType, typename ExpressionType>
-template <typename VectorType>
-void
-IntegrateVectorFaceID < MeshType, TestSpaceType, ExpressionType>::
-addTo (VectorType& vec)
-{
-    UInt nbBoundaryFaces (M_mesh->numBFaces() );
-    UInt nbTestDof (M_testSpace->refFE().nbDof() );
+    // Zeros out the elemental vector
+    elementalVector.zero();
 
-    /*CurrentBoundaryFE origFE(M_testSpace->refFE().boundaryFE(),
-                             M_testSpace->geoMap().boundaryMap(),
-                             quadRuleTria3pt);*/
+    // Get the number of the face in the adjacent element
+    UInt faceIDinAdjacentElement (M_mesh->face (iFace).firstAdjacentElementPosition() );
 
-    for (UInt iFace (0); iFace < nbBoundaryFaces; ++iFace)
+    // Get the ID of the adjacent element
+    UInt adjacentElementID (M_mesh->face (iFace).firstAdjacentElementIdentity() );
+
+    // Update the currentFEs
+    globalCFE[faceIDinAdjacentElement]
+    ->update (M_mesh->element (adjacentElementID) );
+    testCFE[faceIDinAdjacentElement]
+    ->update (M_mesh->element (adjacentElementID), evaluation_Type::S_testUpdateFlag);
+
+    // Update the evaluation
+    evaluation.setQuadrature (M_quadratureBoundary.qr (faceIDinAdjacentElement) );
+    evaluation.setGlobalCFE (globalCFE[faceIDinAdjacentElement]);
+    evaluation.setTestCFE (testCFE[faceIDinAdjacentElement]);
+
+    evaluation.update (adjacentElementID);
+
+    // Loop on the blocks
+    for (UInt iblock (0); iblock < TestSpaceType::field_dim; ++iblock)
     {
-        // Check the identifier
-        if ( M_mesh->face (iFace).markerID() != M_boundaryId )
+        // Set the row global indices in the local vector
+        for (UInt i (0); i < nbTestDof; ++i)
         {
-            continue;
+            elementalVector.setRowIndex
+            (i + iblock * nbTestDof,
+             M_testSpace->dof().localToGlobalMap (adjacentElementID, i) + iblock * M_testSpace->dof().numTotalDof() );
         }
 
-        //origFE.updateMeasNormalQuadPt(M_mesh->face(iFace));
+        // Make the assembly
+        for (UInt iQuadPt (0); iQuadPt < M_quadratureBoundary.qr (faceIDinAdjacentElement).nbQuadPt(); ++iQuadPt)
+        {
+            for (UInt i (0); i < nbTestDof; ++i)
+            {
+                elementalVector.element (i + iblock * nbTestDof) +=
+                    evaluation.value_qi (iQuadPt, i + iblock * nbTestDof)
+                    * globalCFE[faceIDinAdjacentElement]->M_wMeas[iQuadPt];
+
+            }
+        }
+    }
+}
 
-        // Zeros out the elemental vector
-        M_elementalVector.zero();
+template < typename MeshType, typename TestSpaceType, typename ExpressionType>
+template <typename VectorType>
+void
+IntegrateVectorFaceID < MeshType, TestSpaceType, ExpressionType>::
+addToThreaded (VectorType& vec)
+{
+    const UInt nbFaces (M_boundaryFaces.size() );
+    const UInt chunkSize (S_facesPerThreadChunk * M_ompParams.numThreads);
 
-        // Get the number of the face in the adjacent element
-        UInt faceIDinAdjacentElement (M_mesh->face (iFace).firstAdjacentElementPosition() );
+    // Elemental vectors of one chunk of faces
+    std::vector<ETVectorElemental> chunkVectors (chunkSize, M_elementalVector);
 
-        // Get the ID of the adjacent element
-        UInt adjacentElementID (M_mesh->face (iFace).firstAdjacentElementIdentity() );
+    // OpenMP setup and pragmas around the loop
+    M_ompParams.apply();
 
-        // Update the currentFEs
-        M_globalCFE[faceIDinAdjacentElement]
-        ->update (M_mesh->element (adjacentElementID) );
-        M_testCFE[faceIDinAdjacentElement]
-        ->update (M_mesh->element (adjacentElementID), evaluation_Type::S_testUpdateFlag);
+    #pragma omp parallel
+    {
+        std::vector<ETCurrentBDFE<3>*> globalCFE (4);
+        std::vector<ETCurrentFE<3, TestSpaceType::field_dim>*> testCFE (4);
 
-        // Update the evaluation
-        M_evaluation.setQuadrature (M_quadratureBoundary.qr (faceIDinAdjacentElement) );
-        M_evaluation.setGlobalCFE (M_globalCFE[faceIDinAdjacentElement]);
-        M_evaluation.setTestCFE (M_testCFE[faceIDinAdjacentElement]);
+        createCurrentFEs (globalCFE, testCFE);
 
-        M_evaluation.update (adjacentElementID);
+        evaluation_Type evaluation (M_evaluation);
 
-        // Loop on the blocks
-        for (UInt iblock (0); iblock < TestSpaceType::field_dim; ++iblock)
+        for (UInt chunkBegin = 0; chunkBegin < nbFaces; chunkBegin += chunkSize)
         {
-            // Set the row global indices in the local vector
-            for (UInt i (0); i < nbTestDof; ++i)
+            const UInt chunkEnd (std::min (chunkBegin + chunkSize, nbFaces) );
+
+            #pragma omp for schedule(runtime)
+            for (UInt iFace = chunkBegin; iFace < chunkEnd; ++iFace)
             {
-                M_elementalVector.setRowIndex
-                (i + iblock * nbTestDof,
-                 M_testSpace->dof().localToGlobalMap (adjacentElementID, i) + iblock * M_testSpace->dof().numTotalDof() );
+                integrateFace (M_boundaryFaces[iFace], chunkVectors[iFace - chunkBegin], evaluation,
+                               globalCFE, testCFE);
             }
 
-            // Make the assembly
-            for (UInt iQuadPt (0); iQuadPt < M_quadratureBoundary.qr (faceIDinAdjacentElement).nbQuadPt(); ++iQuadPt)
+            // Reduction in the global vector, in the same order as the serial loop
+            // (the implicit barriers make the buffers safe to reuse)
+            #pragma omp single
             {
-                for (UInt i (0); i < nbTestDof; ++i)
+                for (UInt iFace = chunkBegin; iFace < chunkEnd; ++iFace)
                 {
-                    M_elementalVector.element (i + iblock * nbTestDof) +=
-                        M_evaluation.value_qi (iQuadPt, i + iblock * nbTestDof)
-                        * M_globalCFE[faceIDinAdjacentElement]->M_wMeas[iQuadPt];
-
+                    chunkVectors[iFace - chunkBegin].pushToGlobal (vec);
                 }
             }
         }
 
-        M_elementalVector.pushToGlobal (vec);
+        deleteCurrentFEs (globalCFE, testCFE);
     }
+
+    M_ompParams.restorePreviousNumThreads();
 }
 
 
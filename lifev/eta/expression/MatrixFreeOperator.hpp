@@ -0,0 +1,280 @@
+//@HEADER
+/*
+*******************************************************************************
+
+   Copyright (C) 2004, 2005, 2007 EPFL, Politecnico di Milano, INRIA
+   Copyright (C) 2010 EPFL, Politecnico di Milano, Emory UNiversity
+
+   This file is part of the LifeV library
+
+   LifeV is free software; you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+
+   LifeV is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with this library; if not, see <http://www.gnu.org/licenses/>
+
+
+*******************************************************************************
+*/
+//@HEADER
+
+/*!
+ *   @file
+     @brief This file contains the definition of the MatrixFreeOperator class.
+ */
+
+#ifndef MATRIX_FREE_OPERATOR_HPP
+#define MATRIX_FREE_OPERATOR_HPP
+
+#include <memory>
+#include <string>
+
+#include <lifev/core/LifeV.hpp>
+
+#include <lifev/core/array/MapEpetra.hpp>
+#include <lifev/core/array/VectorEpetra.hpp>
+#include <lifev/core/linear_algebra/LinearOperatorAlgebra.hpp>
+
+namespace LifeV
+{
+
+namespace ExpressionAssembly
+{
+
+//! class MatrixFreeOperator  Operator applying an ETA bilinear form without assembling its matrix
+/*!
+    This class wraps an integrator of a bilinear form (as returned by the
+    integrate function for a matricial expression, e.g. IntegrateMatrixElement)
+    in an Epetra_Operator. The Apply method computes the elemental matrices on
+    the fly, multiplies them by the local values of the input vector and sums
+    the results in the output vector: the global matrix is never stored.
+
+    The operator can be passed to the solvers in place of a matrix (e.g.
+    LinearSolver::setOperator). As no matrix is available, the preconditioner
+    has to be built from another source (e.g. a low order matrix), and the
+    transpose and the inverse are not supported.
+
+    Typical usage:
+
+    \code
+    std::shared_ptr<Epetra_Operator> laplacian =
+        matrixFree (integrate (elements (mesh), quadRuleTetra15pt, uSpace, uSpace,
+                               dot (grad (phi_i), grad (phi_j) ) ) );
+    solver.setOperator (laplacian);
+    \endcode
+
+    <b>Template parameters</b>
+
+    <i>IntegratorType</i>: The type of the integrator of the bilinear form
+
+    <b>Template requirements</b>
+
+    <i>IntegratorType</i>: copy constructor; testSpace() and solutionSpace()
+    getters; a multiply(x, y) method summing the product with x in y.
+*/
+template <typename IntegratorType>
+class MatrixFreeOperator : public Operators::LinearOperatorAlgebra
+{
+public:
+
+    //! @name Public Types
+    //@{
+
+    typedef Operators::LinearOperatorAlgebra super;
+    typedef super::comm_Type comm_Type;
+    typedef super::map_Type map_Type;
+    typedef super::vector_Type vector_Type;
+
+    typedef IntegratorType integrator_Type;
+
+    //@}
+
+
+    //! @name Constructors, destructor
+    //@{
+
+    //! Constructor with the integrator of the bilinear form
+    /*!
+      @param integrator The integrator (a copy is stored)
+     */
+    explicit MatrixFreeOperator (const integrator_Type& integrator)
+        :
+        M_integrator (new integrator_Type (integrator) ),
+        M_name ("MatrixFreeOperator"),
+        M_useTranspose (false)
+    {}
+
+    //! Destructor
+    virtual ~MatrixFreeOperator() {}
+
+    //@}
+
+
+    //! @name Methods
+    //@{
+
+    //! Transposition is not supported (returns -1 when asked)
+    int SetUseTranspose (bool useTranspose)
+    {
+        if (useTranspose)
+        {
+            return -1;
+        }
+        M_useTranspose = false;
+        return 0;
+    }
+
+    //! Apply the operator: Y = A X
+    /*!
+      For each column of X, the values are gathered on the repeated map of the
+      solution space, the elemental products are summed on the repeated map of
+      the test space and the result is assembled on the unique map.
+      X and Y can be the same object.
+     */
+    int Apply (const vector_Type& X, vector_Type& Y) const;
+
+    //! The inverse is not available (returns -1)
+    int ApplyInverse (const vector_Type& /*X*/, vector_Type& /*Y*/) const
+    {
+        return -1;
+    }
+
+    //! The infinity norm is not available without the matrix (returns -1)
+    double NormInf() const
+    {
+        return -1.0;
+    }
+
+    //@}
+
+
+    //! @name Get Methods
+    //@{
+
+    //! Name of the operator
+    const char* Label() const
+    {
+        return M_name.c_str();
+    }
+
+    //! Always false
+    bool UseTranspose() const
+    {
+        return M_useTranspose;
+    }
+
+    //! Always false
+    bool HasNormInf() const
+    {
+        return false;
+    }
+
+    //! Communicator of the maps
+    const comm_Type& Comm() const
+    {
+        return OperatorRangeMap().Comm();
+    }
+
+    //! Domain map: unique map of the solution space
+    const map_Type& OperatorDomainMap() const
+    {
+        return *M_integrator->solutionSpace()->map().map (Unique);
+    }
+
+    //! Range map: unique map of the test space
+    const map_Type& OperatorRangeMap() const
+    {
+        return *M_integrator->testSpace()->map().map (Unique);
+    }
+
+    //! Getter for the integrator
+    const std::shared_ptr<integrator_Type>& integrator() const
+    {
+        return M_integrator;
+    }
+
+    //@}
+
+private:
+
+    //! @name Private Methods
+    //@{
+
+    //! No empty constructor
+    MatrixFreeOperator();
+
+    //@}
+
+    // Integrator of the bilinear form (shared_ptr as Apply is const)
+    std::shared_ptr<integrator_Type> M_integrator;
+
+    // Name of the operator
+    std::string M_name;
+
+    // Use of the transpose (not supported)
+    bool M_useTranspose;
+};
+
+
+// ===================================================
+// IMPLEMENTATION
+// ===================================================
+
+template <typename IntegratorType>
+int
+MatrixFreeOperator<IntegratorType>::
+Apply (const vector_Type& X, vector_Type& Y) const
+{
+    ASSERT (X.NumVectors() == Y.NumVectors(), "Different number of vectors in X and Y");
+    ASSERT (X.Map().SameAs (OperatorDomainMap() ), "X is not defined on the domain map");
+    ASSERT (Y.Map().SameAs (OperatorRangeMap() ), "Y is not defined on the range map");
+
+    const MapEpetra& domainMap (M_integrator->solutionSpace()->map() );
+    const MapEpetra& rangeMap (M_integrator->testSpace()->map() );
+
+    for (Int iVector (0); iVector < X.NumVectors(); ++iVector)
+    {
+        // Gather the values of the elements of this processor
+        VectorEpetra xUnique (domainMap, Unique);
+        xUnique.epetraVector().Update (1.0, *X (iVector), 0.0);
+        VectorEpetra xRepeated (xUnique, Repeated);
+
+        // Sum the elemental products
+        VectorEpetra yRepeated (rangeMap, Repeated);
+        yRepeated *= 0.0;
+
+        M_integrator->multiply (xRepeated, yRepeated);
+
+        // Sum the contributions of the different processors
+        VectorEpetra yUnique (yRepeated, Unique);
+        Y (iVector)->Update (1.0, yUnique.epetraVector(), 0.0);
+    }
+
+    return 0;
+}
+
+
+//! Build a matrix-free operator from the integrator of a bilinear form
+/*!
+  @param integrator The integrator, as returned by the integrate function
+  @return A pointer on the operator, usable as an Epetra_Operator
+ */
+template <typename IntegratorType>
+std::shared_ptr<MatrixFreeOperator<IntegratorType> >
+matrixFree (const IntegratorType& integrator)
+{
+    return std::shared_ptr<MatrixFreeOperator<IntegratorType> > (new MatrixFreeOperator<IntegratorType> (integrator) );
+}
+
+} // Namespace ExpressionAssembly
+
+} // Namespace LifeV
+
+#endif
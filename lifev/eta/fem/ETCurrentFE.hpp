@@ -44,6 +44,10 @@
 
 #include <lifev/eta/fem/ETCurrentFlag.hpp>
 
+#include <lifev/eta/array/ETQuadratureTable.hpp>
+
+#include <lifev/eta/fem/ETGeometryCache.hpp>
+
 #include <lifev/core/fem/GeometricMap.hpp>
 
 #include <lifev/core/fem/ReferenceFEScalar.hpp>
@@ -53,6 +57,8 @@
 #include <lifev/core/fem/QuadratureRule.hpp>
 
 
+#include <array>
+#include <memory>
 #include <vector>
 
 namespace LifeV
@@ -287,6 +293,19 @@ public:
      */
     void setQuadratureRule (const QuadratureRule& qr);
 
+    //! Setter for the geometric cache
+    /*!
+      When a cache is set, the geometric quantities (jacobian, its determinant
+      and inverse, weighted determinant) are computed only the first time an
+      element is updated, and copied from the cache for the next updates.
+      The cache is used only if it is compatible with the quadrature rule and
+      the geometric map of this element (this is checked again when the
+      quadrature rule changes). An empty pointer detaches the cache.
+
+      @param cache The cache to use (or an empty pointer)
+     */
+    void setGeometryCache (const std::shared_ptr<ETGeometryCache>& cache);
+
     //@}
 
 
@@ -466,11 +485,14 @@ private:
     //Private typedefs for the 1D array of vector
     typedef std::vector< VectorSmall<spaceDim> > array1D_vector_Type;
 
-    //Private typedefs for the 2D array of vector
-    typedef std::vector< std::vector< VectorSmall<spaceDim> > > array2D_vector_Type;
-    
+    //Private typedefs for the (contiguous) table of the values of the basis functions
+    typedef ETQuadratureTable< Real > table_Type;
+
+    //Private typedefs for the (contiguous) table of the derivatives of the basis functions
+    typedef ETQuadratureTable< VectorSmall<spaceDim> > table_vector_Type;
+
     //To contain the second derivatives
-    typedef std::vector< std::vector< MatrixSmall<spaceDim,spaceDim> > > array2D_matrix_Type;
+    typedef ETQuadratureTable< MatrixSmall<spaceDim, spaceDim> > table_matrix_Type;
 
     //! @name Private Methods
     //@{
@@ -531,6 +553,9 @@ private:
     //! Update Laplacian
     void updateLaplacian (const UInt& iQuadPt);
 
+    //! Update the geometric quantities using the geometric cache
+    void updateGeometryFromCache (const flag_Type& flag);
+
     //@}
 
 
@@ -565,7 +590,7 @@ private:
     Real M_measure;
 
     // Storage for the values of the basis functions
-    array2D_Type M_phi;
+    table_Type M_phi;
 
     // Storage for the values of the geometric map
     array2D_Type M_phiMap;
@@ -598,13 +623,13 @@ private:
     array3D_Type M_tInverseJacobian;
 
     // Storage for the derivative of the basis functions
-    array2D_vector_Type M_dphi;
+    table_vector_Type M_dphi;
 
     // Storage for the second derivative of the basis functions
-    array2D_matrix_Type M_d2phi;
+    table_matrix_Type M_d2phi;
 
     // Storage for the laplacian
-    array2D_Type M_laplacian;
+    table_Type M_laplacian;
 
     // Storage metric tensor (works only for 3D)
     MatrixSmall<3,3> M_metricTensor;
@@ -612,6 +637,12 @@ private:
     // Storage metric vector (works only for 3D)
     VectorSmall<3> M_metricVector;
 
+    // Cache for the geometric quantities (shared with the FE space)
+    std::shared_ptr<ETGeometryCache> M_geometryCache;
+
+    // Is the cache compatible with the current quadrature rule
+    bool M_useGeometryCache;
+
 #ifdef HAVE_LIFEV_DEBUG
     // Debug informations, defined only if the code
     // is compiled in debug mode. These booleans store the
@@ -688,7 +719,10 @@ ETCurrentFE (const ReferenceFE& refFE, const GeometricMap& geoMap, const Quadrat
     M_tInverseJacobian(),
     M_dphi(),
 
-    M_d2phi()
+    M_d2phi(),
+
+    M_geometryCache(),
+    M_useGeometryCache (false)
 
 #ifdef HAVE_LIFEV_DEBUG
     , M_isCellNodeUpdated (false),
@@ -746,7 +780,10 @@ ETCurrentFE (const ReferenceFE& refFE, const GeometricMap& geoMap)
     M_tInverseJacobian(),
     M_dphi(),
 
-    M_d2phi()
+    M_d2phi(),
+
+    M_geometryCache(),
+    M_useGeometryCache (false)
 
 #ifdef HAVE_LIFEV_DEBUG
     , M_isCellNodeUpdated (false),
@@ -802,7 +839,10 @@ ETCurrentFE (const ETCurrentFE<spaceDim, 1>& otherFE)
     M_tInverseJacobian (otherFE.M_tInverseJacobian),
     M_dphi (otherFE.M_dphi),
 
-    M_d2phi (otherFE.M_d2phi)
+    M_d2phi (otherFE.M_d2phi),
+
+    M_geometryCache (otherFE.M_geometryCache),
+    M_useGeometryCache (otherFE.M_useGeometryCache)
 
 #ifdef HAVE_LIFEV_DEBUG
     //Beware for the comma at the begining of this line!
@@ -880,6 +920,21 @@ update (const elementType& element, const flag_Type& flag)
     	updateMetric();
     }
 
+    // The geometric quantities are taken from the cache if possible
+    // (the cache is indexed by the local identifier, so the cell
+    // has to be updated)
+    const flag_Type geometryFlag (ET_UPDATE_ONLY_JACOBIAN
+                                  | ET_UPDATE_ONLY_DET_JACOBIAN
+                                  | ET_UPDATE_ONLY_T_INVERSE_JACOBIAN
+                                  | ET_UPDATE_ONLY_W_DET_JACOBIAN);
+    flag_Type quadratureFlag (flag);
+
+    if ( M_useGeometryCache && (flag & ET_UPDATE_ONLY_CELL_NODE) && (flag & geometryFlag) )
+    {
+        updateGeometryFromCache (flag);
+        quadratureFlag &= ~geometryFlag;
+    }
+
     // Loop over the quadrature nodes
     for (UInt i (0); i < M_nbQuadPt; ++i)
     {
@@ -888,19 +943,19 @@ update (const elementType& element, const flag_Type& flag)
         {
             updateQuadNode (i);
         }
-        if ( flag & ET_UPDATE_ONLY_JACOBIAN )
+        if ( quadratureFlag & ET_UPDATE_ONLY_JACOBIAN )
         {
             updateJacobian (i);
         }
-        if ( flag & ET_UPDATE_ONLY_DET_JACOBIAN )
+        if ( quadratureFlag & ET_UPDATE_ONLY_DET_JACOBIAN )
         {
             updateDetJacobian (i);
         }
-        if ( flag & ET_UPDATE_ONLY_T_INVERSE_JACOBIAN )
+        if ( quadratureFlag & ET_UPDATE_ONLY_T_INVERSE_JACOBIAN )
         {
             updateInverseJacobian (i);
         }
-        if ( flag & ET_UPDATE_ONLY_W_DET_JACOBIAN )
+        if ( quadratureFlag & ET_UPDATE_ONLY_W_DET_JACOBIAN )
         {
             updateWDet (i);
         }
@@ -1040,6 +1095,20 @@ setQuadratureRule (const QuadratureRule& qr)
     M_quadratureRule = new QuadratureRule (qr);
     M_nbQuadPt = qr.nbQuadPt();
     setupInternalConstants();
+
+    M_useGeometryCache = ( M_geometryCache
+                           && M_geometryCache->isCompatible (spaceDim, *M_quadratureRule, *M_geometricMap) );
+}
+
+template< UInt spaceDim>
+void
+ETCurrentFE<spaceDim, 1>::
+setGeometryCache (const std::shared_ptr<ETGeometryCache>& cache)
+{
+    M_geometryCache = cache;
+    M_useGeometryCache = ( M_geometryCache
+                           && M_quadratureRule != 0
+                           && M_geometryCache->isCompatible (spaceDim, *M_quadratureRule, *M_geometricMap) );
 }
 
 
@@ -1057,10 +1126,9 @@ setupInternalConstants()
     // it does not depend on the current element
 
     // PHI
-    M_phi.resize (M_nbQuadPt);
+    M_phi.resize (M_nbQuadPt, M_nbFEDof);
     for (UInt q (0); q < M_nbQuadPt; ++q)
     {
-        M_phi[q].resize (M_nbFEDof);
         for (UInt j (0); j < M_nbFEDof; ++j)
         {
             M_phi[q][j] = M_referenceFE->phi (j, M_quadratureRule->quadPointCoor (q) );
@@ -1197,31 +1265,90 @@ setupInternalConstants()
     }
 
     // dphi
-    M_dphi.resize (M_nbQuadPt);
-    for (UInt i (0); i < M_nbQuadPt; ++i)
-    {
-        M_dphi[i].resize (M_nbFEDof);
-    }
-    
+    M_dphi.resize (M_nbQuadPt, M_nbFEDof);
+
     // d2phi
-    M_d2phi.resize (M_nbQuadPt);
-    for (UInt i (0); i < M_nbQuadPt; ++i)
+    M_d2phi.resize (M_nbQuadPt, M_nbFEDof);
+
+    // laplacian
+    M_laplacian.resize (M_nbQuadPt, M_nbFEDof);
+
+}
+
+
+template< UInt spaceDim>
+void
+ETCurrentFE<spaceDim, 1>::
+updateGeometryFromCache (const flag_Type& flag)
+{
+    ASSERT (M_isCellNodeUpdated, "Cell must be updated to use the geometric cache");
+
+    const UInt matrixSize (spaceDim * spaceDim);
+    Real* jacobian (M_geometryCache->jacobian (M_currentLocalId) );
+    Real* detJacobian (M_geometryCache->detJacobian (M_currentLocalId) );
+    Real* wDet (M_geometryCache->wDet (M_currentLocalId) );
+    Real* tInverseJacobian (M_geometryCache->tInverseJacobian (M_currentLocalId) );
+
+    if ( !M_geometryCache->isStored (M_currentLocalId) )
     {
-    	// we have fieldDim * DoF basis functions
-    	M_d2phi[i].resize ( M_nbFEDof );
+        // First time this element is seen: compute everything and store it
+        for (UInt q (0); q < M_nbQuadPt; ++q)
+        {
+            updateJacobian (q);
+            updateDetJacobian (q);
+            updateInverseJacobian (q);
+            updateWDet (q);
+
+            for (UInt iDim (0); iDim < spaceDim; ++iDim)
+            {
+                for (UInt jDim (0); jDim < spaceDim; ++jDim)
+                {
+                    jacobian[q * matrixSize + iDim * spaceDim + jDim] = M_jacobian[q][iDim][jDim];
+                    tInverseJacobian[q * matrixSize + iDim * spaceDim + jDim] = M_tInverseJacobian[q][iDim][jDim];
+                }
+            }
+            detJacobian[q] = M_detJacobian[q];
+            wDet[q] = M_wDet[q];
+        }
+        M_geometryCache->setStored (M_currentLocalId);
+        return;
     }
 
-    // laplacian
-    M_laplacian.resize (M_nbQuadPt);
-    for (UInt i (0); i < M_nbQuadPt; ++i)
+    // Otherwise, copy only the required quantities
+    for (UInt q (0); q < M_nbQuadPt; ++q)
     {
-    	// we have fieldDim * DoF basis functions
-    	M_laplacian[i].resize ( M_nbFEDof );
+        for (UInt iDim (0); iDim < spaceDim; ++iDim)
+        {
+            for (UInt jDim (0); jDim < spaceDim; ++jDim)
+            {
+                if ( flag & ET_UPDATE_ONLY_JACOBIAN )
+                {
+                    M_jacobian[q][iDim][jDim] = jacobian[q * matrixSize + iDim * spaceDim + jDim];
+                }
+                if ( flag & ET_UPDATE_ONLY_T_INVERSE_JACOBIAN )
+                {
+                    M_tInverseJacobian[q][iDim][jDim] = tInverseJacobian[q * matrixSize + iDim * spaceDim + jDim];
+                }
+            }
+        }
+        if ( flag & ET_UPDATE_ONLY_DET_JACOBIAN )
+        {
+            M_detJacobian[q] = detJacobian[q];
+        }
+        if ( flag & ET_UPDATE_ONLY_W_DET_JACOBIAN )
+        {
+            M_wDet[q] = wDet[q];
+        }
     }
 
+#ifdef HAVE_LIFEV_DEBUG
+    M_isJacobianUpdated = ( flag & ET_UPDATE_ONLY_JACOBIAN );
+    M_isDetJacobianUpdated = ( flag & ET_UPDATE_ONLY_DET_JACOBIAN );
+    M_isInverseJacobianUpdated = ( flag & ET_UPDATE_ONLY_T_INVERSE_JACOBIAN );
+    M_isWDetUpdated = ( flag & ET_UPDATE_ONLY_W_DET_JACOBIAN );
+#endif
 }
 
-
 template <UInt spaceDim>
 void
 ETCurrentFE<spaceDim, 1>::
@@ -53,18 +53,15 @@ private:
     // Matrix return type for dphi
     typedef MatrixSmall< fieldDim, spaceDim > matrix_Return_Type;
 
-    //Private typedefs for the 2D array of vector
-    typedef std::vector< std::vector< array1D_Return_Type > > array2D_vector_Type;
+    //Private typedefs for the (contiguous) table of vectors
+    typedef ETQuadratureTable< array1D_Return_Type > table_vector_Type;
 
-    //Private typedefs for the 3D array of vector
-    typedef std::vector< std::vector< matrix_Return_Type > > array2D_matrix_Type;
-    
-    //Private typedefs for the laplacian
-    typedef std::vector< std::vector< std::vector <matrix_Return_Type > > > array_3D_matrix_Type;
+    //Private typedefs for the (contiguous) table of matrices
+    typedef ETQuadratureTable< matrix_Return_Type > table_matrix_Type;
 
-    // Typedefs for the second derivative
+    // Typedefs for the second derivative (one hessian per component)
     typedef MatrixSmall< spaceDim, spaceDim > matrix_d2Phi;
-    typedef std::vector< std::vector< std::vector< matrix_d2Phi > > > array_d2Phi;
+    typedef ETQuadratureTable< std::array< matrix_d2Phi, fieldDim > > table_d2Phi;
 
 public:
 
@@ -152,6 +149,19 @@ public:
      */
     void setQuadratureRule (const QuadratureRule& qr);
 
+    //! Setter for the geometric cache
+    /*!
+      When a cache is set, the geometric quantities (jacobian, its determinant
+      and inverse, weighted determinant) are computed only the first time an
+      element is updated, and copied from the cache for the next updates.
+      The cache is used only if it is compatible with the quadrature rule and
+      the geometric map of this element (this is checked again when the
+      quadrature rule changes). An empty pointer detaches the cache.
+
+      @param cache The cache to use (or an empty pointer)
+     */
+    void setGeometryCache (const std::shared_ptr<ETGeometryCache>& cache);
+
     //@}
 
     //! @name Get Methods
@@ -292,8 +302,9 @@ private:
 
     //Private typedefs for the 3D array (array of 2D array)
     typedef std::vector< array2D_Type > array3D_Type;
-    
-    typedef std::vector< std::vector< array1D_Return_Type > > arrayLaplacian_Type;
+
+    //Private typedefs for the (contiguous) table of scalars
+    typedef ETQuadratureTable< Real > table_Type;
 
     //Private typedefs for the 4D array (array of 3D array)
     typedef std::vector< array3D_Type > array4D_Type;
@@ -341,6 +352,9 @@ private:
     //! Update Laplacian
     void updateLaplacian ( const UInt& iQuadPt);
 
+    //! Update the geometric quantities using the geometric cache
+    void updateGeometryFromCache (const flag_Type& flag);
+
 
     //@}
 
@@ -364,7 +378,7 @@ private:
     UInt M_currentLocalId;
 
     // Storage for the values of the basis functions
-    array2D_vector_Type M_phi;
+    table_vector_Type M_phi;
 
     // Storage for the values of the geometric map
     array2D_Type M_phiMap;
@@ -389,15 +403,21 @@ private:
     array3D_Type M_tInverseJacobian;
 
     // Storage for the derivative of the basis functions
-    array2D_matrix_Type M_dphi;
+    table_matrix_Type M_dphi;
     // Storage for the divergence of the basis functions
-    array2D_Type M_divergence;
+    table_Type M_divergence;
 
     // Storage for the second derivative of the basis functions
-    array_d2Phi M_d2phi;
+    table_d2Phi M_d2phi;
 
     // Storage for the laplacian of the basis functions
-    arrayLaplacian_Type M_laplacian;
+    table_vector_Type M_laplacian;
+
+    // Cache for the geometric quantities (shared with the FE space)
+    std::shared_ptr<ETGeometryCache> M_geometryCache;
+
+    // Is the cache compatible with the current quadrature rule
+    bool M_useGeometryCache;
 
 
 #ifdef HAVE_LIFEV_DEBUG
@@ -464,7 +484,10 @@ ETCurrentFE (const ReferenceFE& refFE, const GeometricMap& geoMap, const Quadrat
     M_dphi(),
     M_divergence(),
     M_d2phi(),
-    M_laplacian()
+    M_laplacian(),
+
+    M_geometryCache(),
+    M_useGeometryCache (false)
 
 #ifdef HAVE_LIFEV_DEBUG
     , M_isCellNodeUpdated (false),
@@ -516,7 +539,10 @@ ETCurrentFE (const ReferenceFE& refFE, const GeometricMap& geoMap)
     M_divergence(),
 
     M_d2phi(),
-    M_laplacian()
+    M_laplacian(),
+
+    M_geometryCache(),
+    M_useGeometryCache (false)
 
 #ifdef HAVE_LIFEV_DEBUG
     , M_isCellNodeUpdated (false),
@@ -567,7 +593,10 @@ ETCurrentFE (const ETCurrentFE<spaceDim, fieldDim>& otherFE)
     M_divergence (otherFE.M_divergence),
 
     M_d2phi (otherFE.M_d2phi),
-    M_laplacian (otherFE.M_laplacian)
+    M_laplacian (otherFE.M_laplacian),
+
+    M_geometryCache (otherFE.M_geometryCache),
+    M_useGeometryCache (otherFE.M_useGeometryCache)
 
 #ifdef HAVE_LIFEV_DEBUG
     //Beware for the comma at the begining of this line!
@@ -625,6 +654,21 @@ update (const elementType& element, const flag_Type& flag)
         updateCellNode (element);
     }
 
+    // The geometric quantities are taken from the cache if possible
+    // (the cache is indexed by the local identifier, so the cell
+    // has to be updated)
+    const flag_Type geometryFlag (ET_UPDATE_ONLY_JACOBIAN
+                                  | ET_UPDATE_ONLY_DET_JACOBIAN
+                                  | ET_UPDATE_ONLY_T_INVERSE_JACOBIAN
+                                  | ET_UPDATE_ONLY_W_DET_JACOBIAN);
+    flag_Type quadratureFlag (flag);
+
+    if ( M_useGeometryCache && (flag & ET_UPDATE_ONLY_CELL_NODE) && (flag & geometryFlag) )
+    {
+        updateGeometryFromCache (flag);
+        quadratureFlag &= ~geometryFlag;
+    }
+
     // Loop over the quadrature nodes
     for (UInt i (0); i < M_nbQuadPt; ++i)
     {
@@ -633,19 +677,19 @@ update (const elementType& element, const flag_Type& flag)
         {
             updateQuadNode (i);
         }
-        if ( flag & ET_UPDATE_ONLY_JACOBIAN )
+        if ( quadratureFlag & ET_UPDATE_ONLY_JACOBIAN )
         {
             updateJacobian (i);
         }
-        if ( flag & ET_UPDATE_ONLY_DET_JACOBIAN )
+        if ( quadratureFlag & ET_UPDATE_ONLY_DET_JACOBIAN )
         {
             updateDetJacobian (i);
         }
-        if ( flag & ET_UPDATE_ONLY_T_INVERSE_JACOBIAN )
+        if ( quadratureFlag & ET_UPDATE_ONLY_T_INVERSE_JACOBIAN )
         {
             updateInverseJacobian (i);
         }
-        if ( flag & ET_UPDATE_ONLY_W_DET_JACOBIAN )
+        if ( quadratureFlag & ET_UPDATE_ONLY_W_DET_JACOBIAN )
         {
             updateWDet (i);
         }
@@ -765,6 +809,20 @@ setQuadratureRule (const QuadratureRule& qr)
     M_quadratureRule = &qr;
     M_nbQuadPt = qr.nbQuadPt();
     setupInternalConstants();
+
+    M_useGeometryCache = ( M_geometryCache
+                           && M_geometryCache->isCompatible (spaceDim, *M_quadratureRule, *M_geometricMap) );
+}
+
+template< UInt spaceDim, UInt fieldDim >
+void
+ETCurrentFE<spaceDim, fieldDim>::
+setGeometryCache (const std::shared_ptr<ETGeometryCache>& cache)
+{
+    M_geometryCache = cache;
+    M_useGeometryCache = ( M_geometryCache
+                           && M_quadratureRule != 0
+                           && M_geometryCache->isCompatible (spaceDim, *M_quadratureRule, *M_geometricMap) );
 }
 
 // ===================================================
@@ -780,12 +838,10 @@ setupInternalConstants()
     // it does not depend on the current element
 
     // PHI
-    M_phi.resize ( M_nbQuadPt );
+    // we have M_nbFEDof * 3 basis functions
+    M_phi.resize ( M_nbQuadPt, M_nbFEDof * 3 );
     for ( UInt q ( 0 ); q < M_nbQuadPt; ++q )
     {
-        // we have M_nbFEDof * 3 basis functions
-        M_phi[q].resize ( M_nbFEDof * 3 );
-
         // set only appropriate values, other are initialized to 0 by default constructor (of VectorSmall)
         for ( UInt j ( 0 ); j < M_nbFEDof; ++j )
         {
@@ -908,43 +964,92 @@ setupInternalConstants()
         }
     }
 
+    // we have fieldDim * DoF basis functions
+
     // dphi
-    M_dphi.resize (M_nbQuadPt);
-    for (UInt i (0); i < M_nbQuadPt; ++i)
-    {
-        // we have fieldDim * DoF basis functions
-        M_dphi[i].resize ( fieldDim * M_nbFEDof );
-    }
+    M_dphi.resize (M_nbQuadPt, fieldDim * M_nbFEDof);
 
     // divergence
-    M_divergence.resize (M_nbQuadPt);
-    for (UInt i (0); i < M_nbQuadPt; ++i)
-    {
-        // we have fieldDim * DoF basis functions
-        M_divergence[i].resize ( fieldDim * M_nbFEDof );
-    }
+    M_divergence.resize (M_nbQuadPt, fieldDim * M_nbFEDof);
 
-    // d2phi
-    M_d2phi.resize (M_nbQuadPt);
-    for (UInt i (0); i < M_nbQuadPt; ++i)
+    // d2phi (for each basis function we have fieldDim hessians)
+    M_d2phi.resize (M_nbQuadPt, fieldDim * M_nbFEDof);
+
+    // laplacian
+    M_laplacian.resize (M_nbQuadPt, fieldDim * M_nbFEDof);
+}
+
+template< UInt spaceDim, UInt fieldDim >
+void
+ETCurrentFE<spaceDim, fieldDim>::
+updateGeometryFromCache (const flag_Type& flag)
+{
+    ASSERT (M_isCellNodeUpdated, "Cell must be updated to use the geometric cache");
+
+    const UInt matrixSize (spaceDim * spaceDim);
+    Real* jacobian (M_geometryCache->jacobian (M_currentLocalId) );
+    Real* detJacobian (M_geometryCache->detJacobian (M_currentLocalId) );
+    Real* wDet (M_geometryCache->wDet (M_currentLocalId) );
+    Real* tInverseJacobian (M_geometryCache->tInverseJacobian (M_currentLocalId) );
+
+    if ( !M_geometryCache->isStored (M_currentLocalId) )
     {
-    	// we have fieldDim * DoF basis functions
-    	M_d2phi[i].resize ( fieldDim * M_nbFEDof );
+        // First time this element is seen: compute everything and store it
+        for (UInt q (0); q < M_nbQuadPt; ++q)
+        {
+            updateJacobian (q);
+            updateDetJacobian (q);
+            updateInverseJacobian (q);
+            updateWDet (q);
 
-    	// for each basis function we have fieldDim
-    	for (UInt j (0); j < ( fieldDim * M_nbFEDof ); ++j)
-    	{
-    		M_d2phi[i][j].resize(fieldDim);
-    	}
+            for (UInt iDim (0); iDim < spaceDim; ++iDim)
+            {
+                for (UInt jDim (0); jDim < spaceDim; ++jDim)
+                {
+                    jacobian[q * matrixSize + iDim * spaceDim + jDim] = M_jacobian[q][iDim][jDim];
+                    tInverseJacobian[q * matrixSize + iDim * spaceDim + jDim] = M_tInverseJacobian[q][iDim][jDim];
+                }
+            }
+            detJacobian[q] = M_detJacobian[q];
+            wDet[q] = M_wDet[q];
+        }
+        M_geometryCache->setStored (M_currentLocalId);
+        return;
     }
 
-    // laplacian
-    M_laplacian.resize (M_nbQuadPt);
-    for (UInt i (0); i < M_nbQuadPt; ++i)
+    // Otherwise, copy only the required quantities
+    for (UInt q (0); q < M_nbQuadPt; ++q)
     {
-    	// we have fieldDim * DoF basis functions
-    	M_laplacian[i].resize ( fieldDim * M_nbFEDof );
+        for (UInt iDim (0); iDim < spaceDim; ++iDim)
+        {
+            for (UInt jDim (0); jDim < spaceDim; ++jDim)
+            {
+                if ( flag & ET_UPDATE_ONLY_JACOBIAN )
+                {
+                    M_jacobian[q][iDim][jDim] = jacobian[q * matrixSize + iDim * spaceDim + jDim];
+                }
+                if ( flag & ET_UPDATE_ONLY_T_INVERSE_JACOBIAN )
+                {
+                    M_tInverseJacobian[q][iDim][jDim] = tInverseJacobian[q * matrixSize + iDim * spaceDim + jDim];
+                }
+            }
+        }
+        if ( flag & ET_UPDATE_ONLY_DET_JACOBIAN )
+        {
+            M_detJacobian[q] = detJacobian[q];
+        }
+        if ( flag & ET_UPDATE_ONLY_W_DET_JACOBIAN )
+        {
+            M_wDet[q] = wDet[q];
+        }
     }
+
+#ifdef HAVE_LIFEV_DEBUG
+    M_isJacobianUpdated = ( flag & ET_UPDATE_ONLY_JACOBIAN );
+    M_isDetJacobianUpdated = ( flag & ET_UPDATE_ONLY_DET_JACOBIAN );
+    M_isInverseJacobianUpdated = ( flag & ET_UPDATE_ONLY_T_INVERSE_JACOBIAN );
+    M_isWDetUpdated = ( flag & ET_UPDATE_ONLY_W_DET_JACOBIAN );
+#endif
 }
 
 template <UInt spaceDim, UInt fieldDim >
@@ -36,6 +36,8 @@
 #ifndef ETFESPACE_HPP
 #define ETFESPACE_HPP
 
+#include <vector>
+
 #include <boost/shared_ptr.hpp>
 
 #include <lifev/core/LifeV.hpp>
@@ -48,6 +50,7 @@
 #include <lifev/core/fem/DOF.hpp>
 
 #include <lifev/eta/fem/MeshGeometricMap.hpp>
+#include <lifev/eta/fem/ETGeometryCache.hpp>
 #include <lifev/core/mesh/MeshPartitioner.hpp>
 
 namespace LifeV
@@ -72,6 +75,11 @@ namespace LifeV
 
     It does not contain any information about the quadrature (unlike LifeV::FESpace), as this is not strictly needed for the definition of the space.
 
+    For static meshes, a cache of the geometric quantities (jacobians and their determinants and inverses
+    in the quadrature nodes) can be enabled for a given quadrature rule, see enableGeometryCache. The
+    assemblies using this space then compute these quantities only once per element. If the mesh is
+    moved (e.g. in an ALE formulation), invalidateGeometryCache has to be called after each movement.
+
     This class is supposed to be constant during a simulation, so that it can
     be shared across the different structures using it.
 
@@ -109,6 +117,12 @@ public:
     //! Typedef for a pointer on the communicator
     typedef typename map_Type::commPtr_Type commPtr_Type;
 
+    //! Typedef for a pointer on a geometric cache
+    typedef std::shared_ptr<ETGeometryCache> geometryCachePtr_Type;
+
+    //! Typedef for the table of the local identifiers of the dofs
+    typedef std::vector<Int> localDofTable_Type;
+
     //@}
 
 
@@ -191,6 +205,33 @@ public:
     //@}
 
 
+    //! @name Methods
+    //@{
+
+    //! Enable the cache of the geometric quantities for the given quadrature rule
+    /*!
+      The cache is shared with the copies of this space. Enabling it several
+      times for the same quadrature rule has no effect.
+
+      @param qr The quadrature rule used in the assemblies
+     */
+    void enableGeometryCache (const QuadratureRule& qr);
+
+    //! Mark all the stored geometric quantities as outdated
+    /*!
+      This method has to be called each time the mesh is moved.
+     */
+    void invalidateGeometryCache();
+
+    //! Remove all the geometric caches (and release their memory)
+    void disableGeometryCache()
+    {
+        M_geometryCaches.clear();
+    }
+
+    //@}
+
+
     //! @name Get Methods
     //@{
 
@@ -265,6 +306,25 @@ public:
     {
         return field_dim;
     }
+
+    //! Getter for the geometric cache
+    /*!
+      @param qr The quadrature rule used in the assembly
+      @return The cache for this quadrature rule, or an empty pointer if
+      no cache has been enabled for it.
+     */
+    geometryCachePtr_Type geometryCache (const QuadratureRule& qr) const;
+
+    //! Getter for the local identifiers of the dofs of each element
+    /*!
+      The identifiers refer to the repeated algebraic map of this space: they
+      can be used to read directly the local values of a vector defined with
+      this map. For the element iElement, the identifier of the component iDim
+      of the local dof i is stored in position (iElement * FieldDim + iDim) * nbDof + i.
+
+      The table is built at the first call and shared with the copies of this space.
+     */
+    const localDofTable_Type& localDofTable() const;
     //@}
 
 private:
@@ -278,6 +338,9 @@ private:
     //! Creates the map from the input
     void createMap (const commPtr_Type& commptr);
 
+    //! Fill the table of the local identifiers of the dofs
+    void buildLocalDofTable() const;
+
     //@}
 
 
@@ -295,6 +358,12 @@ private:
 
     // Algebraic map
     MapType* M_map;
+
+    // Caches of the geometric quantities (one for each quadrature rule)
+    std::vector<geometryCachePtr_Type> M_geometryCaches;
+
+    // Local identifiers of the dofs of each element (empty until requested)
+    std::shared_ptr<localDofTable_Type> M_localDofTable;
 };
 
 
@@ -314,7 +383,8 @@ ETFESpace (const meshPtr_Type& mesh, const ReferenceFE* refFE, const GeometricMa
       M_referenceFE (refFE),
       M_geometricMap (geoMap),
       M_dof ( new DOF ( *M_mesh, *M_referenceFE ) ),
-      M_map (new MapType() )
+      M_map (new MapType() ),
+      M_localDofTable (new localDofTable_Type)
 {
     createMap (commptr);
 }
@@ -327,7 +397,8 @@ ETFESpace (const meshPtr_Type& mesh, const ReferenceFE* refFE, commPtr_Type& com
       M_referenceFE (refFE),
       M_geometricMap (&geometricMapFromMesh<MeshType>() ),
       M_dof ( new DOF ( *M_mesh, *M_referenceFE ) ),
-      M_map (new MapType() )
+      M_map (new MapType() ),
+      M_localDofTable (new localDofTable_Type)
 {
 
     createMap (commptr);
@@ -343,7 +414,8 @@ ETFESpace (const MeshPartitioner<MeshType>& meshPartitioner,
       M_referenceFE (refFE),
       M_geometricMap (geoMap),
       M_dof ( new DOF ( *M_mesh, *M_referenceFE ) ),
-      M_map (new MapType() )
+      M_map (new MapType() ),
+      M_localDofTable (new localDofTable_Type)
 {
     createMap (commptr);
 }
@@ -357,7 +429,8 @@ ETFESpace (const MeshPartitioner<MeshType>& meshPartitioner,
       M_referenceFE (refFE),
       M_geometricMap ( &geometricMapFromMesh<MeshType>() ),
       M_dof ( new DOF ( *M_mesh, *M_referenceFE ) ),
-      M_map (new MapType() )
+      M_map (new MapType() ),
+      M_localDofTable (new localDofTable_Type)
 {
     createMap (commptr);
 }
@@ -370,9 +443,105 @@ ETFESpace (const ETFESpace<MeshType, MapType, SpaceDim, FieldDim>& otherSpace)
       M_referenceFE (otherSpace.M_referenceFE),
       M_geometricMap (otherSpace.M_geometricMap),
       M_dof (otherSpace.M_dof),
-      M_map (otherSpace.M_map)
+      M_map (otherSpace.M_map),
+      M_geometryCaches (otherSpace.M_geometryCaches),
+      M_localDofTable (otherSpace.M_localDofTable)
 {}
 
+// ===================================================
+// Methods
+// ===================================================
+
+template<typename MeshType, typename MapType, UInt SpaceDim, UInt FieldDim>
+void
+ETFESpace<MeshType, MapType, SpaceDim, FieldDim>::
+enableGeometryCache (const QuadratureRule& qr)
+{
+    if (geometryCache (qr) )
+    {
+        return;
+    }
+
+    M_geometryCaches.push_back (geometryCachePtr_Type (new ETGeometryCache (M_mesh->numElements(), SpaceDim, qr, *M_geometricMap) ) );
+}
+
+template<typename MeshType, typename MapType, UInt SpaceDim, UInt FieldDim>
+void
+ETFESpace<MeshType, MapType, SpaceDim, FieldDim>::
+invalidateGeometryCache()
+{
+    for (UInt i (0); i < M_geometryCaches.size(); ++i)
+    {
+        M_geometryCaches[i]->invalidate();
+    }
+}
+
+// ===================================================
+// Get Methods
+// ===================================================
+
+template<typename MeshType, typename MapType, UInt SpaceDim, UInt FieldDim>
+typename ETFESpace<MeshType, MapType, SpaceDim, FieldDim>::geometryCachePtr_Type
+ETFESpace<MeshType, MapType, SpaceDim, FieldDim>::
+geometryCache (const QuadratureRule& qr) const
+{
+    for (UInt i (0); i < M_geometryCaches.size(); ++i)
+    {
+        if (M_geometryCaches[i]->isCompatible (SpaceDim, qr, *M_geometricMap) )
+        {
+            return M_geometryCaches[i];
+        }
+    }
+    return geometryCachePtr_Type();
+}
+
+template<typename MeshType, typename MapType, UInt SpaceDim, UInt FieldDim>
+const typename ETFESpace<MeshType, MapType, SpaceDim, FieldDim>::localDofTable_Type&
+ETFESpace<MeshType, MapType, SpaceDim, FieldDim>::
+localDofTable() const
+{
+    // The first call can happen in a parallel region
+    #pragma omp critical (ETFESpaceLocalDofTable)
+    {
+        if (M_localDofTable->empty() )
+        {
+            buildLocalDofTable();
+        }
+    }
+    return *M_localDofTable;
+}
+
+// ===================================================
+// Private Methods
+// ===================================================
+
+template<typename MeshType, typename MapType, UInt SpaceDim, UInt FieldDim>
+void
+ETFESpace<MeshType, MapType, SpaceDim, FieldDim>::
+buildLocalDofTable() const
+{
+    const UInt nbElements (M_mesh->numElements() );
+    const UInt nbDof (M_referenceFE->nbDof() );
+    const UInt nbTotalDof (M_dof->numTotalDof() );
+    const typename MapType::map_Type& repeatedMap (*M_map->map (Repeated) );
+
+    localDofTable_Type& table (*M_localDofTable);
+    table.resize (nbElements * FieldDim * nbDof);
+
+    for (UInt iElement (0); iElement < nbElements; ++iElement)
+    {
+        for (UInt iDim (0); iDim < FieldDim; ++iDim)
+        {
+            Int* elementTable (&table[ (iElement * FieldDim + iDim) * nbDof]);
+            for (UInt i (0); i < nbDof; ++i)
+            {
+                elementTable[i] = repeatedMap.LID (static_cast<Int> (M_dof->localToGlobalMap (iElement, i) + iDim * nbTotalDof) );
+                ASSERT (elementTable[i] >= 0, "Dof of a local element not found in the repeated map");
+            }
+        }
+    }
+}
+
 template<typename MeshType, typename MapType, UInt SpaceDim, UInt FieldDim>
 void
 ETFESpace<MeshType, MapType, SpaceDim, FieldDim>::
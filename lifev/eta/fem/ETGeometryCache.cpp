@@ -0,0 +1,111 @@
+//@HEADER
+/*
+*******************************************************************************
+
+   Copyright (C) 2004, 2005, 2007 EPFL, Politecnico di Milano, INRIA
+   Copyright (C) 2010 EPFL, Politecnico di Milano, Emory UNiversity
+
+   This file is part of the LifeV library
+
+   LifeV is free software; you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+
+   LifeV is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with this library; if not, see <http://www.gnu.org/licenses/>
+
+
+*******************************************************************************
+*/
+//@HEADER
+
+/*!
+ *   @file
+     @brief This file contains the implementation of the ETGeometryCache class
+ */
+
+#include <algorithm>
+
+#include <lifev/eta/fem/ETGeometryCache.hpp>
+
+namespace LifeV
+{
+
+// ===================================================
+// Constructors & Destructor
+// ===================================================
+
+ETGeometryCache::
+ETGeometryCache (const UInt& nbElements,
+                 const UInt& spaceDim,
+                 const QuadratureRule& qr,
+                 const GeometricMap& geoMap)
+    :
+    M_nbElements (nbElements),
+    M_spaceDim (spaceDim),
+    M_nbQuadPt (qr.nbQuadPt() ),
+    M_quadratureRule (qr),
+    M_geometricMapName (geoMap.name() ),
+    M_isStored (nbElements, 0),
+    M_jacobian (nbElements * qr.nbQuadPt() * spaceDim * spaceDim),
+    M_detJacobian (nbElements * qr.nbQuadPt() ),
+    M_wDet (nbElements * qr.nbQuadPt() ),
+    M_tInverseJacobian (nbElements * qr.nbQuadPt() * spaceDim * spaceDim)
+{}
+
+// ===================================================
+// Methods
+// ===================================================
+
+void
+ETGeometryCache::
+invalidate()
+{
+    std::fill (M_isStored.begin(), M_isStored.end(), 0);
+}
+
+bool
+ETGeometryCache::
+isCompatible (const UInt& spaceDim, const QuadratureRule& qr, const GeometricMap& geoMap) const
+{
+    if ( spaceDim != M_spaceDim
+            || qr.nbQuadPt() != M_nbQuadPt
+            || geoMap.name() != M_geometricMapName )
+    {
+        return false;
+    }
+
+    // The name is not enough to identify a quadrature
+    // (e.g. boundary quadratures are renamed copies), so
+    // compare the nodes and the weights
+    for (UInt q (0); q < M_nbQuadPt; ++q)
+    {
+        if (qr.weight (q) != M_quadratureRule.weight (q) )
+        {
+            return false;
+        }
+        const GeoVector& coordinates (qr.quadPointCoor (q) );
+        const GeoVector& storedCoordinates (M_quadratureRule.quadPointCoor (q) );
+
+        if (coordinates.size() != storedCoordinates.size() )
+        {
+            return false;
+        }
+        for (UInt iCoor (0); iCoor < coordinates.size(); ++iCoor)
+        {
+            if (coordinates[iCoor] != storedCoordinates[iCoor])
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+} // Namespace LifeV
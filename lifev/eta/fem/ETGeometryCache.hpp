@@ -0,0 +1,198 @@
+//@HEADER
+/*
+*******************************************************************************
+
+   Copyright (C) 2004, 2005, 2007 EPFL, Politecnico di Milano, INRIA
+   Copyright (C) 2010 EPFL, Politecnico di Milano, Emory UNiversity
+
+   This file is part of the LifeV library
+
+   LifeV is free software; you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+
+   LifeV is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with this library; if not, see <http://www.gnu.org/licenses/>
+
+
+*******************************************************************************
+*/
+//@HEADER
+
+/*!
+ *   @file
+     @brief This file contains the definition of the ETGeometryCache class
+ */
+
+#ifndef ET_GEOMETRY_CACHE_HPP
+#define ET_GEOMETRY_CACHE_HPP
+
+#include <lifev/core/LifeV.hpp>
+
+#include <lifev/core/fem/QuadratureRule.hpp>
+#include <lifev/core/fem/GeometricMap.hpp>
+
+namespace LifeV
+{
+
+//! class ETGeometryCache  A storage for the geometric quantities of the elements of a static mesh
+/*!
+    This class stores, for each element of a mesh and for each node of a given
+    quadrature rule, the quantities related to the geometric mapping: the jacobian,
+    its determinant, the weighted determinant and the transposed inverse of the jacobian.
+
+    The cache is filled lazily by the ETCurrentFE to which it is attached: the first
+    time an element is updated, the quantities are computed and stored; the next
+    updates of the same element only copy them back. As the stored quantities are
+    only valid for a given quadrature rule and a given geometric map, the ETCurrentFE
+    uses the cache only if it is compatible with its own (see isCompatible).
+
+    The cache does not know when the mesh moves: codes which move the mesh (e.g. ALE
+    formulations) have to call invalidate() after each change of the mesh.
+
+    Different elements can be filled concurrently (as in the multi-threaded assembly),
+    but a given element must not be filled by two threads at the same time.
+*/
+class ETGeometryCache
+{
+
+public:
+
+    //! @name Constructors, destructor
+    //@{
+
+    //! Constructor with the sizes
+    /*!
+      @param nbElements The number of elements of the mesh (elements are indexed with their local identifier)
+      @param spaceDim The dimension of the space
+      @param qr The quadrature rule for which the quantities are stored
+      @param geoMap The geometric map for which the quantities are stored
+     */
+    ETGeometryCache (const UInt& nbElements,
+                     const UInt& spaceDim,
+                     const QuadratureRule& qr,
+                     const GeometricMap& geoMap);
+
+    //! Destructor
+    ~ETGeometryCache() {}
+
+    //@}
+
+
+    //! @name Methods
+    //@{
+
+    //! Mark all the elements as not stored (to be called after the mesh has moved)
+    void invalidate();
+
+    //! Check if the cache can be used with the given quadrature rule and geometric map
+    bool isCompatible (const UInt& spaceDim, const QuadratureRule& qr, const GeometricMap& geoMap) const;
+
+    //! Mark the quantities of the element as stored
+    void setStored (const UInt& localId)
+    {
+        ASSERT (localId < M_nbElements, "Element out of the geometric cache");
+        M_isStored[localId] = 1;
+    }
+
+    //@}
+
+
+    //! @name Get Methods
+    //@{
+
+    //! Check if the quantities of the element are stored
+    bool isStored (const UInt& localId) const
+    {
+        ASSERT (localId < M_nbElements, "Element out of the geometric cache");
+        return M_isStored[localId] != 0;
+    }
+
+    //! Jacobians of the element, stored as [q][i][j]
+    Real* jacobian (const UInt& localId)
+    {
+        return &M_jacobian[localId * M_nbQuadPt * M_spaceDim * M_spaceDim];
+    }
+
+    //! Determinants of the jacobian of the element, stored as [q]
+    Real* detJacobian (const UInt& localId)
+    {
+        return &M_detJacobian[localId * M_nbQuadPt];
+    }
+
+    //! Weighted determinants of the jacobian of the element, stored as [q]
+    Real* wDet (const UInt& localId)
+    {
+        return &M_wDet[localId * M_nbQuadPt];
+    }
+
+    //! Transposed inverses of the jacobian of the element, stored as [q][i][j]
+    Real* tInverseJacobian (const UInt& localId)
+    {
+        return &M_tInverseJacobian[localId * M_nbQuadPt * M_spaceDim * M_spaceDim];
+    }
+
+    //! Number of elements
+    const UInt& nbElements() const
+    {
+        return M_nbElements;
+    }
+
+    //! Quadrature rule for which the quantities are stored
+    const QuadratureRule& quadratureRule() const
+    {
+        return M_quadratureRule;
+    }
+
+    //@}
+
+private:
+
+    //! @name Private Methods
+    //@{
+
+    //! No default constructor
+    ETGeometryCache();
+
+    //! No copy (the cache is shared through pointers)
+    ETGeometryCache (const ETGeometryCache&);
+
+    //! No assignement
+    void operator= (const ETGeometryCache&);
+
+    //@}
+
+    // Number of elements
+    UInt M_nbElements;
+
+    // Dimension of the space
+    UInt M_spaceDim;
+
+    // Number of quadrature nodes
+    UInt M_nbQuadPt;
+
+    // Quadrature rule used to compute the quantities
+    QuadratureRule M_quadratureRule;
+
+    // Name of the geometric map used to compute the quantities
+    std::string M_geometricMapName;
+
+    // Flags for the stored elements (char and not bool, to allow concurrent writes)
+    std::vector<unsigned char> M_isStored;
+
+    // Stored quantities
+    std::vector<Real> M_jacobian;
+    std::vector<Real> M_detJacobian;
+    std::vector<Real> M_wDet;
+    std::vector<Real> M_tInverseJacobian;
+};
+
+} // Namespace LifeV
+
+#endif
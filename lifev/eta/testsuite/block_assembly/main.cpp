@@ -0,0 +1,197 @@
+//@HEADER
+/*
+*******************************************************************************
+
+    Copyright (C) 2004, 2005, 2007 EPFL, Politecnico di Milano, INRIA
+    Copyright (C) 2010 EPFL, Politecnico di Milano, Emory University
+
+    This file is part of LifeV.
+
+    LifeV is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    LifeV is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with LifeV.  If not, see <http://www.gnu.org/licenses/>.
+
+*******************************************************************************
+*/
+//@HEADER
+
+/*!
+    @file
+    @brief Test for the assembly of a vector field by nodal blocks with ETA
+
+    The vector laplacian is assembled with ETA in a MatrixEpetra and in a
+    MatrixEpetraBlockCRS, then the vector mass matrix is added to both
+    closed matrices by the FastAssemblerGeneric. The products by a vector
+    are compared.
+
+    @date 10-2026
+ */
+
+#pragma GCC diagnostic ignored "-Wunused-variable"
+#pragma GCC diagnostic ignored "-Wunused-parameter"
+
+#include <cstdlib>
+
+#include <Epetra_ConfigDefs.h>
+#ifdef EPETRA_MPI
+#include <mpi.h>
+#include <Epetra_MpiComm.h>
+#else
+#include <Epetra_SerialComm.h>
+#endif
+
+#pragma GCC diagnostic warning "-Wunused-variable"
+#pragma GCC diagnostic warning "-Wunused-parameter"
+
+#include <lifev/core/LifeV.hpp>
+
+#include <lifev/core/mesh/MeshPartitioner.hpp>
+#include <lifev/core/mesh/RegionMesh3DStructured.hpp>
+#include <lifev/core/mesh/RegionMesh.hpp>
+
+#include <lifev/core/array/MatrixEpetra.hpp>
+#include <lifev/core/array/MatrixEpetraBlockCRS.hpp>
+#include <lifev/core/array/VectorEpetra.hpp>
+
+#include <lifev/core/fem/FastAssemblerGeneric.hpp>
+#include <lifev/core/fem/FastAssemblerKernels.hpp>
+
+#include <lifev/eta/fem/ETFESpace.hpp>
+
+#include <lifev/eta/expression/Integrate.hpp>
+
+
+using namespace LifeV;
+
+typedef RegionMesh<LinearTetra> mesh_Type;
+typedef MatrixEpetra<Real> matrix_Type;
+typedef VectorEpetra vector_Type;
+
+int main ( int argc, char** argv )
+{
+
+#ifdef HAVE_MPI
+    MPI_Init (&argc, &argv);
+    std::shared_ptr<Epetra_Comm> Comm (new Epetra_MpiComm (MPI_COMM_WORLD) );
+#else
+    std::shared_ptr<Epetra_Comm> Comm (new Epetra_SerialComm);
+#endif
+
+    const bool verbose (Comm->MyPID() == 0);
+
+    const UInt Nelements (argc > 1 ? std::atoi (argv[1]) : 5);
+
+    if (verbose)
+    {
+        std::cout << " -- Building and partitioning the mesh ... " << std::flush;
+    }
+
+    std::shared_ptr< mesh_Type > fullMeshPtr (new mesh_Type);
+
+    regularMesh3D ( *fullMeshPtr, 1, Nelements, Nelements, Nelements, false,
+                    2.0,   2.0,   2.0,
+                    -1.0,  -1.0,  -1.0);
+
+    MeshPartitioner< mesh_Type >   meshPart;
+    meshPart.setPartitionOverlap ( 1 );
+    meshPart.doPartition ( fullMeshPtr, Comm );
+
+    fullMeshPtr.reset();
+
+    if (verbose)
+    {
+        std::cout << " done ! " << std::endl;
+    }
+
+    std::shared_ptr<ETFESpace< mesh_Type, MapEpetra, 3, 3 > > wSpace
+    ( new ETFESpace< mesh_Type, MapEpetra, 3, 3 > (meshPart, &feTetraP1, Comm) );
+
+    if (verbose)
+    {
+        std::cout << " -- Assembling a vector field by nodal blocks ... " << std::flush;
+    }
+
+    // Vector laplacian assembled with ETA in a point and in a block matrix
+    matrix_Type vectorMatrix (wSpace->map(), 50);
+    MatrixEpetraBlockCRS<Real> blockMatrix (wSpace->map(), 3);
+    {
+        using namespace ExpressionAssembly;
+
+        integrate (  elements (wSpace->mesh() ),
+                     quadRuleTetra4pt,
+                     wSpace,
+                     wSpace,
+                     dot ( grad (phi_i) , grad (phi_j) )
+                  ) >> vectorMatrix;
+
+        integrate (  elements (wSpace->mesh() ),
+                     quadRuleTetra4pt,
+                     wSpace,
+                     wSpace,
+                     dot ( grad (phi_i) , grad (phi_j) )
+                  ) >> blockMatrix;
+    }
+    vectorMatrix.globalAssemble();
+    blockMatrix.globalAssemble();
+
+    // Vector mass matrix added to both closed matrices by the generic fast assembler
+    FastAssemblerGeneric<mesh_Type> vectorFastAssembler (*wSpace, quadRuleTetra4pt);
+    vectorFastAssembler.allocateSpace();
+    vectorFastAssembler.setUseInsertionOffsets (true);
+    vectorFastAssembler.assembleMatrix (vectorMatrix, FastAssemblerKernelMass<3>() );
+    vectorFastAssembler.assembleMatrix (blockMatrix, FastAssemblerKernelMass<3>() );
+    vectorMatrix.globalAssemble();
+    blockMatrix.globalAssemble();
+
+    vector_Type vectorField (wSpace->map(), Unique);
+    const Epetra_BlockMap& vectorMap (vectorField.blockMap() );
+
+    for (Int i (0); i < vectorMap.NumMyElements(); ++i)
+    {
+        vectorField[vectorMap.GID (i)] = 1.0 + vectorMap.GID (i) % 5;
+    }
+
+    vector_Type pointProduct (wSpace->map(), Unique);
+    vector_Type blockProduct (wSpace->map(), Unique);
+    vectorMatrix.multiply (false, vectorField, pointProduct);
+    blockMatrix.multiply (false, vectorField, blockProduct);
+
+    blockProduct -= pointProduct;
+    Real blockMatrixDiff ( blockProduct.normInf() );
+
+    if (verbose)
+    {
+        std::cout << " done ! " << std::endl;
+        std::cout << " Error (block matrix): " << blockMatrixDiff << std::endl;
+    }
+
+#ifdef HAVE_MPI
+    MPI_Finalize();
+#endif
+
+    const Real testTolerance (1e-10);
+
+    if ( blockMatrixDiff >= testTolerance )
+    {
+        if (verbose)
+        {
+            std::cout << "Test status: FAILURE" << std::endl;
+        }
+        return ( EXIT_FAILURE );
+    }
+
+    if (verbose)
+    {
+        std::cout << "Test status: SUCCESS" << std::endl;
+    }
+    return ( EXIT_SUCCESS );
+}
@@ -0,0 +1,271 @@
+//@HEADER
+/*
+*******************************************************************************
+
+    Copyright (C) 2004, 2005, 2007 EPFL, Politecnico di Milano, INRIA
+    Copyright (C) 2010 EPFL, Politecnico di Milano, Emory University
+
+    This file is part of LifeV.
+
+    LifeV is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    LifeV is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with LifeV.  If not, see <http://www.gnu.org/licenses/>.
+
+*******************************************************************************
+*/
+//@HEADER
+
+/*!
+    @file
+    @brief Test for the gather of the dof values in the ETA interpolations
+
+    The values and the gradients of a scalar and of a vector FE function are
+    integrated when the function is defined on the map of its FE space (the
+    values are gathered with the local identifiers of ETFESpace::localDofTable)
+    and when it is a block of a larger vector (the values are gathered with
+    the global identifiers), with and without offset.
+
+    @date 10-2026
+ */
+
+#pragma GCC diagnostic ignored "-Wunused-variable"
+#pragma GCC diagnostic ignored "-Wunused-parameter"
+
+#include <cstdlib>
+
+#include <Epetra_ConfigDefs.h>
+#ifdef EPETRA_MPI
+#include <mpi.h>
+#include <Epetra_MpiComm.h>
+#else
+#include <Epetra_SerialComm.h>
+#endif
+
+#pragma GCC diagnostic warning "-Wunused-variable"
+#pragma GCC diagnostic warning "-Wunused-parameter"
+
+#include <lifev/core/LifeV.hpp>
+
+#include <lifev/core/mesh/MeshPartitioner.hpp>
+#include <lifev/core/mesh/RegionMesh3DStructured.hpp>
+#include <lifev/core/mesh/RegionMesh.hpp>
+
+#include <lifev/core/array/MatrixEpetra.hpp>
+#include <lifev/core/array/VectorEpetra.hpp>
+
+#include <lifev/eta/fem/ETFESpace.hpp>
+
+#include <lifev/eta/expression/Integrate.hpp>
+
+
+using namespace LifeV;
+
+typedef RegionMesh<LinearTetra> mesh_Type;
+typedef VectorEpetra vector_Type;
+
+// Copy "field" in the block of "block" starting at "offset"
+void copyToBlock ( const vector_Type& field, vector_Type& block, const UInt offset )
+{
+    const Epetra_BlockMap& fieldMap (field.blockMap() );
+
+    for (Int i (0); i < fieldMap.NumMyElements(); ++i)
+    {
+        block[fieldMap.GID (i) + offset] = field[fieldMap.GID (i)];
+    }
+}
+
+// Norm of the difference of two repeated vectors
+Real difference ( const vector_Type& u, const vector_Type& v )
+{
+    vector_Type uniqueDifference (u, Unique);
+    uniqueDifference -= vector_Type (v, Unique);
+    return uniqueDifference.normInf();
+}
+
+int main ( int argc, char** argv )
+{
+
+#ifdef HAVE_MPI
+    MPI_Init (&argc, &argv);
+    std::shared_ptr<Epetra_Comm> Comm (new Epetra_MpiComm (MPI_COMM_WORLD) );
+#else
+    std::shared_ptr<Epetra_Comm> Comm (new Epetra_SerialComm);
+#endif
+
+    const bool verbose (Comm->MyPID() == 0);
+
+    const UInt Nelements (argc > 1 ? std::atoi (argv[1]) : 5);
+
+    if (verbose)
+    {
+        std::cout << " -- Building and partitioning the mesh ... " << std::flush;
+    }
+
+    std::shared_ptr< mesh_Type > fullMeshPtr (new mesh_Type);
+
+    regularMesh3D ( *fullMeshPtr, 1, Nelements, Nelements, Nelements, false,
+                    2.0,   2.0,   2.0,
+                    -1.0,  -1.0,  -1.0);
+
+    MeshPartitioner< mesh_Type >   meshPart;
+    meshPart.setPartitionOverlap ( 1 );
+    meshPart.doPartition ( fullMeshPtr, Comm );
+
+    fullMeshPtr.reset();
+
+    if (verbose)
+    {
+        std::cout << " done ! " << std::endl;
+    }
+
+    std::shared_ptr<ETFESpace< mesh_Type, MapEpetra, 3, 1 > > uSpace
+    ( new ETFESpace< mesh_Type, MapEpetra, 3, 1 > (meshPart, &feTetraP2, Comm) );
+
+    std::shared_ptr<ETFESpace< mesh_Type, MapEpetra, 3, 3 > > wSpace
+    ( new ETFESpace< mesh_Type, MapEpetra, 3, 3 > (meshPart, &feTetraP1, Comm) );
+
+    // Non constant FE functions, alone and as the second block of a larger vector
+    vector_Type u (uSpace->map(), Unique);
+    vector_Type w (wSpace->map(), Unique);
+    const Epetra_BlockMap& uMap (u.blockMap() );
+    const Epetra_BlockMap& wMap (w.blockMap() );
+
+    for (Int i (0); i < uMap.NumMyElements(); ++i)
+    {
+        u[uMap.GID (i)] = 1.0 + uMap.GID (i) % 7;
+    }
+    for (Int i (0); i < wMap.NumMyElements(); ++i)
+    {
+        w[wMap.GID (i)] = 1.0 + wMap.GID (i) % 5;
+    }
+
+    const UInt uOffset (uSpace->dof().numTotalDof() );
+    const UInt wOffset (3 * wSpace->dof().numTotalDof() );
+
+    vector_Type uBlock (uSpace->map() + uSpace->map(), Unique);
+    vector_Type wBlock (wSpace->map() + wSpace->map(), Unique);
+    uBlock *= 0.0;
+    wBlock *= 0.0;
+    copyToBlock (u, uBlock, 0);
+    copyToBlock (u, uBlock, uOffset);
+    copyToBlock (w, wBlock, 0);
+    copyToBlock (w, wBlock, wOffset);
+
+    if (verbose)
+    {
+        std::cout << " -- Integrating the scalar field ... " << std::flush;
+    }
+
+    vector_Type uLocal (uSpace->map(), Repeated);
+    vector_Type uGlobal (uSpace->map(), Repeated);
+    vector_Type uGlobalOffset (uSpace->map(), Repeated);
+    uLocal *= 0.0;
+    uGlobal *= 0.0;
+    uGlobalOffset *= 0.0;
+    {
+        using namespace ExpressionAssembly;
+
+        integrate (  elements (uSpace->mesh() ),
+                     quadRuleTetra4pt,
+                     uSpace,
+                     value (uSpace, u) * phi_i + dot ( grad (uSpace, u) , grad (phi_i) )
+                  ) >> uLocal;
+
+        integrate (  elements (uSpace->mesh() ),
+                     quadRuleTetra4pt,
+                     uSpace,
+                     value (uSpace, uBlock) * phi_i + dot ( grad (uSpace, uBlock) , grad (phi_i) )
+                  ) >> uGlobal;
+
+        integrate (  elements (uSpace->mesh() ),
+                     quadRuleTetra4pt,
+                     uSpace,
+                     value (uSpace, uBlock, uOffset) * phi_i + dot ( grad (uSpace, uBlock, uOffset) , grad (phi_i) )
+                  ) >> uGlobalOffset;
+    }
+    uLocal.globalAssemble();
+    uGlobal.globalAssemble();
+    uGlobalOffset.globalAssemble();
+
+    const Real scalarDiff (std::max (difference (uLocal, uGlobal), difference (uLocal, uGlobalOffset) ) );
+
+    if (verbose)
+    {
+        std::cout << " done ! " << std::endl;
+        std::cout << " Error (scalar field): " << scalarDiff << std::endl;
+    }
+
+    if (verbose)
+    {
+        std::cout << " -- Integrating the vector field ... " << std::flush;
+    }
+
+    vector_Type wLocal (wSpace->map(), Repeated);
+    vector_Type wGlobal (wSpace->map(), Repeated);
+    vector_Type wGlobalOffset (wSpace->map(), Repeated);
+    wLocal *= 0.0;
+    wGlobal *= 0.0;
+    wGlobalOffset *= 0.0;
+    {
+        using namespace ExpressionAssembly;
+
+        integrate (  elements (wSpace->mesh() ),
+                     quadRuleTetra4pt,
+                     wSpace,
+                     dot ( value (wSpace, w) , phi_i ) + dot ( grad (wSpace, w) , grad (phi_i) )
+                  ) >> wLocal;
+
+        integrate (  elements (wSpace->mesh() ),
+                     quadRuleTetra4pt,
+                     wSpace,
+                     dot ( value (wSpace, wBlock) , phi_i ) + dot ( grad (wSpace, wBlock) , grad (phi_i) )
+                  ) >> wGlobal;
+
+        integrate (  elements (wSpace->mesh() ),
+                     quadRuleTetra4pt,
+                     wSpace,
+                     dot ( value (wSpace, wBlock, wOffset) , phi_i ) + dot ( grad (wSpace, wBlock, wOffset) , grad (phi_i) )
+                  ) >> wGlobalOffset;
+    }
+    wLocal.globalAssemble();
+    wGlobal.globalAssemble();
+    wGlobalOffset.globalAssemble();
+
+    const Real vectorDiff (std::max (difference (wLocal, wGlobal), difference (wLocal, wGlobalOffset) ) );
+
+    if (verbose)
+    {
+        std::cout << " done ! " << std::endl;
+        std::cout << " Error (vector field): " << vectorDiff << std::endl;
+    }
+
+#ifdef HAVE_MPI
+    MPI_Finalize();
+#endif
+
+    const Real testTolerance (1e-10);
+
+    if ( scalarDiff >= testTolerance || vectorDiff >= testTolerance )
+    {
+        if (verbose)
+        {
+            std::cout << "Test status: FAILURE" << std::endl;
+        }
+        return ( EXIT_FAILURE );
+    }
+
+    if (verbose)
+    {
+        std::cout << "Test status: SUCCESS" << std::endl;
+    }
+    return ( EXIT_SUCCESS );
+}
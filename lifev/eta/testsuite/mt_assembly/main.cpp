@@ -57,13 +57,17 @@
 #include <lifev/core/mesh/MeshPartitioner.hpp>
 #include <lifev/core/mesh/RegionMesh3DStructured.hpp>
 #include <lifev/core/mesh/RegionMesh.hpp>
+#include <lifev/core/mesh/MeshColoring.hpp>
 
 #include <lifev/core/array/MatrixEpetra.hpp>
+#include <lifev/core/array/MatrixEpetraOffsets.hpp>
+#include <lifev/core/array/VectorEpetra.hpp>
 
 #include <lifev/eta/fem/ETFESpace.hpp>
 
 #include <lifev/eta/expression/Integrate.hpp>
 #include <lifev/eta/expression/BuildGraph.hpp>
+#include <lifev/eta/expression/MatrixFreeOperator.hpp>
 
 
 #include <boost/shared_ptr.hpp>
@@ -73,6 +77,7 @@ using namespace LifeV;
 
 typedef RegionMesh<LinearTetra> mesh_Type;
 typedef MatrixEpetra<Real> matrix_Type;
+typedef VectorEpetra vector_Type;
 
 int main ( int argc, char** argv )
 {
@@ -168,7 +173,8 @@ int main ( int argc, char** argv )
                      quadRuleTetra4pt,
                      uSpace,
                      uSpace,
-                     dot ( grad (phi_i) , grad (phi_j) )
+                     dot ( grad (phi_i) , grad (phi_j) ),
+                     ompParams
                    ) >> matrixGraph;
     }
     matrixGraph->GlobalAssemble();
@@ -179,6 +185,37 @@ int main ( int argc, char** argv )
         std::cout << " done in " << timer.elapsedTime() << "s." << std::endl;
     }
 
+    if (verbose)
+    {
+        std::cout << " -- Precomputing matrix graph from the topology ... " << std::flush;
+    }
+
+    timer.start();
+    std::shared_ptr<Epetra_FECrsGraph> topologyGraph;
+    {
+        using namespace ExpressionAssembly;
+
+        // The same graph, without quadrature and expression
+        topologyGraph.reset (new Epetra_FECrsGraph (Copy, * (uSpace->map().map (Unique) ), 0, true) );
+
+        buildGraph ( elements (uSpace->mesh() ),
+                     uSpace,
+                     uSpace,
+                     ompParams
+                   ) >> topologyGraph;
+    }
+    topologyGraph->GlobalAssemble();
+    timer.stop();
+
+    Real graphDiff (std::abs (static_cast<Real> (matrixGraph->NumGlobalNonzeros() )
+                              - static_cast<Real> (topologyGraph->NumGlobalNonzeros() ) ) );
+
+    if (verbose)
+    {
+        std::cout << " done in " << timer.elapsedTime() << "s." << std::endl;
+        std::cout << " Error (topology graph): " << graphDiff << std::endl;
+    }
+
     if (verbose)
     {
         std::cout << " -- Assembling the Laplace matrix with a precomputed graph ... " << std::flush;
@@ -217,6 +254,316 @@ int main ( int argc, char** argv )
         std::cout << " Closed matrix norm : " << closedMatrixNorm << std::endl;
     }
 
+    if (verbose)
+    {
+        std::cout << " -- Coloring the mesh ... " << std::flush;
+    }
+
+    MeshColoring coloring (Comm);
+    coloring.setMesh (uSpace->mesh() );
+    coloring.setup();
+    coloring.colorMesh();
+    ompParams.setElementColors (coloring.getColorsForAssembly() );
+
+    if (verbose)
+    {
+        std::cout << " done ! " << std::endl;
+    }
+
+    if (verbose)
+    {
+        std::cout << " -- Assembling the Laplace matrix with colored elements ... " << std::flush;
+    }
+
+    std::shared_ptr<matrix_Type> coloredSystemMatrix;
+
+    timer.start();
+    {
+        using namespace ExpressionAssembly;
+
+        coloredSystemMatrix.reset (new matrix_Type ( uSpace->map(), *matrixGraph , true) );
+        *coloredSystemMatrix *= 0.0;
+
+        // The colors stored in ompParams trigger the lock-free assembly
+        integrate (  elements (uSpace->mesh() ),
+                     quadRuleTetra4pt,
+                     uSpace,
+                     uSpace,
+                     dot ( grad (phi_i) , grad (phi_j) ), ompParams
+                  ) >> coloredSystemMatrix;
+
+        coloredSystemMatrix->globalAssemble();
+    }
+    timer.stop();
+
+    if (verbose)
+    {
+        std::cout << " done in " << timer.elapsedTime() << "s." << std::endl;
+    }
+
+    Real coloredMatrixNorm ( coloredSystemMatrix->normInf() );
+
+    if (verbose)
+    {
+        std::cout << " Colored matrix norm : " << coloredMatrixNorm << std::endl;
+    }
+
+    if (verbose)
+    {
+        std::cout << " -- Assembling the Laplace matrix with the geometric cache ... " << std::flush;
+    }
+
+    // The first assembly fills the cache, the second one reads it,
+    // the third one refills it after the invalidation
+    uSpace->enableGeometryCache (quadRuleTetra4pt);
+
+    std::shared_ptr<matrix_Type> cachedSystemMatrix;
+    Real cachedMatrixNormDiff (0.0);
+
+    for (UInt iAssembly (0); iAssembly < 3; ++iAssembly)
+    {
+        using namespace ExpressionAssembly;
+
+        if (iAssembly == 2)
+        {
+            uSpace->invalidateGeometryCache();
+        }
+
+        cachedSystemMatrix.reset (new matrix_Type ( uSpace->map(), *matrixGraph , true) );
+        *cachedSystemMatrix *= 0.0;
+
+        integrate (  elements (uSpace->mesh() ),
+                     quadRuleTetra4pt,
+                     uSpace,
+                     uSpace,
+                     dot ( grad (phi_i) , grad (phi_j) )
+                  ) >> cachedSystemMatrix;
+
+        cachedSystemMatrix->globalAssemble();
+
+        cachedMatrixNormDiff = std::max (cachedMatrixNormDiff, std::abs (cachedSystemMatrix->normInf() - 3.2) );
+    }
+
+    uSpace->disableGeometryCache();
+
+    if (verbose)
+    {
+        std::cout << " done ! " << std::endl;
+        std::cout << " Error (geometric cache): " << cachedMatrixNormDiff << std::endl;
+    }
+
+    if (verbose)
+    {
+        std::cout << " -- Assembling the Laplace matrix with cached insertion offsets ... " << std::flush;
+    }
+
+    // The first assembly records the offsets, the following ones use them
+    std::shared_ptr<matrix_Type> offsetsSystemMatrix (new matrix_Type ( uSpace->map(), *matrixGraph , true) );
+    std::shared_ptr<MatrixEpetraOffsets<Real> > insertionOffsets (new MatrixEpetraOffsets<Real>);
+    Real offsetsMatrixNormDiff (0.0);
+
+    for (UInt iAssembly (0); iAssembly < 3; ++iAssembly)
+    {
+        using namespace ExpressionAssembly;
+
+        offsetsSystemMatrix->zero();
+
+        integrate (  elements (uSpace->mesh() ),
+                     quadRuleTetra4pt,
+                     uSpace,
+                     uSpace,
+                     dot ( grad (phi_i) , grad (phi_j) ),
+                     ompParams
+                  ).addToClosed (offsetsSystemMatrix, insertionOffsets);
+
+        offsetsSystemMatrix->globalAssemble();
+
+        offsetsMatrixNormDiff = std::max (offsetsMatrixNormDiff, std::abs (offsetsSystemMatrix->normInf() - 3.2) );
+    }
+
+    if (verbose)
+    {
+        std::cout << " done ! " << std::endl;
+        std::cout << " Error (insertion offsets): " << offsetsMatrixNormDiff << std::endl;
+    }
+
+    if (verbose)
+    {
+        std::cout << " -- Applying the Laplace operator without assembling it ... " << std::flush;
+    }
+
+    vector_Type xVector (uSpace->map(), Unique);
+    xVector.epetraVector().Random();
+
+    vector_Type assembledProduct (uSpace->map(), Unique);
+    vector_Type matrixFreeProduct (uSpace->map(), Unique);
+
+    closedSystemMatrix->multiply (false, xVector, assembledProduct);
+
+    {
+        using namespace ExpressionAssembly;
+
+        matrixFree ( integrate (  elements (uSpace->mesh() ),
+                                  quadRuleTetra4pt,
+                                  uSpace,
+                                  uSpace,
+                                  dot ( grad (phi_i) , grad (phi_j) )
+                               ) )->apply (xVector, matrixFreeProduct);
+    }
+
+    vector_Type productDifference (assembledProduct);
+    productDifference -= matrixFreeProduct;
+    Real matrixFreeDiff ( productDifference.normInf() );
+
+    if (verbose)
+    {
+        std::cout << " done ! " << std::endl;
+        std::cout << " Error (matrix-free product): " << matrixFreeDiff << std::endl;
+    }
+
+    if (verbose)
+    {
+        std::cout << " -- Assembling the right hand side with one and several threads ... " << std::flush;
+    }
+
+    vector_Type serialRhs (uSpace->map(), Repeated);
+    vector_Type threadedRhs (uSpace->map(), Repeated);
+    serialRhs *= 0.0;
+    threadedRhs *= 0.0;
+
+    {
+        using namespace ExpressionAssembly;
+
+        integrate (  elements (uSpace->mesh() ),
+                     quadRuleTetra4pt,
+                     uSpace,
+                     phi_i
+                  ) >> serialRhs;
+
+        integrate (  elements (uSpace->mesh() ),
+                     quadRuleTetra4pt,
+                     uSpace,
+                     phi_i,
+                     ompParams
+                  ) >> threadedRhs;
+    }
+
+    serialRhs.globalAssemble();
+    threadedRhs.globalAssemble();
+
+    vector_Type rhsDifference (serialRhs, Unique);
+    rhsDifference -= vector_Type (threadedRhs, Unique);
+
+    // The threaded assembly sums the contributions in the serial order
+    Real rhsDiff ( rhsDifference.normInf() );
+
+    if (verbose)
+    {
+        std::cout << " done ! " << std::endl;
+        std::cout << " Error (threaded rhs): " << rhsDiff << std::endl;
+    }
+
+    if (verbose)
+    {
+        std::cout << " -- Integrating the volume with one and several threads ... " << std::flush;
+    }
+
+    Real serialVolume (0.0);
+    Real threadedVolume (0.0);
+
+    {
+        using namespace ExpressionAssembly;
+
+        integrate (  elements (uSpace->mesh() ),
+                     quadRuleTetra4pt,
+                     value (1.0)
+                  ) >> serialVolume;
+
+        integrate (  elements (uSpace->mesh() ),
+                     quadRuleTetra4pt,
+                     value (1.0),
+                     ompParams
+                  ) >> threadedVolume;
+    }
+
+    Real volumeDiff (std::abs (serialVolume - threadedVolume) );
+
+    if (verbose)
+    {
+        std::cout << " done ! " << std::endl;
+        std::cout << " Error (threaded volume): " << volumeDiff << std::endl;
+    }
+
+    if (verbose)
+    {
+        std::cout << " -- Assembling boundary terms with one and several threads ... " << std::flush;
+    }
+
+    // Flag of the top face of the structured mesh
+    const UInt topWall (6);
+
+    QuadratureBoundary boundaryQR (buildTetraBDQR (quadRuleTria4pt) );
+
+    matrix_Type serialBoundaryMatrix (uSpace->map() );
+    matrix_Type threadedBoundaryMatrix (uSpace->map() );
+    vector_Type serialBoundaryRhs (uSpace->map(), Repeated);
+    vector_Type threadedBoundaryRhs (uSpace->map(), Repeated);
+    serialBoundaryMatrix *= 0.0;
+    threadedBoundaryMatrix *= 0.0;
+    serialBoundaryRhs *= 0.0;
+    threadedBoundaryRhs *= 0.0;
+
+    {
+        using namespace ExpressionAssembly;
+
+        integrate (  boundary (uSpace->mesh(), topWall),
+                     boundaryQR,
+                     uSpace,
+                     uSpace,
+                     phi_i * phi_j
+                  ) >> serialBoundaryMatrix;
+
+        integrate (  boundary (uSpace->mesh(), topWall),
+                     boundaryQR,
+                     uSpace,
+                     uSpace,
+                     phi_i * phi_j,
+                     ompParams
+                  ) >> threadedBoundaryMatrix;
+
+        integrate (  boundary (uSpace->mesh(), topWall),
+                     boundaryQR,
+                     uSpace,
+                     phi_i
+                  ) >> serialBoundaryRhs;
+
+        integrate (  boundary (uSpace->mesh(), topWall),
+                     boundaryQR,
+                     uSpace,
+                     phi_i,
+                     ompParams
+                  ) >> threadedBoundaryRhs;
+    }
+
+    serialBoundaryMatrix.globalAssemble();
+    threadedBoundaryMatrix.globalAssemble();
+    serialBoundaryRhs.globalAssemble();
+    threadedBoundaryRhs.globalAssemble();
+
+    // The threads insert the face contributions in the serial order
+    Real boundaryMatrixDiff (std::abs (serialBoundaryMatrix.normInf() - threadedBoundaryMatrix.normInf() ) );
+
+    vector_Type boundaryRhsDifference (serialBoundaryRhs, Unique);
+    boundaryRhsDifference -= vector_Type (threadedBoundaryRhs, Unique);
+    Real boundaryRhsDiff ( boundaryRhsDifference.normInf() );
+
+    if (verbose)
+    {
+        std::cout << " done ! " << std::endl;
+        std::cout << " Error (threaded boundary matrix): " << boundaryMatrixDiff << std::endl;
+        std::cout << " Error (threaded boundary rhs): " << boundaryRhsDiff << std::endl;
+    }
+
 #ifdef HAVE_MPI
     MPI_Finalize();
 #endif
@@ -228,9 +575,20 @@ int main ( int argc, char** argv )
         std::cout << " Error (closed): " << closedMatrixNormDiff << std::endl;
     }
 
+    Real coloredMatrixNormDiff (std::abs (coloredMatrixNorm - 3.2) );
+
+    if (verbose)
+    {
+        std::cout << " Error (colored): " << coloredMatrixNormDiff << std::endl;
+    }
+
     Real testTolerance (1e-10);
 
-    if ( closedMatrixNormDiff >= testTolerance )
+    if ( closedMatrixNormDiff >= testTolerance || coloredMatrixNormDiff >= testTolerance
+            || cachedMatrixNormDiff >= testTolerance || offsetsMatrixNormDiff >= testTolerance
+            || matrixFreeDiff >= testTolerance || graphDiff >= testTolerance
+            || rhsDiff >= testTolerance || volumeDiff >= testTolerance
+            || boundaryMatrixDiff >= testTolerance || boundaryRhsDiff >= testTolerance )
     {
         return ( EXIT_FAILURE );
     }
@@ -0,0 +1,275 @@
+//@HEADER
+/*
+*******************************************************************************
+
+    Copyright (C) 2004, 2005, 2007 EPFL, Politecnico di Milano, INRIA
+    Copyright (C) 2010 EPFL, Politecnico di Milano, Emory University
+
+    This file is part of LifeV.
+
+    LifeV is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    LifeV is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with LifeV.  If not, see <http://www.gnu.org/licenses/>.
+
+*******************************************************************************
+*/
+//@HEADER
+
+/*!
+    @file
+    @brief Test for the sharing of repeated interpolations in ETA expressions
+
+    Expressions using several times the same FE function are integrated
+    in a matrix, a vector and a value. The results are compared with the
+    same expressions where one occurrence is interpolated on a copy of the
+    FE space, which is never shared with the original one.
+
+    @date 10-2026
+ */
+
+#pragma GCC diagnostic ignored "-Wunused-variable"
+#pragma GCC diagnostic ignored "-Wunused-parameter"
+
+#include <cstdlib>
+
+#include <Epetra_ConfigDefs.h>
+#ifdef EPETRA_MPI
+#include <mpi.h>
+#include <Epetra_MpiComm.h>
+#else
+#include <Epetra_SerialComm.h>
+#endif
+
+#pragma GCC diagnostic warning "-Wunused-variable"
+#pragma GCC diagnostic warning "-Wunused-parameter"
+
+#include <lifev/core/LifeV.hpp>
+#include <lifev/core/util/OpenMPParameters.hpp>
+
+#include <lifev/core/mesh/MeshPartitioner.hpp>
+#include <lifev/core/mesh/RegionMesh3DStructured.hpp>
+#include <lifev/core/mesh/RegionMesh.hpp>
+
+#include <lifev/core/array/MatrixEpetra.hpp>
+#include <lifev/core/array/VectorEpetra.hpp>
+
+#include <lifev/eta/fem/ETFESpace.hpp>
+
+#include <lifev/eta/expression/Integrate.hpp>
+
+
+using namespace LifeV;
+
+typedef RegionMesh<LinearTetra> mesh_Type;
+typedef MatrixEpetra<Real> matrix_Type;
+typedef VectorEpetra vector_Type;
+typedef ETFESpace< mesh_Type, MapEpetra, 3, 1 > space_Type;
+
+int main ( int argc, char** argv )
+{
+
+#ifdef HAVE_MPI
+    MPI_Init (&argc, &argv);
+    std::shared_ptr<Epetra_Comm> Comm (new Epetra_MpiComm (MPI_COMM_WORLD) );
+#else
+    std::shared_ptr<Epetra_Comm> Comm (new Epetra_SerialComm);
+#endif
+
+    const bool verbose (Comm->MyPID() == 0);
+
+    const UInt Nelements (argc > 1 ? std::atoi (argv[1]) : 5);
+
+    if (verbose)
+    {
+        std::cout << " -- Building and partitioning the mesh ... " << std::flush;
+    }
+
+    std::shared_ptr< mesh_Type > fullMeshPtr (new mesh_Type);
+
+    regularMesh3D ( *fullMeshPtr, 1, Nelements, Nelements, Nelements, false,
+                    2.0,   2.0,   2.0,
+                    -1.0,  -1.0,  -1.0);
+
+    MeshPartitioner< mesh_Type >   meshPart;
+    meshPart.setPartitionOverlap ( 1 );
+    meshPart.doPartition ( fullMeshPtr, Comm );
+
+    fullMeshPtr.reset();
+
+    if (verbose)
+    {
+        std::cout << " done ! " << std::endl;
+    }
+
+    // The interpolations on uSpace are shared, the ones on copySpace are not
+    std::shared_ptr<space_Type> uSpace (new space_Type (meshPart, &feTetraP1, Comm) );
+    std::shared_ptr<space_Type> copySpace (new space_Type (meshPart, &feTetraP1, Comm) );
+
+    // Two non constant FE functions
+    vector_Type f (uSpace->map(), Unique);
+    vector_Type g (uSpace->map(), Unique);
+    const Epetra_BlockMap& uniqueMap (f.blockMap() );
+
+    for (Int i (0); i < uniqueMap.NumMyElements(); ++i)
+    {
+        f[uniqueMap.GID (i)] = 1.0 + uniqueMap.GID (i) % 5;
+        g[uniqueMap.GID (i)] = 1.0 + uniqueMap.GID (i) % 3;
+    }
+
+    // The integrators make one copy of the evaluation tree per thread
+    OpenMPParameters ompParams;
+    ompParams.numThreads = 2;
+
+    if (verbose)
+    {
+        std::cout << " -- Assembling the matrices ... " << std::flush;
+    }
+
+    matrix_Type sharedMatrix (uSpace->map() );
+    matrix_Type referenceMatrix (uSpace->map() );
+    {
+        using namespace ExpressionAssembly;
+
+        integrate (  elements (uSpace->mesh() ),
+                     quadRuleTetra4pt,
+                     uSpace,
+                     uSpace,
+                     value (uSpace, f) * value (uSpace, g) * value (uSpace, f)
+                     * dot ( grad (phi_i) , grad (phi_j) )
+                     + dot ( grad (uSpace, f) , grad (uSpace, f) ) * phi_i * phi_j,
+                     ompParams
+                  ) >> sharedMatrix;
+
+        integrate (  elements (uSpace->mesh() ),
+                     quadRuleTetra4pt,
+                     uSpace,
+                     uSpace,
+                     value (uSpace, f) * value (uSpace, g) * value (copySpace, f)
+                     * dot ( grad (phi_i) , grad (phi_j) )
+                     + dot ( grad (uSpace, f) , grad (copySpace, f) ) * phi_i * phi_j,
+                     ompParams
+                  ) >> referenceMatrix;
+    }
+    sharedMatrix.globalAssemble();
+    referenceMatrix.globalAssemble();
+
+    vector_Type x (uSpace->map(), Unique);
+    x.epetraVector().Random();
+
+    vector_Type sharedProduct (uSpace->map(), Unique);
+    vector_Type referenceProduct (uSpace->map(), Unique);
+    sharedMatrix.multiply (false, x, sharedProduct);
+    referenceMatrix.multiply (false, x, referenceProduct);
+    sharedProduct -= referenceProduct;
+
+    const Real matrixDiff (sharedProduct.normInf() );
+
+    if (verbose)
+    {
+        std::cout << " done ! " << std::endl;
+        std::cout << " Error (matrix): " << matrixDiff << std::endl;
+    }
+
+    if (verbose)
+    {
+        std::cout << " -- Assembling the vectors ... " << std::flush;
+    }
+
+    vector_Type sharedRhs (uSpace->map(), Repeated);
+    vector_Type referenceRhs (uSpace->map(), Repeated);
+    sharedRhs *= 0.0;
+    referenceRhs *= 0.0;
+    {
+        using namespace ExpressionAssembly;
+
+        integrate (  elements (uSpace->mesh() ),
+                     quadRuleTetra4pt,
+                     uSpace,
+                     value (uSpace, f) * value (uSpace, f) * phi_i
+                     + dot ( grad (uSpace, g) , grad (phi_i) ) * value (uSpace, g),
+                     ompParams
+                  ) >> sharedRhs;
+
+        integrate (  elements (uSpace->mesh() ),
+                     quadRuleTetra4pt,
+                     uSpace,
+                     value (uSpace, f) * value (copySpace, f) * phi_i
+                     + dot ( grad (uSpace, g) , grad (phi_i) ) * value (copySpace, g),
+                     ompParams
+                  ) >> referenceRhs;
+    }
+    sharedRhs.globalAssemble();
+    referenceRhs.globalAssemble();
+
+    vector_Type rhsDifference (sharedRhs, Unique);
+    rhsDifference -= vector_Type (referenceRhs, Unique);
+
+    const Real vectorDiff (rhsDifference.normInf() );
+
+    if (verbose)
+    {
+        std::cout << " done ! " << std::endl;
+        std::cout << " Error (vector): " << vectorDiff << std::endl;
+    }
+
+    if (verbose)
+    {
+        std::cout << " -- Integrating the values ... " << std::flush;
+    }
+
+    Real sharedValue (0.0);
+    Real referenceValue (0.0);
+    {
+        using namespace ExpressionAssembly;
+
+        integrate (  elements (uSpace->mesh() ),
+                     quadRuleTetra4pt,
+                     value (uSpace, f) * value (uSpace, g) * value (uSpace, f),
+                     ompParams
+                  ) >> sharedValue;
+
+        integrate (  elements (uSpace->mesh() ),
+                     quadRuleTetra4pt,
+                     value (uSpace, f) * value (uSpace, g) * value (copySpace, f),
+                     ompParams
+                  ) >> referenceValue;
+    }
+
+    const Real valueDiff (std::abs (sharedValue - referenceValue) / std::abs (referenceValue) );
+
+    if (verbose)
+    {
+        std::cout << " done ! " << std::endl;
+        std::cout << " Error (value): " << valueDiff << std::endl;
+    }
+
+#ifdef HAVE_MPI
+    MPI_Finalize();
+#endif
+
+    const Real testTolerance (1e-10);
+
+    if ( matrixDiff >= testTolerance || vectorDiff >= testTolerance || valueDiff >= testTolerance )
+    {
+        if (verbose)
+        {
+            std::cout << "Test status: FAILURE" << std::endl;
+        }
+        return ( EXIT_FAILURE );
+    }
+
+    if (verbose)
+    {
+        std::cout << "Test status: SUCCESS" << std::endl;
+    }
+    return ( EXIT_SUCCESS );
+}
@@ -98,8 +98,7 @@ void FSIExactJacobian::evalResidual (vector_Type&       res,
 
     eval (disp, iter);
 
-    res  = this->lambdaSolid();
-    res -=  disp;
+    res.linearCombination ( 1., this->lambdaSolid(), -1., disp );
 
     if (this->isSolid() )
     {
@@ -83,8 +83,7 @@ void FSIFixedPoint::evalResidual (vector_Type& res, const vector_Type& disp, UIn
 
     eval (disp, iter);
 
-    res  = disp;
-    res -= this->lambdaSolid();
+    res.linearCombination ( 1., disp, -1., this->lambdaSolid() );
 }
 
 
@@ -0,0 +1,520 @@
+//@HEADER
+/*
+*******************************************************************************
+
+    Copyright (C) 2004, 2005, 2007 EPFL, Politecnico di Milano, INRIA
+    Copyright (C) 2010 EPFL, Politecnico di Milano, Emory University
+
+    This file is part of LifeV.
+
+    LifeV is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    LifeV is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with LifeV.  If not, see <http://www.gnu.org/licenses/>.
+
+*******************************************************************************
+*/
+//@HEADER
+
+/*!
+    @file
+    @brief Benchmark of the assembly of P1 matrices with ETA, FastAssembler and AssemblyElemental
+
+    The same operators (scalar and vectorial Laplacian, scalar and vectorial
+    mass, convective term and SUPG streamline term) are assembled on a
+    structured and on an unstructured mesh with:
+
+    <ul>
+        <li> the expression template assembly (ETA), for each number of threads;
+        <li> FastAssembler (and FastAssemblerNS for the convective term), for each number of threads;
+        <li> the classical assembly based on AssemblyElemental (ADRAssembler), serial only.
+    </ul>
+
+    The results (time per assembly, elements per second, estimated memory
+    traffic and threading efficiency) are written in a JSON file.
+
+    Note that the SUPG term of FastAssembler uses the stabilization parameter
+    computed from the velocity, while a constant one is used with ETA: the
+    amount of work is the same, the values are not.
+
+    @date 10-2026
+ */
+
+#include <Epetra_ConfigDefs.h>
+#ifdef EPETRA_MPI
+#include <mpi.h>
+#include <Epetra_MpiComm.h>
+#else
+#include <Epetra_SerialComm.h>
+#endif
+
+#include <fstream>
+#include <functional>
+
+#include <lifev/core/LifeV.hpp>
+#include <lifev/core/util/WallClock.hpp>
+#include <lifev/core/util/OpenMPParameters.hpp>
+
+#include <lifev/core/mesh/MeshData.hpp>
+#include <lifev/core/mesh/MeshPartitioner.hpp>
+#include <lifev/core/mesh/RegionMesh3DStructured.hpp>
+#include <lifev/core/mesh/RegionMesh.hpp>
+
+#include <lifev/core/array/MatrixEpetra.hpp>
+#include <lifev/core/array/VectorEpetra.hpp>
+
+#include <lifev/core/fem/FESpace.hpp>
+#include <lifev/core/fem/FastAssembler.hpp>
+#include <lifev/core/solver/ADRAssembler.hpp>
+
+#include <lifev/eta/fem/ETFESpace.hpp>
+#include <lifev/eta/expression/Integrate.hpp>
+
+#include <lifev/navier_stokes_blocks/solver/FastAssemblerNS.hpp>
+
+using namespace LifeV;
+
+namespace
+{
+
+typedef RegionMesh<LinearTetra> mesh_Type;
+typedef std::shared_ptr<mesh_Type> meshPtr_Type;
+typedef MatrixEpetra<Real> matrix_Type;
+typedef std::shared_ptr<matrix_Type> matrixPtr_Type;
+typedef VectorEpetra vector_Type;
+typedef std::shared_ptr<Epetra_Comm> commPtr_Type;
+
+typedef FESpace<mesh_Type, MapEpetra> fespace_Type;
+typedef std::shared_ptr<fespace_Type> fespacePtr_Type;
+typedef ETFESpace<mesh_Type, MapEpetra, 3, 3> vectorETFESpace_Type;
+typedef ETFESpace<mesh_Type, MapEpetra, 3, 1> scalarETFESpace_Type;
+
+typedef ADRAssembler<mesh_Type, matrix_Type, vector_Type> classicAssembler_Type;
+
+typedef std::function<void ()> assembly_Type;
+
+//! Result of the benchmark of one operator with one engine
+struct BenchmarkRun
+{
+    std::string mesh;
+    std::string engine;
+    std::string operatorName;
+    UInt numThreads;
+    UInt numElements;
+    // Time of one assembly (maximum over the processes)
+    Real time;
+    // Estimated memory traffic of one assembly
+    Real bytes;
+};
+
+//! Estimate of the memory traffic for one element
+/*!
+  Coordinates of the vertices, global indices of the rows and of the columns,
+  entries of the elemental matrix and, for the convective terms, values of the
+  advection field gathered from the global vector. The reads and writes in the
+  global matrix (which depend on the sparsity pattern) are not counted.
+ */
+Real bytesPerElement (const UInt nbDof, const UInt fieldDim, const bool gatherVelocity)
+{
+    const UInt nbRows (nbDof * fieldDim);
+    Real bytes ( mesh_Type::geoShape_Type::S_numVertices * 3 * sizeof (Real)
+                 + 2 * nbRows * sizeof (Int)
+                 + nbRows * nbRows * sizeof (Real) );
+    if (gatherVelocity)
+    {
+        bytes += nbDof * 3 * sizeof (Real);
+    }
+    return bytes;
+}
+
+//! Average time of an assembly, maximum over the processes
+Real timeAssembly (const assembly_Type& assembly, const UInt repetitions, const Epetra_Comm& comm)
+{
+    // The first call is not timed (allocations, first touch of the memory)
+    assembly();
+
+    comm.Barrier();
+    WallClock timer;
+    timer.start();
+    for (UInt i (0); i < repetitions; ++i)
+    {
+        assembly();
+    }
+    timer.stop();
+
+    Real localTime (timer.elapsedTime() / repetitions);
+    Real time (0.0);
+    comm.MaxAll (&localTime, &time, 1);
+    return time;
+}
+
+//! Run all the engines and operators on a partitioned mesh
+void benchmarkMesh (const std::string& meshName, const meshPtr_Type& mesh, const commPtr_Type& comm,
+                    const std::vector<UInt>& threads, const UInt repetitions,
+                    std::vector<BenchmarkRun>& runs, const bool verbose)
+{
+    using namespace ExpressionAssembly;
+
+    if (verbose)
+    {
+        std::cout << " -- Benchmark on the " << meshName << " mesh" << std::endl;
+    }
+
+    // Finite element spaces
+    fespacePtr_Type uFESpace (new fespace_Type (mesh, "P1", 3, comm) );
+    fespacePtr_Type sFESpace (new fespace_Type (mesh, "P1", 1, comm) );
+
+    std::shared_ptr<vectorETFESpace_Type> uETFESpace
+    ( new vectorETFESpace_Type (mesh, & (uFESpace->refFE() ), comm) );
+    std::shared_ptr<scalarETFESpace_Type> sETFESpace
+    ( new scalarETFESpace_Type (mesh, & (sFESpace->refFE() ), comm) );
+
+    const QuadratureRule& qr (uFESpace->qr() );
+
+    // Advection field
+    vector_Type betaUnique (uFESpace->map(), Unique);
+    betaUnique.epetraVector().Random();
+    vector_Type beta (betaUnique, Repeated);
+
+    // Constant stabilization parameter for the ETA streamline term
+    const Real tau (0.1);
+
+    Int localElements (mesh->numElements() );
+    Int globalElements (0);
+    comm->SumAll (&localElements, &globalElements, 1);
+
+    const UInt nbDof (uFESpace->refFE().nbDof() );
+    const Real scalarBytes (bytesPerElement (nbDof, 1, false) );
+    const Real vectorBytes (bytesPerElement (nbDof, 3, false) );
+    const Real convectiveBytes (bytesPerElement (nbDof, 3, true) );
+
+    auto record = [&] (const std::string & engine, const std::string & operatorName,
+                       const UInt numThreads, const Real time, const Real bytes)
+    {
+        BenchmarkRun run;
+        run.mesh = meshName;
+        run.engine = engine;
+        run.operatorName = operatorName;
+        run.numThreads = numThreads;
+        run.numElements = globalElements;
+        run.time = time;
+        run.bytes = bytes * globalElements;
+        runs.push_back (run);
+
+        if (verbose)
+        {
+            std::cout << "    " << engine << " " << operatorName << " (" << numThreads << " threads): "
+                      << time << " s" << std::endl;
+        }
+    };
+
+    // Fast assemblers, allocated once
+    std::shared_ptr<FastAssembler> fastAssembler (new FastAssembler (mesh, comm, & (uFESpace->refFE() ), &qr) );
+    fastAssembler->allocateSpace (mesh->numElements(), & (uFESpace->fe() ), uFESpace);
+    fastAssembler->setConstants_NavierStokes (1.0, 1.0, 0.01, 2, 30.0);
+    fastAssembler->allocateSpace_SUPG (& (uFESpace->fe() ) );
+
+    std::shared_ptr<FastAssemblerNS> fastAssemblerNS
+    ( new FastAssemblerNS (mesh, comm, & (uFESpace->refFE() ), & (sFESpace->refFE() ), uFESpace, sFESpace, &qr) );
+    fastAssemblerNS->setConstants_NavierStokes (1.0, 1.0, 0.01, 2, 30.0);
+    fastAssemblerNS->allocateSpace (& (uFESpace->fe() ), false);
+
+    for (UInt iThreads (0); iThreads < threads.size(); ++iThreads)
+    {
+        OpenMPParameters ompParams;
+        ompParams.numThreads = threads[iThreads];
+        const UInt n (threads[iThreads]);
+
+        // ETA
+
+        record ("eta", "laplacian_scalar", n, timeAssembly ( [&] ()
+        {
+            matrixPtr_Type matrix (new matrix_Type (sFESpace->map() ) );
+            integrate ( elements (mesh), qr, sETFESpace, sETFESpace,
+                        dot (grad (phi_i), grad (phi_j) ), ompParams ) >> matrix;
+            matrix->globalAssemble();
+        }, repetitions, *comm), scalarBytes);
+
+        record ("eta", "laplacian_vectorial", n, timeAssembly ( [&] ()
+        {
+            matrixPtr_Type matrix (new matrix_Type (uFESpace->map() ) );
+            integrate ( elements (mesh), qr, uETFESpace, uETFESpace,
+                        dot (grad (phi_i), grad (phi_j) ), ompParams ) >> matrix;
+            matrix->globalAssemble();
+        }, repetitions, *comm), vectorBytes);
+
+        record ("eta", "mass_scalar", n, timeAssembly ( [&] ()
+        {
+            matrixPtr_Type matrix (new matrix_Type (sFESpace->map() ) );
+            integrate ( elements (mesh), qr, sETFESpace, sETFESpace,
+                        phi_i * phi_j, ompParams ) >> matrix;
+            matrix->globalAssemble();
+        }, repetitions, *comm), scalarBytes);
+
+        record ("eta", "mass_vectorial", n, timeAssembly ( [&] ()
+        {
+            matrixPtr_Type matrix (new matrix_Type (uFESpace->map() ) );
+            integrate ( elements (mesh), qr, uETFESpace, uETFESpace,
+                        dot (phi_i, phi_j), ompParams ) >> matrix;
+            matrix->globalAssemble();
+        }, repetitions, *comm), vectorBytes);
+
+        record ("eta", "convective", n, timeAssembly ( [&] ()
+        {
+            matrixPtr_Type matrix (new matrix_Type (uFESpace->map() ) );
+            integrate ( elements (mesh), qr, uETFESpace, uETFESpace,
+                        dot (value (uETFESpace, beta) * grad (phi_j), phi_i), ompParams ) >> matrix;
+            matrix->globalAssemble();
+        }, repetitions, *comm), convectiveBytes);
+
+        record ("eta", "supg", n, timeAssembly ( [&] ()
+        {
+            matrixPtr_Type matrix (new matrix_Type (uFESpace->map() ) );
+            integrate ( elements (mesh), qr, uETFESpace, uETFESpace,
+                        value (tau) * dot (value (uETFESpace, beta) * grad (phi_i),
+                                           value (uETFESpace, beta) * grad (phi_j) ), ompParams ) >> matrix;
+            matrix->globalAssemble();
+        }, repetitions, *comm), convectiveBytes);
+
+        // FastAssembler: the threads are set through OpenMP
+
+        auto fastRun = [&] (const fespacePtr_Type & space, std::function<void (matrixPtr_Type&)> assemble)
+        {
+            return timeAssembly ( [&] ()
+            {
+                matrixPtr_Type matrix (new matrix_Type (space->map() ) );
+                ompParams.apply();
+                assemble (matrix);
+                ompParams.restorePreviousNumThreads();
+                matrix->globalAssemble();
+            }, repetitions, *comm);
+        };
+
+        record ("fast_assembler", "laplacian_scalar", n,
+                fastRun (sFESpace, [&] (matrixPtr_Type & m)
+        {
+            fastAssembler->assembleGradGrad_scalar (m);
+        }), scalarBytes);
+
+        record ("fast_assembler", "laplacian_vectorial", n,
+                fastRun (uFESpace, [&] (matrixPtr_Type & m)
+        {
+            fastAssembler->assembleGradGrad_vectorial (m);
+        }), vectorBytes);
+
+        record ("fast_assembler", "mass_scalar", n,
+                fastRun (sFESpace, [&] (matrixPtr_Type & m)
+        {
+            fastAssembler->assembleMass_scalar (m);
+        }), scalarBytes);
+
+        record ("fast_assembler", "mass_vectorial", n,
+                fastRun (uFESpace, [&] (matrixPtr_Type & m)
+        {
+            fastAssembler->assembleMass_vectorial (m);
+        }), vectorBytes);
+
+        record ("fast_assembler", "convective", n,
+                fastRun (uFESpace, [&] (matrixPtr_Type & m)
+        {
+            fastAssembler->assembleConvective (m, beta);
+        }), convectiveBytes);
+
+        record ("fast_assembler", "supg", n,
+                fastRun (uFESpace, [&] (matrixPtr_Type & m)
+        {
+            fastAssembler->assemble_SUPG_block00 (m, beta);
+        }), convectiveBytes);
+
+        record ("fast_assembler_ns", "convective", n,
+                fastRun (uFESpace, [&] (matrixPtr_Type & m)
+        {
+            fastAssemblerNS->assembleConvective (m, beta);
+        }), convectiveBytes);
+    }
+
+    // Classical assembly with AssemblyElemental: serial, no SUPG term
+    classicAssembler_Type scalarAssembler;
+    scalarAssembler.setup (sFESpace, uFESpace);
+    classicAssembler_Type vectorAssembler;
+    vectorAssembler.setup (uFESpace, uFESpace);
+
+    auto classicRun = [&] (const fespacePtr_Type & space, std::function<void (matrixPtr_Type&)> assemble)
+    {
+        return timeAssembly ( [&] ()
+        {
+            matrixPtr_Type matrix (new matrix_Type (space->map() ) );
+            assemble (matrix);
+            matrix->globalAssemble();
+        }, repetitions, *comm);
+    };
+
+    record ("assembly_elemental", "laplacian_scalar", 1,
+            classicRun (sFESpace, [&] (matrixPtr_Type & m)
+    {
+        scalarAssembler.addDiffusion (m);
+    }), scalarBytes);
+
+    record ("assembly_elemental", "laplacian_vectorial", 1,
+            classicRun (uFESpace, [&] (matrixPtr_Type & m)
+    {
+        vectorAssembler.addDiffusion (m);
+    }), vectorBytes);
+
+    record ("assembly_elemental", "mass_scalar", 1,
+            classicRun (sFESpace, [&] (matrixPtr_Type & m)
+    {
+        scalarAssembler.addMass (m);
+    }), scalarBytes);
+
+    record ("assembly_elemental", "mass_vectorial", 1,
+            classicRun (uFESpace, [&] (matrixPtr_Type & m)
+    {
+        vectorAssembler.addMass (m);
+    }), vectorBytes);
+
+    record ("assembly_elemental", "convective", 1,
+            classicRun (uFESpace, [&] (matrixPtr_Type & m)
+    {
+        vectorAssembler.addAdvection (m, beta);
+    }), convectiveBytes);
+}
+
+//! Write the results in a JSON file
+/*!
+  The threading efficiency of a run is computed with respect to the run of the
+  same engine and operator on the same mesh with the smallest number of threads.
+ */
+void writeJSON (const std::string& fileName, const std::vector<BenchmarkRun>& runs,
+                const Int numProcesses, const UInt repetitions)
+{
+    std::ofstream out (fileName.c_str() );
+
+    out << "{" << std::endl;
+    out << "  \"benchmark\": \"assembly\"," << std::endl;
+    out << "  \"processes\": " << numProcesses << "," << std::endl;
+    out << "  \"repetitions\": " << repetitions << "," << std::endl;
+    out << "  \"results\": [" << std::endl;
+
+    for (UInt i (0); i < runs.size(); ++i)
+    {
+        const BenchmarkRun& run (runs[i]);
+
+        const BenchmarkRun* reference (&run);
+        for (UInt j (0); j < runs.size(); ++j)
+        {
+            if (runs[j].mesh == run.mesh && runs[j].engine == run.engine
+                    && runs[j].operatorName == run.operatorName
+                    && runs[j].numThreads < reference->numThreads)
+            {
+                reference = &runs[j];
+            }
+        }
+        const Real efficiency ( (reference->time * reference->numThreads) / (run.time * run.numThreads) );
+
+        out << "    {"
+            << "\"mesh\": \"" << run.mesh << "\", "
+            << "\"elements\": " << run.numElements << ", "
+            << "\"engine\": \"" << run.engine << "\", "
+            << "\"operator\": \"" << run.operatorName << "\", "
+            << "\"threads\": " << run.numThreads << ", "
+            << "\"time\": " << run.time << ", "
+            << "\"elements_per_second\": " << run.numElements / run.time << ", "
+            << "\"bytes_moved\": " << run.bytes << ", "
+            << "\"bandwidth\": " << run.bytes / run.time << ", "
+            << "\"threading_efficiency\": " << efficiency
+            << "}" << (i + 1 < runs.size() ? "," : "") << std::endl;
+    }
+
+    out << "  ]" << std::endl;
+    out << "}" << std::endl;
+}
+
+} // anonymous namespace
+
+int
+main ( int argc, char** argv )
+{
+#ifdef HAVE_MPI
+    MPI_Init (&argc, &argv);
+    commPtr_Type Comm ( new Epetra_MpiComm (MPI_COMM_WORLD) );
+#else
+    commPtr_Type Comm ( new Epetra_SerialComm () );
+#endif
+
+    {
+        const bool verbose (Comm->MyPID() == 0);
+
+        // Reading the dataFile
+        const std::string defaultDataName = "data";
+        GetPot command_line (argc, argv);
+        std::string data_file_name = command_line.follow (defaultDataName.c_str(), 2, "-f", "--file");
+        GetPot dataFile ( data_file_name );
+
+        const UInt repetitions (dataFile ("benchmark/repetitions", 5) );
+        const std::string outputFile (dataFile ("benchmark/output", "assembly_benchmark.json") );
+
+        std::vector<UInt> threads;
+        for (UInt i (0); i < dataFile.vector_variable_size ("benchmark/threads"); ++i)
+        {
+            threads.push_back (dataFile ("benchmark/threads", 1, i) );
+        }
+        if (threads.empty() )
+        {
+            threads.push_back (1);
+        }
+
+        std::vector<BenchmarkRun> runs;
+
+        // Structured mesh of the unit cube
+        if (dataFile ("benchmark/structured/use", true) )
+        {
+            const UInt nElements (dataFile ("benchmark/structured/elements", 20) );
+
+            meshPtr_Type fullMeshPtr ( new mesh_Type ( Comm ) );
+            regularMesh3D ( *fullMeshPtr, 1, nElements, nElements, nElements, false,
+                            1.0, 1.0, 1.0, 0.0, 0.0, 0.0 );
+
+            MeshPartitioner< mesh_Type > meshPart (fullMeshPtr, Comm);
+            meshPtr_Type localMeshPtr (meshPart.meshPartition() );
+            fullMeshPtr.reset();
+
+            benchmarkMesh ("structured", localMeshPtr, Comm, threads, repetitions, runs, verbose);
+        }
+
+        // Unstructured mesh read from file
+        if (dataFile ("benchmark/unstructured/use", true) )
+        {
+            meshPtr_Type fullMeshPtr ( new mesh_Type ( Comm ) );
+            MeshData meshData;
+            meshData.setup (dataFile, "benchmark/unstructured");
+            readMesh (*fullMeshPtr, meshData);
+
+            MeshPartitioner< mesh_Type > meshPart (fullMeshPtr, Comm);
+            meshPtr_Type localMeshPtr (meshPart.meshPartition() );
+            fullMeshPtr.reset();
+
+            benchmarkMesh ("unstructured", localMeshPtr, Comm, threads, repetitions, runs, verbose);
+        }
+
+        if (verbose)
+        {
+            writeJSON (outputFile, runs, Comm->NumProc(), repetitions);
+            std::cout << " -- Results written in " << outputFile << std::endl;
+        }
+    }
+
+#ifdef HAVE_MPI
+    MPI_Finalize();
+#endif
+
+    return ( EXIT_SUCCESS );
+}
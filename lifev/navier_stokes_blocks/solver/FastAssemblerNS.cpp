@@ -23,10 +23,44 @@ FastAssemblerNS::FastAssemblerNS( const meshPtr_Type& mesh, const commPtr_Type&
 		M_fespace_velocity ( fespace_velocity ),
 		M_fespace_pressure ( fespace_pressure ),
 		M_qr ( qr ),
-		M_useSUPG ( false )
+		M_useSUPG ( false ),
+		M_useInsertionOffsets ( false )
 {
 }
 //=========================================================================
+void
+FastAssemblerNS::setUseInsertionOffsets ( const bool& useOffsets )
+{
+	M_useInsertionOffsets = useOffsets;
+	M_insertionOffsets.clear();
+}
+//=========================================================================
+void
+FastAssemblerNS::insertValues ( matrix_Type& matrix, const int& block, const int& k, const int& ndof, int* rows, int* cols, double** vals )
+{
+	if ( M_useInsertionOffsets && matrix.filled() )
+	{
+		offsetsPtr_Type& offsets = M_insertionOffsets[ matrix.matrixPtr().get() ];
+
+		if ( !offsets )
+		{
+			offsets.reset ( new offsets_Type );
+		}
+
+		// The structure of the matrix changed (or first use): the offsets are recomputed
+		if ( !offsets->isValidFor ( matrix ) )
+		{
+			offsets->reset ( matrix, 9 * M_numElements );
+		}
+
+		offsets->sumIntoCoefficients ( block * M_numElements + k, matrix, ndof, ndof, rows, cols, vals );
+	}
+	else
+	{
+		matrix.matrixPtr()->InsertGlobalValues ( ndof, rows, ndof, cols, vals, Epetra_FECrsMatrix::ROW_MAJOR);
+	}
+}
+//=========================================================================
 // Destructor //
 FastAssemblerNS::~FastAssemblerNS()
 {
@@ -1417,10 +1451,7 @@ FastAssemblerNS::assembleConvective( matrixPtr_Type& matrix, const vector_Type&
 
     for ( int k = 0; k < M_numElements; ++k )
     {
-        matrix->matrixPtr()->InsertGlobalValues ( ndof_velocity, M_rows_velocity[k],
-                                                  ndof_velocity, M_cols_velocity[k],
-                                                  M_vals_00[k],
-                                                  Epetra_FECrsMatrix::ROW_MAJOR);
+        insertValues ( *matrix, 0, k, ndof_velocity, M_rows_velocity[k], M_cols_velocity[k], M_vals_00[k] );
     }
 
     for ( UInt d1 = 1; d1 < 3 ; d1++ )
@@ -1432,10 +1463,7 @@ FastAssemblerNS::assembleConvective( matrixPtr_Type& matrix, const vector_Type&
                 M_rows_tmp[k][i] = M_rows_velocity[k][i] + d1 * M_numScalarDofs;
                 M_cols_tmp[k][i] = M_cols_velocity[k][i] + d1 * M_numScalarDofs;
             }
-            matrix->matrixPtr()->InsertGlobalValues ( ndof_velocity, M_rows_tmp[k],
-                                                      ndof_velocity, M_cols_tmp[k],
-                                                      M_vals_00[k],
-                                                      Epetra_FECrsMatrix::ROW_MAJOR);
+            insertValues ( *matrix, 4 * d1, k, ndof_velocity, M_rows_tmp[k], M_cols_tmp[k], M_vals_00[k] );
         }
     }
 }
@@ -1577,10 +1605,7 @@ FastAssemblerNS::jacobianNS( matrixPtr_Type& matrix, const vector_Type& u_h )
             {
                 M_rows_tmp[k][i] = M_rows_velocity[k][i] + d1 * M_numScalarDofs;
             }
-            matrix->matrixPtr()->InsertGlobalValues ( ndof_velocity, M_rows_tmp[k],
-                                                      ndof_velocity, M_cols_velocity[k],
-                                                      M_vals_supg[k][d1][0],
-                                                      Epetra_FECrsMatrix::ROW_MAJOR);
+            insertValues ( *matrix, 3 * d1 + 0, k, ndof_velocity, M_rows_tmp[k], M_cols_velocity[k], M_vals_supg[k][d1][0] );
 
         }
 
@@ -1590,10 +1615,7 @@ FastAssemblerNS::jacobianNS( matrixPtr_Type& matrix, const vector_Type& u_h )
             {
                 M_cols_tmp[k][i] = M_cols_velocity[k][i] + M_numScalarDofs;
             }
-            matrix->matrixPtr()->InsertGlobalValues ( ndof_velocity, M_rows_tmp[k],
-                                                      ndof_velocity, M_cols_tmp[k],
-                                                      M_vals_supg[k][d1][1],
-                                                      Epetra_FECrsMatrix::ROW_MAJOR);
+            insertValues ( *matrix, 3 * d1 + 1, k, ndof_velocity, M_rows_tmp[k], M_cols_tmp[k], M_vals_supg[k][d1][1] );
         }
 
         for ( int k = 0; k < M_numElements; ++k )
@@ -1602,10 +1624,7 @@ FastAssemblerNS::jacobianNS( matrixPtr_Type& matrix, const vector_Type& u_h )
             {
                 M_cols_tmp[k][i] = M_cols_velocity[k][i] + 2 * M_numScalarDofs;
             }
-            matrix->matrixPtr()->InsertGlobalValues ( ndof_velocity, M_rows_tmp[k],
-                                                      ndof_velocity, M_cols_tmp[k],
-                                                      M_vals_supg[k][d1][2],
-                                                      Epetra_FECrsMatrix::ROW_MAJOR);
+            insertValues ( *matrix, 3 * d1 + 2, k, ndof_velocity, M_rows_tmp[k], M_cols_tmp[k], M_vals_supg[k][d1][2] );
         }
     }
 }
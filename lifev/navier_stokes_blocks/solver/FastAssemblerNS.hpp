@@ -52,10 +52,13 @@
 #ifndef FASTASSEMBLERNS_HPP
 #define FASTASSEMBLERNS_HPP
 
+#include <map>
+
 #include <lifev/core/LifeV.hpp>
 #include <lifev/core/mesh/RegionMesh.hpp>
 #include <lifev/core/array/VectorEpetra.hpp>
 #include <lifev/core/array/MatrixEpetra.hpp>
+#include <lifev/core/array/MatrixEpetraOffsets.hpp>
 #include <lifev/core/fem/QuadratureRule.hpp>
 #include <lifev/core/fem/ReferenceFE.hpp>
 #include <lifev/core/fem/CurrentFE.hpp>
@@ -86,6 +89,9 @@ public:
     typedef FESpace<mesh_Type, MapEpetra> fespace_Type;
     typedef std::shared_ptr<fespace_Type> fespacePtr_Type;
 
+    typedef MatrixEpetraOffsets<Real> offsets_Type;
+    typedef std::shared_ptr<offsets_Type> offsetsPtr_Type;
+
 
     //! Constructor
     /*!
@@ -240,10 +246,32 @@ public:
 
     void setTimeStep ( const Real& timestep ) { M_timestep = timestep; };
 
+    //! Use cached insertion offsets when assembling the convective term and the Jacobian in closed matrices
+    /*!
+     * When enabled, the first assembly in a closed matrix records the positions
+     * of the entries of each element in the values of the matrix (see MatrixEpetraOffsets),
+     * and the following assemblies in the same matrix write directly in these values.
+     * Assemblies in open matrices are not affected.
+     * @param useOffsets - true to enable the cached offsets
+     */
+    void setUseInsertionOffsets ( const bool& useOffsets );
+
 	//@}
 
 private:
 
+    //! Sum the values of a block of an element in the matrix
+    /*!
+     * @param matrix - global matrix
+     * @param block - index of the block (3*row component + column component)
+     * @param k - index of the element
+     * @param ndof - number of rows and of columns of the block
+     * @param rows - global row indices
+     * @param cols - global column indices
+     * @param vals - values of the block, row by row
+     */
+    void insertValues ( matrix_Type& matrix, const int& block, const int& k, const int& ndof, int* rows, int* cols, double** vals );
+
 	meshPtr_Type M_mesh;
 	commPtr_Type M_comm;
 
@@ -294,6 +322,9 @@ private:
     double M_orderBDF;
     double M_C_I;
     double M_alpha;
+
+    bool M_useInsertionOffsets;
+    std::map<const Epetra_FECrsMatrix*, offsetsPtr_Type> M_insertionOffsets;
 };
 
 } // Namespace LifeV
@@ -55,6 +55,7 @@ NavierStokesSolverBlocks::NavierStokesSolverBlocks(const dataFile_Type dataFile,
         M_flagBody ( dataFile("fluid/forces/flag", 31 ) ),
         M_solve_blocks ( dataFile("fluid/solve_blocks", true ) ),
         M_useFastAssembly ( dataFile("fluid/use_fast_assembly", false ) ),
+        M_useInsertionOffsets ( dataFile("fluid/use_insertion_offsets", false ) ),
         M_orderBDF ( dataFile("fluid/time_discretization/BDF_order", 2 ) ),
         M_orderVel ( dataFile("fluid/stabilization/vel_order", 2 ) )
 {
@@ -148,8 +149,12 @@ void NavierStokesSolverBlocks::setup(const meshPtr_Type& mesh, const int& id_dom
     												 M_velocityFESpace, M_pressureFESpace,
     												 &(M_velocityFESpace->qr()) ) );
     	M_fastAssembler->allocateSpace ( &(M_velocityFESpace->fe()), true );
+    	M_fastAssembler->setUseInsertionOffsets ( M_useInsertionOffsets );
     }
 
+    // Positions of the entries of the elements in the Jacobian, recorded at the first assembly
+    M_jacobianOffsets.reset ( new MatrixEpetraOffsets<Real> );
+
 
     if ( M_fullyImplicit )
     {
@@ -1409,13 +1414,21 @@ void NavierStokesSolverBlocks::updateJacobian( const vector_Type& u_k )
 		else
 		{
 			using namespace ExpressionAssembly;
-			integrate( elements(M_fespaceUETA->mesh()),
+			auto jacobianIntegrator = integrate( elements(M_fespaceUETA->mesh()),
 						M_velocityFESpace->qr(),
 						M_fespaceUETA,
 						M_fespaceUETA,
 						dot( M_density * phi_j * grad(M_fespaceUETA, uk_rep), phi_i )
-			)
-			>> M_Jacobian;
+			);
+
+			if ( M_useInsertionOffsets && M_Jacobian->filled() )
+			{
+				jacobianIntegrator.addToClosed ( M_Jacobian, M_jacobianOffsets );
+			}
+			else
+			{
+				jacobianIntegrator >> M_Jacobian;
+			}
 		}
 	}
     M_Jacobian->globalAssemble();
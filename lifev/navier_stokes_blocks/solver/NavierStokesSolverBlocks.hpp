@@ -50,6 +50,7 @@
 
 // includes for matrices and vector
 #include <lifev/core/array/MatrixEpetra.hpp>
+#include <lifev/core/array/MatrixEpetraOffsets.hpp>
 #include <lifev/core/array/VectorEpetra.hpp>
 
 // includes for building the matrix graph
@@ -766,7 +767,9 @@ private:
     std::shared_ptr<PostProcessingBoundary<mesh_Type> > M_postProcessing;
 
     bool M_useFastAssembly;
+    bool M_useInsertionOffsets;
     std::shared_ptr<FastAssemblerNS> M_fastAssembler;
+    std::shared_ptr<MatrixEpetraOffsets<Real> > M_jacobianOffsets;
     Real M_orderBDF;
     UInt M_orderVel;
 